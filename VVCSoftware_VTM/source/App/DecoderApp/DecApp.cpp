@@ -35,11 +35,22 @@
     \brief    Decoder application class
 */
 
+#include <atomic>
+#include <chrono>
 #include <list>
+#include <memory>
 #include <numeric>
+#include <sstream>
+#include <thread>
 #include <vector>
 #include <stdio.h>
 #include <fcntl.h>
+#include <errno.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 #include "DecApp.h"
 #include "DecoderLib/AnnexBread.h"
@@ -52,6 +63,53 @@
 //! \ingroup DecoderApp
 //! \{
 
+/**
+ * Bounded read buffer over a file descriptor, used when the bitstream is read
+ * from stdin. Every refill returns as soon as some input is available, so NAL
+ * units arriving through a pipe are decoded without waiting for the buffer to
+ * fill, and memory use does not depend on the length of the stream.
+ */
+class StreamingInputBuffer : public std::streambuf
+{
+public:
+  static constexpr size_t DEFAULT_SIZE = 64 * 1024;
+
+  StreamingInputBuffer(int fd, size_t size = DEFAULT_SIZE) : m_fd(fd), m_buffer(size)
+  {
+    setg(m_buffer.data(), m_buffer.data(), m_buffer.data());
+  }
+
+protected:
+  int_type underflow() override
+  {
+    if (gptr() < egptr())
+    {
+      return traits_type::to_int_type(*gptr());
+    }
+
+    int numRead;
+    do
+    {
+#ifdef _WIN32
+      numRead = _read(m_fd, m_buffer.data(), (unsigned int) m_buffer.size());
+#else
+      numRead = (int) read(m_fd, m_buffer.data(), m_buffer.size());
+#endif
+    } while (numRead < 0 && errno == EINTR);
+
+    if (numRead <= 0)
+    {
+      return traits_type::eof();
+    }
+    setg(m_buffer.data(), m_buffer.data(), m_buffer.data() + numRead);
+    return traits_type::to_int_type(*gptr());
+  }
+
+private:
+  int               m_fd;
+  std::vector<char> m_buffer;
+};
+
 // ====================================================================================================================
 // Constructor / destructor / initialization / destroy
 // ====================================================================================================================
@@ -79,27 +137,44 @@ DecApp::DecApp()
  */
 uint32_t DecApp::decode()
 {
+  if (!m_bitstreamListFileName.empty())
+  {
+    return xDecodeBatch();
+  }
+
   int      poc;
   PicList *pcListPic = nullptr;
   
 #if GREEN_METADATA_SEI_ENABLED
-  FeatureCounterStruct featureCounter;
   FeatureCounterStruct featureCounterOld;
-  std::ifstream        bitstreamSize(m_bitstreamFileName.c_str(), std::ifstream::in | std::ifstream::binary);
-  std::streampos fsize = 0;
-  fsize = bitstreamSize.tellg();
-  bitstreamSize.seekg( 0, std::ios::end );
-  featureCounter.bytes = (int) bitstreamSize.tellg() - (int) fsize;
-  bitstreamSize.close();
 #endif
 
-  std::ifstream bitstreamFile(m_bitstreamFileName.c_str(), std::ifstream::in | std::ifstream::binary);
-  if (!bitstreamFile)
+  // "-" reads the bitstream from stdin; named pipes can be given as the file name since the input is never re-positioned
+  std::ifstream                         bitstreamFile;
+  std::unique_ptr<StreamingInputBuffer> stdinBuffer;
+  std::unique_ptr<std::istream>         stdinStream;
+  if (m_bitstreamFileName == "-")
   {
-    EXIT( "Failed to open bitstream file " << m_bitstreamFileName.c_str() << " for reading" ) ;
+#ifdef _WIN32
+    const int stdinFd = _fileno(stdin);
+    _setmode(stdinFd, _O_BINARY);
+#else
+    const int stdinFd = fileno(stdin);
+#endif
+    stdinBuffer = std::make_unique<StreamingInputBuffer>(stdinFd);
+    stdinStream = std::make_unique<std::istream>(stdinBuffer.get());
+  }
+  else
+  {
+    bitstreamFile.open(m_bitstreamFileName.c_str(), std::ifstream::in | std::ifstream::binary);
+    if (!bitstreamFile)
+    {
+      EXIT( "Failed to open bitstream file " << m_bitstreamFileName.c_str() << " for reading" ) ;
+    }
   }
 
-  InputByteStream bytestream(bitstreamFile);
+  InputByteStream   bytestream(stdinStream ? *stdinStream : bitstreamFile);
+  InputNALUnitQueue nalQueue(bytestream);
 
   if (!m_outputDecodedSEIMessagesFilename.empty() && m_outputDecodedSEIMessagesFilename!="-")
   {
@@ -189,20 +264,22 @@ uint32_t DecApp::decode()
   int lastNaluLayerId = -1;
   bool decodedSliceInAU = false;
 
-  while (!!bitstreamFile)
+  while (!nalQueue.empty())
   {
     InputNALUnit nalu;
     nalu.m_nalUnitType = NAL_UNIT_INVALID;
 
     // determine if next NAL unit will be the first one from a new picture
-    bool bNewPicture = m_cDecLib.isNewPicture(&bitstreamFile, &bytestream);
-    bool bNewAccessUnit = bNewPicture && decodedSliceInAU && m_cDecLib.isNewAccessUnit( bNewPicture, &bitstreamFile, &bytestream );
+    bool bNewPicture = m_cDecLib.isNewPicture(nalQueue);
+    bool bNewAccessUnit = bNewPicture && decodedSliceInAU && m_cDecLib.isNewAccessUnit( bNewPicture, nalQueue );
+    bool endOfStream = false;
     if(!bNewPicture)
     {
-      AnnexBStats stats = AnnexBStats();
-
       // find next NAL unit in stream
-      byteStreamNALUnit(bytestream, nalu.getBitstream().getFifo(), stats);
+      PerfTimer readTimer(m_cDecLib.getPerfCounters(), PerfStage::IO);
+      nalQueue.pop(nalu);
+      endOfStream = nalQueue.empty();
+      readTimer.stop();
       if (nalu.getBitstream().getFifo().empty())
       {
         /* this can happen if the following occur:
@@ -214,9 +291,6 @@ uint32_t DecApp::decode()
       }
       else
       {
-        // read NAL unit header
-        read(nalu);
-
         // flush output for first slice of an IDR picture
         if(m_cDecLib.getFirstSliceInPicture() &&
             (nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_IDR_W_RADL ||
@@ -355,11 +429,11 @@ uint32_t DecApp::decode()
       nalu.m_nuhLayerId = lastNaluLayerId;
     }
 
-    if (bNewPicture || !bitstreamFile || nalu.m_nalUnitType == NAL_UNIT_EOS)
+    if (bNewPicture || endOfStream || nalu.m_nalUnitType == NAL_UNIT_EOS)
     {
       if (!m_cDecLib.getFirstSliceInSequence(nalu.m_nuhLayerId) && !bPicSkipped)
       {
-        if (!loopFiltered[nalu.m_nuhLayerId] || bitstreamFile)
+        if (!loopFiltered[nalu.m_nuhLayerId] || !endOfStream)
         {
           m_cDecLib.executeLoopFilters();
           m_cDecLib.finishPicture(poc, pcListPic, INFO, m_newCLVS[nalu.m_nuhLayerId]);
@@ -778,12 +852,12 @@ uint32_t DecApp::decode()
       isEosPresentInLastPu = isEosPresentInPu;
       isEosPresentInPu = false;
     }
-    if (bNewPicture || !bitstreamFile || nalu.m_nalUnitType == NAL_UNIT_EOS)
+    if (bNewPicture || endOfStream || nalu.m_nalUnitType == NAL_UNIT_EOS)
     {
       m_cDecLib.checkAPSInPictureUnit();
       m_cDecLib.resetPictureUnitNals();
     }
-    if (bNewAccessUnit || !bitstreamFile)
+    if (bNewAccessUnit || endOfStream)
     {
       m_cDecLib.CheckNoOutputPriorPicFlagsInAccessUnit();
       m_cDecLib.resetAccessUnitNoOutputPriorPicFlags();
@@ -854,6 +928,8 @@ uint32_t DecApp::decode()
   // get the number of checksum errors
   uint32_t nRet = m_cDecLib.getNumberOfChecksumErrorsDetected();
 
+  msg( INFO, "\n Peak picture buffer memory: %.2f MiB\n", m_cDecLib.getPeakPicBufferSize() / ( 1024.0 * 1024.0 ) );
+
   // delete buffers
   m_cDecLib.deletePicBuffer();
   // destroy internal classes
@@ -868,6 +944,150 @@ uint32_t DecApp::decode()
   return nRet;
 }
 
+/**
+ - read the BitstreamList: one bitstream per line, optionally followed by a reconstruction file name
+ - decode the bitstreams on a pool of worker threads, each with its own DecApp instance
+ - print one summary line per bitstream
+ - returns the number of mismatching pictures plus the number of bitstreams that failed to decode
+ */
+uint32_t DecApp::xDecodeBatch()
+{
+  struct BatchStream
+  {
+    std::string bitstreamFileName;
+    std::string reconFileName;
+    uint32_t    numPictures     = 0;
+    uint32_t    numHashChecked  = 0;
+    uint32_t    numMismatches   = 0;
+    double      decodeTime      = 0.0;
+    std::string error;
+  };
+
+  std::ifstream listFile(m_bitstreamListFileName);
+  if (!listFile)
+  {
+    EXIT("Failed to open bitstream list " << m_bitstreamListFileName << " for reading");
+  }
+
+  std::vector<BatchStream> streams;
+  std::string              line;
+  while (std::getline(listFile, line))
+  {
+    std::istringstream tokens(line);
+    BatchStream        stream;
+    if (!(tokens >> stream.bitstreamFileName) || stream.bitstreamFileName[0] == '#')
+    {
+      continue;
+    }
+    tokens >> stream.reconFileName;
+    CHECK(stream.bitstreamFileName == "-", "Bitstreams of a BitstreamList cannot be read from stdin");
+    streams.push_back(stream);
+  }
+  CHECK(streams.empty(), "No bitstream found in " << m_bitstreamListFileName);
+
+  int numThreads = m_batchThreads > 0 ? m_batchThreads : (int) std::thread::hardware_concurrency();
+  numThreads     = Clip3(1, (int) streams.size(), numThreads);
+
+  // the per-picture output of concurrent decoders would interleave, only errors are printed while decoding
+  const MsgLevel verbosity = g_verbosity;
+  g_verbosity              = std::min(verbosity, ERROR);
+
+  // keep the tables alive across the workers instead of rebuilding them for every bitstream
+  initROM();
+
+  std::atomic<size_t> nextStream(0);
+  auto                decodeStreams = [&]()
+  {
+    for (size_t idx = nextStream++; idx < streams.size(); idx = nextStream++)
+    {
+      BatchStream &stream = streams[idx];
+
+      std::unique_ptr<DecApp> app = std::make_unique<DecApp>();
+      static_cast<DecAppCfg &>(*app) = *this;
+
+      app->m_batchStream       = true;
+      app->m_bitstreamFileName = stream.bitstreamFileName;
+      app->m_reconFileName     = stream.reconFileName;
+      app->m_bitstreamListFileName.clear();
+      app->m_perfStatsFileName.clear();
+      app->m_oplFilename.clear();
+      app->m_outputDecodedSEIMessagesFilename.clear();
+      app->m_colourRemapSEIFileName.clear();
+      app->m_SEICTIFileName.clear();
+      app->m_SEIFGSFileName.clear();
+      app->m_annotatedRegionsSEIFileName.clear();
+#if JVET_S0257_DUMP_360SEI_MESSAGE
+      app->m_outputDecoded360SEIMessagesFilename.clear();
+#endif
+#if JVET_Z0120_SII_SEI_PROCESSING
+      app->m_shutterIntervalPostFileName.clear();
+#endif
+#if GREEN_METADATA_SEI_ENABLED
+      app->m_GMFA = false;
+#endif
+
+      const auto startTime = std::chrono::steady_clock::now();
+      try
+      {
+        stream.numMismatches = app->decode();
+      }
+      catch (Exception &e)
+      {
+        stream.error = e.what();
+        stream.error.erase(0, stream.error.find_first_not_of(" \n"));
+        stream.error.erase(stream.error.find_last_not_of(" \n") + 1);
+      }
+      catch (const std::bad_alloc &e)
+      {
+        stream.error = std::string("Memory allocation failed: ") + e.what();
+      }
+      stream.decodeTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+      stream.numPictures    = app->m_cDecLib.getNumberOfPicturesDecoded();
+      stream.numHashChecked = app->m_cDecLib.getNumberOfPicturesHashChecked();
+      stream.numMismatches  = std::max(stream.numMismatches, app->m_cDecLib.getNumberOfChecksumErrorsDetected());
+    }
+  };
+
+  const auto startTime = std::chrono::steady_clock::now();
+
+  std::vector<std::thread> workers;
+  for (int i = 1; i < numThreads; i++)
+  {
+    workers.emplace_back(decodeStreams);
+  }
+  decodeStreams();
+  for (auto &worker: workers)
+  {
+    worker.join();
+  }
+
+  const double totalTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+  destroyROM();
+  g_verbosity = verbosity;
+
+  uint32_t numErrors = 0;
+  msg(INFO, "\n Decoded %d bitstreams on %d threads in %.3f sec.\n\n", (int) streams.size(), numThreads, totalTime);
+  msg(INFO, "   Idx  Pictures  Hashed  Mismatch     Time      FPS  Result    Bitstream\n");
+  for (size_t idx = 0; idx < streams.size(); idx++)
+  {
+    const BatchStream &stream = streams[idx];
+    const char *result = !stream.error.empty() ? "ERROR" : stream.numMismatches > 0 ? "MISMATCH" : "OK";
+    msg(INFO, "  %4d  %8u  %6u  %8u  %7.3f  %7.2f  %-8s  %s\n", (int) idx, stream.numPictures, stream.numHashChecked,
+        stream.numMismatches, stream.decodeTime, stream.decodeTime > 0 ? stream.numPictures / stream.decodeTime : 0.0,
+        result, stream.bitstreamFileName.c_str());
+    if (!stream.error.empty())
+    {
+      msg(ERROR, "        %s\n", stream.error.c_str());
+      numErrors++;
+    }
+    numErrors += stream.numMismatches;
+  }
+
+  return numErrors;
+}
+
 
 
 void DecApp::writeLineToOutputLog(Picture * pcPic)
@@ -913,6 +1133,12 @@ void DecApp::xCreateDecLib()
   );
   m_cDecLib.setDecodedPictureHashSEIEnabled(m_decodedPictureHashSEIEnabled);
 
+  if (!m_perfStatsFileName.empty())
+  {
+    PerfCounters::Format perfStatsFormat = PerfCounters::Format::CSV;
+    PerfCounters::parseFormat(m_perfStatsFormat, perfStatsFormat);
+    m_cDecLib.getPerfCounters()->open(m_perfStatsFileName, perfStatsFormat);
+  }
 
   if (!m_outputDecodedSEIMessagesFilename.empty())
   {
@@ -970,6 +1196,7 @@ void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
   {
     return;
   }
+  PerfTimer ioTimer(m_cDecLib.getPerfCounters(), PerfStage::IO);
 
   PicList::iterator iterPic   = pcListPic->begin();
   int numPicsNotYetDisplayed = 0;
@@ -1224,6 +1451,7 @@ void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
  */
 void DecApp::xFlushOutput( PicList* pcListPic, const int layerId )
 {
+  PerfTimer ioTimer(m_cDecLib.getPerfCounters(), PerfStage::IO);
   if(!pcListPic || pcListPic->empty())
   {
     return;
@@ -1291,10 +1519,8 @@ void DecApp::xFlushOutput( PicList* pcListPic, const int layerId )
         pcPicTop->neededForOutput = false;
         pcPicBottom->neededForOutput = false;
 
-        pcPicTop->destroy();
-        delete pcPicTop;
-        pcPicBottom->destroy();
-        delete pcPicBottom;
+        m_cDecLib.recyclePicture(pcPicTop);
+        m_cDecLib.recyclePicture(pcPicBottom);
         iterPic--;
         *iterPic = nullptr;
         iterPic++;
@@ -1302,8 +1528,7 @@ void DecApp::xFlushOutput( PicList* pcListPic, const int layerId )
       }
       else
       {
-        pcPicTop->destroy();
-        delete pcPicTop;
+        m_cDecLib.recyclePicture(pcPicTop);
         iterPic--;
         *iterPic = nullptr;
         iterPic++;
@@ -1435,8 +1660,7 @@ void DecApp::xFlushOutput( PicList* pcListPic, const int layerId )
       if(pcPic != nullptr)
 #endif
       {
-        pcPic->destroy();
-        delete pcPic;
+        m_cDecLib.recyclePicture(pcPic);
         pcPic    = nullptr;
         *iterPic = nullptr;
       }
@@ -109,6 +109,7 @@ public:
 #endif
 
 private:
+  uint32_t xDecodeBatch   (); ///< decode the bitstreams of the BitstreamList concurrently
   void  xCreateDecLib     (); ///< create internal classes
   void  xDestroyDecLib    (); ///< destroy internal classes
   void  xWriteOutput      ( PicList* pcListPic , uint32_t tId); ///< write YUV to file
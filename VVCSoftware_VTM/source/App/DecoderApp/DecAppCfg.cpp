@@ -43,6 +43,7 @@
 #include "Utilities/VideoIOYuv.h"
 #include "CommonLib/ChromaFormat.h"
 #include "CommonLib/dtrace_next.h"
+#include "CommonLib/PerfCounters.h"
 
 namespace po = ProgramOptionsLite;
 
@@ -75,9 +76,13 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
   // clang-format off
   opts.addOptions()
   ("help",                      do_help,                               false,      "this help text")
-  ("BitstreamFile,b",           m_bitstreamFileName,                   std::string(""), "bitstream input file name")
+  ("BitstreamFile,b",           m_bitstreamFileName,                   std::string(""), "bitstream input file name (\"-\": read from stdin)")
   ("ReconFile,o",               m_reconFileName,                       std::string(""), "reconstructed YUV output file name\n")
+  ("PerfStatsFile",             m_perfStatsFileName,                   std::string(""), "per-picture timing statistics output file name (empty: disabled)\n")
+  ("PerfStatsFormat",           m_perfStatsFormat,                     std::string("csv"), "format of the per-picture statistics file: csv or json (one object per line)\n")
   ("OplFile,-opl",              m_oplFilename,                         std::string(""), "opl-file name without extension for conformance testing\n")
+  ("BitstreamList",             m_bitstreamListFileName,               std::string(""), "batch mode: file listing bitstreams to decode concurrently, one per line, optionally followed by a reconstruction file name. Other per-stream output files are disabled\n")
+  ("BatchThreads",              m_batchThreads,                        0,          "number of bitstreams of the BitstreamList decoded concurrently (0: number of hardware threads)\n")
 
 #if ENABLE_SIMD_OPT
   ("SIMD",                      ignore,                                std::string(""), "SIMD extension to use (SCALAR, SSE41, SSE42, AVX, AVX2, AVX512), default: the highest supported extension\n")
@@ -162,7 +167,17 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
   }
 
 #if ENABLE_TRACING
-  g_trace_ctx = tracing_init( sTracingFile, sTracingRule );
+  if (!m_bitstreamListFileName.empty() && (!sTracingFile.empty() || !sTracingRule.empty()))
+  {
+    msg( ERROR, "Tracing is not supported when decoding a BitstreamList\n");
+    return false;
+  }
+  // the context is process-wide, a decoder running in the same process as other coders traces into the first one
+  if (g_trace_ctx == nullptr)
+  {
+    g_trace_ctx    = tracing_init( sTracingFile, sTracingRule );
+    m_ownsTraceCtx = true;
+  }
   if( bTracingChannelsList && g_trace_ctx )
   {
     std::string sChannelsList;
@@ -185,11 +200,28 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
     return false;
   }
 
-  if (m_bitstreamFileName.empty())
+  if (m_bitstreamFileName.empty() && m_bitstreamListFileName.empty())
   {
     msg( ERROR, "No input file specified, aborting\n");
     return false;
   }
+  if (!m_bitstreamFileName.empty() && !m_bitstreamListFileName.empty())
+  {
+    msg( ERROR, "BitstreamFile and BitstreamList cannot be used together\n");
+    return false;
+  }
+  if (m_batchThreads < 0)
+  {
+    msg( ERROR, "BatchThreads must not be negative\n");
+    return false;
+  }
+
+  PerfCounters::Format perfStatsFormat;
+  if (!PerfCounters::parseFormat(m_perfStatsFormat, perfStatsFormat))
+  {
+    msg( ERROR, "Bad performance statistics format string, must be csv or json\n");
+    return false;
+  }
 
   if ( !cfg_TargetDecLayerIdSetFile.empty() )
   {
@@ -257,7 +289,15 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
 DecAppCfg::DecAppCfg()
   : m_bitstreamFileName()
   , m_reconFileName()
+  , m_perfStatsFileName()
+  , m_perfStatsFormat()
   , m_oplFilename()
+  , m_bitstreamListFileName()
+  , m_batchThreads(0)
+  , m_batchStream(false)
+#if ENABLE_TRACING
+  , m_ownsTraceCtx(false)
+#endif
 
   , m_iSkipFrame(0)
   // m_outputBitDepth array initialised below
@@ -286,7 +326,11 @@ DecAppCfg::DecAppCfg()
 DecAppCfg::~DecAppCfg()
 {
 #if ENABLE_TRACING
-  tracing_uninit( g_trace_ctx );
+  if (m_ownsTraceCtx && !m_batchStream)
+  {
+    tracing_uninit( g_trace_ctx );
+    g_trace_ctx = nullptr;
+  }
 #endif
 }
 
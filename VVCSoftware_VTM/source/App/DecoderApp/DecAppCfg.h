@@ -59,9 +59,18 @@ protected:
 
   std::string   m_bitstreamFileName;                    ///< input bitstream file name
   std::string   m_reconFileName;                        ///< output reconstruction file name
+  std::string   m_perfStatsFileName;                    ///< output file of the per-picture timing statistics
+  std::string   m_perfStatsFormat;                      ///< format of the timing statistics (csv or json)
 
   std::string   m_oplFilename;                        ///< filename to output conformance log.
 
+  std::string   m_bitstreamListFileName;              ///< list of bitstreams decoded concurrently in batch mode
+  int           m_batchThreads;                       ///< number of bitstreams decoded concurrently (0: hardware threads)
+  bool          m_batchStream;                        ///< one bitstream of a BitstreamList, process-wide state is owned by the batch driver
+#if ENABLE_TRACING
+  bool          m_ownsTraceCtx;                       ///< the trace context was created by this configuration, not taken over from the process
+#endif
+
   int           m_iSkipFrame;                           ///< counter for frames prior to the random access point to skip
   BitDepths     m_outputBitDepth;                       // bit depth used for writing output
 
@@ -49,6 +49,22 @@
 //! \ingroup EncoderApp
 //! \{
 
+/// inserts a suffix in front of the extension of an output file name, e.g. for the files of each layer
+static std::string insertFileNameSuffix(const std::string &fileName, const std::string &suffix)
+{
+  std::string  name = fileName;
+  const size_t pos  = name.find_last_of('.');
+  if (pos != std::string::npos)
+  {
+    name.insert(pos, suffix);
+  }
+  else
+  {
+    name.append(suffix);
+  }
+  return name;
+}
+
 // ====================================================================================================================
 // Constructor / destructor / initialization / destroy
 // ====================================================================================================================
@@ -62,6 +78,8 @@ EncApp::EncApp(std::fstream &bitStream, EncLibCommon *encLibCommon) : m_cEncLib(
   m_metricTime = std::chrono::milliseconds(0);
 #endif
   m_numEncoded = 0;
+  m_inputSource = nullptr;
+  m_ownTemporalFilter = false;
   m_flush = false;
 }
 
@@ -254,6 +272,7 @@ void EncApp::xInitLibCfg( int layerIdx )
   m_cEncLib.setPrintSequenceMSE                                  ( m_printSequenceMSE);
   m_cEncLib.setPrintMSSSIM                                       ( m_printMSSSIM );
   m_cEncLib.setPrintWPSNR                                        ( m_printWPSNR );
+  m_cEncLib.setMetricThreads                                     ( m_metricThreads );
   m_cEncLib.setPrintHightPrecEncTime(m_printHighPrecEncTime);
   m_cEncLib.setCabacZeroWordPaddingEnabled                       ( m_cabacZeroWordPaddingEnabled );
 
@@ -830,6 +849,7 @@ void EncApp::xInitLibCfg( int layerIdx )
   m_cEncLib.setUseEarlySkipDetection                             ( m_useEarlySkipDetection );
   m_cEncLib.setUseFastMerge                                      ( m_useFastMrg );
   m_cEncLib.setMaxMergeRdCandNumTotal                            ( m_maxMergeRdCandNumTotal );
+  m_cEncLib.setSubPelMECacheSize                                 ( m_subPelMECacheSize );
   m_cEncLib.setMergeRdCandQuotaRegular                           ( m_mergeRdCandQuotaRegular );
   m_cEncLib.setMergeRdCandQuotaRegularSmallBlk                   ( m_mergeRdCandQuotaRegularSmallBlk );
   m_cEncLib.setMergeRdCandQuotaSubBlk                            ( m_mergeRdCandQuotaSubBlk);
@@ -845,6 +865,8 @@ void EncApp::xInitLibCfg( int layerIdx )
   m_cEncLib.setUseMRL                                            ( m_MRL );
   m_cEncLib.setUseMIP                                            ( m_MIP );
   m_cEncLib.setUseFastMIP                                        ( m_useFastMIP );
+  m_cEncLib.setIntraSearchThreads                                ( m_intraSearchThreads );
+  m_cEncLib.setNumSplitThreads                                   ( m_numSplitThreads );
   m_cEncLib.setFastLocalDualTreeMode                             ( m_fastLocalDualTreeMode );
   m_cEncLib.setUseReconBasedCrossCPredictionEstimate             ( m_reconBasedCrossCPredictionEstimate );
   m_cEncLib.setUseTransformSkip                                  ( m_useTransformSkip      );
@@ -1493,6 +1515,12 @@ void EncApp::xInitLibCfg( int layerIdx )
 
   m_cEncLib.setGopBasedTemporalFilterEnabled(m_gopBasedTemporalFilterEnabled);
   m_cEncLib.setBIM                                               ( m_bimEnabled );
+  m_cEncLib.setLookaheadFrames                                    ( m_lookaheadFrames );
+  m_cEncLib.setLookaheadQpStrength                                ( m_lookaheadQpStrength );
+  m_cEncLib.setLookahead                                          ( m_lookaheadFrames > 0 ? &m_lookahead : nullptr );
+  m_cEncLib.setAnalysisSaveFile                                   ( m_analysisSaveFile );
+  m_cEncLib.setAnalysisLoadFile                                   ( m_analysisLoadFile );
+  m_cEncLib.setAnalysisReuseLevel                                 ( m_analysisReuseLevel );
   m_cEncLib.setNumRefLayers                                       ( m_numRefLayers );
 
   m_cEncLib.setVPSParameters(m_cfgVPSParameters);
@@ -1501,23 +1529,26 @@ void EncApp::xInitLibCfg( int layerIdx )
 void EncApp::xCreateLib( std::list<PelUnitBuf*>& recBufList, const int layerId )
 {
   // Video I/O
-  m_cVideoIOYuvInputFile.open(m_inputFileName, false, m_inputBitDepth, m_msbExtendedBitDepth,
-                              m_internalBitDepth);   // read  mode
+  if (m_inputSource == nullptr)
+  {
+    m_cVideoIOYuvInputFile.open(m_inputFileName, false, m_inputBitDepth, m_msbExtendedBitDepth,
+                                m_internalBitDepth);   // read  mode
 #if EXTENSION_360_VIDEO
-  m_cVideoIOYuvInputFile.skipFrames(m_frameSkip, m_inputFileWidth, m_inputFileHeight, m_inputChromaFormatIDC);
+    m_cVideoIOYuvInputFile.skipFrames(m_frameSkip, m_inputFileWidth, m_inputFileHeight, m_inputChromaFormatIDC);
 #else
-  const int sourceHeight = m_isField ? m_iSourceHeightOrg : m_sourceHeight;
-  if (m_sourceScalingRatioHor != 1.0 || m_sourceScalingRatioVer != 1.0)
-  {
-    m_cVideoIOYuvInputFile.skipFrames(m_frameSkip, m_sourceWidthBeforeScale, m_sourceHeightBeforeScale,
-                                      m_inputChromaFormatIDC);
-  }
-  else
-  {
-    m_cVideoIOYuvInputFile.skipFrames(m_frameSkip, m_sourceWidth - m_sourcePadding[0],
-                                      sourceHeight - m_sourcePadding[1], m_inputChromaFormatIDC);
-  }
+    const int sourceHeight = m_isField ? m_iSourceHeightOrg : m_sourceHeight;
+    if (m_sourceScalingRatioHor != 1.0 || m_sourceScalingRatioVer != 1.0)
+    {
+      m_cVideoIOYuvInputFile.skipFrames(m_frameSkip, m_sourceWidthBeforeScale, m_sourceHeightBeforeScale,
+                                        m_inputChromaFormatIDC);
+    }
+    else
+    {
+      m_cVideoIOYuvInputFile.skipFrames(m_frameSkip, m_sourceWidth - m_sourcePadding[0],
+                                        sourceHeight - m_sourcePadding[1], m_inputChromaFormatIDC);
+    }
 #endif
+  }
   if (!m_reconFileName.empty())
   {
     if (m_packedYUVMode
@@ -1538,15 +1569,7 @@ void EncApp::xCreateLib( std::list<PelUnitBuf*>& recBufList, const int layerId )
     std::string reconFileName = m_reconFileName;
     if( m_reconFileName.compare( "/dev/null" ) &&  (m_maxLayers > 1) )
     {
-      size_t pos = reconFileName.find_last_of('.');
-      if (pos != std::string::npos)
-      {
-        reconFileName.insert( pos, std::to_string( layerId ) );
-      }
-      else
-      {
-        reconFileName.append( std::to_string( layerId ) );
-      }
+      reconFileName = insertFileNameSuffix( reconFileName, std::to_string( layerId ) );
     }
     if (isY4mFileExt(reconFileName))
     {
@@ -1605,6 +1628,11 @@ void EncApp::createLib( const int layerIdx )
   const int sourceHeight = m_isField ? m_iSourceHeightOrg : m_sourceHeight;
   UnitArea  unitArea(m_chromaFormatIdc, Area(0, 0, m_sourceWidth, sourceHeight));
 
+  if (m_inputSource != nullptr)
+  {
+    xCheckInputSource();
+  }
+
   m_orgPic = new PelStorage;
   m_trueOrgPic = new PelStorage;
   m_orgPic->create( unitArea );
@@ -1636,7 +1664,7 @@ void EncApp::createLib( const int layerIdx )
     m_filteredOrgPicForFG = new PelStorage;
     m_filteredOrgPicForFG->create( unitArea );
   }
-  if ( m_bimEnabled )
+  if ( m_bimEnabled || m_lookaheadFrames > 0 )
   {
     std::map<int, int*> adaptQPmap;
     m_cEncLib.setAdaptQPmap(adaptQPmap);
@@ -1663,13 +1691,23 @@ void EncApp::createLib( const int layerIdx )
   xCreateLib( m_recBufList, layerId );
   xInitLib();
 
+  if (!m_perfStatsFileName.empty())
+  {
+    PerfCounters::Format perfStatsFormat = PerfCounters::Format::CSV;
+    PerfCounters::parseFormat(m_perfStatsFormat, perfStatsFormat);
+    // each layer has its own counters, so each writes its own file
+    const std::string perfStatsFileName =
+      m_maxLayers > 1 ? insertFileNameSuffix(m_perfStatsFileName, std::to_string(layerId)) : m_perfStatsFileName;
+    m_cEncLib.getPerfCounters()->open(perfStatsFileName, perfStatsFormat);
+  }
+
   printChromaFormat();
 
 #if EXTENSION_360_VIDEO
   m_ext360 = new TExt360AppEncTop( *this, m_cEncLib.getGOPEncoder()->getExt360Data(), *( m_cEncLib.getGOPEncoder() ), *m_orgPic );
 #endif
 
-  if( m_gopBasedTemporalFilterEnabled || m_bimEnabled )
+  if( ( m_inputSource == nullptr || m_ownTemporalFilter ) && ( m_gopBasedTemporalFilterEnabled || m_bimEnabled ) )
   {
     m_temporalFilter.init(m_frameSkip, m_inputBitDepth, m_msbExtendedBitDepth, m_internalBitDepth, m_sourceWidth,
                           sourceHeight, m_sourcePadding, m_clipInputVideoToRec709Range, m_inputFileName,
@@ -1678,7 +1716,7 @@ void EncApp::createLib( const int layerIdx )
                           m_lastValidFrame, m_gopBasedTemporalFilterEnabled, m_cEncLib.getAdaptQPmap(),
                           m_cEncLib.getBIM(), m_ctuSize);
   }
-  if ( m_fgcSEIAnalysisEnabled && m_fgcSEIExternalDenoised.empty() )
+  if ( ( m_inputSource == nullptr || m_ownTemporalFilter ) && m_fgcSEIAnalysisEnabled && m_fgcSEIExternalDenoised.empty() )
   {
     m_temporalFilterForFG.init(m_frameSkip, m_inputBitDepth, m_msbExtendedBitDepth, m_internalBitDepth, m_sourceWidth,
                                sourceHeight, m_sourcePadding, m_clipInputVideoToRec709Range, m_inputFileName,
@@ -1686,14 +1724,27 @@ void EncApp::createLib( const int layerIdx )
                                m_fgcSEITemporalFilterPastRefs, m_fgcSEITemporalFilterFutureRefs, m_firstValidFrame,
                                m_lastValidFrame, true, m_cEncLib.getAdaptQPmap(), m_cEncLib.getBIM(), m_ctuSize);
   }
+  if ( m_lookaheadFrames > 0 )
+  {
+    m_lookahead.init(m_frameSkip, m_inputBitDepth, m_msbExtendedBitDepth, m_internalBitDepth, m_sourceWidth, sourceHeight,
+                     m_sourcePadding, m_clipInputVideoToRec709Range, m_inputFileName, m_chromaFormatIdc,
+                     m_inputColourSpaceConvert, m_iQP, m_framesToBeEncoded, m_lookaheadFrames, m_gopSize, m_ctuSize,
+                     m_lookaheadQpStrength);
+  }
 }
 
 void EncApp::destroyLib()
 {
+  if (m_numSharedInputEncodes > 1)
+  {
+    printf( "\nBitstream %s", m_bitstreamFileName.c_str() );
+  }
   printf( "\nLayerId %2d", m_cEncLib.getLayerId() );
 
   m_cEncLib.printSummary( m_isField );
 
+  m_lookahead.destroy();
+
   // delete used buffers in encoder class
   m_cEncLib.deletePicBuffer();
 
@@ -1736,13 +1787,13 @@ void EncApp::destroyLib()
     m_filteredOrgPic->destroy();
     delete m_filteredOrgPic;
   }
-  if ( m_bimEnabled )
+  if ( m_bimEnabled || m_lookaheadFrames > 0 )
   {
     auto map = m_cEncLib.getAdaptQPmap();
     for (auto it = map->begin(); it != map->end(); ++it)
     {
       int *p = it->second;
-      delete p;
+      delete[] p;
     }
   }
   if (m_fgcSEIAnalysisEnabled && m_fgcSEIExternalDenoised.empty())
@@ -1760,11 +1811,17 @@ void EncApp::destroyLib()
 
 bool EncApp::encodePrep( bool& eos )
 {
+  if (m_inputSource != nullptr)
+  {
+    return xEncodePrepFromSource(eos);
+  }
+
   // main encoder loop
   const InputColourSpaceConversion ipCSC = m_inputColourSpaceConvert;
   const InputColourSpaceConversion snrCSC = ( !m_snrInternalColourSpace ) ? m_inputColourSpaceConvert : IPCOLOURSPACE_UNCHANGED;
 
   // read input YUV file
+  PerfTimer readTimer(m_cEncLib.getPerfCounters(), PerfStage::IO);
 #if EXTENSION_360_VIDEO
   if( m_ext360->isEnabled() )
   {
@@ -1804,7 +1861,12 @@ bool EncApp::encodePrep( bool& eos )
                                 m_clipInputVideoToRec709Range);
   }
 #endif
+  readTimer.stop();
+
+  // encodes with their own temporal filter receive the picture before it is filtered in place
+  xPassInputToSharedEncodes();
 
+  PerfTimer mctfTimer(m_cEncLib.getPerfCounters(), PerfStage::MCTF);
   if (m_fgcSEIAnalysisEnabled && m_fgcSEIExternalDenoised.empty())
   {
     m_filteredOrgPicForFG->copyFrom(*m_orgPic);
@@ -1815,6 +1877,7 @@ bool EncApp::encodePrep( bool& eos )
     m_temporalFilter.filter(m_orgPic, m_frameRcvd);
     m_filteredOrgPic->copyFrom(*m_orgPic);
   }
+  mctfTimer.stop();
 
   // increase number of received frames
   m_frameRcvd++;
@@ -1831,6 +1894,11 @@ bool EncApp::encodePrep( bool& eos )
     m_cEncLib.setFramesToBeEncoded(m_frameRcvd);
   }
 
+  if( !m_flush )
+  {
+    xPassFilteredInputToSharedEncodes();
+  }
+
   bool keepDoing = false;
 
   // call encoding function for one frame
@@ -1886,7 +1954,7 @@ bool EncApp::encode()
       xWriteOutput( m_numEncoded, m_recBufList );
     }
     // temporally skip frames
-    if( m_temporalSubsampleRatio > 1 )
+    if( m_temporalSubsampleRatio > 1 && m_inputSource == nullptr )
     {
 #if EXTENSION_360_VIDEO
       m_cVideoIOYuvInputFile.skipFrames(m_temporalSubsampleRatio - 1, m_inputFileWidth, m_inputFileHeight,
@@ -1902,6 +1970,157 @@ bool EncApp::encode()
   return keepDoing;
 }
 
+void EncApp::xCheckInputSource()
+{
+  const EncApp &src = *m_inputSource;
+
+  if (m_inputFileName != src.m_inputFileName || m_frameSkip != src.m_frameSkip
+      || m_framesToBeEncoded != src.m_framesToBeEncoded || m_temporalSubsampleRatio != src.m_temporalSubsampleRatio
+      || m_sourceWidth != src.m_sourceWidth || m_sourceHeight != src.m_sourceHeight || m_isField != src.m_isField
+      || m_sourcePadding[0] != src.m_sourcePadding[0] || m_sourcePadding[1] != src.m_sourcePadding[1]
+      || m_inputChromaFormatIDC != src.m_inputChromaFormatIDC || m_chromaFormatIdc != src.m_chromaFormatIdc
+      || m_inputBitDepth != src.m_inputBitDepth || m_msbExtendedBitDepth != src.m_msbExtendedBitDepth
+      || m_internalBitDepth != src.m_internalBitDepth
+      || m_clipInputVideoToRec709Range != src.m_clipInputVideoToRec709Range
+      || m_inputColourSpaceConvert != src.m_inputColourSpaceConvert
+      || m_sourceScalingRatioHor != src.m_sourceScalingRatioHor || m_sourceScalingRatioVer != src.m_sourceScalingRatioVer)
+  {
+    EXIT("Encodes sharing the input must use the input and source format of the first encode");
+  }
+  // the temporal filters depend on the QP, an encode with other filter settings filters the shared input itself
+  const bool fgFilter    = m_fgcSEIAnalysisEnabled && m_fgcSEIExternalDenoised.empty();
+  const bool srcFgFilter = src.m_fgcSEIAnalysisEnabled && src.m_fgcSEIExternalDenoised.empty();
+  m_ownTemporalFilter =
+    ((m_gopBasedTemporalFilterEnabled || m_bimEnabled || fgFilter) && m_iQP != src.m_iQP)
+    || m_gopBasedTemporalFilterEnabled != src.m_gopBasedTemporalFilterEnabled || m_bimEnabled != src.m_bimEnabled
+    || (m_bimEnabled && m_ctuSize != src.m_ctuSize)
+    || m_gopBasedTemporalFilterStrengths != src.m_gopBasedTemporalFilterStrengths
+    || m_gopBasedTemporalFilterPastRefs != src.m_gopBasedTemporalFilterPastRefs
+    || m_gopBasedTemporalFilterFutureRefs != src.m_gopBasedTemporalFilterFutureRefs || fgFilter != srcFgFilter
+    || (fgFilter
+        && (m_fgcSEITemporalFilterStrengths != src.m_fgcSEITemporalFilterStrengths
+            || m_fgcSEITemporalFilterPastRefs != src.m_fgcSEITemporalFilterPastRefs
+            || m_fgcSEITemporalFilterFutureRefs != src.m_fgcSEITemporalFilterFutureRefs));
+
+  // all encodes are encoded in lockstep, picture by picture, which requires the same coding order
+  if (m_gopSize != src.m_gopSize || m_intraPeriod != src.m_intraPeriod)
+  {
+    EXIT("Encodes sharing the input must use the GOPSize and IntraPeriod of the first encode");
+  }
+  if (m_bitstreamFileName == src.m_bitstreamFileName)
+  {
+    EXIT("Each encode sharing the input requires its own bitstream file, set by -r<n> -b <file>");
+  }
+
+  // further output files shared with the first encode get the index of the encode appended to their name
+  const std::string encodeSuffix = std::to_string(src.m_sharedInputEncodes.size());
+  auto              makeUnique   = [&encodeSuffix](std::string &fileName, const std::string &srcFileName)
+  {
+    if (!fileName.empty() && fileName == srcFileName && fileName != "/dev/null")
+    {
+      fileName = insertFileNameSuffix(fileName, encodeSuffix);
+    }
+  };
+  makeUnique(m_reconFileName, src.m_reconFileName);
+  makeUnique(m_perfStatsFileName, src.m_perfStatsFileName);
+  makeUnique(m_analysisSaveFile, src.m_analysisSaveFile);
+  makeUnique(m_summaryOutFilename, src.m_summaryOutFilename);
+  makeUnique(m_summaryPicFilenameBase, src.m_summaryPicFilenameBase);
+#if JVET_Z0120_SII_SEI_PROCESSING
+  makeUnique(m_shutterIntervalPreFileName, src.m_shutterIntervalPreFileName);
+#endif
+}
+
+void EncApp::xPassInputToSharedEncodes()
+{
+  // the encoder library takes over the input buffers by swapping, so each encode receives its own copy
+  for( EncApp *encode : m_sharedInputEncodes )
+  {
+    encode->m_orgPic->copyFrom(*m_orgPic);
+    encode->m_trueOrgPic->copyFrom(*m_trueOrgPic);
+  }
+}
+
+void EncApp::xPassFilteredInputToSharedEncodes()
+{
+  for( EncApp *encode : m_sharedInputEncodes )
+  {
+    if( encode->m_ownTemporalFilter )
+    {
+      continue;
+    }
+    if( m_gopBasedTemporalFilterEnabled || m_bimEnabled )
+    {
+      encode->m_orgPic->copyFrom(*m_orgPic);
+      encode->m_filteredOrgPic->copyFrom(*m_filteredOrgPic);
+    }
+    if( m_fgcSEIAnalysisEnabled && m_fgcSEIExternalDenoised.empty() )
+    {
+      encode->m_filteredOrgPicForFG->copyFrom(*m_filteredOrgPicForFG);
+    }
+  }
+
+  if( m_bimEnabled )
+  {
+    // copy the block importance map the temporal filter derived for this picture
+    auto it = m_cEncLib.getAdaptQPmap()->find(m_frameRcvd - 1);
+    if( it != m_cEncLib.getAdaptQPmap()->end() )
+    {
+      const int sourceHeight = m_isField ? m_iSourceHeightOrg : m_sourceHeight;
+      const int numCtus = ((m_sourceWidth + m_ctuSize - 1) / m_ctuSize) * ((sourceHeight + m_ctuSize - 1) / m_ctuSize);
+      for( EncApp *encode : m_sharedInputEncodes )
+      {
+        if( encode->m_ownTemporalFilter )
+        {
+          continue;
+        }
+        int *qpMap = new int[numCtus];
+        std::copy(it->second, it->second + numCtus, qpMap);
+        encode->m_cEncLib.getAdaptQPmap()->insert({ it->first, qpMap });
+      }
+    }
+  }
+}
+
+bool EncApp::xEncodePrepFromSource( bool& eos )
+{
+  const InputColourSpaceConversion snrCSC = ( !m_snrInternalColourSpace ) ? m_inputColourSpaceConvert : IPCOLOURSPACE_UNCHANGED;
+
+  // the input source has already read the picture of this call and copied it to the input buffers, filtered unless
+  // this encode has its own temporal filter
+  m_frameRcvd = m_inputSource->m_frameRcvd;
+  m_flush     = m_inputSource->m_flush;
+  eos =
+    (m_isField && (m_frameRcvd == (m_framesToBeEncoded >> 1))) || (!m_isField && (m_frameRcvd == m_framesToBeEncoded));
+  if( m_flush )
+  {
+    eos = true;
+    m_cEncLib.setFramesToBeEncoded(m_frameRcvd);
+  }
+  else if( m_ownTemporalFilter )
+  {
+    PerfTimer mctfTimer(m_cEncLib.getPerfCounters(), PerfStage::MCTF);
+    if (m_fgcSEIAnalysisEnabled && m_fgcSEIExternalDenoised.empty())
+    {
+      m_filteredOrgPicForFG->copyFrom(*m_orgPic);
+      m_temporalFilterForFG.filter(m_filteredOrgPicForFG, m_frameRcvd - 1);
+    }
+    if ( m_gopBasedTemporalFilterEnabled || m_bimEnabled )
+    {
+      m_temporalFilter.filter(m_orgPic, m_frameRcvd - 1);
+      m_filteredOrgPic->copyFrom(*m_orgPic);
+    }
+  }
+
+  if( m_isField )
+  {
+    return m_cEncLib.encodePrep( eos, m_flush ? 0 : m_orgPic, m_flush ? 0 : m_trueOrgPic, m_flush ? 0 : m_filteredOrgPic, snrCSC, m_recBufList, m_numEncoded, m_isTopFieldFirst );
+  }
+  return m_cEncLib.encodePrep( eos, m_flush ? 0 : m_orgPic, m_flush ? 0 : m_trueOrgPic, m_flush ? 0 : m_filteredOrgPic, m_flush ? 0 : m_filteredOrgPicForFG, snrCSC, m_recBufList, m_numEncoded
+    , m_rprPic
+  );
+}
+
 void EncApp::applyNnPostFilter()
 {
   m_cEncLib.applyNnPostFilter();
@@ -1919,6 +2138,7 @@ void EncApp::applyNnPostFilter()
  */
 void EncApp::xWriteOutput(int numEncoded, std::list<PelUnitBuf *> &recBufList)
 {
+  PerfTimer ioTimer(m_cEncLib.getPerfCounters(), PerfStage::IO);
   const InputColourSpaceConversion ipCSC = (!m_outputInternalColourSpace) ? m_inputColourSpaceConvert : IPCOLOURSPACE_UNCHANGED;
   std::list<PelUnitBuf*>::iterator iterPicYuvRec = recBufList.end();
   int i;
@@ -2007,6 +2227,7 @@ void EncApp::xWriteOutput(int numEncoded, std::list<PelUnitBuf *> &recBufList)
 
 void EncApp::outputAU( const AccessUnit& au )
 {
+  PerfTimer ioTimer(m_cEncLib.getPerfCounters(), PerfStage::IO);
   const std::vector<uint32_t> &stats = writeAnnexBAccessUnit(m_bitstream, au);
   rateStatsAccum(au, stats);
   m_bitstream.flush();
@@ -49,6 +49,7 @@
 #include "AppEncHelper360/TExt360AppEncTop.h"
 #endif
 #include "EncoderLib/EncTemporalFilter.h"
+#include "EncoderLib/EncLookahead.h"
 
 #if JVET_O0756_CALCULATE_HDRMETRICS
 #include <chrono>
@@ -88,6 +89,10 @@ private:
   void xInitLibCfg ( int layerIdx );             ///< initialize internal variables
   void xInitLib();                               ///< initialize encoder class
   void xDestroyLib ();                           ///< destroy encoder class
+  void xCheckInputSource();                      ///< check that the input of an encode can be shared, rename shared output files
+  void xPassInputToSharedEncodes();              ///< copy the current input pictures to the further encodes sharing the input
+  void xPassFilteredInputToSharedEncodes();      ///< copy the temporally filtered input to the encodes sharing the filter
+  bool xEncodePrepFromSource( bool& eos );       ///< pass the pictures received from the input source to the encoder
 
   // file I/O
   void xWriteOutput(int numEncoded, std::list<PelUnitBuf *> &recBufList);   ///< write bitstream to file
@@ -109,6 +114,10 @@ private:
   EncTemporalFilter      m_temporalFilter;
   PelStorage*            m_filteredOrgPicForFG;
   EncTemporalFilter      m_temporalFilterForFG;
+  EncLookahead           m_lookahead;
+  EncApp*                m_inputSource;         ///< encoder reading the input of all shared input encodes, nullptr for that encoder itself
+  std::vector<EncApp*>   m_sharedInputEncodes;  ///< encoders of further encodes sharing the input of this encoder
+  bool                   m_ownTemporalFilter;   ///< the input is shared, but filtered by this encoder because its filter settings differ
   bool m_flush;
 #if GREEN_METADATA_SEI_ENABLED
   FeatureCounterStruct      m_featureCounter;
@@ -119,6 +128,8 @@ public:
   virtual ~EncApp();
 
   int   getMaxLayers() const { return m_maxLayers; }
+  int   getNumSharedInputEncodes() const { return m_numSharedInputEncodes; }
+  void  setInputSource( EncApp* source ) { m_inputSource = source; source->m_sharedInputEncodes.push_back( this ); }
   void  createLib( const int layerIdx );
   void  destroyLib();
   bool  encodePrep( bool& eos );
@@ -51,6 +51,7 @@
 
 #include "CommonLib/dtrace_next.h"
 #include "CommonLib/ProfileTierLevel.h"
+#include "CommonLib/PerfCounters.h"
 
 #define MACRO_TO_STRING_HELPER(val) #val
 #define MACRO_TO_STRING(val) MACRO_TO_STRING_HELPER(val)
@@ -100,14 +101,20 @@ EncAppCfg::EncAppCfg()
 #if EXTENSION_360_VIDEO
 , m_ext360(*this)
 #endif
+#if ENABLE_TRACING
+, m_ownsTraceCtx(false)
+#endif
 {
 }
 
 EncAppCfg::~EncAppCfg()
 {
 #if ENABLE_TRACING
-  tracing_uninit(g_trace_ctx);
-  g_trace_ctx = nullptr;
+  if (m_ownsTraceCtx)
+  {
+    tracing_uninit(g_trace_ctx);
+    g_trace_ctx = nullptr;
+  }
 #endif
 }
 
@@ -815,6 +822,8 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("InputPathPrefix,-ipp",                            inputPathPrefix,                             std::string(""), "pathname to prepend to input filename")
   ("BitstreamFile,b",                                 m_bitstreamFileName,                         std::string(""), "Bitstream output file name")
   ("ReconFile,o",                                     m_reconFileName,                             std::string(""), "Reconstructed YUV output file name")
+  ("PerfStatsFile",                                   m_perfStatsFileName,                         std::string(""), "Per-picture timing and mode evaluation statistics output file name (empty: disabled)")
+  ("PerfStatsFormat",                                 m_perfStatsFormat,                        std::string("csv"), "Format of the per-picture statistics file: csv or json (one object per line)")
 #if JVET_Z0120_SII_SEI_PROCESSING
   ("SEIShutterIntervalPreFilename,-sii",              m_shutterIntervalPreFileName, std::string(""), "File name of Pre-Filtering video. If empty, not output video\n")
 #endif
@@ -843,6 +852,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("PrintSequenceMSE",                                m_printSequenceMSE,                               false, "0 (default) emit only bit rate and PSNRs for the whole sequence, 1 = also emit MSE values")
   ("PrintMSSSIM",                                     m_printMSSSIM,                                    false, "0 (default) do not print MS-SSIM scores, 1 = print MS-SSIM scores for each frame and for the whole sequence")
   ("PrintWPSNR",                                      m_printWPSNR,                                     false, "0 (default) do not print HDR-PQ based wPSNR, 1 = print HDR-PQ based wPSNR")
+  ("MetricThreads",                                   m_metricThreads,                                      1, "Number of threads computing the PSNR, wPSNR and MS-SSIM of the picture planes and the 360 metrics, the result does not depend on it")
   ("PrintHighPrecEncTime",                            m_printHighPrecEncTime,                           false, "0 (default): print integer value of encoding time in seconds, 1: print floating-point value of encoding time")
   ("CabacZeroWordPaddingEnabled",                     m_cabacZeroWordPaddingEnabled,                     true, "0 do not add conforming cabac-zero-words to bit streams, 1 (default) = add cabac-zero-words as required")
   ("ChromaFormatIDC,-cf",                             tmpChromaFormat,                                      0, "ChromaFormatIDC (400|420|422|444 or set 0 (default) for same as InputChromaFormat)")
@@ -1114,6 +1124,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("LCTUFast",                                        m_useFastLCTU,                                    false, "Fast methods for large CTU")
   ("FastMrg",                                         m_useFastMrg,                                     false, "Fast methods for inter merge")
   ("MaxMergeRdCandNumTotal",                          m_maxMergeRdCandNumTotal,                            15, "Max total number of merge candidates in full RD checking")
+  ("SubPelMECacheSize",                               m_subPelMECacheSize,                                  0, "Memory limit in MB of the cache of interpolated reference planes used by fractional ME (0: disabled)")
   ("MergeRdCandQuotaRegular",                         m_mergeRdCandQuotaRegular,            NUM_MRG_SATD_CAND, "Quota of regular merge candidates in full RD checking")
   ("MergeRdCandQuotaRegularSmallBlk",                 m_mergeRdCandQuotaRegularSmallBlk,    NUM_MRG_SATD_CAND, "Quota of regular merge candidates in full RD checking for blocks < 64 luma samples")
   ("MergeRdCandQuotaSubBlk",                          m_mergeRdCandQuotaSubBlk,         NUM_AFF_MRG_SATD_CAND, "Quota of sub-block merge candidates in full RD checking")
@@ -1130,6 +1141,8 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("MRL",                                             m_MRL,                                            false,  "Enable MRL (multiple reference line intra prediction)")
   ("MIP",                                             m_MIP,                                             true,  "Enable MIP (matrix-based intra prediction)")
   ("FastMIP",                                         m_useFastMIP,                                     false,  "Fast encoder search for MIP (matrix-based intra prediction)")
+  ("IntraSearchThreads",                              m_intraSearchThreads,                                 1,  "Number of threads computing the SAD/SATD of the intra mode candidates, the result does not depend on it")
+  ("NumSplitThreads",                                 m_numSplitThreads,                                    1,  "Number of threads evaluating the CTU-level split hypotheses concurrently (1: sequential search, the result of larger values does not depend on the number but differs from the sequential search)")
   ("FastLocalDualTreeMode",                           m_fastLocalDualTreeMode,                              0,  "Fast intra pass coding for local dual-tree in intra coding region, 0: off, 1: use threshold, 2: one intra mode only")
   ("SplitPredictAdaptMode",                           m_fastAdaptCostPredMode,                              0,  "Mode for split cost prediction, 0..2 (Default: 0)" )
   ("DisableFastTTfromBT",                             m_disableFastDecisionTT,                          false,  "Disable fast decision for TT from BT")
@@ -1212,6 +1225,11 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("SmoothQPReductionModelOffsetInter",               m_smoothQPReductionModelOffsetInter,                27.0, "Offset parameter of the QP reduction model for inter pictures")
   ("SmoothQPReductionLimitInter",                     m_smoothQPReductionLimitInter,                        -4, "Threshold parameter for controlling maximum amount of QP reduction by the QP reduction model for inter pictures")
   ("BIM",                                             m_bimEnabled,                                      false, "Block Importance Mapping QP adaptation depending on estimated propagation of reference samples.")
+  ("Lookahead",                                       m_lookaheadFrames,                                     0, "Number of pictures analysed ahead of the current picture by the first-pass lookahead for rate control and QP adaptation (0: disabled)")
+  ("LookaheadQPStrength",                             m_lookaheadQpStrength,                               2.0, "Strength of the propagation based CTU QP offsets derived by the lookahead (0: bit allocation only)")
+  ("AnalysisSaveFile",                                m_analysisSaveFile,                        std::string(), "File to write the CU decisions of this encode to, for reuse by encodes of the same source at other QPs or rates")
+  ("AnalysisLoadFile",                                m_analysisLoadFile,                        std::string(), "File with the CU decisions of a previous encode of the same source")
+  ("AnalysisReuseLevel",                              m_analysisReuseLevel,                                  2, "Reuse of the loaded CU decisions (0: none, 1: motion search start vectors and intra mode candidates, 2: partitioning with one level tolerance, 3: exact partitioning and intra/inter decision)")
   ("UseIdentityTableForNon420Chroma",                 m_useIdentityTableForNon420Chroma,                  true, "True: Indicates that 422/444 chroma uses identity chroma QP mapping tables; False: explicit Qp table may be specified in config")
   ("SameCQPTablesForAllChroma",                       m_chromaQpMappingTableParams.m_sameCQPTableForAllChromaFlag,                        true, "0: Different tables for Cb, Cr and joint Cb-Cr components, 1 (default): Same tables for all three chroma components")
   ("QpInValCb",                                       cfg_qpInValCb,                            cfg_qpInValCb, "Input coordinates for the QP table for Cb component")
@@ -1724,6 +1742,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ( "UpscaledOutput",                                 m_upscaledOutput,                             0, "Output upscaled (2), decoded but in full resolution buffer (1) or decoded cropped (0, default) picture for RPR" )
   ("UpscaleFilterForDisplay",                         m_upscaleFilterForDisplay,                    1, "Filters used for upscaling reconstruction to full resolution (2: ECM 12-tap luma and 6-tap chroma MC filters, 1: Alternative 12-tap luma and 6-tap chroma filters, 0: VVC 8-tap luma and 4-tap chroma MC filters)")
   ( "MaxLayers",                                      m_maxLayers,                                  1, "Max number of layers" )
+  ( "SharedInputEncodes",                             m_numSharedInputEncodes,                      1, "Number of bitstreams encoded from one input read, encodes with the temporal filter settings and QP of the first one also share its temporal filter, options prefixed with -r<n> apply to encode n only" )
   ( "EnableOperatingPointInformation",                m_OPIEnabled,                             false, "Enables writing of Operating Point Information (OPI)" )
   ( "MaxTemporalLayer",                               m_maxTemporalLayer,                         500, "Maximum temporal layer to be signalled in OPI" )
   ( "TargetOutputLayerSet",                           m_targetOlsIdx,                             500, "Target output layer set index to be signalled in OPI" )
@@ -3501,7 +3520,12 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   m_reshapeCW.adpOption = m_adpOption;
   m_reshapeCW.initialCW = m_initialCW;
 #if ENABLE_TRACING
-  g_trace_ctx = tracing_init(sTracingFile, sTracingRule);
+  // the context is process-wide, encoders of other layers or running in parallel trace into the first one
+  if (g_trace_ctx == nullptr)
+  {
+    g_trace_ctx    = tracing_init(sTracingFile, sTracingRule);
+    m_ownsTraceCtx = true;
+  }
   if( bTracingChannelsList && g_trace_ctx )
   {
     std::string sChannelsList;
@@ -3934,6 +3958,8 @@ bool EncAppCfg::xCheckParameter()
 
 
   xConfirmPara(m_bitstreamFileName.empty(), "A bitstream file name must be specified (BitstreamFile)");
+  PerfCounters::Format perfStatsFormat;
+  xConfirmPara(!PerfCounters::parseFormat(m_perfStatsFormat, perfStatsFormat), "PerfStatsFormat must be csv or json");
   xConfirmPara(m_internalBitDepth[ChannelType::CHROMA] != m_internalBitDepth[ChannelType::LUMA],
                "The internalBitDepth must be the same for luma and chroma");
   if (m_profile != Profile::NONE)
@@ -4263,6 +4289,7 @@ bool EncAppCfg::xCheckParameter()
   // Limit maximum value of MaxMergeRdCandNumTotal to maxCandNum. Larger values are not expected to be beneficial
   xConfirmPara( m_maxMergeRdCandNumTotal < 1 || m_maxMergeRdCandNumTotal > maxCandNum, 
     "MaxMergeRdCandNumTotal must be between 1 and 15, inclusive");
+  xConfirmPara(m_subPelMECacheSize < 0, "SubPelMECacheSize must not be negative");
   xConfirmPara(m_mergeRdCandQuotaRegular < 0 || m_mergeRdCandQuotaRegular > maxCandNum
     || m_mergeRdCandQuotaRegularSmallBlk < 0 || m_mergeRdCandQuotaRegularSmallBlk > maxCandNum
     || m_mergeRdCandQuotaSubBlk < 0 || m_mergeRdCandQuotaSubBlk > maxCandNum
@@ -4422,6 +4449,9 @@ bool EncAppCfg::xCheckParameter()
 
 
   xConfirmPara( m_fastLocalDualTreeMode < 0 || m_fastLocalDualTreeMode > 2, "FastLocalDualTreeMode must be in range [0..2]" );
+  xConfirmPara( m_metricThreads < 1, "MetricThreads must be at least 1" );
+  xConfirmPara( m_intraSearchThreads < 1, "IntraSearchThreads must be at least 1" );
+  xConfirmPara( m_numSplitThreads < 1, "NumSplitThreads must be at least 1" );
 
   xConfirmPara( m_fastAdaptCostPredMode < 0 || m_fastAdaptCostPredMode > 2, "FastAdaptCostPredMode must be in range [0..2]" );
 
@@ -5285,6 +5315,25 @@ bool EncAppCfg::xCheckParameter()
       m_gopBasedTemporalFilterPastRefs <= 0 && m_gopBasedTemporalFilterFutureRefs <= 0,
       "Either TemporalFilterPastRefs or TemporalFilterFutureRefs must be larger than 0 when Block Importance Mapping is enabled" );
   }
+  xConfirmPara( m_lookaheadFrames < 0, "Lookahead must be greater than or equal to 0" );
+  xConfirmPara( m_lookaheadQpStrength < 0.0, "LookaheadQPStrength must be greater than or equal to 0" );
+  if (m_lookaheadFrames > 0)
+  {
+    xConfirmPara( m_bimEnabled, "Lookahead and Block Importance Mapping cannot be enabled at the same time" );
+    xConfirmPara( m_temporalSubsampleRatio != 1, "Lookahead only supports Temporal sub-sample ratio 1" );
+    xConfirmPara( m_isField, "Lookahead is not supported for field coding" );
+    xConfirmPara( m_compositeRefEnabled, "Lookahead is not supported with composite reference pictures" );
+    xConfirmPara( m_sourceScalingRatioHor != 1.0 || m_sourceScalingRatioVer != 1.0, "Lookahead is not supported with source scaling" );
+  }
+  xConfirmPara( m_analysisReuseLevel < 0 || m_analysisReuseLevel > 3, "AnalysisReuseLevel must be in the range of 0 to 3" );
+  if (!m_analysisSaveFile.empty() || !m_analysisLoadFile.empty())
+  {
+    xConfirmPara( m_maxLayers > 1, "Saving or loading CU decisions is only supported for single layer encoding" );
+    xConfirmPara( m_resChangeInClvsEnabled, "Saving or loading CU decisions is not supported with reference picture resampling" );
+    xConfirmPara( m_analysisSaveFile == m_analysisLoadFile, "AnalysisSaveFile and AnalysisLoadFile must be different files" );
+  }
+  xConfirmPara( m_numSharedInputEncodes < 1 || m_numSharedInputEncodes > 10, "SharedInputEncodes must be in the range of 1 to 10" );
+  xConfirmPara( m_numSharedInputEncodes > 1 && m_maxLayers > 1, "Encodes sharing the input are only supported for single layer encoding" );
 #if EXTENSION_360_VIDEO
   check_failed |= m_ext360.verifyParameters();
 #endif
@@ -5320,6 +5369,10 @@ void EncAppCfg::xPrintParameter()
   msg( DETAILS, "Input          File                    : %s\n", m_inputFileName.c_str() );
   msg( DETAILS, "Bitstream      File                    : %s\n", m_bitstreamFileName.c_str() );
   msg( DETAILS, "Reconstruction File                    : %s\n", m_reconFileName.c_str() );
+  if (!m_perfStatsFileName.empty())
+  {
+    msg(DETAILS, "Performance statistics File            : %s (%s)\n", m_perfStatsFileName.c_str(), m_perfStatsFormat.c_str());
+  }
 #if JVET_Z0120_SII_SEI_PROCESSING
   if (m_ShutterFilterEnable && !m_shutterIntervalPreFileName.empty())
   {
@@ -5335,6 +5388,7 @@ void EncAppCfg::xPrintParameter()
   msg( DETAILS, "Sequence MSE output                    : %s\n", ( m_printSequenceMSE ? "Enabled" : "Disabled" ) );
   msg( DETAILS, "Frame MSE output                       : %s\n", ( m_printFrameMSE ? "Enabled" : "Disabled" ) );
   msg( DETAILS, "MS-SSIM output                         : %s\n", ( m_printMSSSIM ? "Enabled" : "Disabled") );
+  msg( DETAILS, "Metric threads                         : %d\n", m_metricThreads );
   msg( DETAILS, "Cabac-zero-word-padding                : %s\n", ( m_cabacZeroWordPaddingEnabled ? "Enabled" : "Disabled" ) );
   if (m_isField)
   {
@@ -5634,6 +5688,7 @@ void EncAppCfg::xPrintParameter()
     m_maxMergeRdCandNumTotal, m_mergeRdCandQuotaRegular, m_mergeRdCandQuotaRegularSmallBlk);
   msg( VERBOSE, "MergeRdCandQuotaSubBlk:%d MergeRdCandQuotaCiip:%d MergeRdCandQuotaGpm:%d ",
     m_mergeRdCandQuotaSubBlk, m_mergeRdCandQuotaCiip, m_mergeRdCandQuotaGpm);
+  msg( VERBOSE, "SubPelMECacheSize:%d ", m_subPelMECacheSize );
   msg( VERBOSE, "PBIntraFast:%d ", m_usePbIntraFast );
   if( m_ImvMode ) msg( VERBOSE, "IMV4PelFast:%d ", m_Imv4PelFast );
   if (m_mtsMode)
@@ -5649,6 +5704,8 @@ void EncAppCfg::xPrintParameter()
   msg( VERBOSE, "UseNonLinearAlfChroma:%d ", m_useNonLinearAlfChroma );
   msg( VERBOSE, "MaxNumAlfAlternativesChroma:%d ", m_maxNumAlfAlternativesChroma );
   if( m_MIP ) msg(VERBOSE, "FastMIP:%d ", m_useFastMIP);
+  msg( VERBOSE, "IntraSearchThreads:%d ", m_intraSearchThreads );
+  msg( VERBOSE, "NumSplitThreads:%d ", m_numSplitThreads );
   msg( VERBOSE, "TTFastSkip:%d ", m_ttFastSkip);
   msg( VERBOSE, "TTFastSkipThr:%.3f ", m_ttFastSkipThr);
   msg( VERBOSE, "FastLocalDualTree:%d ", m_fastLocalDualTreeMode );
@@ -5677,6 +5734,11 @@ void EncAppCfg::xPrintParameter()
   msg(VERBOSE, "TemporalFilter:%d/%d ", m_gopBasedTemporalFilterPastRefs, m_gopBasedTemporalFilterFutureRefs);
   msg(VERBOSE, "SEI CTI:%d ", m_ctiSEIEnabled);
   msg(VERBOSE, "BIM:%d ", m_bimEnabled);
+  msg(VERBOSE, "Lookahead:%d ", m_lookaheadFrames);
+  if (!m_analysisLoadFile.empty())
+  {
+    msg(VERBOSE, "AnalysisReuse:%d ", m_analysisReuseLevel);
+  }
   msg(VERBOSE, "SEI FGC:%d ", m_fgcSEIEnabled);
 
   msg(VERBOSE, "SEI processing Order:%d ", m_poSEIEnabled);
@@ -79,6 +79,8 @@ protected:
   std::string m_inputFileName;                                ///< source file name
   std::string m_bitstreamFileName;                            ///< output bitstream file
   std::string m_reconFileName;                                ///< output reconstruction file
+  std::string m_perfStatsFileName;                            ///< output file of the per-picture performance statistics
+  std::string m_perfStatsFormat;                              ///< format of the performance statistics (csv or json)
 
   // Lambda modifiers
   double    m_adLambdaModifier[ MAX_TLAYER ];                 ///< Lambda modifier array for each temporal layer
@@ -129,6 +131,7 @@ protected:
   bool      m_printSequenceMSE;
   bool      m_printMSSSIM;
   bool      m_printWPSNR;
+  int       m_metricThreads;
   bool      m_printHighPrecEncTime = false;
   bool      m_cabacZeroWordPaddingEnabled;
   bool      m_clipInputVideoToRec709Range;
@@ -423,6 +426,7 @@ protected:
   bool      m_useAMaxBT;
   bool      m_useFastMrg;
   int       m_maxMergeRdCandNumTotal;
+  int       m_subPelMECacheSize;
   int       m_mergeRdCandQuotaRegular;
   int       m_mergeRdCandQuotaRegularSmallBlk;
   int       m_mergeRdCandQuotaSubBlk;
@@ -436,6 +440,8 @@ protected:
   bool      m_MRL;
   bool      m_MIP;
   bool      m_useFastMIP;
+  int       m_intraSearchThreads;
+  int       m_numSplitThreads;
   int       m_fastLocalDualTreeMode;
 
   int       m_log2MaxTbSize;
@@ -1016,8 +1022,14 @@ protected:
   int                   m_gopBasedTemporalFilterFutureRefs;
   std::map<int, double> m_gopBasedTemporalFilterStrengths;             ///< Filter strength per frame for the GOP-based Temporal Filter
   bool                  m_bimEnabled;
+  int                   m_lookaheadFrames;
+  double                m_lookaheadQpStrength;
+  std::string           m_analysisSaveFile;
+  std::string           m_analysisLoadFile;
+  int                   m_analysisReuseLevel;
 
   int         m_maxLayers;
+  int         m_numSharedInputEncodes;                          ///< number of bitstreams encoded from the same input pictures
   int         m_targetOlsIdx;
   bool        m_OPIEnabled;                                     ///< enable Operating Point Information (OPI)
   int         m_maxTemporalLayer;
@@ -1067,6 +1079,9 @@ protected:
   int         m_cropOffsetBottom;
   bool        m_calculateHdrMetrics;
 #endif
+#if ENABLE_TRACING
+  bool        m_ownsTraceCtx;                                 ///< the trace context was created by this configuration, not taken over from the process
+#endif
 
   // internal member functions
   bool  xCheckParameter ();                                   ///< check validity of configuration values
@@ -39,6 +39,7 @@
 #include <iostream>
 #include <chrono>
 #include <ctime>
+#include <memory>
 
 #include "EncoderLib/EncLibCommon.h"
 #include "EncApp.h"
@@ -80,6 +81,73 @@ static void printMacroSettings()
 // Main function
 // ====================================================================================================================
 
+/// returns true if the argument is a layer (-l<n>) or shared input encode (-r<n>) prefix, and its index n
+static bool isIndexPrefix( const char* arg, int& idx )
+{
+  if( arg[0] != '-' || ( arg[1] != 'l' && arg[1] != 'r' ) || arg[2] == '\0' )
+  {
+    return false;
+  }
+  idx = 0;
+  for( const char* c = arg + 2; *c != '\0'; c++ )
+  {
+    if( *c < '0' || *c > '9' || idx > 1000 )
+    {
+      return false;
+    }
+    idx = 10 * idx + ( *c - '0' );
+  }
+  return true;
+}
+
+/// collects the command line arguments of one encoder, arguments prefixed with -l<n> (-r<n>) are only passed to the
+/// encoder of layer n (shared input encode n)
+static int collectArguments( int argc, char* argv[], const int layerIdx, const int encodeIdx, char** encArgv )
+{
+  int j = 0;
+  for( int i = 0; i < argc; i++ )
+  {
+    int prefixIdx;
+    if( isIndexPrefix( argv[i], prefixIdx ) )
+    {
+      if (argc <= i + 1)
+      {
+        THROW("Command line parsing error: missing parameter after -" << argv[i][1] << "x\n");
+      }
+      int numParams = 1; // count how many parameters are consumed
+      // check for long parameters, which start with "--"
+      const std::string param = argv[i + 1];
+      if (param.rfind("--", 0) != 0)
+      {
+        // only short parameters have a second parameter for the value
+        if (argc <= i + 2)
+        {
+          THROW("Command line parsing error: missing parameter after -" << argv[i][1] << "x\n");
+        }
+        numParams++;
+      }
+      // check if correct layer or shared input encode index
+      const int idx = argv[i][1] == 'l' ? layerIdx : encodeIdx;
+      if( prefixIdx == idx )
+      {
+        encArgv[j] = argv[i + 1];
+        if (numParams > 1)
+        {
+          encArgv[j + 1] = argv[i + 2];
+        }
+        j+= numParams;
+      }
+      i += numParams;
+    }
+    else
+    {
+      encArgv[j] = argv[i];
+      j++;
+    }
+  }
+  return j;
+}
+
 int main(int argc, char* argv[])
 {
   #if STORCHMAIN_H
@@ -127,45 +195,7 @@ int main(int argc, char* argv[])
     // parse configuration per layer
     try
     {
-      int j = 0;
-      for( int i = 0; i < argc; i++ )
-      {
-        if( argv[i][0] == '-' && argv[i][1] == 'l' )
-        {
-          if (argc <= i + 1)
-          {
-            THROW("Command line parsing error: missing parameter after -lx\n");
-          }
-          int numParams = 1; // count how many parameters are consumed
-          // check for long parameters, which start with "--"
-          const std::string param = argv[i + 1];
-          if (param.rfind("--", 0) != 0)
-          {
-            // only short parameters have a second parameter for the value
-            if (argc <= i + 2)
-            {
-              THROW("Command line parsing error: missing parameter after -lx\n");
-            }
-            numParams++;
-          }
-          // check if correct layer index
-          if( argv[i][2] == std::to_string( layerIdx ).c_str()[0] )
-          {
-            layerArgv[j] = argv[i + 1];
-            if (numParams > 1)
-            {
-              layerArgv[j + 1] = argv[i + 2];
-            }
-            j+= numParams;
-          }
-          i += numParams;
-        }
-        else
-        {
-          layerArgv[j] = argv[i];
-          j++;
-        }
-      }
+      const int j = collectArguments( argc, argv, layerIdx, 0, layerArgv );
 
       if( !pcEncApp[layerIdx]->parseCfg( j, layerArgv ) )
       {
@@ -190,6 +220,39 @@ int main(int argc, char* argv[])
     layerIdx++;
   } while( layerIdx < pcEncApp.size() );
 
+  // further encodes are encoded from the input pictures read by the first encoder
+  const int numSharedInputEncodes = pcEncApp[0]->getNumSharedInputEncodes();
+  std::vector<std::unique_ptr<std::fstream>> sharedBitstreams;
+  std::vector<std::unique_ptr<EncLibCommon>> sharedEncLibCommons;
+
+  for( int encodeIdx = 1; encodeIdx < numSharedInputEncodes; encodeIdx++ )
+  {
+    sharedBitstreams.emplace_back( new std::fstream );
+    sharedEncLibCommons.emplace_back( new EncLibCommon );
+    EncApp *encApp = new EncApp( *sharedBitstreams.back(), sharedEncLibCommons.back().get() );
+    encApp->create();
+    pcEncApp.push_back( encApp );
+
+    try
+    {
+      const int j = collectArguments( argc, argv, 0, encodeIdx, layerArgv );
+
+      if( !encApp->parseCfg( j, layerArgv ) )
+      {
+        encApp->destroy();
+        return 1;
+      }
+    }
+    catch (ProgramOptionsLite::ParseFailure& e)
+    {
+      std::cerr << "Error parsing option \"" << e.arg << "\" with argument \"" << e.val << "\"." << std::endl;
+      return 1;
+    }
+
+    encApp->setInputSource( pcEncApp[0] );
+    encApp->createLib( 0 );
+  }
+
   delete[] layerArgv;
 
   if (layerIdx > 1)
@@ -0,0 +1,288 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2023, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     KernelBenchmarkApp.cpp
+    \brief    Kernel benchmark application class
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#include "KernelBenchmarkApp.h"
+
+//! \ingroup KernelBenchmarkApp
+//! \{
+
+namespace
+{
+const char *levelName( const KernelLevel level )
+{
+  switch( level )
+  {
+#if ENABLE_SIMD_OPT && defined( TARGET_SIMD_X86 )
+  case SSE41: return "SSE41";
+  case SSE42: return "SSE42";
+  case AVX: return "AVX";
+  case AVX2: return "AVX2";
+  case AVX512: return "AVX512";
+#endif
+  default: return "SCALAR";
+  }
+}
+}   // namespace
+
+// ====================================================================================================================
+// Constructor / destructor / initialization / destroy
+// ====================================================================================================================
+
+KernelBenchmarkApp::KernelBenchmarkApp()
+{
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/**
+ - select the SIMD levels to test
+ - build the kernel cases of all modules
+ - check each SIMD implementation against the scalar one and measure all of them
+ - returns the number of kernels with a mismatching SIMD implementation
+ */
+int KernelBenchmarkApp::run()
+{
+  std::vector<KernelLevel> levels;
+  if( !xSelectLevels( levels ) )
+  {
+    THROW( "Unsupported SIMD level " << m_maxSimd );
+  }
+
+  const KernelSuiteParam  param = { levels, m_bitDepths };
+  std::vector<KernelCase> cases;
+  addPelBufOpsCases( param, cases );
+  addRdCostCases( param, cases );
+  addInterpolationFilterCases( param, cases );
+  addAdaptiveLoopFilterCases( param, cases );
+  addAffineGradientSearchCases( param, cases );
+  addIntraPredictionCases( param, cases );
+  addTransformCases( param, cases );
+
+  printf( "\n%-48s", "kernel (ns per call)" );
+  for( const auto level: levels )
+  {
+    printf( "%10s", levelName( level ) );
+  }
+  printf( "   speedup  result\n" );
+
+  int numCases      = 0;
+  int numSimdCases  = 0;
+  int numMismatches = 0;
+  for( const auto &kernelCase: cases )
+  {
+    if( !m_filter.empty() && kernelCase.name.find( m_filter ) == std::string::npos )
+    {
+      continue;
+    }
+    numCases++;
+    numSimdCases += kernelCase.levels.size() > 1 ? 1 : 0;
+
+    std::vector<int> mismatchLevels;
+    const bool       match = xVerify( kernelCase, mismatchLevels );
+    numMismatches += match ? 0 : 1;
+
+    printf( "%-48s", kernelCase.name.c_str() );
+    double scalarTime = 0;
+    double bestTime   = 0;
+    for( int k = 0; k < (int) levels.size(); k++ )
+    {
+      if( std::find( kernelCase.levels.begin(), kernelCase.levels.end(), k ) == kernelCase.levels.end() )
+      {
+        printf( "%10s", "-" );
+        continue;
+      }
+      const double time = xMeasure( kernelCase, k );
+      printf( "%10.1f", time );
+      if( k == 0 )
+      {
+        scalarTime = time;
+      }
+      else if( bestTime == 0 || time < bestTime )
+      {
+        bestTime = time;
+      }
+    }
+    if( bestTime > 0 )
+    {
+      printf( "%9.2fx", scalarTime / bestTime );
+    }
+    else
+    {
+      printf( "%10s", "-" );
+    }
+    if( match )
+    {
+      printf( "  ok\n" );
+    }
+    else
+    {
+      printf( "  MISMATCH" );
+      for( const int k: mismatchLevels )
+      {
+        printf( " %s", levelName( levels[k] ) );
+      }
+      printf( "\n" );
+    }
+    fflush( stdout );
+  }
+
+  printf( "\n%d kernels tested, %d with a SIMD implementation, %d mismatching\n", numCases, numSimdCases, numMismatches );
+
+  return numMismatches;
+}
+
+// ====================================================================================================================
+// Private member functions
+// ====================================================================================================================
+
+/** The scalar code is always tested, followed by each level with own implementations up to the highest level
+    supported by the CPU or the one given by --SIMD. The global level is fixed to SCALAR, so that the CommonLib
+    objects created by the kernel cases start with the scalar implementations.
+ */
+bool KernelBenchmarkApp::xSelectLevels( std::vector<KernelLevel> &levels ) const
+{
+  levels = { SCALAR };
+#if ENABLE_SIMD_OPT && defined( TARGET_SIMD_X86 )
+  read_x86_extension_flags( "SCALAR" );
+
+  X86_VEXT maxLevel = _get_x86_extensions();
+  if( !m_maxSimd.empty() )
+  {
+    static const std::vector<std::pair<std::string, X86_VEXT>> names = {
+      { "SCALAR", SCALAR }, { "SSE41", SSE41 }, { "SSE42", SSE42 }, { "AVX", AVX }, { "AVX2", AVX2 }, { "AVX512", AVX512 }
+    };
+    auto it = std::find_if( names.begin(), names.end(), [this]( const std::pair<std::string, X86_VEXT> &n ) { return n.first == m_maxSimd; } );
+    if( it == names.end() )
+    {
+      return false;
+    }
+    maxLevel = std::min( maxLevel, it->second );
+  }
+
+  // SSE42 and AVX512 select the SSE41 and AVX2 implementations
+  for( const X86_VEXT level: { SSE41, AVX, AVX2 } )
+  {
+    if( level <= maxLevel )
+    {
+      levels.push_back( level );
+    }
+  }
+#else
+  if( !m_maxSimd.empty() && m_maxSimd != "SCALAR" )
+  {
+    return false;
+  }
+#endif
+  return true;
+}
+
+bool KernelBenchmarkApp::xVerify( const KernelCase &kernelCase, std::vector<int> &mismatchLevels ) const
+{
+  std::vector<uint8_t> reference( kernelCase.outSize );
+
+  for( const int k: kernelCase.levels )
+  {
+    if( kernelCase.reset )
+    {
+      kernelCase.reset();
+    }
+    else
+    {
+      memset( kernelCase.out, 0, kernelCase.outSize );
+    }
+    kernelCase.run( k );
+
+    if( k == 0 )
+    {
+      memcpy( reference.data(), kernelCase.out, kernelCase.outSize );
+    }
+    else if( !xEqual( kernelCase, reference.data() ) )
+    {
+      mismatchLevels.push_back( k );
+    }
+  }
+  return mismatchLevels.empty();
+}
+
+bool KernelBenchmarkApp::xEqual( const KernelCase &kernelCase, const uint8_t *reference ) const
+{
+  const uint8_t *out = static_cast<const uint8_t *>( kernelCase.out );
+  if( kernelCase.outRowSize == 0 )
+  {
+    return memcmp( reference, out, kernelCase.outSize ) == 0;
+  }
+  for( size_t offset = 0; offset < kernelCase.outSize; offset += kernelCase.outStride )
+  {
+    if( memcmp( reference + offset, out + offset, kernelCase.outRowSize ) != 0 )
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+double KernelBenchmarkApp::xMeasure( const KernelCase &kernelCase, const int level ) const
+{
+  if( kernelCase.reset )
+  {
+    kernelCase.reset();
+  }
+
+  // double the number of calls until the minimum measurement time is reached
+  for( int64_t numCalls = 1;; numCalls *= 2 )
+  {
+    const auto start = std::chrono::steady_clock::now();
+    for( int64_t i = 0; i < numCalls; i++ )
+    {
+      kernelCase.run( level );
+    }
+    const double elapsedNs = std::chrono::duration<double, std::nano>( std::chrono::steady_clock::now() - start ).count();
+    if( elapsedNs >= m_minTimeMs * 1e6 || numCalls >= ( int64_t( 1 ) << 32 ) )
+    {
+      return elapsedNs / numCalls;
+    }
+  }
+}
+
+//! \}
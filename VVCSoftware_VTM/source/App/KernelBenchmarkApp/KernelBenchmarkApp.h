@@ -0,0 +1,71 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2023, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     KernelBenchmarkApp.h
+    \brief    Kernel benchmark application class (header)
+*/
+
+#ifndef __KERNELBENCHMARKAPP__
+#define __KERNELBENCHMARKAPP__
+
+#pragma once
+
+#include "KernelBenchmarkAppCfg.h"
+#include "KernelBenchmarkSuites.h"
+
+//! \ingroup KernelBenchmarkApp
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// kernel benchmark application class, checks every SIMD implementation against the scalar one and times both
+class KernelBenchmarkApp : public KernelBenchmarkAppCfg
+{
+public:
+  KernelBenchmarkApp();
+  virtual ~KernelBenchmarkApp() {}
+
+  int  run();   ///< main processing function, returns the number of mismatching kernels
+
+private:
+  bool   xSelectLevels( std::vector<KernelLevel> &levels ) const;
+  bool   xVerify      ( const KernelCase &kernelCase, std::vector<int> &mismatchLevels ) const;
+  bool   xEqual       ( const KernelCase &kernelCase, const uint8_t *reference ) const;
+  double xMeasure     ( const KernelCase &kernelCase, const int level ) const;   ///< returns ns per call
+};
+
+//! \}
+
+#endif  // __KERNELBENCHMARKAPP__
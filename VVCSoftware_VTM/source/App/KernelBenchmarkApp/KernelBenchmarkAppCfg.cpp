@@ -0,0 +1,133 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2023, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     KernelBenchmarkAppCfg.cpp
+    \brief    Kernel benchmark configuration class
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include "KernelBenchmarkAppCfg.h"
+#include "Utilities/program_options_lite.h"
+
+namespace po = ProgramOptionsLite;
+
+//! \ingroup KernelBenchmarkApp
+//! \{
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/** \param argc number of arguments
+    \param argv array of arguments
+ */
+bool KernelBenchmarkAppCfg::parseCfg( int argc, char* argv[] )
+{
+  bool do_help = false;
+  std::string bitDepths;
+  po::Options opts;
+
+  // clang-format off
+  opts.addOptions()
+  ("help",                      do_help,                               false,      "this help text")
+  ("Filter,f",                  m_filter,                              std::string(""), "only run the kernels whose name contains the given string")
+  ("BitDepths",                 bitDepths,                             std::string("8,10"), "comma separated list of sample bit depths to test")
+  ("MinTime",                   m_minTimeMs,                           10.0,       "minimum measurement time per kernel and SIMD level in ms")
+  ("SIMD",                      m_maxSimd,                             std::string(""), "highest SIMD level to test (SSE41, AVX, AVX2), default: highest level supported by the CPU")
+  ;
+  // clang-format on
+
+  po::setDefaults(opts);
+  po::ErrorReporter err;
+  const std::list<const char *> &argv_unhandled = po::scanArgv(opts, argc, (const char **) argv, err);
+
+  for (std::list<const char *>::const_iterator it = argv_unhandled.begin(); it != argv_unhandled.end(); it++)
+  {
+    std::cerr << "Unhandled argument ignored: "<< *it << std::endl;
+  }
+
+  if (do_help)
+  {
+    po::doHelp(std::cout, opts);
+    return false;
+  }
+
+  if (err.is_errored)
+  {
+    /* errors have already been reported to stderr */
+    return false;
+  }
+
+  m_bitDepths.clear();
+  std::istringstream bitDepthStream(bitDepths);
+  std::string        bitDepth;
+  while (std::getline(bitDepthStream, bitDepth, ','))
+  {
+    const int value = atoi(bitDepth.c_str());
+    if (value < 8 || value > 12)
+    {
+      std::cerr << "Unsupported bit depth " << bitDepth << ", aborting" << std::endl;
+      return false;
+    }
+    m_bitDepths.push_back(value);
+  }
+  if (m_bitDepths.empty())
+  {
+    std::cerr << "No bit depth specified, aborting" << std::endl;
+    return false;
+  }
+  if (m_minTimeMs <= 0)
+  {
+    std::cerr << "MinTime must be positive, aborting" << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+KernelBenchmarkAppCfg::KernelBenchmarkAppCfg()
+: m_filter()
+, m_bitDepths()
+, m_minTimeMs( 10.0 )
+, m_maxSimd()
+{
+}
+
+KernelBenchmarkAppCfg::~KernelBenchmarkAppCfg()
+{
+}
+
+//! \}
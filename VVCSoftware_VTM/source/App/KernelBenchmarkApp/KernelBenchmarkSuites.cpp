@@ -0,0 +1,1276 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2023, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     KernelBenchmarkSuites.cpp
+    \brief    Kernel test cases of the CommonLib modules
+*/
+
+#include "KernelBenchmarkSuites.h"
+
+#include "CommonLib/AdaptiveLoopFilter.h"
+#include "CommonLib/AffineGradientSearch.h"
+#include "CommonLib/Buffer.h"
+#include "CommonLib/CodingStructure.h"
+#include "CommonLib/InterpolationFilter.h"
+#include "CommonLib/IntraPrediction.h"
+#include "CommonLib/Mv.h"
+#include "CommonLib/RdCost.h"
+#include "CommonLib/Reshape.h"
+#include "CommonLib/TrQuant_EMT.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <tuple>
+#include <type_traits>
+
+//! \ingroup KernelBenchmarkApp
+//! \{
+
+namespace
+{
+// ====================================================================================================================
+// Helpers
+// ====================================================================================================================
+
+constexpr int MARGIN = 8;   // samples around each plane, covers the support of all filters
+
+std::mt19937 g_rng( 0x5eed );
+
+int randRange( const int lo, const int hi )
+{
+  return std::uniform_int_distribution<int>( lo, hi )( g_rng );
+}
+
+/// one or several equally sized sample planes with a margin, stored in one allocation so they can be compared at once
+template<typename T> struct Plane
+{
+  int            width;
+  int            height;
+  ptrdiff_t      stride;
+  size_t         planeSize;
+  std::vector<T> data;
+
+  Plane( const int w, const int h, const int num = 1 )
+    : width( w )
+    , height( h )
+    , stride( w + 2 * MARGIN )
+    , planeSize( stride * ( h + 2 * MARGIN ) )
+    , data( planeSize * num, T( 0 ) )
+  {
+  }
+
+  T *buf( const int idx = 0 ) { return data.data() + idx * planeSize + MARGIN * stride + MARGIN; }
+  size_t bytes() const { return data.size() * sizeof( T ); }
+
+  void fill( const int lo, const int hi )
+  {
+    for( auto &v: data )
+    {
+      v = T( randRange( lo, hi ) );
+    }
+  }
+  void fillPel( const int bd ) { fill( 0, ( 1 << bd ) - 1 ); }
+  void fillIntermediate( const int bd )
+  {
+    for( auto &v: data )
+    {
+      v = T( ( randRange( 0, ( 1 << bd ) - 1 ) << IF_INTERNAL_FRAC_BITS( bd ) ) - IF_INTERNAL_OFFS );
+    }
+  }
+};
+
+ClpRng makeClpRng( const int bd )
+{
+  ClpRng clpRng;
+  clpRng.min = 0;
+  clpRng.max = ( 1 << bd ) - 1;
+  clpRng.bd  = bd;
+  return clpRng;
+}
+
+std::string caseName( const std::string &kernel, const int w, const int h, const int bd )
+{
+  return kernel + " " + std::to_string( w ) + "x" + std::to_string( h ) + " bd" + std::to_string( bd );
+}
+
+/// levels with an own implementation: non-null and different from the scalar one
+template<typename F> std::vector<int> distinctLevels( const std::vector<F> &impl )
+{
+  std::vector<int> levels = { 0 };
+  for( int k = 1; k < (int) impl.size(); k++ )
+  {
+    if( impl[k] != nullptr && impl[k] != impl[0] )
+    {
+      levels.push_back( k );
+    }
+  }
+  return levels;
+}
+
+template<typename S, typename F> std::vector<F> gather( const std::vector<S> &objs, F S::*member )
+{
+  std::vector<F> impl;
+  for( const auto &obj: objs )
+  {
+    impl.push_back( obj.*member );
+  }
+  return impl;
+}
+
+/// calls init with the vext template argument matching the SIMD level, nothing is done for SCALAR
+template<typename Init> void dispatchLevel( const KernelLevel level, Init init )
+{
+#if ENABLE_SIMD_OPT && defined( TARGET_SIMD_X86 )
+  switch( level )
+  {
+  case SSE41:
+  case SSE42: init( std::integral_constant<X86_VEXT, SSE41>() ); break;
+  case AVX: init( std::integral_constant<X86_VEXT, AVX>() ); break;
+  case AVX2:
+  case AVX512: init( std::integral_constant<X86_VEXT, AVX2>() ); break;
+  default: break;
+  }
+#endif
+}
+
+void addCase( std::vector<KernelCase> &cases, const std::string &name, const std::vector<int> &levels,
+              std::function<void( int )> run, void *out, const size_t outSize,
+              std::function<void()> reset = nullptr )
+{
+  cases.push_back( KernelCase{ name, levels, run, reset, out, outSize } );
+}
+
+struct BlockCtx
+{
+  Plane<Pel> src0;
+  Plane<Pel> src1;
+  Plane<Pel> dst;
+
+  BlockCtx( const int w, const int h, const int numDst = 1 ) : src0( w, h ), src1( w, h ), dst( w, h, numDst ) {}
+};
+
+/// a PelBufferOps kernel pointer, the 4-sample variants are only used for block widths that are not a multiple of 8
+template<typename F> struct OpVariant
+{
+  const char *    name;
+  F PelBufferOps::*member;
+  int             width;
+};
+
+template<typename F> OpVariant<F> makeVariant( const char *name, F PelBufferOps::*member, const int width )
+{
+  return OpVariant<F>{ name, member, width };
+}
+
+const std::vector<Size> g_blockSizes = { Size( 8, 8 ), Size( 16, 16 ), Size( 64, 64 ) };
+
+/// exposes the tap indices of the filter tables
+class InterpolationFilterTaps : public InterpolationFilter
+{
+public:
+  static constexpr int TAPS_8    = _8_TAPS;
+  static constexpr int TAPS_4    = _4_TAPS;
+  static constexpr int TAPS_6    = _6_TAPS;
+  static constexpr int TAPS_DMVR = _2_TAPS_DMVR;
+};
+}   // namespace
+
+// ====================================================================================================================
+// PelBufferOps
+// ====================================================================================================================
+
+void addPelBufOpsCases( const KernelSuiteParam &param, std::vector<KernelCase> &cases )
+{
+  auto ops = std::make_shared<std::vector<PelBufferOps>>( param.levels.size() );
+  for( size_t k = 0; k < param.levels.size(); k++ )
+  {
+#if ENABLE_SIMD_OPT_BUFFER && defined( TARGET_SIMD_X86 )
+    PelBufferOps &op = ( *ops )[k];
+    dispatchLevel( param.levels[k], [&op]( auto vext ) { op._initPelBufOpsX86<decltype( vext )::value>(); } );
+#endif
+  }
+
+  for( const int bd: param.bitDepths )
+  {
+    const ClpRng clpRng = makeClpRng( bd );
+    const int    maxVal = ( 1 << bd ) - 1;
+
+    for( const auto &size: g_blockSizes )
+    {
+      const int w = size.width;
+      const int h = size.height;
+
+      // bi-prediction average and reconstruction
+      for( const auto &op: { makeVariant( "addAvg4", &PelBufferOps::addAvg4, 4 ), makeVariant( "addAvg8", &PelBufferOps::addAvg8, w ) } )
+      {
+        const int width = op.width;
+        auto ctx = std::make_shared<BlockCtx>( width, h );
+        ctx->src0.fillIntermediate( bd );
+        ctx->src1.fillIntermediate( bd );
+        const int shift  = IF_INTERNAL_FRAC_BITS( bd ) + 1;
+        const int offset = ( 1 << ( shift - 1 ) ) + 2 * IF_INTERNAL_OFFS;
+        const auto impl  = gather( *ops, op.member );
+        addCase( cases, caseName( op.name, width, h, bd ), distinctLevels( impl ),
+                 [=]( int k ) { impl[k]( ctx->src0.buf(), ctx->src0.stride, ctx->src1.buf(), ctx->src1.stride, ctx->dst.buf(), ctx->dst.stride, width, h, shift, offset, clpRng ); },
+                 ctx->dst.data.data(), ctx->dst.bytes() );
+      }
+      for( const auto &op: { makeVariant( "reco4", &PelBufferOps::reco4, 4 ), makeVariant( "reco8", &PelBufferOps::reco8, w ) } )
+      {
+        const int width = op.width;
+        auto ctx = std::make_shared<BlockCtx>( width, h );
+        ctx->src0.fillPel( bd );
+        ctx->src1.fill( -maxVal, maxVal );
+        const auto impl = gather( *ops, op.member );
+        addCase( cases, caseName( op.name, width, h, bd ), distinctLevels( impl ),
+                 [=]( int k ) { impl[k]( ctx->src0.buf(), ctx->src0.stride, ctx->src1.buf(), ctx->src1.stride, ctx->dst.buf(), ctx->dst.stride, width, h, clpRng ); },
+                 ctx->dst.data.data(), ctx->dst.bytes() );
+      }
+
+      // linear transform, with clipping as used by weighted prediction and without
+      for( const auto &op: { makeVariant( "linTf4", &PelBufferOps::linTf4, 4 ), makeVariant( "linTf8", &PelBufferOps::linTf8, w ) } )
+      {
+        const int width = op.width;
+        for( const bool clip: { true, false } )
+        {
+          auto ctx = std::make_shared<BlockCtx>( width, h );
+          ctx->src0.fillPel( bd );
+          const int  scale  = clip ? 25 : 1;
+          const int  shift  = clip ? 5 : 0;
+          const int  offset = clip ? -7 : -( 1 << ( bd - 1 ) );
+          const auto impl   = gather( *ops, op.member );
+          addCase( cases, caseName( std::string( op.name ) + ( clip ? " clip" : "" ), width, h, bd ), distinctLevels( impl ),
+                   [=]( int k ) { impl[k]( ctx->src0.buf(), ctx->src0.stride, ctx->dst.buf(), ctx->dst.stride, width, h, scale, shift, offset, clpRng, clip ); },
+                   ctx->dst.data.data(), ctx->dst.bytes() );
+        }
+      }
+
+      // BCW and explicit weighted prediction, bi-prediction with the intermediate offsets folded into the rounding
+      for( const auto &op: { makeVariant( "addWeightedAvg4", &PelBufferOps::addWeightedAvg4, 4 ), makeVariant( "addWeightedAvg8", &PelBufferOps::addWeightedAvg8, w ) } )
+      {
+        const int width = op.width;
+        for( const auto &weights: { std::make_pair( -2, 10 ), std::make_pair( 45, 83 ) } )
+        {
+          auto ctx = std::make_shared<BlockCtx>( width, h );
+          ctx->src0.fillIntermediate( bd );
+          ctx->src1.fillIntermediate( bd );
+          const int  w0     = weights.first;
+          const int  w1     = weights.second;
+          const int  shift  = IF_INTERNAL_FRAC_BITS( bd ) + ( w0 < 0 ? BCW_LOG2_WEIGHT_BASE : 7 );
+          const int  offset = ( w0 + w1 ) * IF_INTERNAL_OFFS + ( 1 << ( shift - 1 ) ) + ( w0 < 0 ? 0 : -9 * ( 1 << ( shift - 1 ) ) );
+          const auto impl   = gather( *ops, op.member );
+          addCase( cases, caseName( std::string( op.name ) + " w" + std::to_string( w0 ) + "," + std::to_string( w1 ), width, h, bd ), distinctLevels( impl ),
+                   [=]( int k ) { impl[k]( ctx->src0.buf(), ctx->src0.stride, ctx->src1.buf(), ctx->src1.stride, ctx->dst.buf(), ctx->dst.stride, width, h, w0, w1, shift, offset, clpRng ); },
+                   ctx->dst.data.data(), ctx->dst.bytes() );
+        }
+      }
+      for( const auto &op: { makeVariant( "weightUni4", &PelBufferOps::weightUni4, 4 ), makeVariant( "weightUni8", &PelBufferOps::weightUni8, w ) } )
+      {
+        const int width = op.width;
+        for( const int w0: { 1, 107 } )
+        {
+          auto ctx = std::make_shared<BlockCtx>( width, h );
+          ctx->src0.fillIntermediate( bd );
+          const int  shift      = IF_INTERNAL_FRAC_BITS( bd ) + ( w0 == 1 ? 0 : 6 );
+          const int  offset     = w0 * IF_INTERNAL_OFFS + ( 1 << shift >> 1 );
+          const int  postOffset = w0 == 1 ? 0 : -13;
+          const auto impl       = gather( *ops, op.member );
+          addCase( cases, caseName( std::string( op.name ) + " w" + std::to_string( w0 ), width, h, bd ), distinctLevels( impl ),
+                   [=]( int k ) { impl[k]( ctx->src0.buf(), ctx->src0.stride, ctx->dst.buf(), ctx->dst.stride, width, h, w0, shift, offset, postOffset, clpRng ); },
+                   ctx->dst.data.data(), ctx->dst.bytes() );
+        }
+      }
+
+      // block copy and in-place padding
+      {
+        auto ctx = std::make_shared<BlockCtx>( w, h );
+        ctx->src0.fillPel( bd );
+        const auto impl = gather( *ops, &PelBufferOps::copyBuffer );
+        addCase( cases, caseName( "copyBuffer", w, h, bd ), distinctLevels( impl ),
+                 [=]( int k ) { impl[k]( ctx->src0.buf(), ctx->src0.stride, ctx->dst.buf(), ctx->dst.stride, w, h ); },
+                 ctx->dst.data.data(), ctx->dst.bytes() );
+      }
+      for( const int padSize: { 1, 2 } )
+      {
+        auto ctx = std::make_shared<BlockCtx>( w, h );
+        ctx->src0.fillPel( bd );
+        const auto impl = gather( *ops, &PelBufferOps::padding );
+        addCase( cases, caseName( "padding" + std::to_string( padSize ), w, h, bd ), distinctLevels( impl ),
+                 [=]( int k ) { impl[k]( ctx->dst.buf(), ctx->dst.stride, w, h, padSize ); },
+                 ctx->dst.data.data(), ctx->dst.bytes(),
+                 [=]() { ctx->dst.data = ctx->src0.data; } );
+      }
+
+#if ENABLE_SIMD_OPT_BCW
+      // BCW high frequency removal, the scalar implementations are the AreaBuf fallbacks
+      for( const auto &op: { makeVariant( "removeWeightHighFreq4", &PelBufferOps::removeWeightHighFreq4, 4 ), makeVariant( "removeWeightHighFreq8", &PelBufferOps::removeWeightHighFreq8, w ) } )
+      {
+        const int width = op.width;
+        for( const int8_t bcwWeight: { int8_t( -2 ), int8_t( 5 ) } )
+        {
+          auto ctx = std::make_shared<BlockCtx>( width, h );
+          ctx->src0.fillPel( bd );
+          ctx->src1.fillPel( bd );
+          const auto impl = gather( *ops, op.member );
+          addCase( cases, caseName( std::string( op.name ) + " w" + std::to_string( bcwWeight ), width, h, bd ), distinctLevels( impl ),
+                   [=]( int k )
+                   {
+                     if( k == 0 )
+                     {
+                       PelBuf( ctx->dst.buf(), ctx->dst.stride, width, h ).removeWeightHighFreq( PelBuf( ctx->src1.buf(), ctx->src1.stride, width, h ), true, clpRng, bcwWeight );
+                     }
+                     else
+                     {
+                       impl[k]( ctx->dst.buf(), ctx->dst.stride, ctx->src1.buf(), ctx->src1.stride, width, h, bcwWeight, clpRng.min, clpRng.max );
+                     }
+                   },
+                   ctx->dst.data.data(), ctx->dst.bytes(),
+                   [=]() { ctx->dst.data = ctx->src0.data; } );
+        }
+      }
+      for( const auto &op: { makeVariant( "removeHighFreq4", &PelBufferOps::removeHighFreq4, 4 ), makeVariant( "removeHighFreq8", &PelBufferOps::removeHighFreq8, w ) } )
+      {
+        const int width = op.width;
+        auto ctx = std::make_shared<BlockCtx>( width, h );
+        ctx->src0.fillPel( bd );
+        ctx->src1.fillPel( bd );
+        const auto impl = gather( *ops, op.member );
+        addCase( cases, caseName( op.name, width, h, bd ), distinctLevels( impl ),
+                 [=]( int k )
+                 {
+                   if( k == 0 )
+                   {
+                     PelBuf( ctx->dst.buf(), ctx->dst.stride, width, h ).removeHighFreq( PelBuf( ctx->src1.buf(), ctx->src1.stride, width, h ), false, clpRng );
+                   }
+                   else
+                   {
+                     impl[k]( ctx->dst.buf(), ctx->dst.stride, ctx->src1.buf(), ctx->src1.stride, width, h );
+                   }
+                 },
+                 ctx->dst.data.data(), ctx->dst.bytes(),
+                 [=]() { ctx->dst.data = ctx->src0.data; } );
+      }
+#endif
+
+      // chroma residual scaling, in place
+      for( const auto &op: { makeVariant( "crsInv4", &PelBufferOps::crsInv4, 4 ), makeVariant( "crsInv8", &PelBufferOps::crsInv8, w ) } )
+      {
+        const int width = op.width;
+        auto ctx = std::make_shared<BlockCtx>( width, h );
+        ctx->src0.fill( -maxVal, maxVal );
+        const int  scale = randRange( 1 << ( CSCALE_FP_PREC - 1 ), 1 << ( CSCALE_FP_PREC + 1 ) );
+        const auto impl  = gather( *ops, op.member );
+        addCase( cases, caseName( op.name, width, h, bd ), distinctLevels( impl ),
+                 [=]( int k ) { impl[k]( ctx->dst.buf(), ctx->dst.stride, width, h, scale, clpRng ); },
+                 ctx->dst.data.data(), ctx->dst.bytes(),
+                 [=]() { ctx->dst.data = ctx->src0.data; } );
+      }
+    }
+
+    // LMCS mapping with a model of alternating bin code words
+    {
+      auto reshape = std::make_shared<Reshape>();
+      reshape->createDec( bd );
+      SliceReshapeInfo &info = reshape->getSliceReshaperInfo();
+      const int         initCW = ( 1 << bd ) / PIC_CODE_CW_BINS;
+      info.setUseSliceReshaper( true );
+      info.reshaperModelMinBinIdx = 1;
+      info.reshaperModelMaxBinIdx = PIC_CODE_CW_BINS - 2;
+      info.chrResScalingOffset    = 0;
+      for( int i = 0; i < PIC_CODE_CW_BINS; i++ )
+      {
+        info.reshaperModelBinCWDelta[i] = ( i & 1 ) ? -initCW / 4 : initCW / 4;
+      }
+      reshape->constructReshaper();
+
+      for( const bool inverse: { false, true } )
+      {
+        if( !( inverse ? reshape->getInvPwl() : reshape->getFwdPwl() ).valid )
+        {
+          continue;
+        }
+        for( const auto &size: g_blockSizes )
+        {
+          for( const auto &op: { makeVariant( "rspPwl4", &PelBufferOps::rspPwl4, 4 ), makeVariant( "rspPwl8", &PelBufferOps::rspPwl8, size.width ) } )
+          {
+            const int width = op.width;
+            const int h     = size.height;
+            auto      ctx   = std::make_shared<BlockCtx>( width, h );
+            ctx->src0.fillPel( bd );
+            const auto impl = gather( *ops, op.member );
+            addCase( cases, caseName( std::string( op.name ) + ( inverse ? " inv" : " fwd" ), width, h, bd ), distinctLevels( impl ),
+                     [ctx, impl, reshape, inverse, width, h]( int k )
+                     {
+                       const ReshapePwl &pwl = inverse ? reshape->getInvPwl() : reshape->getFwdPwl();
+                       impl[k]( ctx->src0.buf(), ctx->src0.stride, ctx->dst.buf(), ctx->dst.stride, width, h, pwl );
+                     },
+                     ctx->dst.data.data(), ctx->dst.bytes() );
+          }
+        }
+      }
+    }
+
+    // BDOF: gradients, sums and the final average
+    for( const int inner: { 4, 8, 16, 64 } )
+    {
+      const int  w    = inner + 2 * BIO_EXTEND_SIZE;
+      auto       ctx  = std::make_shared<BlockCtx>( w, w, 2 );
+      ctx->src0.fillIntermediate( bd );
+      const auto impl = gather( *ops, &PelBufferOps::bioGradFilter );
+      addCase( cases, caseName( "bioGradFilter", w, w, bd ), distinctLevels( impl ),
+               [=]( int k ) { impl[k]( ctx->src0.buf(), ctx->src0.stride, w, w, ctx->dst.stride, ctx->dst.buf( 0 ), ctx->dst.buf( 1 ), bd ); },
+               ctx->dst.data.data(), ctx->dst.bytes() );
+    }
+    for( const int size: { 8, 16 } )
+    {
+      // one gradient buffer of widthG x heightG per list and direction, the same layout as in applyBiOptFlow()
+      struct BioSumsCtx
+      {
+        Plane<Pel>       src0, src1;
+        std::vector<Pel> grad[4];
+        std::vector<int> sums;
+        BioSumsCtx( const int widthG ) : src0( widthG, widthG ), src1( widthG, widthG ) {}
+      };
+      const int widthG = size + 2 * BIO_EXTEND_SIZE;
+      const int units  = ( size >> 2 ) * ( size >> 2 );
+      auto      ctx    = std::make_shared<BioSumsCtx>( widthG );
+      ctx->src0.fillIntermediate( bd );
+      ctx->src1.fillIntermediate( bd );
+      for( auto &grad: ctx->grad )
+      {
+        grad.resize( widthG * widthG + MARGIN * widthG );
+        for( auto &v: grad )
+        {
+          v = Pel( randRange( -256, 256 ) );
+        }
+      }
+      ctx->sums.resize( 5 * units );
+      const auto impl = gather( *ops, &PelBufferOps::calcBIOSums );
+      addCase( cases, caseName( "calcBIOSums", size, size, bd ), distinctLevels( impl ),
+               [=]( int k )
+               {
+                 int *sums = ctx->sums.data();
+                 for( int yu = 0; yu < ( size >> 2 ); yu++ )
+                 {
+                   for( int xu = 0; xu < ( size >> 2 ); xu++, sums += 5 )
+                   {
+                     const ptrdiff_t gradOffset = ( xu << 2 ) + ( yu << 2 ) * widthG;
+                     std::fill_n( sums, 5, 0 );
+                     impl[k]( ctx->src0.buf() + ( xu << 2 ) + ( yu << 2 ) * ctx->src0.stride,
+                              ctx->src1.buf() + ( xu << 2 ) + ( yu << 2 ) * ctx->src1.stride,
+                              ctx->grad[0].data() + gradOffset, ctx->grad[1].data() + gradOffset,
+                              ctx->grad[2].data() + gradOffset, ctx->grad[3].data() + gradOffset, xu, yu,
+                              ctx->src0.stride, ctx->src1.stride, widthG, bd, sums, sums + 1, sums + 2, sums + 3, sums + 4 );
+                   }
+                 }
+               },
+               ctx->sums.data(), ctx->sums.size() * sizeof( int ) );
+    }
+    for( const int size: { 4, 16 } )
+    {
+      struct BioAvgCtx : BlockCtx
+      {
+        Plane<Pel> grad;
+        BioAvgCtx( const int s ) : BlockCtx( s, s ), grad( s, s, 4 ) {}
+      };
+      auto ctx = std::make_shared<BioAvgCtx>( size );
+      ctx->src0.fillIntermediate( bd );
+      ctx->src1.fillIntermediate( bd );
+      ctx->grad.fill( -256, 256 );
+      const int  tmpx   = randRange( -15, 15 );
+      const int  tmpy   = randRange( -15, 15 );
+      const int  shift  = IF_INTERNAL_FRAC_BITS( bd ) + 1;
+      const int  offset = ( 1 << ( shift - 1 ) ) + 2 * IF_INTERNAL_OFFS;
+      const auto impl   = gather( *ops, &PelBufferOps::addBIOAvg4 );
+      addCase( cases, caseName( "addBIOAvg4", size, size, bd ), distinctLevels( impl ),
+               [=]( int k ) { impl[k]( ctx->src0.buf(), ctx->src0.stride, ctx->src1.buf(), ctx->src1.stride, ctx->dst.buf(), ctx->dst.stride,
+                                       ctx->grad.buf( 0 ), ctx->grad.buf( 1 ), ctx->grad.buf( 2 ), ctx->grad.buf( 3 ), ctx->grad.stride,
+                                       size, size, tmpx, tmpy, shift, offset, clpRng ); },
+               ctx->dst.data.data(), ctx->dst.bytes() );
+    }
+
+    // PROF on one affine sub-block
+    {
+      const int  sizeExt = AFFINE_SUBBLOCK_SIZE + 2 * PROF_BORDER_EXT_W;
+      auto       ctx     = std::make_shared<BlockCtx>( sizeExt, sizeExt, 2 );
+      ctx->src0.fillIntermediate( bd );
+      const auto impl = gather( *ops, &PelBufferOps::profGradFilter );
+      addCase( cases, caseName( "profGradFilter", sizeExt, sizeExt, bd ), distinctLevels( impl ),
+               [=]( int k ) { impl[k]( ctx->src0.buf(), ctx->src0.stride, sizeExt, sizeExt, ctx->dst.stride, ctx->dst.buf( 0 ), ctx->dst.buf( 1 ), bd ); },
+               ctx->dst.data.data(), ctx->dst.bytes() );
+    }
+    for( const bool bi: { false, true } )
+    {
+      struct ProfCtx : BlockCtx
+      {
+        Plane<Pel> grad;
+        int        dMv[2][AFFINE_SUBBLOCK_SIZE * AFFINE_SUBBLOCK_SIZE];
+        ProfCtx() : BlockCtx( AFFINE_SUBBLOCK_SIZE, AFFINE_SUBBLOCK_SIZE ), grad( AFFINE_SUBBLOCK_SIZE, AFFINE_SUBBLOCK_SIZE, 2 ) {}
+      };
+      const int size = AFFINE_SUBBLOCK_SIZE;
+      auto      ctx  = std::make_shared<ProfCtx>();
+      ctx->src0.fillIntermediate( bd );
+      ctx->grad.fill( -256, 256 );
+      for( auto &dMv: ctx->dMv )
+      {
+        for( auto &v: dMv )
+        {
+          v = randRange( -31, 31 );
+        }
+      }
+      const int  shift  = IF_INTERNAL_FRAC_BITS( bd );
+      const Pel  offset = ( 1 << shift >> 1 ) + IF_INTERNAL_OFFS;
+      const auto impl   = gather( *ops, &PelBufferOps::applyPROF );
+      addCase( cases, caseName( bi ? "applyPROF bi" : "applyPROF", size, size, bd ), distinctLevels( impl ),
+               [=]( int k ) { impl[k]( ctx->dst.buf(), ctx->dst.stride, ctx->src0.buf(), ctx->src0.stride, size, size, ctx->grad.buf( 0 ), ctx->grad.buf( 1 ),
+                                       ctx->grad.stride, ctx->dMv[0], ctx->dMv[1], size, bi, shift, offset, clpRng ); },
+               ctx->dst.data.data(), ctx->dst.bytes() );
+    }
+  }
+
+  // motion vector refinement rounding of PROF, the scalar implementation is the loop in xPredAffineBlk()
+  {
+    struct RoundCtx
+    {
+      std::vector<int> orig, v;
+    };
+    const int      size     = AFFINE_SUBBLOCK_SIZE * AFFINE_SUBBLOCK_SIZE;
+    const int      mvShift  = 7;
+    const int      dmvLimit = ( 1 << 5 ) - 1;
+    auto           ctx      = std::make_shared<RoundCtx>();
+    for( int i = 0; i < size; i++ )
+    {
+      ctx->orig.push_back( randRange( -( 1 << 13 ), 1 << 13 ) );
+    }
+    ctx->v          = ctx->orig;
+    const auto impl = gather( *ops, &PelBufferOps::roundIntVector );
+    addCase( cases, "roundIntVector " + std::to_string( size ), distinctLevels( impl ),
+             [=]( int k )
+             {
+               if( k == 0 )
+               {
+                 for( auto &v: ctx->v )
+                 {
+                   Mv tmpMv( v, 0 );
+                   tmpMv >>= mvShift;
+                   v = Clip3( -dmvLimit, dmvLimit, tmpMv.getHor() );
+                 }
+               }
+               else
+               {
+                 impl[k]( ctx->v.data(), size, mvShift, dmvLimit );
+               }
+             },
+             ctx->v.data(), ctx->v.size() * sizeof( int ),
+             [=]() { ctx->v = ctx->orig; } );
+  }
+}
+
+// ====================================================================================================================
+// RdCost
+// ====================================================================================================================
+
+void addRdCostCases( const KernelSuiteParam &param, std::vector<KernelCase> &cases )
+{
+  typedef Distortion ( *DistPtr )( const DistParam & );
+
+  // the distortion tables are static, copy them after initializing each level
+  RdCost rdCost;
+  auto   distFuncs = std::make_shared<std::vector<EnumArray<DistFunc, DFunc>>>( param.levels.size() );
+  std::vector<DistFuncX4>   sadX4( param.levels.size() );
+  std::vector<DistFuncDmvr> sadDmvr( param.levels.size() );
+  std::vector<DistFuncMulti> sadMaskMulti( param.levels.size() );
+  std::vector<DistFuncPlane>   planeSse( param.levels.size() );
+  std::vector<SsimFuncWindows> ssimWindows( param.levels.size() );
+  for( size_t k = 0; k < param.levels.size(); k++ )
+  {
+#if ENABLE_SIMD_OPT_DIST && defined( TARGET_SIMD_X86 )
+    dispatchLevel( param.levels[k], [&rdCost]( auto vext ) { rdCost._initRdCostX86<decltype( vext )::value>(); } );
+#endif
+    for( int f = 0; f < to_underlying( DFunc::NUM ); f++ )
+    {
+      ( *distFuncs )[k][DFunc( f )] = RdCost::getDistFunc( DFunc( f ) );
+    }
+    sadX4[k]   = RdCost::getSADX4Func();
+    sadDmvr[k] = RdCost::getSADDmvrFunc();
+    sadMaskMulti[k] = RdCost::getSADwMaskMultiFunc();
+    planeSse[k]     = RdCost::getPlaneSSEFunc();
+    ssimWindows[k]  = RdCost::getSSIMWindowsFunc();
+  }
+
+  // the weighted SSE uses the luma level weights of the highest bit depth, kept alive by each case using them
+  const int maxBitDepth = *std::max_element( param.bitDepths.begin(), param.bitDepths.end() );
+  auto      wtdRdCost   = std::make_shared<RdCost>();
+  wtdRdCost->setReshapeInfo( RESHAPE_SIGNAL_PQ, maxBitDepth );
+  wtdRdCost->initLumaLevelToWeightTableReshape();
+
+  auto levelsOf = [&]( const DFunc dFunc )
+  {
+    std::vector<DistPtr> impl;
+    for( const auto &funcs: *distFuncs )
+    {
+      const DistPtr *ptr = funcs[dFunc].target<DistPtr>();
+      impl.push_back( ptr ? *ptr : nullptr );
+    }
+    return distinctLevels( impl );
+  };
+
+  struct DistCtx
+  {
+    Plane<Pel>              org, cur, mask;
+    DistParam               dp;
+    std::vector<Distortion> dist;
+    std::shared_ptr<RdCost> rdCost;
+    DistCtx( const int w, const int h ) : org( w, h ), cur( w, h, 4 ), mask( 64, 64 ), dist( 4 ) {}
+  };
+
+  auto makeCtx = [wtdRdCost]( const int w, const int h, const int bd, const bool intermediate )
+  {
+    auto ctx = std::make_shared<DistCtx>( w, h );
+    if( intermediate )
+    {
+      ctx->org.fillIntermediate( bd );
+      ctx->cur.fillIntermediate( bd );
+    }
+    else
+    {
+      ctx->org.fillPel( bd );
+      ctx->cur.fillPel( bd );
+    }
+    ctx->dp.org      = CPelBuf( ctx->org.buf(), ctx->org.stride, w, h );
+    ctx->dp.cur      = CPelBuf( ctx->cur.buf(), ctx->cur.stride, w, h );
+    ctx->dp.orgLuma  = ctx->dp.org;
+    ctx->rdCost      = wtdRdCost;
+    ctx->dp.rdCost   = wtdRdCost.get();
+    ctx->dp.cShiftX  = 0;
+    ctx->dp.cShiftY  = 0;
+    ctx->dp.bitDepth = bd;
+    ctx->dp.compID   = COMPONENT_Y;
+    return ctx;
+  };
+
+  auto addDistCase = [&]( const std::string &name, const DFunc dFunc, std::shared_ptr<DistCtx> ctx )
+  {
+    addCase( cases, caseName( name, ctx->org.width, ctx->org.height, ctx->dp.bitDepth ), levelsOf( dFunc ),
+             [=]( int k ) { ctx->dist[0] = ( *distFuncs )[k][dFunc]( ctx->dp ); },
+             ctx->dist.data(), sizeof( Distortion ) );
+  };
+
+  const std::vector<std::pair<const char *, DFunc>> families = {
+    { "SSE", DFunc::SSE },     { "SAD", DFunc::SAD },     { "HAD", DFunc::HAD },
+    { "MRSAD", DFunc::MRSAD }, { "MRHAD", DFunc::MRHAD }, { "SAD_FULL_NBIT", DFunc::SAD_FULL_NBIT },
+    { "SSE_WTD", DFunc::SSE_WTD }
+  };
+  const std::vector<Size> sizes = { Size( 12, 12 ), Size( 2, 2 ),   Size( 4, 4 ),   Size( 8, 8 ),
+                                    Size( 16, 16 ), Size( 32, 32 ), Size( 64, 64 ), Size( 96, 16 ) };
+
+  for( const int bd: param.bitDepths )
+  {
+    for( const auto &family: families )
+    {
+      for( int i = 0; i < (int) sizes.size(); i++ )
+      {
+        auto       ctx      = makeCtx( sizes[i].width, sizes[i].height, bd, false );
+        ctx->dp.useMR       = family.second == DFunc::MRSAD || family.second == DFunc::MRHAD;
+        addDistCase( family.first, family.second + static_cast<DFuncDiff>( i ), ctx );
+      }
+    }
+    for( const auto &odd: { std::make_pair( 12, 0 ), std::make_pair( 24, 1 ), std::make_pair( 48, 2 ) } )
+    {
+      addDistCase( "SAD", DFunc::SAD12 + static_cast<DFuncDiff>( odd.second ), makeCtx( odd.first, 16, bd, false ) );
+      auto ctx      = makeCtx( odd.first, 16, bd, false );
+      ctx->dp.useMR = true;
+      addDistCase( "MRSAD", DFunc::MRSAD12 + static_cast<DFuncDiff>( odd.second ), ctx );
+    }
+    addDistCase( "SAD_INTERMEDIATE_BITDEPTH", DFunc::SAD_INTERMEDIATE_BITDEPTH, makeCtx( 16, 16, bd, true ) );
+
+    // GPM mask, normal and horizontally mirrored as set up in EncCu::xCheckRDCostMergeGeo2Nx2N()
+    for( const bool mirror: { false, true } )
+    {
+      const int w   = 16;
+      auto      ctx = makeCtx( w, w, bd, false );
+      ctx->mask.fill( 0, 1 );
+      ctx->dp.mask        = mirror ? ctx->mask.buf() + w - 1 : ctx->mask.buf();
+      ctx->dp.maskStride  = ctx->mask.stride;
+      ctx->dp.stepX       = mirror ? -1 : 1;
+      ctx->dp.maskStride2 = mirror ? w : -w;
+      addDistCase( mirror ? "SAD_WITH_MASK mirror" : "SAD_WITH_MASK", DFunc::SAD_WITH_MASK, ctx );
+    }
+
+    // all GPM merge candidates under the mask of one split direction as in EncCu::prepareGpmComboList()
+    for( const int w: { 8, 16, 32 } )
+    {
+      for( const bool mirror: { false, true } )
+      {
+        auto ctx   = makeCtx( w, w, bd, false );
+        auto cands = std::make_shared<Plane<Pel>>( w, w, GEO_MAX_NUM_UNI_CANDS );
+        cands->fillPel( bd );
+        ctx->mask.fill( 0, 1 );
+        ctx->dp.cur         = CPelBuf( cands->buf(), cands->stride, w, w );
+        ctx->dp.mask        = mirror ? ctx->mask.buf() + w - 1 : ctx->mask.buf();
+        ctx->dp.maskStride  = ctx->mask.stride;
+        ctx->dp.stepX       = mirror ? -1 : 1;
+        ctx->dp.maskStride2 = mirror ? w : -w;
+        ctx->dist.resize( GEO_MAX_NUM_UNI_CANDS );
+        addCase( cases, caseName( mirror ? "SAD_WITH_MASK multi mirror" : "SAD_WITH_MASK multi", w, w, bd ),
+                 distinctLevels( sadMaskMulti ),
+                 [=]( int k )
+                 {
+                   const Pel *cur[GEO_MAX_NUM_UNI_CANDS];
+                   for( int i = 0; i < GEO_MAX_NUM_UNI_CANDS; i++ )
+                   {
+                     cur[i] = cands->buf( i );
+                   }
+                   sadMaskMulti[k]( ctx->dp, cur, GEO_MAX_NUM_UNI_CANDS, ctx->dist.data() );
+                 },
+                 ctx->dist.data(), ctx->dist.size() * sizeof( Distortion ) );
+      }
+    }
+
+    // four candidates at once as used by RdCost::getSADMulti()
+    for( const auto &size: { Size( 8, 8 ), Size( 16, 16 ), Size( 32, 32 ), Size( 64, 64 ), Size( 12, 16 ) } )
+    {
+      auto ctx = makeCtx( size.width, size.height, bd, false );
+      addCase( cases, caseName( "SADX4", size.width, size.height, bd ), distinctLevels( sadX4 ),
+               [=]( int k )
+               {
+                 const Pel *cur[4] = { ctx->cur.buf( 0 ), ctx->cur.buf( 1 ), ctx->cur.buf( 2 ), ctx->cur.buf( 3 ) };
+                 sadX4[k]( ctx->dp, cur, ctx->dist.data() );
+               },
+               ctx->dist.data(), ctx->dist.size() * sizeof( Distortion ) );
+    }
+  }
+
+  // whole planes and MS-SSIM window rows as in EncGOP::xCalculateAddPSNR(), odd widths exercise the tails
+  for( const int bd: param.bitDepths )
+  {
+    for( const auto &size: { Size( 256, 144 ), Size( 1920, 8 ), Size( 90, 36 ) } )
+    {
+      auto ctx = makeCtx( size.width, size.height, bd, false );
+      addCase( cases, caseName( "SSE plane", size.width, size.height, bd ), distinctLevels( planeSse ),
+               [=]( int k )
+               {
+                 ctx->dist[0] = planeSse[k]( ctx->dp.org.buf, ctx->dp.org.stride, ctx->dp.cur.buf, ctx->dp.cur.stride,
+                                             size.width, size.height );
+               },
+               ctx->dist.data(), sizeof( Distortion ) );
+    }
+
+    for( const int numWindows: { 64, 61 } )
+    {
+      for( const bool luminance: { false, true } )
+      {
+        struct SsimCtx
+        {
+          Plane<double>       org, rec;
+          std::vector<double> weights, ssim;
+          SsimCtx( const int w )
+            : org( w, SSIM_WINDOW_SIZE ), rec( w, SSIM_WINDOW_SIZE ), weights( SSIM_WINDOW_SIZE * SSIM_WINDOW_SIZE )
+            , ssim( w )
+          {
+          }
+        };
+        auto ctx = std::make_shared<SsimCtx>( numWindows + SSIM_WINDOW_SIZE - 1 );
+        ctx->org.fillPel( bd );
+        ctx->rec.fillPel( bd );
+        for( auto &w: ctx->weights )
+        {
+          w = randRange( 1, 1000 ) / ( 1000.0 * SSIM_WINDOW_SIZE * SSIM_WINDOW_SIZE );
+        }
+        const double maxValue = ( 1 << bd ) - 1;
+        const double c1       = ( 0.01 * maxValue ) * ( 0.01 * maxValue );
+        const double c2       = ( 0.03 * maxValue ) * ( 0.03 * maxValue );
+        addCase( cases, caseName( luminance ? "SSIM windows luminance" : "SSIM windows", numWindows, SSIM_WINDOW_SIZE, bd ),
+                 distinctLevels( ssimWindows ),
+                 [=]( int k )
+                 {
+                   ssimWindows[k]( ctx->org.buf(), ctx->rec.buf(), ctx->org.stride, ctx->weights.data(), numWindows, c1,
+                                   c2, luminance, ctx->ssim.data() );
+                 },
+                 ctx->ssim.data(), numWindows * sizeof( double ) );
+      }
+    }
+  }
+
+  // DMVR search window on the row-subsampled bilinear intermediates of InterPrediction::xDmvrIntegerRefine(), the
+  // plane margin covers the search range
+  for( const auto &size: { Size( 8, 8 ), Size( 16, 8 ), Size( 8, 16 ), Size( 16, 16 ) } )
+  {
+    const int bd  = IF_INTERNAL_PREC_BILINEAR;
+    auto      ctx = makeCtx( size.width, size.height, bd, false );
+    ctx->dist.resize( DMVR_AREA );
+    ctx->dp.subShift = 1;
+    addCase( cases, caseName( "SAD_DMVR", size.width, size.height, bd ), distinctLevels( sadDmvr ),
+             [=]( int k ) { sadDmvr[k]( ctx->dp, ctx->dist.data() ); }, ctx->dist.data(),
+             ctx->dist.size() * sizeof( Distortion ) );
+  }
+}
+
+// ====================================================================================================================
+// InterpolationFilter
+// ====================================================================================================================
+
+void addInterpolationFilterCases( const KernelSuiteParam &param, std::vector<KernelCase> &cases )
+{
+  typedef InterpolationFilterTaps IF;
+
+  auto filters = std::make_shared<std::vector<InterpolationFilter>>( param.levels.size() );
+  for( size_t k = 0; k < param.levels.size(); k++ )
+  {
+#if ENABLE_SIMD_OPT_MCIF && defined( TARGET_SIMD_X86 )
+    InterpolationFilter &filter = ( *filters )[k];
+    dispatchLevel( param.levels[k], [&filter]( auto vext ) { filter._initInterpolationFilterX86<decltype( vext )::value>(); } );
+#endif
+  }
+
+  static const TFilterCoeff coeff6[6]    = { 3, -11, 40, 40, -11, 3 };
+  static const TFilterCoeff coeffDmvr[2] = { 8, 8 };
+
+  const std::vector<std::tuple<const char *, int, const TFilterCoeff *>> taps = {
+    std::make_tuple( "8tap", IF::TAPS_8, InterpolationFilter::m_lumaFilter[4] ),
+    std::make_tuple( "4tap", IF::TAPS_4, InterpolationFilter::m_chromaFilter[8] ),
+    std::make_tuple( "6tap", IF::TAPS_6, coeff6 ),
+    std::make_tuple( "2tapDMVR", IF::TAPS_DMVR, coeffDmvr )
+  };
+
+  for( const int bd: param.bitDepths )
+  {
+    const ClpRng clpRng = makeClpRng( bd );
+
+    for( const auto &size: { Size( 4, 4 ), Size( 16, 16 ), Size( 64, 64 ) } )
+    {
+      const int w = size.width;
+      const int h = size.height;
+
+      for( const auto &tap: taps )
+      {
+        for( const bool isVer: { false, true } )
+        {
+          for( int isFirst = 0; isFirst < 2; isFirst++ )
+          {
+            for( int isLast = 0; isLast < 2; isLast++ )
+            {
+              // only the combinations used by InterPrediction: the horizontal pass always comes first and the
+              // bilinear DMVR filter never produces the final samples
+              if( ( !isVer && !isFirst ) || ( std::get<1>( tap ) == IF::TAPS_DMVR && isLast ) )
+              {
+                continue;
+              }
+              std::vector<void ( * )( const ClpRng &, Pel const *, ptrdiff_t, Pel *, ptrdiff_t, int, int, TFilterCoeff const * )> impl;
+              for( const auto &filter: *filters )
+              {
+                impl.push_back( isVer ? filter.m_filterVer[std::get<1>( tap )][isFirst][isLast] : filter.m_filterHor[std::get<1>( tap )][isFirst][isLast] );
+              }
+              const bool dmvr = std::get<1>( tap ) == IF::TAPS_DMVR;
+              auto       ctx  = std::make_shared<BlockCtx>( w, h );
+              if( isFirst )
+              {
+                ctx->src0.fillPel( bd );
+              }
+              else if( dmvr )
+              {
+                ctx->src0.fill( 0, ( 1 << IF_INTERNAL_PREC_BILINEAR ) - 1 );
+              }
+              else
+              {
+                ctx->src0.fillIntermediate( bd );
+              }
+              const TFilterCoeff *coeff = std::get<2>( tap );
+              const std::string   name  = std::string( isVer ? "filterVer " : "filterHor " ) + std::get<0>( tap ) + ( isFirst ? " first" : "" ) + ( isLast ? " last" : "" );
+              addCase( cases, caseName( name, w, h, bd ), distinctLevels( impl ),
+                       [=]( int k ) { impl[k]( clpRng, ctx->src0.buf(), ctx->src0.stride, ctx->dst.buf(), ctx->dst.stride, w, h, coeff ); },
+                       ctx->dst.data.data(), ctx->dst.bytes() );
+              if( dmvr )
+              {
+                // the DMVR kernels may write a few samples past the block width, the DMVR buffers leave room for it
+                cases.back().out        = ctx->dst.buf();
+                cases.back().outSize    = h * ctx->dst.stride * sizeof( Pel );
+                cases.back().outRowSize = w * sizeof( Pel );
+                cases.back().outStride  = ctx->dst.stride * sizeof( Pel );
+              }
+            }
+          }
+        }
+      }
+
+      for( int isFirst = 0; isFirst < 2; isFirst++ )
+      {
+        for( int isLast = 0; isLast < 2; isLast++ )
+        {
+          for( const bool biMCForDMVR: { false, true } )
+          {
+            if( biMCForDMVR && isLast )
+            {
+              continue;
+            }
+            std::vector<void ( * )( const ClpRng &, Pel const *, ptrdiff_t, Pel *, ptrdiff_t, int, int, bool )> impl;
+            for( const auto &filter: *filters )
+            {
+              impl.push_back( filter.m_filterCopy[isFirst][isLast] );
+            }
+            auto ctx = std::make_shared<BlockCtx>( w, h );
+            if( isFirst )
+            {
+              ctx->src0.fillPel( bd );
+            }
+            else
+            {
+              ctx->src0.fillIntermediate( bd );
+            }
+            const std::string name = std::string( "filterCopy" ) + ( isFirst ? " first" : "" ) + ( isLast ? " last" : "" ) + ( biMCForDMVR ? " DMVR" : "" );
+            addCase( cases, caseName( name, w, h, bd ), distinctLevels( impl ),
+                     [=]( int k ) { impl[k]( clpRng, ctx->src0.buf(), ctx->src0.stride, ctx->dst.buf(), ctx->dst.stride, w, h, biMCForDMVR ); },
+                     ctx->dst.data.data(), ctx->dst.bytes() );
+          }
+        }
+      }
+    }
+  }
+}
+
+// ====================================================================================================================
+// AdaptiveLoopFilter
+// ====================================================================================================================
+
+void addAdaptiveLoopFilterCases( const KernelSuiteParam &param, std::vector<KernelCase> &cases )
+{
+  static constexpr int PIC_SIZE = 64;
+  static constexpr int CLS_SIZE = AdaptiveLoopFilter::m_CLASSIFICATION_BLK_SIZE;
+
+  auto alf = std::make_shared<std::vector<AdaptiveLoopFilter>>( param.levels.size() );
+  for( size_t k = 0; k < param.levels.size(); k++ )
+  {
+#if ENABLE_SIMD_OPT_ALF && defined( TARGET_SIMD_X86 )
+    AdaptiveLoopFilter &filter = ( *alf )[k];
+    dispatchLevel( param.levels[k], [&filter]( auto vext ) { filter._initAdaptiveLoopFilterX86<decltype( vext )::value>(); } );
+#endif
+  }
+
+  struct AlfCtx
+  {
+    Plane<Pel>                   rec, dst, recCb, dstCb;
+    std::vector<AlfClassifier>   classifierData, refClassifierData;
+    std::vector<AlfClassifier *> classifier, refClassifier;
+    std::vector<int>             laplacianData;
+    std::vector<int *>           laplacianRows;
+    int **                       laplacian[NUM_DIRECTIONS];
+    std::vector<short>           coeff;
+    std::vector<Pel>             clip;
+    XuPool                       xuPool;
+    CodingStructure              cs;
+
+    AlfCtx()
+      : rec( PIC_SIZE, PIC_SIZE )
+      , dst( PIC_SIZE, PIC_SIZE )
+      , recCb( PIC_SIZE / 2, PIC_SIZE / 2 )
+      , dstCb( PIC_SIZE / 2, PIC_SIZE / 2 )
+      , classifierData( PIC_SIZE * PIC_SIZE )
+      , refClassifierData( PIC_SIZE * PIC_SIZE )
+      , classifier( PIC_SIZE )
+      , refClassifier( PIC_SIZE )
+      , laplacianData( NUM_DIRECTIONS * ( CLS_SIZE + 5 ) * ( CLS_SIZE + 5 ) )
+      , laplacianRows( NUM_DIRECTIONS * ( CLS_SIZE + 5 ) )
+      , cs( xuPool )
+    {
+      for( int y = 0; y < PIC_SIZE; y++ )
+      {
+        classifier[y]    = classifierData.data() + y * PIC_SIZE;
+        refClassifier[y] = refClassifierData.data() + y * PIC_SIZE;
+      }
+      for( int i = 0; i < (int) laplacianRows.size(); i++ )
+      {
+        laplacianRows[i] = laplacianData.data() + i * ( CLS_SIZE + 5 );
+      }
+      for( int dir = 0; dir < NUM_DIRECTIONS; dir++ )
+      {
+        laplacian[dir] = laplacianRows.data() + dir * ( CLS_SIZE + 5 );
+      }
+    }
+  };
+
+  for( const int bd: param.bitDepths )
+  {
+    const ClpRng clpRng  = makeClpRng( bd );
+    const Pel    clips[] = { Pel( 1 << bd ), Pel( 1 << ( bd - 3 ) ), Pel( 1 << ( bd - 5 ) ), Pel( 1 << ( bd - 7 ) ) };
+
+    auto ctx = std::make_shared<AlfCtx>();
+    ctx->rec.fillPel( bd );
+    ctx->recCb.fillPel( bd );
+    ctx->coeff.resize( MAX_NUM_ALF_CLASSES * MAX_NUM_ALF_LUMA_COEFF );
+    ctx->clip.resize( MAX_NUM_ALF_CLASSES * MAX_NUM_ALF_LUMA_COEFF );
+    for( size_t i = 0; i < ctx->coeff.size(); i++ )
+    {
+      ctx->coeff[i] = short( randRange( -32, 32 ) );
+      ctx->clip[i]  = clips[randRange( 0, 3 )];
+    }
+
+    const CPelBuf rec( ctx->rec.buf(), ctx->rec.stride, PIC_SIZE, PIC_SIZE );
+    const int     shift = bd + 4;
+
+    // classification of the four 32x32 blocks, the luma virtual boundary 4 rows above the CTU bottom
+    const auto classify = gather( *alf, &AdaptiveLoopFilter::m_deriveClassificationBlk );
+    auto classifyAll = [ctx, classify, rec, shift]( const int k, AlfClassifier **classifier )
+    {
+      for( int y = 0; y < PIC_SIZE; y += CLS_SIZE )
+      {
+        for( int x = 0; x < PIC_SIZE; x += CLS_SIZE )
+        {
+          const Area blk( x, y, CLS_SIZE, CLS_SIZE );
+          classify[k]( classifier, ctx->laplacian, rec, blk, blk, shift, PIC_SIZE, PIC_SIZE - 4 );
+        }
+      }
+    };
+    classifyAll( 0, ctx->refClassifier.data() );
+    addCase( cases, caseName( "deriveClassificationBlk", PIC_SIZE, PIC_SIZE, bd ), distinctLevels( classify ),
+             [=]( int k ) { classifyAll( k, ctx->classifier.data() ); },
+             ctx->classifierData.data(), ctx->classifierData.size() * sizeof( AlfClassifier ) );
+
+    // luma 7x7 and chroma 5x5 filtering of one CTU
+    const auto filter7x7 = gather( *alf, &AdaptiveLoopFilter::m_filter7x7Blk );
+    const Area blkY( 0, 0, PIC_SIZE, PIC_SIZE );
+    addCase( cases, caseName( "filter7x7Blk", PIC_SIZE, PIC_SIZE, bd ), distinctLevels( filter7x7 ),
+             [=]( int k )
+             {
+               const PelUnitBuf dst( ChromaFormat::_400, PelBuf( ctx->dst.buf(), ctx->dst.stride, PIC_SIZE, PIC_SIZE ) );
+               const CPelUnitBuf src( ChromaFormat::_400, CPelBuf( ctx->rec.buf(), ctx->rec.stride, PIC_SIZE, PIC_SIZE ) );
+               filter7x7[k]( ctx->refClassifier.data(), dst, src, blkY, blkY, COMPONENT_Y, ctx->coeff.data(), ctx->clip.data(),
+                             clpRng, ctx->cs, PIC_SIZE, PIC_SIZE - 4 );
+             },
+             ctx->dst.data.data(), ctx->dst.bytes() );
+
+    const auto filter5x5 = gather( *alf, &AdaptiveLoopFilter::m_filter5x5Blk );
+    const Area blkC( 0, 0, PIC_SIZE / 2, PIC_SIZE / 2 );
+    addCase( cases, caseName( "filter5x5Blk", PIC_SIZE / 2, PIC_SIZE / 2, bd ), distinctLevels( filter5x5 ),
+             [=]( int k )
+             {
+               PelUnitBuf::UnitBufBuffers dstBufs;
+               dstBufs.push_back( PelBuf( ctx->dst.buf(), ctx->dst.stride, PIC_SIZE, PIC_SIZE ) );
+               dstBufs.push_back( PelBuf( ctx->dstCb.buf(), ctx->dstCb.stride, PIC_SIZE / 2, PIC_SIZE / 2 ) );
+               dstBufs.push_back( PelBuf( ctx->dstCb.buf(), ctx->dstCb.stride, PIC_SIZE / 2, PIC_SIZE / 2 ) );
+               CPelUnitBuf::UnitBufBuffers srcBufs;
+               srcBufs.push_back( CPelBuf( ctx->rec.buf(), ctx->rec.stride, PIC_SIZE, PIC_SIZE ) );
+               srcBufs.push_back( CPelBuf( ctx->recCb.buf(), ctx->recCb.stride, PIC_SIZE / 2, PIC_SIZE / 2 ) );
+               srcBufs.push_back( CPelBuf( ctx->recCb.buf(), ctx->recCb.stride, PIC_SIZE / 2, PIC_SIZE / 2 ) );
+               filter5x5[k]( ctx->refClassifier.data(), PelUnitBuf( ChromaFormat::_420, dstBufs ), CPelUnitBuf( ChromaFormat::_420, srcBufs ),
+                             blkC, blkC, COMPONENT_Cb, ctx->coeff.data(), ctx->clip.data(), clpRng, ctx->cs, PIC_SIZE / 2, PIC_SIZE / 2 - 2 );
+             },
+             ctx->dstCb.data.data(), ctx->dstCb.bytes() );
+  }
+}
+
+// ====================================================================================================================
+// AffineGradientSearch
+// ====================================================================================================================
+
+void addAffineGradientSearchCases( const KernelSuiteParam &param, std::vector<KernelCase> &cases )
+{
+  auto search = std::make_shared<std::vector<AffineGradientSearch>>( param.levels.size() );
+  for( size_t k = 0; k < param.levels.size(); k++ )
+  {
+#if ENABLE_SIMD_OPT_AFFINE_ME && defined( TARGET_SIMD_X86 )
+    AffineGradientSearch &s = ( *search )[k];
+    dispatchLevel( param.levels[k], [&s]( auto vext ) { s._initAffineGradientSearchX86<decltype( vext )::value>(); } );
+#endif
+  }
+
+  struct SobelCtx
+  {
+    Plane<Pel>       pred;
+    std::vector<int> deriv;
+    SobelCtx( const int w, const int h ) : pred( w, h ), deriv( w * h ) {}
+  };
+  struct EqualCoeffCtx
+  {
+    Plane<Pel>       residue;
+    std::vector<int> deriv[2];
+    int64_t          equalCoeff[7][7];
+    EqualCoeffCtx( const int w, const int h ) : residue( w, h ) {}
+  };
+
+  for( const int bd: param.bitDepths )
+  {
+    for( const int size: { 16, 64 } )
+    {
+      for( const bool vertical: { false, true } )
+      {
+        auto ctx = std::make_shared<SobelCtx>( size, size );
+        ctx->pred.fillPel( bd );
+        const auto impl = gather( *search, vertical ? &AffineGradientSearch::m_VerticalSobelFilter : &AffineGradientSearch::m_HorizontalSobelFilter );
+        addCase( cases, caseName( vertical ? "VerticalSobelFilter" : "HorizontalSobelFilter", size, size, bd ), distinctLevels( impl ),
+                 [=]( int k ) { impl[k]( ctx->pred.buf(), ctx->pred.stride, ctx->deriv.data(), size, size, size ); },
+                 ctx->deriv.data(), ctx->deriv.size() * sizeof( int ) );
+      }
+      for( const bool b6Param: { false, true } )
+      {
+        auto ctx = std::make_shared<EqualCoeffCtx>( size, size );
+        ctx->residue.fill( -( 1 << bd ) + 1, ( 1 << bd ) - 1 );
+        for( auto &deriv: ctx->deriv )
+        {
+          deriv.resize( size * size );
+          for( auto &v: deriv )
+          {
+            v = randRange( -( 1 << ( bd + 3 ) ), 1 << ( bd + 3 ) );
+          }
+        }
+        const auto impl = gather( *search, &AffineGradientSearch::m_EqualCoeffComputer );
+        addCase( cases, caseName( b6Param ? "EqualCoeffComputer 6param" : "EqualCoeffComputer 4param", size, size, bd ), distinctLevels( impl ),
+                 [=]( int k )
+                 {
+                   int *deriv[2] = { ctx->deriv[0].data(), ctx->deriv[1].data() };
+                   impl[k]( ctx->residue.buf(), ctx->residue.stride, deriv, size, ctx->equalCoeff, size, size, b6Param );
+                 },
+                 ctx->equalCoeff, sizeof( ctx->equalCoeff ),
+                 [=]() { memset( ctx->equalCoeff, 0, sizeof( ctx->equalCoeff ) ); } );
+      }
+    }
+  }
+}
+
+// ====================================================================================================================
+// IntraPrediction
+// ====================================================================================================================
+
+void addIntraPredictionCases( const KernelSuiteParam &param, std::vector<KernelCase> &cases )
+{
+  auto pred = std::make_shared<std::vector<IntraPrediction>>( param.levels.size() );
+  for( size_t k = 0; k < param.levels.size(); k++ )
+  {
+#if ENABLE_SIMD_OPT_CCLM && defined( TARGET_SIMD_X86 )
+    IntraPrediction &p = ( *pred )[k];
+    dispatchLevel( param.levels[k], [&p]( auto vext ) { p._initIntraPredictionX86<decltype( vext )::value>(); } );
+#endif
+  }
+
+  struct DsFilter
+  {
+    const char *name;
+    IntraPrediction::CclmDsFilterFunc IntraPrediction::*member;
+    int rowStep;
+  };
+  const DsFilter filters[] = { { "CclmDsFilter3Tap", &IntraPrediction::m_cclmDsFilter3Tap, 1 },
+                               { "CclmDsFilter5Tap", &IntraPrediction::m_cclmDsFilter5Tap, 2 },
+                               { "CclmDsFilter6Tap", &IntraPrediction::m_cclmDsFilter6Tap, 2 } };
+
+  for( const int bd: param.bitDepths )
+  {
+    for( const auto &filter: filters )
+    {
+      // 4 and 6 wide blocks cover the partial vectors of the above template row
+      for( const Size size: { Size( 4, 4 ), Size( 6, 1 ), Size( 8, 8 ), Size( 32, 32 ) } )
+      {
+        for( const bool padding: { false, true } )
+        {
+          auto ctx = std::make_shared<BlockCtx>( 2 * size.width, filter.rowStep * size.height );
+          ctx->src0.fillPel( bd );
+          const auto       impl   = gather( *pred, filter.member );
+          const int        w      = size.width;
+          const int        h      = size.height;
+          const std::string name = caseName( std::string( filter.name ) + ( padding ? " padded" : "" ), w, h, bd );
+          addCase( cases, name, distinctLevels( impl ),
+                   [=]( int k )
+                   { impl[k]( ctx->src0.buf(), ctx->src0.stride, ctx->dst.buf(), ctx->dst.stride, w, h, padding, padding ); },
+                   ctx->dst.data.data(), ctx->dst.bytes() );
+        }
+      }
+    }
+  }
+}
+
+// ====================================================================================================================
+// Transforms
+// ====================================================================================================================
+
+void addTransformCases( const KernelSuiteParam &param, std::vector<KernelCase> &cases )
+{
+  typedef void ( *FwdTrans )( const TCoeff *, TCoeff *, int, int, int, int );
+  typedef void ( *InvTrans )( const TCoeff *, TCoeff *, int, int, int, int, const TCoeff, const TCoeff );
+
+  // the partial butterflies have no SIMD implementation, they are listed for timing only
+  const std::vector<std::tuple<const char *, int, FwdTrans, InvTrans>> transforms = {
+    std::make_tuple( "DCT2", 2, fastForwardDCT2_B2, fastInverseDCT2_B2 ),
+    std::make_tuple( "DCT2", 4, fastForwardDCT2_B4, fastInverseDCT2_B4 ),
+    std::make_tuple( "DCT2", 8, fastForwardDCT2_B8, fastInverseDCT2_B8 ),
+    std::make_tuple( "DCT2", 16, fastForwardDCT2_B16, fastInverseDCT2_B16 ),
+    std::make_tuple( "DCT2", 32, fastForwardDCT2_B32, fastInverseDCT2_B32 ),
+    std::make_tuple( "DCT2", 64, fastForwardDCT2_B64, fastInverseDCT2_B64 ),
+    std::make_tuple( "DST7", 4, fastForwardDST7_B4, fastInverseDST7_B4 ),
+    std::make_tuple( "DST7", 8, fastForwardDST7_B8, fastInverseDST7_B8 ),
+    std::make_tuple( "DST7", 16, fastForwardDST7_B16, fastInverseDST7_B16 ),
+    std::make_tuple( "DST7", 32, fastForwardDST7_B32, fastInverseDST7_B32 ),
+    std::make_tuple( "DCT8", 4, fastForwardDCT8_B4, fastInverseDCT8_B4 ),
+    std::make_tuple( "DCT8", 8, fastForwardDCT8_B8, fastInverseDCT8_B8 ),
+    std::make_tuple( "DCT8", 16, fastForwardDCT8_B16, fastInverseDCT8_B16 ),
+    std::make_tuple( "DCT8", 32, fastForwardDCT8_B32, fastInverseDCT8_B32 )
+  };
+
+  struct TransCtx
+  {
+    std::vector<TCoeff> src, dst;
+    TransCtx( const int n ) : src( n * n ), dst( n * n ) {}
+  };
+
+  for( const int bd: param.bitDepths )
+  {
+    for( const auto &transform: transforms )
+    {
+      const int n = std::get<1>( transform );
+      {
+        auto ctx = std::make_shared<TransCtx>( n );
+        for( auto &v: ctx->src )
+        {
+          v = randRange( -( 1 << bd ) + 1, ( 1 << bd ) - 1 );
+        }
+        const FwdTrans fwd   = std::get<2>( transform );
+        const int      shift = floorLog2( n ) + bd + 6 - 15;
+        addCase( cases, caseName( std::string( "fastForward" ) + std::get<0>( transform ), n, n, bd ), { 0 },
+                 [=]( int ) { fwd( ctx->src.data(), ctx->dst.data(), shift, n, 0, 0 ); },
+                 ctx->dst.data(), ctx->dst.size() * sizeof( TCoeff ) );
+      }
+      {
+        auto ctx = std::make_shared<TransCtx>( n );
+        for( auto &v: ctx->src )
+        {
+          v = randRange( -( 1 << 15 ), ( 1 << 15 ) - 1 );
+        }
+        const InvTrans inv   = std::get<3>( transform );
+        const int      shift = 20 - bd;
+        addCase( cases, caseName( std::string( "fastInverse" ) + std::get<0>( transform ), n, n, bd ), { 0 },
+                 [=]( int ) { inv( ctx->src.data(), ctx->dst.data(), shift, n, 0, 0, -( 1 << 15 ), ( 1 << 15 ) - 1 ); },
+                 ctx->dst.data(), ctx->dst.size() * sizeof( TCoeff ) );
+      }
+    }
+  }
+}
+
+//! \}
@@ -0,0 +1,90 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2023, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     KernelBenchmarkSuites.h
+    \brief    Kernel test cases of the CommonLib modules
+*/
+
+#ifndef __KERNELBENCHMARKSUITES__
+#define __KERNELBENCHMARKSUITES__
+
+#pragma once
+
+#include "CommonLib/CommonDef.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+//! \ingroup KernelBenchmarkApp
+//! \{
+
+#if ENABLE_SIMD_OPT && defined(TARGET_SIMD_X86)
+typedef X86_VEXT KernelLevel;
+#else
+enum KernelLevel
+{
+  SCALAR = 0
+};
+#endif
+
+/// one kernel configuration, the implementation of each level is checked against the scalar one and timed
+struct KernelCase
+{
+  std::string              name;
+  std::vector<int>         levels;    ///< indices of the levels with an own implementation, always starts with 0 (scalar)
+  std::function<void(int)> run;       ///< runs the implementation of the given level index once
+  std::function<void()>    reset;     ///< restores the inputs of kernels operating in place, may be empty
+  void *                   out;       ///< output compared against the scalar reference, cleared before each check unless reset is set
+  size_t                   outSize;   ///< size of the output in bytes
+  size_t                   outRowSize = 0;   ///< if set, only the first outRowSize bytes of each row are compared
+  size_t                   outStride  = 0;   ///< distance of the rows in bytes, used with outRowSize
+};
+
+struct KernelSuiteParam
+{
+  std::vector<KernelLevel> levels;      ///< levels to test, the first one is SCALAR
+  std::vector<int>         bitDepths;
+};
+
+// one function per module, each appends its cases
+void addPelBufOpsCases           ( const KernelSuiteParam &param, std::vector<KernelCase> &cases );
+void addRdCostCases              ( const KernelSuiteParam &param, std::vector<KernelCase> &cases );
+void addInterpolationFilterCases ( const KernelSuiteParam &param, std::vector<KernelCase> &cases );
+void addAdaptiveLoopFilterCases  ( const KernelSuiteParam &param, std::vector<KernelCase> &cases );
+void addAffineGradientSearchCases( const KernelSuiteParam &param, std::vector<KernelCase> &cases );
+void addIntraPredictionCases     ( const KernelSuiteParam &param, std::vector<KernelCase> &cases );
+void addTransformCases           ( const KernelSuiteParam &param, std::vector<KernelCase> &cases );
+
+//! \}
+
+#endif  // __KERNELBENCHMARKSUITES__
@@ -0,0 +1,593 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2023, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     parallelencodertestmain.cpp
+    \brief    Runs several encoders in parallel in one process and checks that their bitstreams match serial runs,
+              or encodes with several variants of an option and checks that the bitstreams do not depend on it,
+              or encodes several bitstreams from one input read and checks that each matches a standalone encode
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "CommonLib/dtrace_next.h"
+#include "EncoderLib/EncLibCommon.h"
+#include "EncApp.h"
+#include "DecApp.h"
+#include "Utilities/program_options_lite.h"
+
+//! \ingroup ParallelEncoderTestApp
+//! \{
+
+static const char* const TEST_FILE_PREFIX = "ParallelEncoderTest";
+
+static const int SYNTHETIC_WIDTH  = 128;
+static const int SYNTHETIC_HEIGHT = 64;
+static const int SYNTHETIC_FRAMES = 8;
+
+/// writes a deterministic 8-bit 4:2:0 test sequence with moving gradients and edges
+static bool writeSyntheticInput( const std::string& fileName )
+{
+  std::ofstream file( fileName, std::ios::binary );
+  if( !file )
+  {
+    return false;
+  }
+
+  std::vector<uint8_t> frame( SYNTHETIC_WIDTH * SYNTHETIC_HEIGHT * 3 / 2 );
+  for( int f = 0; f < SYNTHETIC_FRAMES; f++ )
+  {
+    uint8_t* luma = frame.data();
+    for( int y = 0; y < SYNTHETIC_HEIGHT; y++ )
+    {
+      for( int x = 0; x < SYNTHETIC_WIDTH; x++ )
+      {
+        const int xs   = x + 3 * f;
+        const int ys   = y + f;
+        const int edge = ( ( xs >> 4 ) + ( ys >> 3 ) ) & 1 ? 48 : 0;
+        luma[y * SYNTHETIC_WIDTH + x] = uint8_t( 32 + ( ( xs * 5 + ys * 3 ) & 127 ) + edge );
+      }
+    }
+    uint8_t* chroma = luma + SYNTHETIC_WIDTH * SYNTHETIC_HEIGHT;
+    for( int c = 0; c < 2; c++ )
+    {
+      for( int y = 0; y < SYNTHETIC_HEIGHT / 2; y++ )
+      {
+        for( int x = 0; x < SYNTHETIC_WIDTH / 2; x++ )
+        {
+          *chroma++ = uint8_t( 96 + ( ( ( c ? y : x ) * 4 + f * 2 ) & 63 ) );
+        }
+      }
+    }
+    file.write( reinterpret_cast<const char*>( frame.data() ), frame.size() );
+  }
+  return bool( file );
+}
+
+/// encodes one bitstream per argument list the same way as the encoder application for a single layer, further
+/// encodes take their input pictures from the first one (SharedInputEncodes)
+static bool encodeBitstreams( std::vector<std::vector<std::string>> encodeArgs )
+{
+  const size_t numEncodes = encodeArgs.size();
+  std::vector<std::fstream>             bitstreams( numEncodes );
+  std::vector<EncLibCommon>             encLibCommons( numEncodes );
+  std::vector<std::unique_ptr<EncApp>>  encApps;
+
+  try
+  {
+    for( size_t i = 0; i < numEncodes; i++ )
+    {
+      encApps.emplace_back( new EncApp( bitstreams[i], &encLibCommons[i] ) );
+      EncApp* encApp = encApps.back().get();
+      encApp->create();
+
+      std::vector<char*> argv;
+      for( std::string& arg : encodeArgs[i] )
+      {
+        argv.push_back( &arg[0] );
+      }
+      if( !encApp->parseCfg( (int) argv.size(), argv.data() ) )
+      {
+        for( auto& app : encApps )
+        {
+          app->destroy();
+        }
+        return false;
+      }
+      if( i > 0 )
+      {
+        encApp->setInputSource( encApps[0].get() );
+      }
+      encApp->createLib( 0 );
+      CHECK( encApp->getMaxLayers() != 1, "Only single layer encodes are supported" );
+    }
+    CHECK( encApps[0]->getNumSharedInputEncodes() != numEncodes,
+           "SharedInputEncodes does not match the number of encodes" );
+
+    bool eos = false;
+    while( !eos )
+    {
+      bool keepLoop = true;
+      while( keepLoop )
+      {
+        for( auto& encApp : encApps )
+        {
+          keepLoop = encApp->encodePrep( eos );
+        }
+      }
+      keepLoop = true;
+      while( keepLoop )
+      {
+        for( auto& encApp : encApps )
+        {
+          keepLoop = encApp->encode();
+        }
+      }
+    }
+
+    for( auto& encApp : encApps )
+    {
+      encApp->destroyLib();
+      encApp->destroy();
+    }
+  }
+  catch( Exception &e )
+  {
+    std::cerr << e.what() << std::endl;
+    return false;
+  }
+  catch( ProgramOptionsLite::ParseFailure &e )
+  {
+    std::cerr << "Error parsing option \"" << e.arg << "\" with argument \"" << e.val << "\"." << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/// encodes one bitstream with its own encoder instance
+static bool encodeBitstream( std::vector<std::string> args )
+{
+  return encodeBitstreams( { std::move( args ) } );
+}
+
+static bool readFile( const std::string& fileName, std::vector<char>& data )
+{
+  std::ifstream file( fileName, std::ios::binary );
+  if( !file )
+  {
+    return false;
+  }
+  data.assign( std::istreambuf_iterator<char>( file ), std::istreambuf_iterator<char>() );
+  return true;
+}
+
+/// runs the decoder application with the given options
+static bool runDecoder( std::vector<std::string> args )
+{
+  std::vector<char*> argv;
+  for( std::string& arg : args )
+  {
+    argv.push_back( &arg[0] );
+  }
+
+  std::unique_ptr<DecApp> decApp( new DecApp );
+  try
+  {
+    if( !decApp->parseCfg( (int) argv.size(), argv.data() ) || decApp->decode() != 0 )
+    {
+      return false;
+    }
+  }
+  catch( Exception &e )
+  {
+    std::cerr << e.what() << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/// decodes a bitstream with the decoder application and checks the output against the reconstruction of the encoder
+static bool decodeBitstream( const std::string& name )
+{
+  std::vector<char> recon, decoded;
+  return runDecoder( { "DecoderApp", "-b", name + ".bin", "-o", name + "_dec.yuv" } )
+         && readFile( name + "_rec.yuv", recon ) && readFile( name + "_dec.yuv", decoded ) && !recon.empty()
+         && recon == decoded;
+}
+
+/// decodes the bitstreams together with a BitstreamList on two threads and checks the output of each one against the
+/// one of its single bitstream decode
+static bool decodeBitstreamList( const std::vector<std::string>& names )
+{
+  const std::string listFileName = std::string( TEST_FILE_PREFIX ) + "_list.txt";
+  {
+    std::ofstream listFile( listFileName );
+    for( const std::string& name : names )
+    {
+      listFile << name << ".bin " << name << "_batch.yuv\n";
+    }
+    if( !listFile )
+    {
+      return false;
+    }
+  }
+  if( !runDecoder( { "DecoderApp", "--BitstreamList=" + listFileName, "--BatchThreads=2" } ) )
+  {
+    return false;
+  }
+
+  bool match = true;
+  for( const std::string& name : names )
+  {
+    std::vector<char> decoded, batch;
+    if( !readFile( name + "_dec.yuv", decoded ) || !readFile( name + "_batch.yuv", batch ) || decoded != batch )
+    {
+      printf( "\n***ERROR*** Output of %s.bin in the BitstreamList differs from the single bitstream decode\n",
+              name.c_str() );
+      match = false;
+    }
+  }
+  return match;
+}
+
+static void printUsage()
+{
+  printf( "usage: ParallelEncoderTestApp [-n <encoders>] [-q <qp>] [-s] [-v <option>]... [-r <option>]... [-d] [-b]\n"
+          "                              <EncoderApp options>\n"
+          "  -n <encoders>  number of encoders run in parallel (default 2)\n"
+          "  -q <qp>        QP of the first encoder, each further encoder uses a QP higher by 5 (default 27)\n"
+          "  -s             encode a synthetic %dx%d 8-bit 4:2:0 sequence of %d pictures instead of the input file\n"
+          "  -v <option>    EncoderApp option of a variant, if given, each encoder is run serially once per variant\n"
+          "                 instead of in parallel and the bitstreams of all variants must match the first one\n"
+          "  -r <option>    EncoderApp option of a further encode sharing the input read (SharedInputEncodes) of each\n"
+          "                 encoder, instead of running the encoders in parallel, the bitstream of every encode must\n"
+          "                 match the one of a standalone encode with the same options\n"
+          "  -d             decode each bitstream, the output must match the reconstruction of the encoder\n"
+          "  -b             implies -d, in addition decode all bitstreams together with a BitstreamList on two threads,\n"
+          "                 the output must match the one of the single bitstream decodes\n"
+          "The bitstreams are written to %s_<serial|parallel><n>.bin, %s_variant<v>_<n>.bin or\n"
+          "%s_<shared|standalone><r>_<n>.bin, the reconstruction and the decoder output to <bitstream>_rec.yuv, <bitstream>_dec.yuv and <bitstream>_batch.yuv.\n",
+          SYNTHETIC_WIDTH, SYNTHETIC_HEIGHT, SYNTHETIC_FRAMES, TEST_FILE_PREFIX, TEST_FILE_PREFIX, TEST_FILE_PREFIX );
+}
+
+// ====================================================================================================================
+// Main function
+// ====================================================================================================================
+
+int main(int argc, char* argv[])
+{
+  // print information
+  fprintf( stdout, "\n" );
+  fprintf( stdout, "VVCSoftware: VTM Parallel Encoder Test Version %s ", VTM_VERSION );
+  fprintf( stdout, NVM_ONOS );
+  fprintf( stdout, NVM_COMPILEDBY );
+  fprintf( stdout, NVM_BITS );
+  fprintf( stdout, "\n" );
+
+  int  numEncoders = 2;
+  int  qp          = 27;
+  bool synthetic   = false;
+  bool decode      = false;
+  bool batchDecode = false;
+
+  std::vector<std::string> variants;
+  std::vector<std::string> sharedOptions;
+
+  int argIdx = 1;
+  for( ; argIdx < argc; argIdx++ )
+  {
+    const std::string arg = argv[argIdx];
+    if( arg == "-n" && argIdx + 1 < argc )
+    {
+      numEncoders = atoi( argv[++argIdx] );
+    }
+    else if( arg == "-q" && argIdx + 1 < argc )
+    {
+      qp = atoi( argv[++argIdx] );
+    }
+    else if( arg == "-s" )
+    {
+      synthetic = true;
+    }
+    else if( arg == "-d" )
+    {
+      decode = true;
+    }
+    else if( arg == "-b" )
+    {
+      decode      = true;
+      batchDecode = true;
+    }
+    else if( arg == "-v" && argIdx + 1 < argc )
+    {
+      variants.push_back( argv[++argIdx] );
+    }
+    else if( arg == "-r" && argIdx + 1 < argc )
+    {
+      sharedOptions.push_back( argv[++argIdx] );
+    }
+    else
+    {
+      break;
+    }
+  }
+  if( argIdx == argc || numEncoders < 1 )
+  {
+    printUsage();
+    return EXIT_FAILURE;
+  }
+
+  // options common to all encoders, the options of the application are followed by the per-encoder ones
+  std::vector<std::string> commonArgs( 1, argv[0] );
+  if( synthetic )
+  {
+    const std::string inputFileName = std::string( TEST_FILE_PREFIX ) + "_input.yuv";
+    if( !writeSyntheticInput( inputFileName ) )
+    {
+      fprintf( stderr, "Cannot write %s\n", inputFileName.c_str() );
+      return EXIT_FAILURE;
+    }
+    commonArgs.insert( commonArgs.end(), { "-i", inputFileName, "-wdt", std::to_string( SYNTHETIC_WIDTH ), "-hgt",
+                                           std::to_string( SYNTHETIC_HEIGHT ), "-f", std::to_string( SYNTHETIC_FRAMES ),
+                                           "-fr", "30", "--InputBitDepth=8", "--InputChromaFormat=420" } );
+  }
+  commonArgs.insert( commonArgs.end(), argv + argIdx, argv + argc );
+  commonArgs.push_back( "--ReconFile=" );
+  commonArgs.push_back( "--Verbosity=2" );
+
+  auto encoderArgs = [&]( const int encIdx, const std::string& mode )
+  {
+    const std::string        name = std::string( TEST_FILE_PREFIX ) + "_" + mode + std::to_string( encIdx );
+    std::vector<std::string> args = commonArgs;
+    args.push_back( "--QP=" + std::to_string( qp + 5 * encIdx ) );
+    args.push_back( "--BitstreamFile=" + name + ".bin" );
+    if( decode )
+    {
+      args.push_back( "--ReconFile=" + name + "_rec.yuv" );
+    }
+    return args;
+  };
+  auto variantArgs = [&]( const int encIdx, const int variantIdx )
+  {
+    std::vector<std::string> args = encoderArgs( encIdx, "variant" + std::to_string( variantIdx ) + "_" );
+    args.push_back( variants[variantIdx] );
+    return args;
+  };
+  // encode 0 of the shared input encodes uses the options of the encoder only, encode r adds the r-th -r option
+  auto sharedArgs = [&]( const int encIdx, const int sharedIdx, const std::string& mode )
+  {
+    std::vector<std::string> args = encoderArgs( encIdx, mode + std::to_string( sharedIdx ) + "_" );
+    if( sharedIdx > 0 )
+    {
+      args.push_back( sharedOptions[sharedIdx - 1] );
+    }
+    return args;
+  };
+  const bool serialParallel = variants.empty() && sharedOptions.empty();
+
+  // the ROM tables are shared by all encoders of the process
+  initROM();
+#if ENABLE_TRACING
+  // so is the trace context, which no encoder may destroy while the others are running
+  std::string tracingFile, tracingRule;
+  g_trace_ctx = tracing_init( tracingFile, tracingRule );
+#endif
+
+  int returnCode = EXIT_SUCCESS;
+
+  // bitstreams whose single decode matched the reconstruction
+  std::vector<std::string> decodedNames;
+
+  // variants of an option that must not change the bitstream, e.g. the number of threads of a search stage
+  for( int encIdx = 0; encIdx < numEncoders && !variants.empty(); encIdx++ )
+  {
+    std::vector<char> reference;
+    for( int variantIdx = 0; variantIdx < (int) variants.size(); variantIdx++ )
+    {
+      std::vector<char> bitstream;
+      const std::string name = std::string( TEST_FILE_PREFIX ) + "_variant" + std::to_string( variantIdx ) + "_";
+      if( !encodeBitstream( variantArgs( encIdx, variantIdx ) )
+          || !readFile( name + std::to_string( encIdx ) + ".bin", bitstream ) || bitstream.empty() )
+      {
+        printf( "\n***ERROR*** Encode %d with %s failed\n", encIdx, variants[variantIdx].c_str() );
+        returnCode = EXIT_FAILURE;
+      }
+      else if( decode && !decodeBitstream( name + std::to_string( encIdx ) ) )
+      {
+        printf( "\n***ERROR*** Decoded pictures of encode %d with %s differ from the reconstruction\n", encIdx,
+                variants[variantIdx].c_str() );
+        returnCode = EXIT_FAILURE;
+      }
+      else if( variantIdx == 0 )
+      {
+        if( decode )
+        {
+          decodedNames.push_back( name + std::to_string( encIdx ) );
+        }
+        reference.swap( bitstream );
+      }
+      else if( bitstream != reference )
+      {
+        printf( "\n***ERROR*** Bitstream of encode %d with %s differs from the one with %s\n", encIdx,
+                variants[variantIdx].c_str(), variants[0].c_str() );
+        returnCode = EXIT_FAILURE;
+      }
+      else
+      {
+        printf( "Encoder %d (QP %d): %d bytes, bitstreams with %s and %s match\n", encIdx, qp + 5 * encIdx,
+                (int) reference.size(), variants[variantIdx].c_str(), variants[0].c_str() );
+      }
+    }
+  }
+
+  // several encodes from one input read, each must give the bitstream of a standalone encode with the same options
+  for( int encIdx = 0; encIdx < numEncoders && !sharedOptions.empty(); encIdx++ )
+  {
+    const int numShared = (int) sharedOptions.size() + 1;
+    std::vector<std::vector<std::string>> encodeArgs;
+    for( int sharedIdx = 0; sharedIdx < numShared; sharedIdx++ )
+    {
+      encodeArgs.push_back( sharedArgs( encIdx, sharedIdx, "shared" ) );
+    }
+    encodeArgs[0].push_back( "--SharedInputEncodes=" + std::to_string( numShared ) );
+    if( !encodeBitstreams( encodeArgs ) )
+    {
+      printf( "\n***ERROR*** Shared input encodes of encoder %d failed\n", encIdx );
+      returnCode = EXIT_FAILURE;
+      continue;
+    }
+
+    for( int sharedIdx = 0; sharedIdx < numShared; sharedIdx++ )
+    {
+      std::vector<char> shared, standalone;
+      const std::string option = sharedIdx > 0 ? sharedOptions[sharedIdx - 1] : std::string( "no option" );
+      const std::string name   = std::string( TEST_FILE_PREFIX ) + "_shared" + std::to_string( sharedIdx ) + "_"
+                               + std::to_string( encIdx );
+      if( !encodeBitstream( sharedArgs( encIdx, sharedIdx, "standalone" ) ) || !readFile( name + ".bin", shared )
+          || !readFile( std::string( TEST_FILE_PREFIX ) + "_standalone" + std::to_string( sharedIdx ) + "_"
+                          + std::to_string( encIdx ) + ".bin",
+                        standalone ) )
+      {
+        printf( "\n***ERROR*** Standalone encode %d with %s failed\n", encIdx, option.c_str() );
+        returnCode = EXIT_FAILURE;
+      }
+      else if( shared.empty() || shared != standalone )
+      {
+        printf( "\n***ERROR*** Bitstream of shared input encode %d with %s differs from the standalone one\n", encIdx,
+                option.c_str() );
+        returnCode = EXIT_FAILURE;
+      }
+      else if( decode && !decodeBitstream( name ) )
+      {
+        printf( "\n***ERROR*** Decoded pictures of shared input encode %d with %s differ from the reconstruction\n",
+                encIdx, option.c_str() );
+        returnCode = EXIT_FAILURE;
+      }
+      else
+      {
+        if( decode )
+        {
+          decodedNames.push_back( name );
+        }
+        printf( "Encoder %d with %s: %d bytes, shared input and standalone bitstreams match\n", encIdx,
+                option.c_str(), (int) shared.size() );
+      }
+    }
+  }
+
+  // reference bitstreams, one encoder at a time
+  for( int encIdx = 0; encIdx < numEncoders && serialParallel; encIdx++ )
+  {
+    if( !encodeBitstream( encoderArgs( encIdx, "serial" ) ) )
+    {
+      printf( "\n***ERROR*** Serial encode %d failed\n", encIdx );
+      returnCode = EXIT_FAILURE;
+    }
+  }
+
+  // all encoders at the same time, each driven by its own thread
+  if( returnCode == EXIT_SUCCESS && serialParallel )
+  {
+    std::vector<std::thread> threads;
+    std::unique_ptr<bool[]>  success( new bool[numEncoders] );
+    for( int encIdx = 0; encIdx < numEncoders; encIdx++ )
+    {
+      threads.emplace_back( [&, encIdx] { success[encIdx] = encodeBitstream( encoderArgs( encIdx, "parallel" ) ); } );
+    }
+    for( std::thread &thread : threads )
+    {
+      thread.join();
+    }
+
+    for( int encIdx = 0; encIdx < numEncoders; encIdx++ )
+    {
+      std::vector<char> serial, parallel;
+      const std::string name = std::string( TEST_FILE_PREFIX ) + "_";
+      if( !success[encIdx] || !readFile( name + "serial" + std::to_string( encIdx ) + ".bin", serial )
+          || !readFile( name + "parallel" + std::to_string( encIdx ) + ".bin", parallel ) )
+      {
+        printf( "\n***ERROR*** Parallel encode %d failed\n", encIdx );
+        returnCode = EXIT_FAILURE;
+      }
+      else if( serial.empty() || serial != parallel )
+      {
+        printf( "\n***ERROR*** Bitstream of parallel encode %d differs from the serial one\n", encIdx );
+        returnCode = EXIT_FAILURE;
+      }
+      else if( decode && !decodeBitstream( name + "parallel" + std::to_string( encIdx ) ) )
+      {
+        printf( "\n***ERROR*** Decoded pictures of parallel encode %d differ from the reconstruction\n", encIdx );
+        returnCode = EXIT_FAILURE;
+      }
+      else
+      {
+        if( decode )
+        {
+          decodedNames.push_back( name + "parallel" + std::to_string( encIdx ) );
+        }
+        printf( "Encoder %d (QP %d): %d bytes, parallel and serial bitstreams match\n", encIdx, qp + 5 * encIdx,
+                (int) serial.size() );
+      }
+    }
+  }
+
+  if( returnCode == EXIT_SUCCESS && batchDecode )
+  {
+    if( decodeBitstreamList( decodedNames ) )
+    {
+      printf( "%d bitstreams decoded on two threads, output matches the single bitstream decodes\n",
+              (int) decodedNames.size() );
+    }
+    else
+    {
+      printf( "\n***ERROR*** Decoding with a BitstreamList failed\n" );
+      returnCode = EXIT_FAILURE;
+    }
+  }
+
+#if ENABLE_TRACING
+  tracing_uninit( g_trace_ctx );
+  g_trace_ctx = nullptr;
+#endif
+  destroyROM();
+
+  return returnCode;
+}
+
+//! \}
@@ -108,6 +108,7 @@ TApp360ConvertCfg::TApp360ConvertCfg()
   , m_outputInternalColourSpace(false)
   , m_temporalSubsampleRatio(1)
   , m_faceSizeAlignment(8)
+  , m_geoConvertThreads(1)
 {
 }
 
@@ -566,6 +567,7 @@ Bool TApp360ConvertCfg::parseCfg( Int argc, TChar* argv[] )
     ("ConfWinTop",                                      m_confWinTop,                                         0, "Top offset for window conformance mode 3")
     ("ConfWinBottom",                                   m_confWinBottom,                                      0, "Bottom offset for window conformance mode 3")
     ("FaceSizeAlignment",                               m_faceSizeAlignment,                                  4, "Unit size for alignment")
+    ("GeometryConvertThreads",                          m_geoConvertThreads,                                  1, "Number of threads converting the faces of a frame, the result does not depend on it")
     ("FrameRate,-fr",                                   m_iFrameRate,                                         0, "Frame rate")
     ("FrameSkip,-fs",                                   m_FrameSkip,                                         0u, "Number of frames to skip at start of input YUV")
     ("TemporalSubsampleRatio,-ts",                      m_temporalSubsampleRatio,                            1u, "Temporal sub-sample ratio when reading input YUV")
@@ -769,6 +771,11 @@ Bool TApp360ConvertCfg::parseCfg( Int argc, TChar* argv[] )
     printf("FaceSizeAlignment must be even for chroma 4:2:0 format, it is reset to %d.\n", m_faceSizeAlignment+1);
     m_faceSizeAlignment = m_faceSizeAlignment+1;
   }
+  if(m_geoConvertThreads < 1)
+  {
+    printf("GeometryConvertThreads must be greater than 0, it is reset to 1 (default value).\n");
+    m_geoConvertThreads = 1;
+  }
   calcOutputResolution(m_sourceSVideoInfo, m_codingSVideoInfo, m_iSourceWidth, m_iSourceHeight, m_faceSizeAlignment);
 
   /* convert std::string to c string for compatability */
@@ -3132,6 +3139,7 @@ Void  TApp360ConvertCfg::convert()
   }
 
   pcInputGeometry = TGeometry::create(m_sourceSVideoInfo, &m_inputGeoParam); 
+  pcInputGeometry->setConvertThreads(m_geoConvertThreads);
   pcCodingGeometry = TGeometry::create(m_codingSVideoInfo, &m_inputGeoParam);
 #if SVIDEO_CPPPSNR
   //pcReferenceGeometry = TGeometry::create(m_referenceSVideoInfo, &m_inputGeoParam);
@@ -130,6 +130,7 @@ protected:
 
   UInt  m_temporalSubsampleRatio;                         ///< temporal subsample ratio, 2 means code every two frames
   Int   m_faceSizeAlignment;
+  Int   m_geoConvertThreads;                                ///< number of threads converting the faces of a frame
 
   //snr flags
   Bool m_psnrEnabled[METRIC_NUM];                                     //0-psnr;1-spsnr;2-wspsnr;
@@ -488,6 +488,7 @@ Void TExt360AppEncCfg::addOptions(ProgramOptionsLite::Options &opts, TExt360AppE
   ("CodingFaceWidth",                            m_iCodingFaceWidth,                  0,                                    "Face width for coding")
   ("CodingFaceHeight",                           m_iCodingFaceHeight,                 0,                                    "Face height for coding")
   ("FaceSizeAlignment",                          m_faceSizeAlignment,                 4,                                    "Unit size for alignment, 0: minimal CU size")
+  ("GeometryConvertThreads",                     m_geoConvertThreads,                 1,                                    "Number of threads converting the faces of a frame, the result does not depend on it")
   ("InternalChromaFormat,-intercf",              ctx.tmpInternalChromaFormat,             0,                                    "InternalChromaFormatIDC (400|420|422|444 or set 0 (default) for same as OutputChromaFormat)")
   ("InterpolationMethodY,-interpY",              m_inputGeoParam.iInterp[Int(ChannelType::LUMA)],   (Int)SI_LANCZOS3,            "Interpolation method for luma, 0: default setting(lanczos3); 1:NN, 2: bilinear, 3: bicubic, 4: lanczos2, 5: lanczos3")
   ("InterpolationMethodC,-interpC",              m_inputGeoParam.iInterp[Int(ChannelType::CHROMA)], (Int)SI_LANCZOS2,            "Interpolation method for chroma, 0: default setting(lanczos2); 1:NN, 2: bilinear, 3: bicubic, 4: lanczos2, 5: lanczos3")
@@ -2062,6 +2063,7 @@ Bool TExt360AppEncCfg::verifyParameters()
   if(m_bSVideo)
   {
     xConfirmPara(m_faceSizeAlignment<0, "FaceSizeAlignment must be no less than 0");
+    xConfirmPara(m_geoConvertThreads<1, "GeometryConvertThreads must be greater than 0");
     //check source;
     if(   m_sourceSVideoInfo.geoType == SVIDEO_EQUIRECT 
 #if SVIDEO_ADJUSTED_EQUALAREA
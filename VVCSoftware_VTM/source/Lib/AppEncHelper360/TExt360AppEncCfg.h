@@ -58,6 +58,7 @@ protected:
   Int       m_iCodingFaceWidth;
   Int       m_iCodingFaceHeight;
   Int       m_faceSizeAlignment;
+  Int       m_geoConvertThreads;                              ///< number of threads converting the faces of a frame
   InputGeoParam m_inputGeoParam;
 #if SVIDEO_VIEWPORT_PSNR
   ViewPortPSNRParam m_viewPortPSNRParam;
@@ -139,6 +139,10 @@ Void TExt360AppEncTop::xCreate(EncGOP &encGop, PelStorage &yuvOrig)
     m_pcInputGeomtry  = TGeometry::create(extCfg.m_sourceSVideoInfo, &extCfg.m_inputGeoParam);
     m_pcCodingGeomtry = TGeometry::create(extCfg.m_codingSVideoInfo, &extCfg.m_inputGeoParam);
 #endif
+    if (m_pcInputGeomtry)
+    {
+      m_pcInputGeomtry->setConvertThreads(extCfg.m_geoConvertThreads);
+    }
 #if SVIDEO_E2E_METRICS
     m_ext360EncGop.initE2EMetricsCalc(extCfg.m_sourceSVideoInfo, extCfg.m_codingSVideoInfo, &extCfg.m_inputGeoParam, m_cTVideoIOYuvInputFile4E2EMetrics, cfg.m_inputChromaFormatIDC, cfg.m_inputFileWidth, cfg.m_inputFileHeight, cfg.m_temporalSubsampleRatio);
 #endif
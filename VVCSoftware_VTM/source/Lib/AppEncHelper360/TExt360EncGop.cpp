@@ -80,7 +80,7 @@ TExt360EncGop::~TExt360EncGop()
 #endif
 }
 
-Void TExt360EncGop::calculatePSNRs(Picture *pcPic)
+Void TExt360EncGop::calculatePSNRs(Picture *pcPic, ThreadPool *pcThreadPool)
 {
   PelUnitBuf recPicYuv = pcPic->getRecoBuf();
   PelUnitBuf orgPicYuv = pcPic->getOrigBuf();
@@ -88,19 +88,21 @@ Void TExt360EncGop::calculatePSNRs(Picture *pcPic)
   readOrigPicYuv(pcPic->getPOC());
   reconstructPicYuv(recPicYuv);
 #endif
+  // each metric only writes its own state, so the enabled ones are computed as independent jobs;
+  std::vector<std::function<Void()>> metricJobs;
 #if SVIDEO_SPSNR_NN
   if(getSPSNRMetric()->getSPSNREnabled())
   {
 #if SVIDEO_E2E_METRICS
-    getSPSNRMetric()->xCalculateSPSNR(*getOrigPicYuv(), *getRecPicYuv());
+    metricJobs.push_back([&]() { getSPSNRMetric()->xCalculateSPSNR(*getOrigPicYuv(), *getRecPicYuv()); });
 #else
-    getSPSNRMetric()->xCalculateSPSNR(orgPicYuv, recPicYuv);
+    metricJobs.push_back([&]() { getSPSNRMetric()->xCalculateSPSNR(orgPicYuv, recPicYuv); });
 #endif
   }
 #if SVIDEO_CODEC_SPSNR_NN
   if(getCodecSPSNRMetric()->getSPSNREnabled())
   {
-    getCodecSPSNRMetric()->xCalculateSPSNR(orgPicYuv, recPicYuv);
+    metricJobs.push_back([&]() { getCodecSPSNRMetric()->xCalculateSPSNR(orgPicYuv, recPicYuv); });
   }
 #endif
 #endif
@@ -110,7 +112,7 @@ Void TExt360EncGop::calculatePSNRs(Picture *pcPic)
 #if SVIDEO_HEMI_PROJECTIONS
     if (!((Int)(m_pRecGeometry->getType()) == SVIDEO_HCMP || (Int)(m_pRecGeometry->getType()) == SVIDEO_HEAC))
 #endif
-    getWSPSNRMetric()->xCalculateWSPSNR(&orgPicYuv, &recPicYuv);
+    metricJobs.push_back([&]() { getWSPSNRMetric()->xCalculateWSPSNR(&orgPicYuv, &recPicYuv); });
   }
 #if SVIDEO_WSPSNR_E2E
   if(getE2EWSPSNRMetric()->getWSPSNREnabled())
@@ -120,9 +122,9 @@ Void TExt360EncGop::calculatePSNRs(Picture *pcPic)
 #endif
 
 #if SVIDEO_E2E_METRICS
-    getE2EWSPSNRMetric()->xCalculateE2EWSPSNR(getRecPicYuv(),  getOrigPicYuv());
+    metricJobs.push_back([&]() { getE2EWSPSNRMetric()->xCalculateE2EWSPSNR(getRecPicYuv(),  getOrigPicYuv()); });
 #else
-    getE2EWSPSNRMetric()->xCalculateE2EWSPSNR(&recPicYuv, pcPic->getPOC());
+    metricJobs.push_back([&]() { getE2EWSPSNRMetric()->xCalculateE2EWSPSNR(&recPicYuv, pcPic->getPOC()); });
 #endif
   }
 #endif
@@ -131,9 +133,9 @@ Void TExt360EncGop::calculatePSNRs(Picture *pcPic)
   if(getSPSNRIMetric()->getSPSNRIEnabled())
   {
 #if SVIDEO_E2E_METRICS
-    getSPSNRIMetric()->xCalculateSPSNRI(getOrigPicYuv(), getRecPicYuv());
+    metricJobs.push_back([&]() { getSPSNRIMetric()->xCalculateSPSNRI(getOrigPicYuv(), getRecPicYuv()); });
 #else
-    getSPSNRIMetric()->xCalculateSPSNRI(&orgPicYuv, &recPicYuv);
+    metricJobs.push_back([&]() { getSPSNRIMetric()->xCalculateSPSNRI(&orgPicYuv, &recPicYuv); });
 #endif
   }
 #endif
@@ -141,9 +143,9 @@ Void TExt360EncGop::calculatePSNRs(Picture *pcPic)
   if(getCPPPSNRMetric()->getCPPPSNREnabled())
   {
 #if SVIDEO_E2E_METRICS
-    getCPPPSNRMetric()->xCalculateCPPPSNR(getOrigPicYuv(), getRecPicYuv());
+    metricJobs.push_back([&]() { getCPPPSNRMetric()->xCalculateCPPPSNR(getOrigPicYuv(), getRecPicYuv()); });
 #else
-    getCPPPSNRMetric()->xCalculateCPPPSNR(&orgPicYuv, &recPicYuv);
+    metricJobs.push_back([&]() { getCPPPSNRMetric()->xCalculateCPPPSNR(&orgPicYuv, &recPicYuv); });
 #endif
   }
 #endif
@@ -151,36 +153,48 @@ Void TExt360EncGop::calculatePSNRs(Picture *pcPic)
   if(getViewPortPSNRMetric()->isEnabled())
   {
 #if SVIDEO_E2E_METRICS
-    getViewPortPSNRMetric()->xCalculatePSNR(pcPic, getOrigPicYuv());
+    metricJobs.push_back([&]() { getViewPortPSNRMetric()->xCalculatePSNR(pcPic, getOrigPicYuv()); });
 #else
-    getViewPortPSNRMetric()->xCalculatePSNR(pcPic);
+    metricJobs.push_back([&]() { getViewPortPSNRMetric()->xCalculatePSNR(pcPic); });
 #endif
   }
 #endif
 #if SVIDEO_DYNAMIC_VIEWPORT_PSNR
   if(getDynamicViewPortPSNRMetric()->isEnabled())
   {
-    getDynamicViewPortPSNRMetric()->xCalculateDynamicViewPSNR(pcPic, getOrigPicYuv());
+    metricJobs.push_back([&]() { getDynamicViewPortPSNRMetric()->xCalculateDynamicViewPSNR(pcPic, getOrigPicYuv()); });
   }
 #endif
 #if SVIDEO_CF_SPSNR_NN
   if(getCFSPSNRMetric()->getSPSNREnabled())
   { 
-    getCFSPSNRMetric()->xCalculateCFSPSNR(getOrigPicYuv(), &recPicYuv);
+    metricJobs.push_back([&]() { getCFSPSNRMetric()->xCalculateCFSPSNR(getOrigPicYuv(), &recPicYuv); });
   }
 #endif
 #if SVIDEO_CF_SPSNR_I
   if(getCFSPSNRIMetric()->getSPSNRIEnabled())
   { 
-    getCFSPSNRIMetric()->xCalculateSPSNRI(getOrigPicYuv(), &recPicYuv);
+    metricJobs.push_back([&]() { getCFSPSNRIMetric()->xCalculateSPSNRI(getOrigPicYuv(), &recPicYuv); });
   }
 #endif
 #if SVIDEO_CF_CPPPSNR
   if(getCFCPPPSNRMetric()->getCPPPSNREnabled())
   { 
-    getCFCPPPSNRMetric()->xCalculateCPPPSNR(getOrigPicYuv(), &recPicYuv);
+    metricJobs.push_back([&]() { getCFCPPPSNRMetric()->xCalculateCPPPSNR(getOrigPicYuv(), &recPicYuv); });
   }
 #endif
+
+  if (pcThreadPool && metricJobs.size() > 1)
+  {
+    pcThreadPool->parallelFor((Int)metricJobs.size(), [&](Int, Int idx) { metricJobs[idx](); });
+  }
+  else
+  {
+    for (auto &job : metricJobs)
+    {
+      job();
+    }
+  }
 }
 
 
@@ -36,6 +36,7 @@
 
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/Picture.h"
+#include "CommonLib/ThreadPool.h"
 //struct Picture;
 class Analyze;
 class EncGOP;
@@ -64,7 +65,7 @@ public:
   TExt360EncGop();
   virtual ~TExt360EncGop();
 
-  Void calculatePSNRs(Picture *pcPic); // Picture should be constant.
+  Void calculatePSNRs(Picture *pcPic, ThreadPool *pcThreadPool = nullptr); // Picture should be constant. The enabled metrics run concurrently on pcThreadPool.
   Void addResult(Analyze &encAnalyze);
 #if SVIDEO_HEX_PSNR_SUPPORT
   Void printPsnr(MsgLevel level, bool printHexPsnr, const char *name, Double *dPsnr);
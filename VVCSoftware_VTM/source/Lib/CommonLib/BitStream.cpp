@@ -58,15 +58,13 @@ OutputBitstream::~OutputBitstream()
 }
 
 InputBitstream::InputBitstream()
-  : m_fifo(), m_emulationPreventionByteLocation(), m_fifoIdx(0), m_numHeldBits(0), m_heldBits(0), m_numBitsRead(0)
+  : m_fifo(), m_emulationPreventionByteLocation(), m_bitPos(0), m_numBitsRead(0)
 { }
 
 InputBitstream::InputBitstream(const InputBitstream &src)
   : m_fifo(src.m_fifo)
   , m_emulationPreventionByteLocation(src.m_emulationPreventionByteLocation)
-  , m_fifoIdx(src.m_fifoIdx)
-  , m_numHeldBits(src.m_numHeldBits)
-  , m_heldBits(src.m_heldBits)
+  , m_bitPos(src.m_bitPos)
   , m_numBitsRead(src.m_numBitsRead)
 { }
 
@@ -76,9 +74,7 @@ InputBitstream::InputBitstream(const InputBitstream &src)
 
 void InputBitstream::resetToStart()
 {
-  m_fifoIdx     = 0;
-  m_numHeldBits = 0;
-  m_heldBits    = 0;
+  m_bitPos      = 0;
   m_numBitsRead = 0;
 }
 
@@ -223,93 +219,32 @@ int OutputBitstream::countStartCodeEmulations()
   return cnt;
 }
 
-/**
- * read numberOfBits from bitstream without updating the bitstream
- * state, storing the result in bits.
- *
- * If reading numberOfBits would overrun the bitstream buffer,
- * the bitstream is effectively padded with sufficient zero-bits to
- * avoid the overrun.
- */
-void InputBitstream::pseudoRead(uint32_t numberOfBits, uint32_t &bits)
+uint32_t InputBitstream::readExpGolomb(uint32_t &numBits)
 {
-  uint32_t savedNumHeldBits = m_numHeldBits;
-  uint8_t  savedHeldBits    = m_heldBits;
-  uint32_t savedFifoIdx     = m_fifoIdx;
-
-  uint32_t numBitsToRead = std::min(numberOfBits, getNumBitsLeft());
-  read(numBitsToRead, bits);
-  bits <<= (numberOfBits - numBitsToRead);
-
-  m_fifoIdx     = savedFifoIdx;
-  m_heldBits    = savedHeldBits;
-  m_numHeldBits = savedNumHeldBits;
-}
-
-void InputBitstream::read(uint32_t numberOfBits, uint32_t &ruiBits)
-{
-  CHECK(numberOfBits > BITS_PER_WORD, "Too many bits read");
-
-  m_numBitsRead += numberOfBits;
-
-  /* NB, bits are extracted from the MSB of each byte. */
-  uint32_t retval = 0;
-  if (numberOfBits <= m_numHeldBits)
+  // the prefix fits in the 32-bit window for all codeNum values below 2^31 - 1
+  const uint32_t window = peekBits(BITS_PER_WORD);
+  if (window != 0)
   {
-    /* n=1, len(H)=7:   -VHH HHHH, shift_down=6, mask=0xfe
-     * n=3, len(H)=7:   -VVV HHHH, shift_down=4, mask=0xf8
-     */
-    retval = m_heldBits >> (m_numHeldBits - numberOfBits);
-    retval &= ~(BYTE_MASK << numberOfBits);
-    m_numHeldBits -= numberOfBits;
-    ruiBits = retval;
-    return;
+    const uint32_t length = BITS_PER_WORD - 1 - floorLog2(window);
+    numBits               = 2 * length + 1;
+    if (numBits <= BITS_PER_WORD)
+    {
+      // the whole codeword 0..01x..x is the value 2^length + suffix = codeNum + 1
+      return read(numBits) - 1;
+    }
+    read(length + 1);
+    return read(length) + (1u << length) - 1;
   }
 
-  /* all num_held_bits will go into retval
-   *   => need to mask leftover bits from previous extractions
-   *   => align retval with top of extracted word */
-  /* n=5, len(H)=3: ---- -VVV, mask=0x07, shift_up=5-3=2,
-   * n=9, len(H)=3: ---- -VVV, mask=0x07, shift_up=9-3=6 */
-  numberOfBits -= m_numHeldBits;
-  retval = m_heldBits & ~(BYTE_MASK << m_numHeldBits);
-  retval <<= numberOfBits;
-
-  /* number of whole bytes that need to be loaded to form retval */
-  /* n=32, len(H)=0, load 4bytes, shift_down=0
-   * n=32, len(H)=1, load 4bytes, shift_down=1
-   * n=31, len(H)=1, load 4bytes, shift_down=1+1
-   * n=8,  len(H)=0, load 1byte,  shift_down=0
-   * n=8,  len(H)=3, load 1byte,  shift_down=3
-   * n=5,  len(H)=1, load 1byte,  shift_down=1+3
-   */
-  uint32_t alignedWord       = 0;
-  uint32_t num_bytes_to_load = (numberOfBits - 1) >> BITS_PER_BYTE_LOG2;
-  CHECK(m_fifoIdx + num_bytes_to_load >= m_fifo.size(), "Exceeded FIFO size");
-
-  switch (num_bytes_to_load)
+  uint32_t length = BITS_PER_WORD;
+  read(BITS_PER_WORD);
+  while (read(1) == 0)
   {
-  case 3:
-    alignedWord = m_fifo[m_fifoIdx++] << 3 * BITS_PER_BYTE;
-  case 2:
-    alignedWord |= m_fifo[m_fifoIdx++] << 2 * BITS_PER_BYTE;
-  case 1:
-    alignedWord |= m_fifo[m_fifoIdx++] << BITS_PER_BYTE;
-  case 0:
-    alignedWord |= m_fifo[m_fifoIdx++];
+    length++;
   }
-
-  /* resolve remainder bits */
-  uint32_t nextNumHeldBits = (BITS_PER_WORD - numberOfBits) % BITS_PER_BYTE;
-
-  /* copy required part of alignedWord into retval */
-  retval |= alignedWord >> nextNumHeldBits;
-
-  /* store held bits */
-  m_numHeldBits = nextNumHeldBits;
-  m_heldBits    = alignedWord;
-
-  ruiBits = retval;
+  numBits = 2 * length + 1;
+  const uint32_t suffix = read(length);
+  return uint32_t(suffix + (uint64_t(1) << length) - 1);
 }
 
 /**
@@ -325,14 +260,10 @@ void OutputBitstream::insertAt(const OutputBitstream& src, uint32_t pos)
 
 uint32_t InputBitstream::readOutTrailingBits ()
 {
-  uint32_t count = 0;
-  uint32_t bits  = 0;
-
-  while (getNumBitsLeft() > 0 && getNumBitsUntilByteAligned() != 0)
-  {
-    count++;
-    read(1, bits);
-  }
+  // the bits up to the next byte boundary are always within the fifo
+  const uint32_t count = getNumBitsUntilByteAligned();
+  m_bitPos += count;
+  m_numBitsRead += count;
   return count;
 }
 
@@ -349,15 +280,16 @@ InputBitstream *InputBitstream::extractSubstream(uint32_t numBits)
   std::vector<uint8_t> &buf = pResult->getFifo();
   buf.reserve((numBits + BITS_PER_BYTE_MASK) >> BITS_PER_BYTE_LOG2);
 
-  if (m_numHeldBits == 0)
+  if (getNumBitsUntilByteAligned() == 0)
   {
+    const size_t   fifoIdx                 = m_bitPos >> BITS_PER_BYTE_LOG2;
     const size_t   currentOutputBufferSize = buf.size();
-    const uint32_t numBytesToReadFromFifo  = std::min<uint32_t>(numBytes, (uint32_t) m_fifo.size() - m_fifoIdx);
+    const uint32_t numBytesToReadFromFifo  = std::min<uint32_t>(numBytes, (uint32_t) (m_fifo.size() - fifoIdx));
     buf.resize(currentOutputBufferSize + numBytes);
     if (!buf.empty())
     {
-      std::copy_n(&m_fifo[m_fifoIdx], numBytesToReadFromFifo, &buf[currentOutputBufferSize]);
-      m_fifoIdx += numBytesToReadFromFifo;
+      std::copy_n(&m_fifo[fifoIdx], numBytesToReadFromFifo, &buf[currentOutputBufferSize]);
+      m_bitPos += BITS_PER_BYTE * numBytesToReadFromFifo;
     }
     if (numBytesToReadFromFifo != numBytes)
     {
@@ -146,6 +146,11 @@ public:
 /**
  * Model of an input bitstream that extracts bits from a predefined
  * bytestream.
+ *
+ * The read position is kept as a bit offset into the fifo. Reads load the
+ * 64-bit big-endian window starting at the current byte and extract the
+ * requested bits from it with shifts only, so there is no held-bits state to
+ * refill and no per-byte branching.
  */
 class InputBitstream
 {
@@ -153,12 +158,37 @@ protected:
   std::vector<uint8_t> m_fifo; /// FIFO for storage of complete bytes
   std::vector<uint32_t>    m_emulationPreventionByteLocation;
 
-  uint32_t m_fifoIdx;   /// Read index into m_fifo
-
-  uint32_t  m_numHeldBits;
-  uint8_t   m_heldBits;
+  size_t    m_bitPos;   /// Read position in bits from the start of m_fifo
   uint32_t  m_numBitsRead;
 
+  /**
+   * returns the 64 bits starting at byte position bytePos, MSB first. Bytes
+   * beyond the end of the fifo are read as zero.
+   */
+  uint64_t loadWindow(size_t bytePos) const
+  {
+    if (bytePos + sizeof(uint64_t) <= m_fifo.size())
+    {
+      const uint8_t *p = m_fifo.data() + bytePos;
+      return (uint64_t) p[0] << 56 | (uint64_t) p[1] << 48 | (uint64_t) p[2] << 40 | (uint64_t) p[3] << 32
+             | (uint64_t) p[4] << 24 | (uint64_t) p[5] << 16 | (uint64_t) p[6] << 8 | (uint64_t) p[7];
+    }
+
+    uint64_t window = 0;
+    for (size_t i = 0; i < sizeof(uint64_t); i++)
+    {
+      window = (window << 8) | (bytePos + i < m_fifo.size() ? m_fifo[bytePos + i] : 0);
+    }
+    return window;
+  }
+
+  /** returns the next numberOfBits (1..32) bits without consuming them */
+  uint32_t peekWindow(uint32_t numberOfBits) const
+  {
+    const uint64_t window = loadWindow(m_bitPos >> BITS_PER_BYTE_LOG2) << (m_bitPos & BITS_PER_BYTE_MASK);
+    return uint32_t(window >> (64 - numberOfBits));
+  }
+
 public:
   /**
    * Create a new bitstream reader object that reads from buf.
@@ -166,16 +196,33 @@ public:
   InputBitstream();
   virtual ~InputBitstream() { }
   InputBitstream(const InputBitstream &src);
+  InputBitstream(InputBitstream &&src) = default;
+
+  InputBitstream &operator=(const InputBitstream &src) = default;
+  InputBitstream &operator=(InputBitstream &&src)      = default;
 
   void resetToStart();
 
   // interface for decoding
-  void        pseudoRead(uint32_t numberOfBits, uint32_t &bits);
-  void        read(uint32_t numberOfBits, uint32_t &ruiBits);
+  void        pseudoRead(uint32_t numberOfBits, uint32_t &bits) { bits = numberOfBits ? peekWindow(numberOfBits) : 0; }
+  void        read(uint32_t numberOfBits, uint32_t &ruiBits)
+  {
+    CHECK(numberOfBits > BITS_PER_WORD, "Too many bits read");
+    CHECK(m_bitPos + numberOfBits > BITS_PER_BYTE * m_fifo.size(), "Exceeded FIFO size");
+
+    ruiBits = numberOfBits ? peekWindow(numberOfBits) : 0;
+    m_bitPos += numberOfBits;
+    m_numBitsRead += numberOfBits;
+  }
+
+  /** reads the next byte. The read position must be byte aligned. */
   void        readByte        ( uint32_t &ruiBits )
   {
-    CHECK(m_fifoIdx >= m_fifo.size(), "FIFO exceeded");
-    ruiBits = m_fifo[m_fifoIdx++];
+    const size_t bytePos = m_bitPos >> BITS_PER_BYTE_LOG2;
+    CHECKD(m_bitPos & BITS_PER_BYTE_MASK, "Reading a byte at an unaligned position");
+    CHECK(bytePos >= m_fifo.size(), "FIFO exceeded");
+    ruiBits = m_fifo[bytePos];
+    m_bitPos += BITS_PER_BYTE;
 #if ENABLE_TRACING
     m_numBitsRead += 8;
 #endif
@@ -183,14 +230,14 @@ public:
 
   void        peekPreviousByte( uint32_t &byte )
   {
-    CHECK(m_fifoIdx == 0, "FIFO empty");
-    byte = m_fifo[m_fifoIdx - 1];
+    CHECK(getByteLocation() == 0, "FIFO empty");
+    byte = m_fifo[getByteLocation() - 1];
   }
 
   uint32_t        readOutTrailingBits ();
-  uint8_t          getHeldBits() { return m_heldBits; }
+  uint8_t          getHeldBits() { return getNumBitsUntilByteAligned() ? m_fifo[m_bitPos >> BITS_PER_BYTE_LOG2] : 0; }
   OutputBitstream& operator= (const OutputBitstream& src);
-  uint32_t         getByteLocation() { return m_fifoIdx; }
+  uint32_t         getByteLocation() { return uint32_t((m_bitPos + BITS_PER_BYTE_MASK) >> BITS_PER_BYTE_LOG2); }
 
   // Peek at bits in word-storage. Used in determining if we have completed reading of current bitstream and therefore slice in LCEC.
   uint32_t peekBits(uint32_t bits)
@@ -200,11 +247,17 @@ public:
     return tmp;
   }
 
+  /**
+   * reads an Exp-Golomb code and returns its codeNum. numBits is set to the
+   * number of bits read.
+   */
+  uint32_t readExpGolomb(uint32_t &numBits);
+
   // utility functions
   uint32_t read(uint32_t numberOfBits)      { uint32_t tmp; read(numberOfBits, tmp); return tmp; }
   uint32_t readByte()                   { uint32_t tmp; readByte( tmp ); return tmp; }
-  uint32_t        getNumBitsUntilByteAligned() { return m_numHeldBits & (0x7); }
-  uint32_t        getNumBitsLeft() { return 8 * ((uint32_t) m_fifo.size() - m_fifoIdx) + m_numHeldBits; }
+  uint32_t        getNumBitsUntilByteAligned() { return uint32_t(-m_bitPos) & BITS_PER_BYTE_MASK; }
+  uint32_t        getNumBitsLeft() { return uint32_t(BITS_PER_BYTE * m_fifo.size() - m_bitPos); }
   InputBitstream *extractSubstream(uint32_t numBits);   // Read the nominated number of bits, and return as a bitstream.
   uint32_t  getNumBitsRead()            { return m_numBitsRead; }
   uint32_t  readByteAlignment();
@@ -257,6 +257,72 @@ void linTfCore(const T *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride,
 #undef LINTF_CORE_INC
 }
 
+void addWeightedAvgCore(const Pel *src0, ptrdiff_t src0Stride, const Pel *src1, ptrdiff_t src1Stride, Pel *dst,
+                        ptrdiff_t dstStride, int width, int height, int w0, int w1, int shift, int offset,
+                        const ClpRng &clpRng)
+{
+#define ADD_WGHT_AVG_CORE_OP( ADDR ) dst[ADDR] = ClipPel( ( src0[ADDR] * w0 + src1[ADDR] * w1 + offset ) >> shift, clpRng )
+#define ADD_WGHT_AVG_CORE_INC \
+  src0 += src0Stride;         \
+  src1 += src1Stride;         \
+  dst  += dstStride;          \
+
+  SIZE_AWARE_PER_EL_OP( ADD_WGHT_AVG_CORE_OP, ADD_WGHT_AVG_CORE_INC );
+
+#undef ADD_WGHT_AVG_CORE_OP
+#undef ADD_WGHT_AVG_CORE_INC
+}
+
+void weightUniCore(const Pel *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride, int width, int height, int w0,
+                   int shift, int offset, int postOffset, const ClpRng &clpRng)
+{
+#define WGHT_UNI_CORE_OP( ADDR ) dst[ADDR] = ClipPel( ( ( src[ADDR] * w0 + offset ) >> shift ) + postOffset, clpRng )
+#define WGHT_UNI_CORE_INC \
+  src += srcStride;       \
+  dst += dstStride;       \
+
+  SIZE_AWARE_PER_EL_OP( WGHT_UNI_CORE_OP, WGHT_UNI_CORE_INC );
+
+#undef WGHT_UNI_CORE_OP
+#undef WGHT_UNI_CORE_INC
+}
+
+void rspPwlCore(const Pel *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride, int width, int height,
+                const ReshapePwl &pwl)
+{
+  const Pel *lut = pwl.lut;
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      dst[x] = lut[Clip3<int>(0, pwl.maxVal, src[x])];
+    }
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+
+void crsInvCore(Pel *buf, ptrdiff_t stride, int width, int height, int scale, const ClpRng &clpRng)
+{
+  const int maxAbsclipBD = (1 << clpRng.bd) - 1;
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      const int val    = Clip3(-maxAbsclipBD - 1, maxAbsclipBD, (int) buf[x]);
+      const int sign   = sgn2(val);
+      const int absval = sign * val;
+      int       res    = sign * ((absval * scale + (1 << (CSCALE_FP_PREC - 1))) >> CSCALE_FP_PREC);
+      if (sizeof(Pel) == 2)   // avoid overflow when storing data
+      {
+        res = Clip3<int>(-32768, 32767, res);
+      }
+      buf[x] = (Pel) res;
+    }
+    buf += stride;
+  }
+}
+
 PelBufferOps::PelBufferOps()
 {
   addAvg4 = addAvgCore<Pel>;
@@ -268,6 +334,11 @@ PelBufferOps::PelBufferOps()
   linTf4 = linTfCore<Pel>;
   linTf8 = linTfCore<Pel>;
 
+  addWeightedAvg4 = addWeightedAvgCore;
+  addWeightedAvg8 = addWeightedAvgCore;
+  weightUni4      = weightUniCore;
+  weightUni8      = weightUniCore;
+
   addBIOAvg4      = addBIOAvgCore;
   bioGradFilter   = gradFilterCore;
   calcBIOSums = calcBIOSumsCore;
@@ -284,6 +355,11 @@ PelBufferOps::PelBufferOps()
   profGradFilter = gradFilterCore <false>;
   applyPROF      = applyPROFCore;
   roundIntVector = nullptr;
+
+  rspPwl4 = rspPwlCore;
+  rspPwl8 = rspPwlCore;
+  crsInv4 = crsInvCore;
+  crsInv8 = crsInvCore;
 }
 
 PelBufferOps g_pelBufOP = PelBufferOps();
@@ -339,32 +415,59 @@ void AreaBuf<Pel>::addWeightedAvg(const AreaBuf<const Pel> &other1, const AreaBu
   const int shiftNum = IF_INTERNAL_FRAC_BITS(clipbd) + log2WeightBase;
   const int offset = (1 << (shiftNum - 1)) + (IF_INTERNAL_OFFS << log2WeightBase);
 
+#if ENABLE_SIMD_OPT_BUFFER && defined(TARGET_SIMD_X86)
+  if ((width & 7) == 0)
+  {
+    g_pelBufOP.addWeightedAvg8(src0, src1Stride, src2, src2Stride, dest, destStride, width, height, w0, w1, shiftNum,
+                               offset, clpRng);
+  }
+  else if ((width & 3) == 0)
+  {
+    g_pelBufOP.addWeightedAvg4(src0, src1Stride, src2, src2Stride, dest, destStride, width, height, w0, w1, shiftNum,
+                               offset, clpRng);
+  }
+  else
+#endif
+  {
 #define ADD_AVG_OP( ADDR ) dest[ADDR] = ClipPel( rightShift( ( src0[ADDR]*w0 + src2[ADDR]*w1 + offset ), shiftNum ), clpRng )
 #define ADD_AVG_INC     \
     src0 += src1Stride; \
     src2 += src2Stride; \
     dest += destStride; \
 
-  SIZE_AWARE_PER_EL_OP(ADD_AVG_OP, ADD_AVG_INC);
+    SIZE_AWARE_PER_EL_OP(ADD_AVG_OP, ADD_AVG_INC);
 
 #undef ADD_AVG_OP
 #undef ADD_AVG_INC
+  }
 }
 
 template<>
-void AreaBuf<Pel>::rspSignal(std::vector<Pel>& pLUT)
+void AreaBuf<Pel>::rspSignal(const AreaBuf<const Pel> &src, const ReshapePwl& pwl)
 {
-  Pel* dst = buf;
-  Pel* src = buf;
-  for (unsigned y = 0; y < height; y++)
+  CHECK(width != src.width || height != src.height, "Incompatible size");
+  CHECK(pwl.lut == nullptr, "LMCS mapping not initialized");
+
+#if ENABLE_SIMD_OPT_BUFFER && defined(TARGET_SIMD_X86)
+  if (pwl.valid && (width & 7) == 0)
   {
-    for (unsigned x = 0; x < width; x++)
-    {
-      dst[x] = pLUT[src[x]];
-    }
-    dst += stride;
-    src += stride;
+    g_pelBufOP.rspPwl8(src.buf, src.stride, buf, stride, width, height, pwl);
   }
+  else if (pwl.valid && (width & 3) == 0)
+  {
+    g_pelBufOP.rspPwl4(src.buf, src.stride, buf, stride, width, height, pwl);
+  }
+  else
+#endif
+  {
+    rspPwlCore(src.buf, src.stride, buf, stride, width, height, pwl);
+  }
+}
+
+template<>
+void AreaBuf<Pel>::rspSignal(const ReshapePwl& pwl)
+{
+  rspSignal(*this, pwl);
 }
 
 template<>
@@ -398,22 +501,19 @@ void AreaBuf<Pel>::scaleSignal(const int scale, const bool dir, const ClpRng& cl
   }
   else // inverse
   {
-    for (unsigned y = 0; y < height; y++)
+#if ENABLE_SIMD_OPT_BUFFER && defined(TARGET_SIMD_X86)
+    if ((width & 7) == 0)
     {
-      for (unsigned x = 0; x < width; x++)
-      {
-        src[x] = (Pel)Clip3((Pel)(-maxAbsclipBD - 1), (Pel)maxAbsclipBD, src[x]);
-        const int sign = sgn2(src[x]);
-        absval = sign * src[x];
-        int val = sign * ((absval * scale + (1 << (CSCALE_FP_PREC - 1))) >> CSCALE_FP_PREC);
-        if (sizeof(Pel) == 2) // avoid overflow when storing data
-        {
-           val = Clip3<int>(-32768, 32767, val);
-        }
-        dst[x] = (Pel)val;
-      }
-      dst += stride;
-      src += stride;
+      g_pelBufOP.crsInv8(buf, stride, width, height, scale, clpRng);
+    }
+    else if ((width & 3) == 0)
+    {
+      g_pelBufOP.crsInv4(buf, stride, width, height, scale, clpRng);
+    }
+    else
+#endif
+    {
+      crsInvCore(buf, stride, width, height, scale, clpRng);
     }
   }
 }
@@ -655,8 +755,17 @@ void AreaBuf<Pel>::reconstruct( const AreaBuf<const Pel> &pred, const AreaBuf<co
 template<>
 void AreaBuf<Pel>::linearTransform( const int scale, const int shift, const int offset, bool bClip, const ClpRng& clpRng )
 {
-  const Pel* src = buf;
-        Pel* dst = buf;
+  linearTransform( *this, scale, shift, offset, bClip, clpRng );
+}
+
+template<>
+void AreaBuf<Pel>::linearTransform( const AreaBuf<const Pel> &other, const int scale, const int shift, const int offset, bool bClip, const ClpRng& clpRng )
+{
+  CHECK( width != other.width || height != other.height, "Incompatible size" );
+
+  const Pel*      src       = other.buf;
+  const ptrdiff_t srcStride = other.stride;
+        Pel*      dst       = buf;
 
   if( width == 1 )
   {
@@ -665,18 +774,18 @@ void AreaBuf<Pel>::linearTransform( const int scale, const int shift, const int
 #if ENABLE_SIMD_OPT_BUFFER && defined(TARGET_SIMD_X86)
   else if( ( width & 7 ) == 0 )
   {
-    g_pelBufOP.linTf8( src, stride, dst, stride, width, height, scale, shift, offset, clpRng, bClip );
+    g_pelBufOP.linTf8( src, srcStride, dst, stride, width, height, scale, shift, offset, clpRng, bClip );
   }
   else if( ( width & 3 ) == 0 )
   {
-    g_pelBufOP.linTf4( src, stride, dst, stride, width, height, scale, shift, offset, clpRng, bClip );
+    g_pelBufOP.linTf4( src, srcStride, dst, stride, width, height, scale, shift, offset, clpRng, bClip );
   }
 #endif
   else
   {
 #define LINTF_OP( ADDR ) dst[ADDR] = ( Pel ) bClip ? ClipPel( rightShift( scale * src[ADDR], shift ) + offset, clpRng ) : ( rightShift( scale * src[ADDR], shift ) + offset )
 #define LINTF_INC        \
-    src += stride;       \
+    src += srcStride;    \
     dst += stride;       \
 
     SIZE_AWARE_PER_EL_OP( LINTF_OP, LINTF_INC );
@@ -702,6 +811,7 @@ PelStorage::PelStorage()
   {
     m_origin[i] = nullptr;
   }
+  m_allocatedSize = 0;
 }
 
 PelStorage::~PelStorage()
@@ -754,6 +864,7 @@ void PelStorage::create( const ChromaFormat &_chromaFormat, const Area& _area, c
     CHECK( !area, "Trying to create a buffer with zero area" );
 
     m_origin[i] = ( Pel* ) xMalloc( Pel, area );
+    m_allocatedSize += area * sizeof( Pel );
     Pel* topLeft = m_origin[i] + totalWidth * ymargin + xmargin;
     bufs.push_back( PelBuf( topLeft, totalWidth, _area.width >> scaleX, _area.height >> scaleY ) );
   }
@@ -789,6 +900,7 @@ void PelStorage::swap( PelStorage& other )
     std::swap( bufs[i].stride, other.bufs[i].stride );
     std::swap( m_origin[i],    other.m_origin[i] );
   }
+  std::swap( m_allocatedSize, other.m_allocatedSize );
 }
 
 void PelStorage::destroy()
@@ -802,6 +914,7 @@ void PelStorage::destroy()
       m_origin[i] = nullptr;
     }
   }
+  m_allocatedSize = 0;
   bufs.clear();
 }
 
@@ -52,6 +52,25 @@
 // AreaBuf struct
 // ---------------------------------------------------------------------------
 
+// piecewise-linear form of an LMCS mapping LUT, evaluated without table gathers:
+//   idx = (log2BinLen > 0) ? x >> log2BinLen : binBase + #{ k < numThresholds : x >= thresholds[k] }
+//   y   = Clip3( 0, maxVal, outPivot[idx] + ( ( scale[idx] * ( x - inPivot[idx] ) + ( 1 << ( FP_PREC - 1 ) ) ) >> FP_PREC ) )
+struct ReshapePwl
+{
+  bool       valid;          // the PWL reproduces lut bit-exactly, otherwise lut is used
+  int        log2BinLen;     // > 0 for uniform input bins (forward mapping)
+  int        binBase;
+  int        numThresholds;
+  int        maxVal;
+  int16_t    thresholds[PIC_CODE_CW_BINS];
+  int16_t    inPivot   [PIC_CODE_CW_BINS];
+  int16_t    outPivot  [PIC_CODE_CW_BINS];
+  int16_t    scale     [PIC_CODE_CW_BINS];
+  const Pel *lut;
+
+  ReshapePwl() : valid( false ), log2BinLen( 0 ), binBase( 0 ), numThresholds( 0 ), maxVal( 0 ), lut( nullptr ) {}
+};
+
 struct PelBufferOps
 {
   PelBufferOps();
@@ -74,6 +93,18 @@ struct PelBufferOps
                  int shift, int offset, const ClpRng &clpRng, bool bClip);
   void (*linTf8)(const Pel *src0, ptrdiff_t src0Stride, Pel *dst, ptrdiff_t dstStride, int width, int height, int scale,
                  int shift, int offset, const ClpRng &clpRng, bool bClip);
+  // dst = clip((w0 * src0 + w1 * src1 + offset) >> shift), BCW and explicit weighted bi-prediction
+  void (*addWeightedAvg4)(const Pel *src0, ptrdiff_t src0Stride, const Pel *src1, ptrdiff_t src1Stride, Pel *dst,
+                          ptrdiff_t dstStride, int width, int height, int w0, int w1, int shift, int offset,
+                          const ClpRng &clpRng);
+  void (*addWeightedAvg8)(const Pel *src0, ptrdiff_t src0Stride, const Pel *src1, ptrdiff_t src1Stride, Pel *dst,
+                          ptrdiff_t dstStride, int width, int height, int w0, int w1, int shift, int offset,
+                          const ClpRng &clpRng);
+  // dst = clip(((w0 * src + offset) >> shift) + postOffset), explicit weighted uni-prediction
+  void (*weightUni4)(const Pel *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride, int width, int height, int w0,
+                     int shift, int offset, int postOffset, const ClpRng &clpRng);
+  void (*weightUni8)(const Pel *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride, int width, int height, int w0,
+                     int shift, int offset, int postOffset, const ClpRng &clpRng);
   void (*addBIOAvg4)(const Pel *src0, ptrdiff_t src0Stride, const Pel *src1, ptrdiff_t src1Stride, Pel *dst,
                      ptrdiff_t dstStride, const Pel *gradX0, const Pel *gradX1, const Pel *gradY0, const Pel *gradY1,
                      ptrdiff_t gradStride, int width, int height, int tmpx, int tmpy, int shift, int offset,
@@ -107,6 +138,12 @@ struct PelBufferOps
                     const Pel *gradX, const Pel *gradY, ptrdiff_t gradStride, const int *dMvX, const int *dMvY,
                     ptrdiff_t dMvStride, const bool bi, int shiftNum, Pel offset, const ClpRng &clpRng);
   void (*roundIntVector) (int* v, int size, unsigned int nShift, const int dmvLimit);
+  void (*rspPwl4)(const Pel *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride, int width, int height,
+                  const ReshapePwl &pwl);
+  void (*rspPwl8)(const Pel *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride, int width, int height,
+                  const ReshapePwl &pwl);
+  void (*crsInv4)(Pel *buf, ptrdiff_t stride, int width, int height, int scale, const ClpRng &clpRng);
+  void (*crsInv8)(Pel *buf, ptrdiff_t stride, int width, int height, int scale, const ClpRng &clpRng);
 };
 
 extern PelBufferOps g_pelBufOP;
@@ -157,12 +194,14 @@ struct AreaBuf : public Size
   void subtract             ( const T val );
 
   void linearTransform      ( const int scale, const int shift, const int offset, bool bClip, const ClpRng& clpRng );
+  void linearTransform      ( const AreaBuf<const T> &other, const int scale, const int shift, const int offset, bool bClip, const ClpRng& clpRng );
 
   void transposedFrom       ( const AreaBuf<const T> &other );
 
   void toLast               ( const ClpRng& clpRng );
 
-  void rspSignal            ( std::vector<Pel>& pLUT );
+  void rspSignal            ( const ReshapePwl& pwl );
+  void rspSignal            ( const AreaBuf<const T> &src, const ReshapePwl& pwl );
   void scaleSignal          ( const int scale, const bool dir , const ClpRng& clpRng);
   void applyLumaCTI(std::vector<Pel>& pLUTY);
   void applyChromaCTI(Pel *bufY, ptrdiff_t strideY, std::vector<Pel> &pLUTUV, int bitDepth, ChromaFormat chrFormat,
@@ -399,6 +438,15 @@ void AreaBuf<T>::linearTransform( const int scale, const int shift, const int of
 template<>
 void AreaBuf<Pel>::linearTransform( const int scale, const int shift, const int offset, bool bClip, const ClpRng& clpRng );
 
+template<typename T>
+void AreaBuf<T>::linearTransform( const AreaBuf<const T> &other, const int scale, const int shift, const int offset, bool bClip, const ClpRng& clpRng )
+{
+  THROW( "Type not supported" );
+}
+
+template<>
+void AreaBuf<Pel>::linearTransform( const AreaBuf<const Pel> &other, const int scale, const int shift, const int offset, bool bClip, const ClpRng& clpRng );
+
 template<typename T>
 void AreaBuf<T>::toLast( const ClpRng& clpRng )
 {
@@ -1014,8 +1062,11 @@ struct PelStorage : public PelUnitBuf
 
   Pel *getOrigin(const int id) const { return m_origin[id]; }
 
+  size_t getAllocatedSize() const { return m_allocatedSize; }   // in bytes, including margins and alignment
+
 private:
   Pel *m_origin[MAX_NUM_COMPONENT];
+  size_t m_allocatedSize;
 };
 
 struct CompStorage : public PelBuf
@@ -43,8 +43,6 @@
 #include "UnitTools.h"
 #include "UnitPartitioner.h"
 
-XuPool g_xuPool = XuPool();
-
 // ---------------------------------------------------------------------------
 // coding structure method definitions
 // ---------------------------------------------------------------------------
@@ -55,6 +53,7 @@ CodingStructure::CodingStructure(XuPool &xuPool)
   , parent(nullptr)
   , bestCS(nullptr)
   , m_isTuEnc(false)
+  , m_xuPool(xuPool)
   , m_cuPool(xuPool.cuPool)
   , m_puPool(xuPool.puPool)
   , m_tuPool(xuPool.tuPool)
@@ -1918,6 +1917,7 @@ void CodingStructure::clearPUs()
 
   m_puPool.giveBack(pus);
   m_numPUs = 0;
+  m_nbStripCtu = Area();
 
   for( auto &pcu : cus )
   {
@@ -2147,7 +2147,14 @@ const CodingUnit* CodingStructure::getCURestricted( const Position &pos, const P
 
 const PredictionUnit* CodingStructure::getPURestricted( const Position &pos, const PredictionUnit& curPu, const ChannelType _chType ) const
 {
-  const PredictionUnit* pu = getPU( pos, _chType );
+  const PredictionUnit* pu = nullptr;
+  // the units left of and above the CTU are read from the strip of the picture level structure instead of walking up
+  // the parent structures to it
+  if( picture == nullptr || picture->cs == nullptr || !picture->cs->xGetNeighbourStripPU( pos, curPu, _chType, pu ) )
+  {
+    pu = getPU( pos, _chType );
+  }
+  CHECKD( pu != getPU( pos, _chType ), "Neighbour strip does not match the PU map" );
   // exists       same slice and tile                  pu precedes curPu in encoding order
   //                                                  (thus, is either from parent CS in RD-search or its index is lower)
   const bool wavefrontsEnabled = curPu.cu->slice->getSPS()->getEntropyCodingSyncEnabledFlag();
@@ -2165,6 +2172,54 @@ const PredictionUnit* CodingStructure::getPURestricted( const Position &pos, con
   }
 }
 
+void CodingStructure::initNeighbourStrip( const Area &ctuArea )
+{
+  CHECK( parent != nullptr, "The neighbour strip is kept by the picture level structure" );
+
+  const UnitScale &scale    = unitScale[COMPONENT_Y];
+  const int        unitW    = 1 << scale.posx;
+  const int        unitH    = 1 << scale.posy;
+  const int        numLeft  = scale.scaleVer( ctuArea.height ) + 2;
+  const int        numAbove = scale.scaleHor( ctuArea.width ) + 2;
+
+  m_nbStripCtu = ctuArea;
+  m_nbStrip.resize( numLeft + numAbove );
+
+  for( int i = 0; i < numLeft; i++ )
+  {
+    m_nbStrip[i] = getPU( Position( ctuArea.x - unitW, ctuArea.y + ( i - 1 ) * unitH ), ChannelType::LUMA );
+  }
+  for( int i = 0; i < numAbove; i++ )
+  {
+    m_nbStrip[numLeft + i] = getPU( Position( ctuArea.x + ( i - 1 ) * unitW, ctuArea.y - unitH ), ChannelType::LUMA );
+  }
+}
+
+bool CodingStructure::xGetNeighbourStripPU( const Position &pos, const PredictionUnit &curPu, const ChannelType _chType, const PredictionUnit *&pu ) const
+{
+  if( _chType != ChannelType::LUMA || !isLuma( curPu.chType ) || !m_nbStripCtu.contains( curPu.lumaPos() ) )
+  {
+    return false;
+  }
+
+  const UnitScale &scale   = unitScale[COMPONENT_Y];
+  const Position   unitPos = scale.scale( pos );
+  const Position   ctuPos  = scale.scale( m_nbStripCtu.pos() );
+  const int        numLeft = scale.scaleVer( m_nbStripCtu.height ) + 2;
+
+  if( unitPos.x == ctuPos.x - 1 && unitPos.y >= ctuPos.y - 1 && unitPos.y - ctuPos.y + 1 < numLeft )
+  {
+    pu = m_nbStrip[unitPos.y - ctuPos.y + 1];
+    return true;
+  }
+  if( unitPos.y == ctuPos.y - 1 && unitPos.x >= ctuPos.x - 1 && unitPos.x - ctuPos.x + 1 < (int) m_nbStrip.size() - numLeft )
+  {
+    pu = m_nbStrip[numLeft + unitPos.x - ctuPos.x + 1];
+    return true;
+  }
+  return false;
+}
+
 const TransformUnit* CodingStructure::getTURestricted( const Position &pos, const TransformUnit& curTu, const ChannelType _chType ) const
 {
   const TransformUnit* tu = getTU( pos, _chType );
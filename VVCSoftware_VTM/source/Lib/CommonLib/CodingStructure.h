@@ -68,7 +68,6 @@ enum PictureType
 #endif
   NUM_PIC_TYPES
 };
-extern XuPool g_xuPool;
 
 // ---------------------------------------------------------------------------
 // coding structure
@@ -105,6 +104,8 @@ public:
 
   CodingStructure(XuPool &);
 
+  XuPool &getXuPool() const { return m_xuPool; }
+
   void create(const UnitArea &_unit, const bool isTopLayer, const bool isPLTused);
   void create(const ChromaFormat &_chromaFormat, const Area& _area, const bool isTopLayer, const bool isPLTused);
 
@@ -207,6 +208,7 @@ public:
 #endif
   
   void initStructData  (const int &QP = MAX_INT, const bool &skipMotBuf = false);
+  void initNeighbourStrip(const Area &ctuArea);
   void initSubStructure(      CodingStructure& cs, const ChannelType chType, const UnitArea &subArea, const bool &isTuEnc);
 
   void copyStructure   (const CodingStructure& cs, const ChannelType chType, const bool copyTUs = false, const bool copyRecoBuffer = false);
@@ -257,6 +259,7 @@ private:
   unsigned m_numPUs;
   unsigned m_numTUs;
 
+  XuPool &m_xuPool;
   CuPool &m_cuPool;
   PuPool &m_puPool;
   TuPool &m_tuPool;
@@ -275,6 +278,13 @@ private:
 
   MotionInfo *m_motionBuf;
 
+  // luma PUs of the units left of the CTU being coded (from above-left to below-left), followed by those above it (from
+  // above-left to above-right), kept by the picture level structure for the restricted lookups of the CTU's PUs
+  Area                                 m_nbStripCtu;
+  std::vector<const PredictionUnit *>  m_nbStrip;
+
+  bool xGetNeighbourStripPU(const Position &pos, const PredictionUnit &curPu, const ChannelType _chType, const PredictionUnit *&pu) const;
+
 public:
   CodingStructure *bestParent;
   double        tmpColorSpaceCost;
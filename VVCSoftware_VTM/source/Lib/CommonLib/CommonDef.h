@@ -166,6 +166,7 @@ static constexpr int IBC_REF_IDX        = MAX_NUM_ACTIVE_REF;
 template<class T> using RefSetArray = T[NUM_REF_PIC_LIST_01][MAX_NUM_REF];
 
 static constexpr int MAX_QP =                                          63;
+static constexpr int SSIM_WINDOW_SIZE =                               11; ///< width and height of the Gaussian window of the (MS-)SSIM metric
 static constexpr int NOT_VALID =                                       -1;
 
 
@@ -887,6 +888,7 @@ typedef enum{
 
 X86_VEXT read_x86_extension_flags(const std::string &extStrId = std::string());
 const char* read_x86_extension(const std::string &extStrId);
+X86_VEXT _get_x86_extensions();   // highest level supported by the CPU, independent of the level selected above
 #endif //TARGET_SIMD_X86
 #endif //ENABLE_SIMD_OPT
 
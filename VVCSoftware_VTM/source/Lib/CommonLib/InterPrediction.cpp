@@ -1640,18 +1640,31 @@ void InterPrediction::xDmvrPad(const PredictionUnit &pu)
   }
 }
 
-constexpr InterPrediction::DmvrDist InterPrediction::UNDEFINED_DMVR_DIST;
-
 void InterPrediction::xDmvrIntegerRefine(int bd, DmvrDist &minCost, Mv &deltaMv, DmvrDist *sadPtr, int width,
                                          int height)
 {
+  // all candidates of the search window in one pass, the centre keeps the biased cost provided by the caller
+  const Pel *p0 = m_dmvrInitialPred[REF_PIC_LIST_0].bufAt(DMVR_RANGE, DMVR_RANGE);
+  const Pel *p1 = m_dmvrInitialPred[REF_PIC_LIST_1].bufAt(DMVR_RANGE, DMVR_RANGE);
+
+  const ptrdiff_t s0 = m_dmvrInitialPred[REF_PIC_LIST_0].stride;
+  const ptrdiff_t s1 = m_dmvrInitialPred[REF_PIC_LIST_1].stride;
+
+  DistParam cDistParam;
+  cDistParam.applyWeight = false;
+  cDistParam.useMR = false;
+  m_pcRdCost->setDistParam(cDistParam, p0, p1, s0, s1, bd, COMPONENT_Y, width, height, 1);
+
+  std::array<Distortion, DMVR_AREA> dist;
+  m_pcRdCost->getSADsDmvr(cDistParam, dist.data());
+
   for (const auto &mvd: m_dmvrSearchOffsets)
   {
     const int32_t sadOffset = mvd.ver * DMVR_SPAN + mvd.hor;
 
-    if (sadPtr[sadOffset] == UNDEFINED_DMVR_DIST)
+    if (sadOffset != 0)
     {
-      sadPtr[sadOffset] = xDmvrCost(bd, mvd, width, height);
+      sadPtr[sadOffset] = DmvrDist(dist[DMVR_AREA / 2 + sadOffset] >> 1);
     }
     if (sadPtr[sadOffset] < minCost)
     {
@@ -1749,21 +1762,11 @@ Mv InterPrediction::xDmvrSubpelRefine(const DmvrDist *sadPtr)
       if (s1 != s0 && s2 != s0)
       {
         const DmvrDist num  = ((s1 - s2) << MV_FRACTIONAL_BITS_INTERNAL) >> 1;
-        DmvrDist       rem  = abs(num);
+        const DmvrDist rem  = abs(num);
         const bool     sign = num < 0;
 
-        int q = 0;
-
-        for (int i = 2; i >= 0; i--)
-        {
-          const DmvrDist div = den << i;
-
-          if (rem >= div)
-          {
-            rem -= div;
-            q += 1 << i;
-          }
-        }
+        // s0 is the minimum, so |s1 - s2| < den and the quotient is below 2^MV_FRACTIONAL_BITS_INTERNAL / 2
+        const int q = int(rem / den);
 
         return sign ? -q : q;
       }
@@ -1961,7 +1964,6 @@ void InterPrediction::xProcessDMVR(PredictionUnit &pu, PelUnitBuf &pcYuvDst, con
 #endif
 
       std::array<DmvrDist, DMVR_AREA> sads;
-      sads.fill(UNDEFINED_DMVR_DIST);
       DmvrDist *sadPtr = &sads[sads.size() / 2];
 
       DmvrDist minCost = xDmvrCost(clpRngs.comp[COMPONENT_Y].bd, Mv(), dx, dy);
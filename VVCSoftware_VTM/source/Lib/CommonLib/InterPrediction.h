@@ -272,7 +272,6 @@ public:
   // DMVR related definitions
   using DmvrDist = int32_t;
 
-  static constexpr DmvrDist UNDEFINED_DMVR_DIST = -1;
 #if JVET_AD0045
   bool     dmvrEnableEncoderCheck;
   void     xDmvrSetEncoderCheckFlag(bool enableFlag) { dmvrEnableEncoderCheck = enableFlag; }
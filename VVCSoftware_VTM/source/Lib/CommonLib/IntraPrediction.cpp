@@ -84,6 +84,16 @@ IntraPrediction::IntraPrediction() : m_currChromaFormat(ChromaFormat::UNDEFINED)
 
   m_piTemp = nullptr;
   m_pMdlmTemp = nullptr;
+
+  m_cclmDsFilter3Tap = xCclmDsFilter3Tap;
+  m_cclmDsFilter5Tap = xCclmDsFilter5Tap;
+  m_cclmDsFilter6Tap = xCclmDsFilter6Tap;
+
+#if ENABLE_SIMD_OPT_CCLM
+#ifdef TARGET_SIMD_X86
+  initIntraPredictionX86();
+#endif
+#endif
 }
 
 IntraPrediction::~IntraPrediction()
@@ -283,8 +293,7 @@ void IntraPrediction::predIntraChromaLM(const ComponentID compID, PelBuf &piPred
   xGetLMParameters(pu, compID, chromaArea, a, b, shift);
 
   // final prediction
-  piPred.copyFrom(temp);
-  piPred.linearTransform(a, shift, b, true, pu.cs->slice->clpRng(compID));
+  piPred.linearTransform(temp, a, shift, b, true, pu.cs->slice->clpRng(compID));
 }
 
 /** Function for deriving planar intra prediction. This function derives the prediction samples for planar mode (intra coding).
@@ -1437,53 +1446,31 @@ void IntraPrediction::xGetLumaRecPixels(const PredictionUnit &pu, CompArea chrom
     {
       addedAboveRight = avaiAboveRightUnits*chromaUnitWidth;
     }
-    for (int i = 0; i < chromaWidth + addedAboveRight; i++)
+    const int aboveWidth = chromaWidth + addedAboveRight;
+
+    if (pu.chromaFormat == ChromaFormat::_444)
     {
-      const bool leftPadding = i == 0 && !leftIsAvailable;
-      if (pu.chromaFormat == ChromaFormat::_444)
+      src = pRecSrc0 - recStride;
+      for (int i = 0; i < aboveWidth; i++)
       {
-        src     = pRecSrc0 - recStride;
         pDst[i] = src[i];
       }
-      else if (isFirstRowOfCtu)
-      {
-        src     = pRecSrc0 - recStride;
-        pDst[i] = (src[2 * i] * 2 + src[2 * i - (leftPadding ? 0 : 1)] + src[2 * i + 1] + 2) >> 2;
-      }
-      else if (pu.chromaFormat == ChromaFormat::_422)
-      {
-        src = pRecSrc0 - recStride2;
-
-        int s = 2;
-        s += src[2 * i] * 2;
-        s += src[2 * i - (leftPadding ? 0 : 1)];
-        s += src[2 * i + 1];
-        pDst[i] = s >> 2;
-      }
-      else if (pu.cs->sps->getCclmCollocatedChromaFlag())
-      {
-        src = pRecSrc0 - recStride2;
-
-        int s = 4;
-        s += src[2 * i - recStride];
-        s += src[2 * i] * 4;
-        s += src[2 * i - (leftPadding ? 0 : 1)];
-        s += src[2 * i + 1];
-        s += src[2 * i + recStride];
-        pDst[i] = s >> 3;
-      }
-      else
-      {
-        src   = pRecSrc0 - recStride2;
-        int s = 4;
-        s += src[2 * i] * 2;
-        s += src[2 * i + 1];
-        s += src[2 * i - (leftPadding ? 0 : 1)];
-        s += src[2 * i + recStride] * 2;
-        s += src[2 * i + 1 + recStride];
-        s += src[2 * i + recStride - (leftPadding ? 0 : 1)];
-        pDst[i] = s >> 3;
-      }
+    }
+    else if (isFirstRowOfCtu)
+    {
+      m_cclmDsFilter3Tap(pRecSrc0 - recStride, recStride, pDst, dstStride, aboveWidth, 1, !leftIsAvailable, false);
+    }
+    else if (pu.chromaFormat == ChromaFormat::_422)
+    {
+      m_cclmDsFilter3Tap(pRecSrc0 - recStride2, recStride, pDst, dstStride, aboveWidth, 1, !leftIsAvailable, false);
+    }
+    else if (pu.cs->sps->getCclmCollocatedChromaFlag())
+    {
+      m_cclmDsFilter5Tap(pRecSrc0 - recStride2, recStride, pDst, dstStride, aboveWidth, 1, !leftIsAvailable, false);
+    }
+    else
+    {
+      m_cclmDsFilter6Tap(pRecSrc0 - recStride2, recStride, pDst, dstStride, aboveWidth, 1, !leftIsAvailable, false);
     }
   }
 
@@ -1542,55 +1529,107 @@ void IntraPrediction::xGetLumaRecPixels(const PredictionUnit &pu, CompArea chrom
   }
 
   // inner part from reconstructed picture buffer
-  for (int j = 0; j < chromaHeight; j++)
+  if (pu.chromaFormat == ChromaFormat::_444)
   {
-    for (int i = 0; i < chromaWidth; i++)
+    for (int j = 0; j < chromaHeight; j++)
     {
-      if (pu.chromaFormat == ChromaFormat::_444)
+      for (int i = 0; i < chromaWidth; i++)
       {
         pDst0[i] = pRecSrc0[i];
       }
-      else if (pu.chromaFormat == ChromaFormat::_422)
-      {
-        const bool leftPadding  = i == 0 && !leftIsAvailable;
 
-        int s = 2;
-        s += pRecSrc0[2 * i] * 2;
-        s += pRecSrc0[2 * i - (leftPadding ? 0 : 1)];
-        s += pRecSrc0[2 * i + 1];
-        pDst0[i] = s >> 2;
-      }
-      else if (pu.cs->sps->getCclmCollocatedChromaFlag())
-      {
-        const bool leftPadding  = i == 0 && !leftIsAvailable;
-        const bool abovePadding = j == 0 && !aboveIsAvailable;
+      pDst0 += dstStride;
+      pRecSrc0 += recStride2;
+    }
+  }
+  else if (pu.chromaFormat == ChromaFormat::_422)
+  {
+    m_cclmDsFilter3Tap(pRecSrc0, recStride, pDst0, dstStride, chromaWidth, chromaHeight, !leftIsAvailable,
+                       !aboveIsAvailable);
+  }
+  else if (pu.cs->sps->getCclmCollocatedChromaFlag())
+  {
+    m_cclmDsFilter5Tap(pRecSrc0, recStride, pDst0, dstStride, chromaWidth, chromaHeight, !leftIsAvailable,
+                       !aboveIsAvailable);
+  }
+  else
+  {
+    CHECK(pu.chromaFormat != ChromaFormat::_420, "Chroma format must be 4:2:0 for vertical filtering");
+    m_cclmDsFilter6Tap(pRecSrc0, recStride, pDst0, dstStride, chromaWidth, chromaHeight, !leftIsAvailable,
+                       !aboveIsAvailable);
+  }
+}
 
-        int s = 4;
-        s += pRecSrc0[2 * i - (abovePadding ? 0 : recStride)];
-        s += pRecSrc0[2 * i] * 4;
-        s += pRecSrc0[2 * i - (leftPadding ? 0 : 1)];
-        s += pRecSrc0[2 * i + 1];
-        s += pRecSrc0[2 * i + recStride];
-        pDst0[i] = s >> 3;
-      }
-      else
-      {
-        CHECK(pu.chromaFormat != ChromaFormat::_420, "Chroma format must be 4:2:0 for vertical filtering");
-        const bool leftPadding = i == 0 && !leftIsAvailable;
+// The downsampling filters below produce one row of chroma-resolution samples per luma row (3-tap) or per two luma
+// rows (5-tap, 6-tap). The left (above) neighbour of the first column (row) is replaced by the collocated sample when
+// it is not available.
+void IntraPrediction::xCclmDsFilter3Tap(const Pel *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride,
+                                        int width, int height, bool leftPadding, bool abovePadding)
+{
+  for (int j = 0; j < height; j++)
+  {
+    for (int i = 0; i < width; i++)
+    {
+      const int left = i == 0 && leftPadding ? 0 : 1;
 
-        int s = 4;
-        s += pRecSrc0[2 * i] * 2;
-        s += pRecSrc0[2 * i + 1];
-        s += pRecSrc0[2 * i - (leftPadding ? 0 : 1)];
-        s += pRecSrc0[2 * i + recStride] * 2;
-        s += pRecSrc0[2 * i + 1 + recStride];
-        s += pRecSrc0[2 * i + recStride - (leftPadding ? 0 : 1)];
-        pDst0[i] = s >> 3;
-      }
+      int s = 2;
+      s += src[2 * i] * 2;
+      s += src[2 * i - left];
+      s += src[2 * i + 1];
+      dst[i] = s >> 2;
+    }
+
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+
+void IntraPrediction::xCclmDsFilter5Tap(const Pel *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride,
+                                        int width, int height, bool leftPadding, bool abovePadding)
+{
+  for (int j = 0; j < height; j++)
+  {
+    const ptrdiff_t above = j == 0 && abovePadding ? 0 : srcStride;
+
+    for (int i = 0; i < width; i++)
+    {
+      const int left = i == 0 && leftPadding ? 0 : 1;
+
+      int s = 4;
+      s += src[2 * i - above];
+      s += src[2 * i] * 4;
+      s += src[2 * i - left];
+      s += src[2 * i + 1];
+      s += src[2 * i + srcStride];
+      dst[i] = s >> 3;
     }
 
-    pDst0 += dstStride;
-    pRecSrc0 += recStride2;
+    src += 2 * srcStride;
+    dst += dstStride;
+  }
+}
+
+void IntraPrediction::xCclmDsFilter6Tap(const Pel *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride,
+                                        int width, int height, bool leftPadding, bool abovePadding)
+{
+  for (int j = 0; j < height; j++)
+  {
+    for (int i = 0; i < width; i++)
+    {
+      const int left = i == 0 && leftPadding ? 0 : 1;
+
+      int s = 4;
+      s += src[2 * i] * 2;
+      s += src[2 * i + 1];
+      s += src[2 * i - left];
+      s += src[2 * i + srcStride] * 2;
+      s += src[2 * i + 1 + srcStride];
+      s += src[2 * i + srcStride - left];
+      dst[i] = s >> 3;
+    }
+
+    src += 2 * srcStride;
+    dst += dstStride;
   }
 }
 
@@ -1822,6 +1861,29 @@ void IntraPrediction::xGetLMParameters(const PredictionUnit &pu, const Component
   }
 }
 
+void IntraPrediction::copyIntraPattern(const IntraPrediction &src, const ComponentID compId)
+{
+  std::copy_n(&src.m_refBuffer[compId][0][0], sizeof(m_refBuffer[compId]) / sizeof(Pel), &m_refBuffer[compId][0][0]);
+  m_refBufferStride[compId] = src.m_refBufferStride[compId];
+  m_topRefLength            = src.m_topRefLength;
+  m_leftRefLength           = src.m_leftRefLength;
+  m_ipaParam                = src.m_ipaParam;
+  m_matrixIntraPred         = src.m_matrixIntraPred;
+}
+
+void IntraPrediction::predIntraLumaCand(PelBuf &piPred, const PredictionUnit &pu)
+{
+  if (pu.cu->mipFlag)
+  {
+    predIntraMip(COMPONENT_Y, piPred, pu);
+  }
+  else
+  {
+    initPredIntraParams(pu, pu.Y(), *pu.cs->sps);
+    predIntraAng(COMPONENT_Y, piPred, pu);
+  }
+}
+
 void IntraPrediction::initIntraMip( const PredictionUnit &pu, const CompArea &area )
 {
   CHECK( area.width > MIP_MAX_WIDTH || area.height > MIP_MAX_HEIGHT, "Error: block size not supported for MIP" );
@@ -65,6 +65,21 @@ static constexpr uint32_t MAX_INTRA_FILTER_DEPTHS=8;
 
 class IntraPrediction
 {
+public:
+  /// luma downsampling for cross-component prediction, one output sample per chroma sample
+  typedef void (*CclmDsFilterFunc)(const Pel *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride, int width,
+                                   int height, bool leftPadding, bool abovePadding);
+
+  CclmDsFilterFunc m_cclmDsFilter3Tap;   // [1 2 1] horizontal, 4:2:2 and the first luma row of a CTU
+  CclmDsFilterFunc m_cclmDsFilter5Tap;   // cross-shaped, 4:2:0 with collocated chroma
+  CclmDsFilterFunc m_cclmDsFilter6Tap;   // [1 2 1; 1 2 1], 4:2:0
+
+#ifdef TARGET_SIMD_X86
+  void initIntraPredictionX86();
+  template <X86_VEXT vext>
+  void _initIntraPredictionX86();
+#endif
+
 protected:
   Pel      m_refBuffer[MAX_NUM_COMPONENT][NUM_PRED_BUF][(MAX_CU_SIZE * 2 + 1 + MAX_REF_LINE_IDX) * 2];
   uint32_t m_refBufferStride[MAX_NUM_COMPONENT];
@@ -143,6 +158,13 @@ protected:
   void xGetLMParameters(const PredictionUnit &pu, const ComponentID compID, const CompArea &chromaArea, int &a, int &b,
                         int &shift);
 
+  static void xCclmDsFilter3Tap(const Pel *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride, int width,
+                                int height, bool leftPadding, bool abovePadding);
+  static void xCclmDsFilter5Tap(const Pel *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride, int width,
+                                int height, bool leftPadding, bool abovePadding);
+  static void xCclmDsFilter6Tap(const Pel *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride, int width,
+                                int height, bool leftPadding, bool abovePadding);
+
 public:
   IntraPrediction();
   virtual ~IntraPrediction();
@@ -162,11 +184,16 @@ public:
   /// set parameters from CU data for accessing intra data
   void initIntraPatternChType     (const CodingUnit &cu, const CompArea &area, const bool forceRefFilterFlag = false); // use forceRefFilterFlag to get both filtered and unfiltered buffers
   void initIntraPatternChTypeISP  (const CodingUnit& cu, const CompArea& area, PelBuf& piReco, const bool forceRefFilterFlag = false); // use forceRefFilterFlag to get both filtered and unfiltered buffers
+  /// copy the reference samples and prediction parameters set up by another instance, e.g. for parallel mode tests
+  void copyIntraPattern           (const IntraPrediction &src, const ComponentID compId);
 
   // Matrix-based intra prediction
   void initIntraMip               (const PredictionUnit &pu, const CompArea &area);
   void predIntraMip               (const ComponentID compId, PelBuf &piPred, const PredictionUnit &pu);
 
+  // luma prediction of one encoder mode candidate, MIP for MIP CUs and angular otherwise
+  void predIntraLumaCand          (PelBuf &piPred, const PredictionUnit &pu);
+
   void geneWeightedPred(PelBuf &pred, const PredictionUnit &pu, const Pel *srcBuf);
   Pel* getPredictorPtr2           (const ComponentID compID, uint32_t idx) { return m_yuvExt2[compID][idx]; }
   void switchBuffer               (const PredictionUnit &pu, ComponentID compID, PelBuf srcBuff, Pel *dst);
@@ -0,0 +1,184 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2023, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     PerfCounters.cpp
+    \brief    per-picture and per-stage timing and counting of the coding process
+*/
+
+#include "PerfCounters.h"
+
+#include <iomanip>
+
+//! \ingroup CommonLib
+//! \{
+
+static const char *const stageNames[] = { "mctf",     "mode_decision",  "intra_search",   "inter_search", "transform",
+                                          "loop_filter", "entropy_coding", "reconstruction", "io" };
+static const char *const countNames[] = { "cu", "intra", "inter", "merge", "ibc", "palette" };
+
+static_assert(sizeof(stageNames) / sizeof(stageNames[0]) == to_underlying(PerfStage::NUM), "missing stage name");
+static_assert(sizeof(countNames) / sizeof(countNames[0]) == to_underlying(PerfCount::NUM), "missing counter name");
+
+PerfCounters::PerfCounters() : m_enabled(false), m_format(Format::CSV)
+{
+  for (auto &t: m_time)
+  {
+    t = 0;
+  }
+  for (auto &c: m_count)
+  {
+    c = 0;
+  }
+}
+
+PerfCounters::~PerfCounters()
+{
+  close();
+}
+
+bool PerfCounters::parseFormat(const std::string &name, Format &format)
+{
+  if (name == "csv")
+  {
+    format = Format::CSV;
+    return true;
+  }
+  if (name == "json")
+  {
+    format = Format::JSON;
+    return true;
+  }
+  return false;
+}
+
+void PerfCounters::open(const std::string &fileName, Format format)
+{
+  close();
+  m_stream.open(fileName, std::ios::out | std::ios::trunc);
+  CHECK(!m_stream.is_open(), "Unable to open performance statistics file " << fileName);
+  m_format  = format;
+  m_enabled = true;
+  m_stream << std::fixed << std::setprecision(3);
+  xWriteHeader();
+}
+
+void PerfCounters::close()
+{
+  if (m_stream.is_open())
+  {
+    m_stream.close();
+  }
+  m_enabled = false;
+}
+
+void PerfCounters::xWriteHeader()
+{
+  if (m_format != Format::CSV)
+  {
+    return;
+  }
+  m_stream << "poc,layer,type,qp,total_ms";
+  for (const char *name: stageNames)
+  {
+    m_stream << "," << name << "_ms";
+  }
+  for (const char *name: countNames)
+  {
+    m_stream << "," << name;
+  }
+  m_stream << "\n";
+}
+
+void PerfCounters::beginPicture()
+{
+  if (!m_enabled)
+  {
+    return;
+  }
+  m_picStart = std::chrono::steady_clock::now();
+}
+
+void PerfCounters::endPicture(int poc, int layerId, char sliceType, int qp)
+{
+  if (!m_enabled)
+  {
+    return;
+  }
+  const int64_t totalNs =
+    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_picStart).count();
+
+  EnumArray<int64_t, PerfStage> time;
+  for (int i = 0; i < to_underlying(PerfStage::NUM); i++)
+  {
+    time[PerfStage(i)] = m_time[PerfStage(i)].exchange(0, std::memory_order_relaxed);
+  }
+
+  const bool csv = m_format == Format::CSV;
+  if (csv)
+  {
+    m_stream << poc << "," << layerId << "," << sliceType << "," << qp << "," << totalNs * 1e-6;
+  }
+  else
+  {
+    m_stream << "{\"poc\":" << poc << ",\"layer\":" << layerId << ",\"type\":\"" << sliceType << "\",\"qp\":" << qp
+             << ",\"total_ms\":" << totalNs * 1e-6;
+  }
+  for (int i = 0; i < to_underlying(PerfStage::NUM); i++)
+  {
+    const double ms = time[PerfStage(i)] * 1e-6;
+    if (csv)
+    {
+      m_stream << "," << ms;
+    }
+    else
+    {
+      m_stream << ",\"" << stageNames[i] << "_ms\":" << ms;
+    }
+  }
+  for (int i = 0; i < to_underlying(PerfCount::NUM); i++)
+  {
+    const int64_t n = m_count[PerfCount(i)].exchange(0, std::memory_order_relaxed);
+    if (csv)
+    {
+      m_stream << "," << n;
+    }
+    else
+    {
+      m_stream << ",\"" << countNames[i] << "\":" << n;
+    }
+  }
+  m_stream << (csv ? "\n" : "}\n");
+  m_stream.flush();
+}
+
+//! \}
@@ -0,0 +1,165 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2023, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     PerfCounters.h
+    \brief    per-picture and per-stage timing and counting of the coding process (header)
+*/
+
+#ifndef __PERFCOUNTERS__
+#define __PERFCOUNTERS__
+
+#include "CommonDef.h"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <string>
+
+//! \ingroup CommonLib
+//! \{
+
+// ====================================================================================================================
+// Enumeration
+// ====================================================================================================================
+
+/// coding stages with a separate timer; nested stages are accounted inclusively, e.g. INTRA_SEARCH is part of
+/// MODE_DECISION and TRANSFORM is part of both
+enum class PerfStage : int
+{
+  MCTF = 0,
+  MODE_DECISION,
+  INTRA_SEARCH,
+  INTER_SEARCH,
+  TRANSFORM,
+  LOOP_FILTER,
+  ENTROPY_CODING,
+  RECONSTRUCTION,
+  IO,
+  NUM
+};
+
+/// evaluation counters
+enum class PerfCount : int
+{
+  CU = 0,    // partitions entering the CU mode decision
+  INTRA,     // intra mode tests
+  INTER,     // inter (motion estimation) mode tests
+  MERGE,     // merge/skip mode tests
+  IBC,       // IBC mode tests
+  PALETTE,   // palette mode tests
+  NUM
+};
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// Collects the time spent in the coding stages and the number of mode evaluations per picture and writes one
+/// record per picture as CSV or JSON Lines. When no output file is opened, all accounting is skipped.
+/// Time and counts spent between two pictures are accounted to the next picture, unless they are explicitly
+/// assigned to the POC they belong to (e.g. reading and filtering of input pictures ahead of coding).
+class PerfCounters
+{
+public:
+  enum class Format
+  {
+    CSV,
+    JSON
+  };
+
+  PerfCounters();
+  ~PerfCounters();
+
+  static bool parseFormat(const std::string &name, Format &format);
+
+  void open(const std::string &fileName, Format format);
+  void close();
+  bool isEnabled() const { return m_enabled; }
+
+  void beginPicture();
+  void endPicture(int poc, int layerId, char sliceType, int qp);
+
+  void addTime(PerfStage stage, int64_t ns) { m_time[stage].fetch_add(ns, std::memory_order_relaxed); }
+  void increment(PerfCount count, int64_t n = 1)
+  {
+    if (m_enabled)
+    {
+      m_count[count].fetch_add(n, std::memory_order_relaxed);
+    }
+  }
+
+private:
+  void xWriteHeader();
+
+  bool                                            m_enabled;
+  Format                                          m_format;
+  std::ofstream                                   m_stream;
+  std::chrono::steady_clock::time_point           m_picStart;
+  EnumArray<std::atomic<int64_t>, PerfStage>      m_time;
+  EnumArray<std::atomic<int64_t>, PerfCount>      m_count;
+};
+
+/// scoped timer adding the elapsed time to one stage, does nothing if the counters are not enabled
+class PerfTimer
+{
+public:
+  PerfTimer(PerfCounters *counters, PerfStage stage)
+    : m_counters(counters != nullptr && counters->isEnabled() ? counters : nullptr), m_stage(stage)
+  {
+    if (m_counters != nullptr)
+    {
+      m_start = std::chrono::steady_clock::now();
+    }
+  }
+  ~PerfTimer() { stop(); }
+
+  void stop()
+  {
+    if (m_counters != nullptr)
+    {
+      const int64_t ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count();
+      m_counters->addTime(m_stage, ns);
+      m_counters = nullptr;
+    }
+  }
+
+private:
+  PerfCounters                         *m_counters;
+  PerfStage                             m_stage;
+  std::chrono::steady_clock::time_point m_start;
+};
+
+//! \}
+
+#endif
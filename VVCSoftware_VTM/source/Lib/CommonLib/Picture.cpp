@@ -46,6 +46,8 @@
 
 
 
+thread_local int Picture::s_splitJobId = 0;
+
 Picture::Picture()
 {
   cs                   = nullptr;
@@ -120,8 +122,9 @@ void Picture::destroy()
 {
   for (uint32_t t = 0; t < NUM_PIC_TYPES; t++)
   {
-    M_BUFS(jId, t).destroy();
+    M_BUFS(0, t).destroy();
   }
+  m_splitJobBufs.clear();
   m_hashMap.clearAll();
   if (cs)
   {
@@ -157,6 +160,58 @@ void Picture::destroy()
   m_grainBuf           = nullptr;
 }
 
+void Picture::resetForReuse()
+{
+  // the coding structure was set up for the parameter sets of the previous owner and is rebuilt by finalInit()
+  if (cs)
+  {
+    cs->destroy();
+    delete cs;
+    cs = nullptr;
+  }
+  // slices and SEI messages belong to the previous owner, NNPFC activations do not persist across CLVSs
+  clearSliceBuffer();
+  deleteSEIs(SEIs);
+  deleteSEIs(m_nnpfcActivated);
+
+  m_isSubPicBorderSaved   = false;
+  m_extendedBorder        = false;
+  m_wrapAroundValid       = false;
+  m_wrapAroundOffset      = 0;
+  usedByCurr              = false;
+  longTerm                = false;
+  reconstructed           = false;
+  neededForOutput         = false;
+  referenced              = false;
+  temporalId              = std::numeric_limits<uint32_t>::max();
+  fieldPic                = false;
+  topField                = false;
+  precedingDRAP           = false;
+  edrapRapId              = -1;
+  nonReferencePictureFlag = false;
+
+  m_prevQP.fill(-1);
+  numSlices   = 1;
+  unscaledPic = nullptr;
+}
+
+size_t Picture::getBufferSize() const
+{
+  size_t size = 0;
+  for (uint32_t t = 0; t < NUM_PIC_TYPES; t++)
+  {
+    size += m_bufs[t].getAllocatedSize();
+  }
+  for (const auto &jobBufs: m_splitJobBufs)
+  {
+    for (uint32_t t = 0; t < NUM_PIC_TYPES; t++)
+    {
+      size += jobBufs[t].getAllocatedSize();
+    }
+  }
+  return size;
+}
+
 void Picture::createTempBuffers( const unsigned _maxCUSize )
 {
 #if KEEP_PRED_AND_RESI_SIGNALS
@@ -165,8 +220,8 @@ void Picture::createTempBuffers( const unsigned _maxCUSize )
   const Area a = m_ctuArea.Y();
 #endif
 
-  M_BUFS( jId, PIC_PREDICTION                   ).create( chromaFormat, a,   _maxCUSize );
-  M_BUFS( jId, PIC_RESIDUAL                     ).create( chromaFormat, a,   _maxCUSize );
+  M_BUFS( 0, PIC_PREDICTION                     ).create( chromaFormat, a,   _maxCUSize );
+  M_BUFS( 0, PIC_RESIDUAL                       ).create( chromaFormat, a,   _maxCUSize );
 
   if (cs)
   {
@@ -183,6 +238,7 @@ void Picture::destroyTempBuffers()
       M_BUFS(0, t).destroy();
     }
   }
+  m_splitJobBufs.clear();
 
   if (cs)
   {
@@ -190,6 +246,54 @@ void Picture::destroyTempBuffers()
   }
 }
 
+void Picture::createSplitJobBuffers( const int numJobs, const unsigned _maxCUSize )
+{
+#if KEEP_PRED_AND_RESI_SIGNALS
+  const Area a( Position{ 0, 0 }, lumaSize() );
+#else
+  const Area a = m_ctuArea.Y();
+#endif
+
+  m_splitJobBufs.clear();
+
+  for( int jobId = 1; jobId <= numJobs; jobId++ )
+  {
+    m_splitJobBufs.emplace_back( new PelStorage[NUM_PIC_TYPES] );
+
+    M_BUFS( jobId, PIC_RECONSTRUCTION ).create( chromaFormat, Area( Position{ 0, 0 }, lumaSize() ), _maxCUSize, margin, MEMORY_ALIGN_DEF_SIZE );
+    M_BUFS( jobId, PIC_PREDICTION     ).create( chromaFormat, a, _maxCUSize );
+    M_BUFS( jobId, PIC_RESIDUAL       ).create( chromaFormat, a, _maxCUSize );
+
+    M_BUFS( jobId, PIC_RECONSTRUCTION ).copyFrom( M_BUFS( 0, PIC_RECONSTRUCTION ) );
+  }
+}
+
+void Picture::finishSplitJob( const int jobId, const UnitArea &area )
+{
+  CHECK( jobId < 0 || jobId > getNumSplitJobs(), "Invalid split job" );
+
+  for( const CompArea &blk : area.blocks )
+  {
+    if( !blk.valid() )
+    {
+      continue;
+    }
+
+    // take over the winning job's reconstruction and make it visible to all other jobs
+    if( jobId > 0 )
+    {
+      M_BUFS( 0, PIC_RECONSTRUCTION ).getBuf( blk ).copyFrom( M_BUFS( jobId, PIC_RECONSTRUCTION ).getBuf( blk ) );
+    }
+    for( int otherId = 1; otherId <= getNumSplitJobs(); otherId++ )
+    {
+      if( otherId != jobId )
+      {
+        M_BUFS( otherId, PIC_RECONSTRUCTION ).getBuf( blk ).copyFrom( M_BUFS( 0, PIC_RECONSTRUCTION ).getBuf( blk ) );
+      }
+    }
+  }
+}
+
        PelBuf     Picture::getOrigBuf(const CompArea &blk)        { return getBuf(blk,  PIC_ORIGINAL); }
 const CPelBuf     Picture::getOrigBuf(const CompArea &blk)  const { return getBuf(blk,  PIC_ORIGINAL); }
        PelUnitBuf Picture::getOrigBuf(const UnitArea &unit)       { return getBuf(unit, PIC_ORIGINAL); }
@@ -227,15 +331,15 @@ const CPelBuf     Picture::getRecoBuf(const ComponentID compID, bool wrap) const
 const CPelBuf     Picture::getRecoBuf(const CompArea &blk, bool wrap)      const { return getBuf(blk,                       wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION); }
        PelUnitBuf Picture::getRecoBuf(const UnitArea &unit, bool wrap)           { return getBuf(unit,                      wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION); }
 const CPelUnitBuf Picture::getRecoBuf(const UnitArea &unit, bool wrap)     const { return getBuf(unit,                      wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION); }
-       PelUnitBuf Picture::getRecoBuf(bool wrap)                                 { return M_BUFS(scheduler.getSplitPicId(), wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION); }
-const CPelUnitBuf Picture::getRecoBuf(bool wrap)                           const { return M_BUFS(scheduler.getSplitPicId(), wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION); }
+       PelUnitBuf Picture::getRecoBuf(bool wrap)                                 { return M_BUFS(xGetSplitJobId(wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION), wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION); }
+const CPelUnitBuf Picture::getRecoBuf(bool wrap)                           const { return M_BUFS(xGetSplitJobId(wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION), wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION); }
 
 #if JVET_Z0120_SII_SEI_PROCESSING
-       PelUnitBuf Picture::getPostRecBuf()                           { return M_BUFS(scheduler.getSplitPicId(), PIC_YUV_POST_REC); }
-const CPelUnitBuf Picture::getPostRecBuf()                     const { return M_BUFS(scheduler.getSplitPicId(), PIC_YUV_POST_REC); }
+       PelUnitBuf Picture::getPostRecBuf()                           { return M_BUFS(0, PIC_YUV_POST_REC); }
+const CPelUnitBuf Picture::getPostRecBuf()                     const { return M_BUFS(0, PIC_YUV_POST_REC); }
 #endif
 
-void Picture::finalInit( const VPS* vps, const SPS& sps, const PPS& pps, PicHeader *picHeader, APS** alfApss, APS* lmcsAps, APS* scalingListAps )
+void Picture::finalInit( XuPool &xuPool, const VPS* vps, const SPS& sps, const PPS& pps, PicHeader *picHeader, APS** alfApss, APS* lmcsAps, APS* scalingListAps )
 {
   for( auto &sei : SEIs )
   {
@@ -254,7 +358,7 @@ void Picture::finalInit( const VPS* vps, const SPS& sps, const PPS& pps, PicHead
   }
   else
   {
-    cs      = new CodingStructure(g_xuPool);
+    cs      = new CodingStructure(xuPool);
     cs->sps = &sps;
     cs->create(chromaFormatIdc, Area(0, 0, width, height), true, (bool) sps.getPLTMode());
   }
@@ -1258,12 +1362,12 @@ void Picture::extendWrapBorder( const PPS *pps )
 
 PelBuf Picture::getBuf( const ComponentID compID, const PictureType &type )
 {
-  return M_BUFS( ( type == PIC_ORIGINAL || type == PIC_TRUE_ORIGINAL || type == PIC_FILTERED_ORIGINAL || type == PIC_ORIGINAL_INPUT || type == PIC_TRUE_ORIGINAL_INPUT || type == PIC_FILTERED_ORIGINAL_INPUT ) ? 0 : scheduler.getSplitPicId(), type ).getBuf( compID );
+  return M_BUFS( xGetSplitJobId( type ), type ).getBuf( compID );
 }
 
 const CPelBuf Picture::getBuf( const ComponentID compID, const PictureType &type ) const
 {
-  return M_BUFS( ( type == PIC_ORIGINAL || type == PIC_TRUE_ORIGINAL || type == PIC_FILTERED_ORIGINAL || type == PIC_ORIGINAL_INPUT || type == PIC_TRUE_ORIGINAL_INPUT || type == PIC_FILTERED_ORIGINAL_INPUT ) ? 0 : scheduler.getSplitPicId(), type ).getBuf( compID );
+  return M_BUFS( xGetSplitJobId( type ), type ).getBuf( compID );
 }
 
 PelBuf Picture::getBuf( const CompArea &blk, const PictureType &type )
@@ -1280,11 +1384,11 @@ PelBuf Picture::getBuf( const CompArea &blk, const PictureType &type )
     localBlk.x &= ( cs->pcv->maxCUWidthMask  >> getComponentScaleX( blk.compID, blk.chromaFormat ) );
     localBlk.y &= ( cs->pcv->maxCUHeightMask >> getComponentScaleY( blk.compID, blk.chromaFormat ) );
 
-    return M_BUFS( jId, type ).getBuf( localBlk );
+    return M_BUFS( xGetSplitJobId( type ), type ).getBuf( localBlk );
   }
 #endif
 
-  return M_BUFS( jId, type ).getBuf( blk );
+  return M_BUFS( xGetSplitJobId( type ), type ).getBuf( blk );
 }
 
 const CPelBuf Picture::getBuf( const CompArea &blk, const PictureType &type ) const
@@ -1301,11 +1405,11 @@ const CPelBuf Picture::getBuf( const CompArea &blk, const PictureType &type ) co
     localBlk.x &= ( cs->pcv->maxCUWidthMask  >> getComponentScaleX( blk.compID, blk.chromaFormat ) );
     localBlk.y &= ( cs->pcv->maxCUHeightMask >> getComponentScaleY( blk.compID, blk.chromaFormat ) );
 
-    return M_BUFS( jId, type ).getBuf( localBlk );
+    return M_BUFS( xGetSplitJobId( type ), type ).getBuf( localBlk );
   }
 #endif
 
-  return M_BUFS( jId, type ).getBuf( blk );
+  return M_BUFS( xGetSplitJobId( type ), type ).getBuf( blk );
 }
 
 PelUnitBuf Picture::getBuf( const UnitArea &unit, const PictureType &type )
@@ -1334,7 +1438,7 @@ const CPelUnitBuf Picture::getBuf( const UnitArea &unit, const PictureType &type
 
 Pel* Picture::getOrigin( const PictureType &type, const ComponentID compID ) const
 {
-  return M_BUFS( jId, type ).getOrigin( compID );
+  return M_BUFS( xGetSplitJobId( type ), type ).getOrigin( compID );
 }
 
 void Picture::createSpliceIdx(int nums)
@@ -1475,7 +1579,7 @@ PelUnitBuf Picture::getDisplayBufFG(bool wrap)
     {
       msg(WARNING, "Film Grain synthesis is not performed. Error code: 0x%x \n", m_grainCharacteristic->m_errorCode);
     }
-    return M_BUFS(scheduler.getSplitPicId(), wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION);
+    return getRecoBuf(wrap);
   }
 }
 
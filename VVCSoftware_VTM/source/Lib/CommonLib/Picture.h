@@ -50,6 +50,7 @@
 #include "MCTS.h"
 #include "SEIColourTransform.h"
 #include <deque>
+#include <memory>
 #include "SEIFilmGrainSynthesizer.h"
 
 class SEI;
@@ -57,7 +58,7 @@ class AQpLayer;
 
 typedef std::list<SEI*> SEIMessages;
 
-#define M_BUFS(JID,PID) m_bufs[PID]
+#define M_BUFS(JID,PID) getSplitJobBufs(JID)[PID]
 
 #if GDR_ENABLED
 struct GdrPicParam
@@ -79,9 +80,24 @@ struct Picture : public UnitArea
 #endif
   void destroy();
 
+  // state reset of a picture whose sample buffers are recycled by the decoder's picture pool
+  void   resetForReuse();
+  size_t getBufferSize() const;
+
   void createTempBuffers( const unsigned _maxCUSize );
   void destroyTempBuffers();
 
+  // private reconstruction, prediction and residual buffers of the encoder's parallel split jobs
+  void createSplitJobBuffers( const int numJobs, const unsigned _maxCUSize );
+  int  getNumSplitJobs() const { return (int) m_splitJobBufs.size(); }
+  void finishSplitJob( const int jobId, const UnitArea &area );
+
+  static void setSplitJobId( const int jobId ) { s_splitJobId = jobId; }
+  static int  getSplitJobId()                  { return s_splitJobId; }
+
+         PelStorage* getSplitJobBufs( const int jobId )       { return jobId > 0 ? m_splitJobBufs[jobId - 1].get() : m_bufs; }
+  const PelStorage* getSplitJobBufs( const int jobId ) const { return jobId > 0 ? m_splitJobBufs[jobId - 1].get() : m_bufs; }
+
   int                       m_padValue;
   bool                      m_isMctfFiltered;
   SEIFilmGrainSynthesizer*  m_grainCharacteristic;
@@ -157,7 +173,7 @@ struct Picture : public UnitArea
 
   void extendPicBorder( const PPS *pps );
   void extendWrapBorder( const PPS *pps );
-  void finalInit( const VPS* vps, const SPS& sps, const PPS& pps, PicHeader *picHeader, APS** alfApss, APS* lmcsAps, APS* scalingListAps );
+  void finalInit( XuPool &xuPool, const VPS* vps, const SPS& sps, const PPS& pps, PicHeader *picHeader, APS** alfApss, APS* lmcsAps, APS* scalingListAps );
 
   int  getPOC()                               const { return poc; }
   int  getDecodingOrderNumber()               const { return m_decodingOrderNumber; }
@@ -321,6 +337,16 @@ public:
   void resizeAlfData(int numEntries);
 
   AlfMode *getAlfModes(int compIdx) { return m_alfModes[compIdx].data(); }
+
+private:
+  std::vector<std::unique_ptr<PelStorage[]>> m_splitJobBufs;
+  static thread_local int                    s_splitJobId;
+
+  int xGetSplitJobId( const PictureType type ) const
+  {
+    return ( s_splitJobId > 0 && s_splitJobId <= getNumSplitJobs()
+             && ( type == PIC_RECONSTRUCTION || type == PIC_PREDICTION || type == PIC_RESIDUAL ) ) ? s_splitJobId : 0;
+  }
 };
 
 int calcAndPrintHashStatus(const CPelUnitBuf& pic, const class SEIDecodedPictureHash* pictureHashSEI, const BitDepths &bitDepths, const MsgLevel msgl);
@@ -43,11 +43,17 @@
 #include "UnitPartitioner.h"
 
 #include <limits>
+#include <mutex>
 
 //! \ingroup CommonLib
 //! \{
 
 EnumArray<DistFunc, DFunc> RdCost::m_distortionFunc;
+DistFuncX4                 RdCost::m_sadX4Func;
+DistFuncDmvr               RdCost::m_sadDmvrFunc;
+DistFuncMulti              RdCost::m_sadMaskMultiFunc;
+DistFuncPlane              RdCost::m_planeSseFunc;
+SsimFuncWindows            RdCost::m_ssimWindowsFunc;
 
 RdCost::RdCost()
 {
@@ -129,6 +135,26 @@ void RdCost::lambdaAdjustColorTrans(bool forward, ComponentID componentID, bool
 
 // Initialize Function Pointer by [distFunc]
 void RdCost::init()
+{
+  // the distortion functions are shared by all instances, several encoders or decoders may be created concurrently
+  static std::once_flag distFuncInitialized;
+  std::call_once(distFuncInitialized, [this] { xInitDistFuncs(); });
+
+  m_costMode                   = COST_STANDARD_LOSSY;
+
+  m_motionLambda               = 0;
+  m_iCostScale                 = 0;
+  m_resetStore = true;
+  m_pairCheck    = 0;
+
+#if WCG_EXT
+  m_signalType   = RESHAPE_SIGNAL_NULL;
+  m_chromaWeight = MSE_WEIGHT_ONE;
+  m_lumaBD       = 10;
+#endif
+}
+
+void RdCost::xInitDistFuncs()
 {
   m_distortionFunc[DFunc::SSE]    = RdCost::xGetSSE;
   m_distortionFunc[DFunc::SSE2]   = RdCost::xGetSSE;
@@ -206,19 +232,19 @@ void RdCost::init()
   m_distortionFunc[DFunc::SAD_INTERMEDIATE_BITDEPTH] = RdCost::xGetSAD;
 
   m_distortionFunc[DFunc::SAD_WITH_MASK] = RdCost::xGetSADwMask;
+  m_sadMaskMultiFunc = RdCost::xGetSADwMaskMulti;
+
+  m_planeSseFunc    = RdCost::xGetPlaneSSE;
+  m_ssimWindowsFunc = RdCost::xGetSSIMWindows;
+
+  m_sadX4Func   = RdCost::xGetSADX4;
+  m_sadDmvrFunc = RdCost::xGetSADDmvr;
 
 #if ENABLE_SIMD_OPT_DIST
 #ifdef TARGET_SIMD_X86
   initRdCostX86();
 #endif
 #endif
-
-  m_costMode                   = COST_STANDARD_LOSSY;
-
-  m_motionLambda               = 0;
-  m_iCostScale                 = 0;
-  m_resetStore = true;
-  m_pairCheck    = 0;
 }
 
 void RdCost::setDistParam(DistParam &rcDP, const CPelBuf &org, const Pel *piRefY, ptrdiff_t iRefStride, int bitDepth,
@@ -361,6 +387,7 @@ Distortion RdCost::getDistPart(const CPelBuf &org, const CPelBuf &cur, int bitDe
   cDtParam.compID     = compID;
 
 #if WCG_EXT
+  cDtParam.rdCost = this;
   if( orgLuma )
   {
     cDtParam.cShiftX = getComponentScaleX(compID,  m_cf);
@@ -461,6 +488,106 @@ Distortion RdCost::xGetSAD( const DistParam& rcDtParam )
   return (sum >> distortionShift);
 }
 
+void RdCost::xGetSADX4(const DistParam &rcDtParam, const Pel *const *cur, Distortion *dist)
+{
+  const Pel      *piOrg     = rcDtParam.org.buf;
+  const Pel      *piCur[4]  = { cur[0], cur[1], cur[2], cur[3] };
+  const int       cols      = rcDtParam.org.width;
+  int             rows      = rcDtParam.org.height;
+  const int       subShift  = rcDtParam.subShift;
+  const int       subStep   = (1 << subShift);
+  const ptrdiff_t strideCur = rcDtParam.cur.stride * subStep;
+  const ptrdiff_t strideOrg = rcDtParam.org.stride * subStep;
+
+  Distortion sum[4] = { 0, 0, 0, 0 };
+
+  for (; rows != 0; rows -= subStep)
+  {
+    for (int n = 0; n < cols; n++)
+    {
+      const Pel org = piOrg[n];
+      sum[0] += abs(org - piCur[0][n]);
+      sum[1] += abs(org - piCur[1][n]);
+      sum[2] += abs(org - piCur[2][n]);
+      sum[3] += abs(org - piCur[3][n]);
+    }
+    piOrg += strideOrg;
+    for (int k = 0; k < 4; k++)
+    {
+      piCur[k] += strideCur;
+    }
+  }
+
+  for (int k = 0; k < 4; k++)
+  {
+    dist[k] = (sum[k] << subShift) >> DISTORTION_PRECISION_ADJUSTMENT(rcDtParam.bitDepth);
+  }
+}
+
+void RdCost::xGetSADDmvr(const DistParam &rcDtParam, Distortion *dist)
+{
+  const int       cols      = rcDtParam.org.width;
+  const int       subShift  = rcDtParam.subShift;
+  const int       subStep   = (1 << subShift);
+  const ptrdiff_t strideOrg = rcDtParam.org.stride;
+  const ptrdiff_t strideCur = rcDtParam.cur.stride;
+
+  for (int dy = -DMVR_RANGE; dy <= DMVR_RANGE; dy++)
+  {
+    for (int dx = -DMVR_RANGE; dx <= DMVR_RANGE; dx++)
+    {
+      const Pel *piOrg = rcDtParam.org.buf + dy * strideOrg + dx;
+      const Pel *piCur = rcDtParam.cur.buf - dy * strideCur - dx;
+
+      Distortion sum = 0;
+
+      for (int rows = rcDtParam.org.height; rows != 0; rows -= subStep)
+      {
+        for (int n = 0; n < cols; n++)
+        {
+          sum += abs(piOrg[n] - piCur[n]);
+        }
+        piOrg += strideOrg * subStep;
+        piCur += strideCur * subStep;
+      }
+
+      dist[(dy + DMVR_RANGE) * DMVR_SPAN + dx + DMVR_RANGE] =
+        (sum << subShift) >> DISTORTION_PRECISION_ADJUSTMENT(rcDtParam.bitDepth);
+    }
+  }
+}
+
+bool RdCost::getSADMulti(const DistParam &rcDP, const Pel *const *cur, int numCand, Distortion *dist) const
+{
+  if (rcDP.applyWeight || rcDP.useMR || rcDP.step != 1 || (rcDP.org.width & 3) != 0)
+  {
+    return false;
+  }
+
+  for (int i = 0; i < numCand; i += 4)
+  {
+    const int n = std::min(4, numCand - i);
+    if (n == 4)
+    {
+      m_sadX4Func(rcDP, cur + i, dist + i);
+    }
+    else
+    {
+      // pad the last group with the last candidate
+      const Pel *curX4[4];
+      Distortion distX4[4];
+      for (int k = 0; k < 4; k++)
+      {
+        curX4[k] = cur[i + std::min(k, n - 1)];
+      }
+      m_sadX4Func(rcDP, curX4, distX4);
+      std::copy_n(distX4, n, dist + i);
+    }
+  }
+
+  return true;
+}
+
 Distortion RdCost::xGetSAD4( const DistParam& rcDtParam )
 {
   if ( rcDtParam.applyWeight )
@@ -3004,13 +3131,6 @@ Distortion RdCost::xGetHADs( const DistParam &rcDtParam )
 
 
 #if WCG_EXT
-uint32_t RdCost::m_signalType   = RESHAPE_SIGNAL_NULL;
-int32_t  RdCost::m_chromaWeight = MSE_WEIGHT_ONE;
-int      RdCost::m_lumaBD       = 10;
-
-std::vector<int32_t> RdCost::m_reshapeLumaLevelToWeightPLUT;
-std::vector<double> RdCost::m_lumaLevelToWeightPLUT;
-
 void RdCost::saveUnadjustedLambda()
 {
   m_dLambda_unadjusted = m_dLambda;
@@ -3126,7 +3246,7 @@ void RdCost::updateReshapeLumaLevelToWeightTable(SliceReshapeInfo &sliceReshape,
   }
 }
 
-Distortion RdCost::getWeightedMSE(int compIdx, const Pel org, const Pel cur, const uint32_t shift, const Pel orgLuma)
+Distortion RdCost::getWeightedMSE(int compIdx, const Pel org, const Pel cur, const uint32_t shift, const Pel orgLuma) const
 {
   CHECKD(org < 0, "Sample value must be positive");
 
@@ -3181,7 +3301,7 @@ Distortion RdCost::xGetSSE_WTD( const DistParam &rcDtParam )
   {
     for (int n = 0; n < cols; n++)
     {
-      sum += getWeightedMSE(rcDtParam.compID, piOrg[n], piCur[n], shift, piOrgLuma[n << cShift]);
+      sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[n], piCur[n], shift, piOrgLuma[n << cShift]);
     }
     piOrg += strideOrg;
     piCur += strideCur;
@@ -3213,10 +3333,10 @@ Distortion RdCost::xGetSSE2_WTD( const DistParam &rcDtParam )
   uint32_t   shift   = DISTORTION_PRECISION_ADJUSTMENT(rcDtParam.bitDepth) << 1;
   for (; rows != 0; rows--)
   {
-    sum += getWeightedMSE(
+    sum += rcDtParam.rdCost->getWeightedMSE(
       rcDtParam.compID, piOrg[0], piCur[0], shift,
       piOrgLuma[size_t(0) << cShift]);   // piOrg[0] - piCur[0]; sum += Distortion(( temp * temp ) >> shift);
-    sum += getWeightedMSE(
+    sum += rcDtParam.rdCost->getWeightedMSE(
       rcDtParam.compID, piOrg[1], piCur[1], shift,
       piOrgLuma[size_t(1) << cShift]);   // piOrg[1] - piCur[1]; sum += Distortion(( temp * temp ) >> shift);
     piOrg += strideOrg;
@@ -3248,16 +3368,16 @@ Distortion RdCost::xGetSSE4_WTD( const DistParam &rcDtParam )
   uint32_t   shift   = DISTORTION_PRECISION_ADJUSTMENT(rcDtParam.bitDepth) << 1;
   for (; rows != 0; rows--)
   {
-    sum += getWeightedMSE(
+    sum += rcDtParam.rdCost->getWeightedMSE(
       rcDtParam.compID, piOrg[0], piCur[0], shift,
       piOrgLuma[size_t(0) << cShift]);   // piOrg[0] - piCur[0]; sum += Distortion(( temp * temp ) >> shift);
-    sum += getWeightedMSE(
+    sum += rcDtParam.rdCost->getWeightedMSE(
       rcDtParam.compID, piOrg[1], piCur[1], shift,
       piOrgLuma[size_t(1) << cShift]);   // piOrg[1] - piCur[1]; sum += Distortion(( temp * temp ) >> shift);
-    sum += getWeightedMSE(
+    sum += rcDtParam.rdCost->getWeightedMSE(
       rcDtParam.compID, piOrg[2], piCur[2], shift,
       piOrgLuma[size_t(2) << cShift]);   // piOrg[2] - piCur[2]; sum += Distortion(( temp * temp ) >> shift);
-    sum += getWeightedMSE(
+    sum += rcDtParam.rdCost->getWeightedMSE(
       rcDtParam.compID, piOrg[3], piCur[3], shift,
       piOrgLuma[size_t(3) << cShift]);   // piOrg[3] - piCur[3]; sum += Distortion(( temp * temp ) >> shift);
     piOrg += strideOrg;
@@ -3289,27 +3409,27 @@ Distortion RdCost::xGetSSE8_WTD( const DistParam &rcDtParam )
   uint32_t   shift   = DISTORTION_PRECISION_ADJUSTMENT(rcDtParam.bitDepth) << 1;
   for (; rows != 0; rows--)
   {
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[0], piCur[0], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[0], piCur[0], shift,
                           piOrgLuma[0]);   // piOrg[0] - piCur[0]; sum += Distortion(( temp * temp ) >> shift);
-    sum += getWeightedMSE(
+    sum += rcDtParam.rdCost->getWeightedMSE(
       rcDtParam.compID, piOrg[1], piCur[1], shift,
       piOrgLuma[size_t(1) << cShift]);   // piOrg[1] - piCur[1]; sum += Distortion(( temp * temp ) >> shift);
-    sum += getWeightedMSE(
+    sum += rcDtParam.rdCost->getWeightedMSE(
       rcDtParam.compID, piOrg[2], piCur[2], shift,
       piOrgLuma[size_t(2) << cShift]);   // piOrg[2] - piCur[2]; sum += Distortion(( temp * temp ) >> shift);
-    sum += getWeightedMSE(
+    sum += rcDtParam.rdCost->getWeightedMSE(
       rcDtParam.compID, piOrg[3], piCur[3], shift,
       piOrgLuma[size_t(3) << cShift]);   // piOrg[3] - piCur[3]; sum += Distortion(( temp * temp ) >> shift);
-    sum += getWeightedMSE(
+    sum += rcDtParam.rdCost->getWeightedMSE(
       rcDtParam.compID, piOrg[4], piCur[4], shift,
       piOrgLuma[size_t(4) << cShift]);   // piOrg[4] - piCur[4]; sum += Distortion(( temp * temp ) >> shift);
-    sum += getWeightedMSE(
+    sum += rcDtParam.rdCost->getWeightedMSE(
       rcDtParam.compID, piOrg[5], piCur[5], shift,
       piOrgLuma[size_t(5) << cShift]);   // piOrg[5] - piCur[5]; sum += Distortion(( temp * temp ) >> shift);
-    sum += getWeightedMSE(
+    sum += rcDtParam.rdCost->getWeightedMSE(
       rcDtParam.compID, piOrg[6], piCur[6], shift,
       piOrgLuma[size_t(6) << cShift]);   // piOrg[6] - piCur[6]; sum += Distortion(( temp * temp ) >> shift);
-    sum += getWeightedMSE(
+    sum += rcDtParam.rdCost->getWeightedMSE(
       rcDtParam.compID, piOrg[7], piCur[7], shift,
       piOrgLuma[size_t(7) << cShift]);   // piOrg[7] - piCur[7]; sum += Distortion(( temp * temp ) >> shift);
     piOrg += strideOrg;
@@ -3339,51 +3459,51 @@ Distortion RdCost::xGetSSE16_WTD( const DistParam &rcDtParam )
   uint32_t      shift            = DISTORTION_PRECISION_ADJUSTMENT(rcDtParam.bitDepth) << 1;
   for (; rows != 0; rows--)
   {
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[0], piCur[0], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[0], piCur[0], shift,
                           piOrgLuma[0]);   // piOrg[ 0] - piCur[ 0]; sum += Distortion(( temp * temp ) >> shift);
-    sum += getWeightedMSE(
+    sum += rcDtParam.rdCost->getWeightedMSE(
       rcDtParam.compID, piOrg[1], piCur[1], shift,
       piOrgLuma[size_t(1) << cShift]);   // piOrg[ 1] - piCur[ 1]; sum += Distortion(( temp * temp ) >> shift);
-    sum += getWeightedMSE(
+    sum += rcDtParam.rdCost->getWeightedMSE(
       rcDtParam.compID, piOrg[2], piCur[2], shift,
       piOrgLuma[size_t(2) << cShift]);   // piOrg[ 2] - piCur[ 2]; sum += Distortion(( temp * temp ) >> shift);
-    sum += getWeightedMSE(
+    sum += rcDtParam.rdCost->getWeightedMSE(
       rcDtParam.compID, piOrg[3], piCur[3], shift,
       piOrgLuma[size_t(3) << cShift]);   // piOrg[ 3] - piCur[ 3]; sum += Distortion(( temp * temp ) >> shift);
-    sum += getWeightedMSE(
+    sum += rcDtParam.rdCost->getWeightedMSE(
       rcDtParam.compID, piOrg[4], piCur[4], shift,
       piOrgLuma[size_t(4) << cShift]);   // piOrg[ 4] - piCur[ 4]; sum += Distortion(( temp * temp ) >> shift);
-    sum += getWeightedMSE(
+    sum += rcDtParam.rdCost->getWeightedMSE(
       rcDtParam.compID, piOrg[5], piCur[5], shift,
       piOrgLuma[size_t(5) << cShift]);   // piOrg[ 5] - piCur[ 5]; sum += Distortion(( temp * temp ) >> shift);
-    sum += getWeightedMSE(
+    sum += rcDtParam.rdCost->getWeightedMSE(
       rcDtParam.compID, piOrg[6], piCur[6], shift,
       piOrgLuma[size_t(6) << cShift]);   // piOrg[ 6] - piCur[ 6]; sum += Distortion(( temp * temp ) >> shift);
-    sum += getWeightedMSE(
+    sum += rcDtParam.rdCost->getWeightedMSE(
       rcDtParam.compID, piOrg[7], piCur[7], shift,
       piOrgLuma[size_t(7) << cShift]);   // piOrg[ 7] - piCur[ 7]; sum += Distortion(( temp * temp ) >> shift);
-    sum += getWeightedMSE(
+    sum += rcDtParam.rdCost->getWeightedMSE(
       rcDtParam.compID, piOrg[8], piCur[8], shift,
       piOrgLuma[size_t(8) << cShift]);   // piOrg[ 8] - piCur[ 8]; sum += Distortion(( temp * temp ) >> shift);
-    sum += getWeightedMSE(
+    sum += rcDtParam.rdCost->getWeightedMSE(
       rcDtParam.compID, piOrg[9], piCur[9], shift,
       piOrgLuma[size_t(9) << cShift]);   // piOrg[ 9] - piCur[ 9]; sum += Distortion(( temp * temp ) >> shift);
-    sum += getWeightedMSE(
+    sum += rcDtParam.rdCost->getWeightedMSE(
       rcDtParam.compID, piOrg[10], piCur[10], shift,
       piOrgLuma[size_t(10) << cShift]);   // piOrg[10] - piCur[10]; sum += Distortion(( temp * temp ) >> shift);
-    sum += getWeightedMSE(
+    sum += rcDtParam.rdCost->getWeightedMSE(
       rcDtParam.compID, piOrg[11], piCur[11], shift,
       piOrgLuma[size_t(11) << cShift]);   // piOrg[11] - piCur[11]; sum += Distortion(( temp * temp ) >> shift);
-    sum += getWeightedMSE(
+    sum += rcDtParam.rdCost->getWeightedMSE(
       rcDtParam.compID, piOrg[12], piCur[12], shift,
       piOrgLuma[size_t(12) << cShift]);   // piOrg[12] - piCur[12]; sum += Distortion(( temp * temp ) >> shift);
-    sum += getWeightedMSE(
+    sum += rcDtParam.rdCost->getWeightedMSE(
       rcDtParam.compID, piOrg[13], piCur[13], shift,
       piOrgLuma[size_t(13) << cShift]);   // piOrg[13] - piCur[13]; sum += Distortion(( temp * temp ) >> shift);
-    sum += getWeightedMSE(
+    sum += rcDtParam.rdCost->getWeightedMSE(
       rcDtParam.compID, piOrg[14], piCur[14], shift,
       piOrgLuma[size_t(14) << cShift]);   // piOrg[14] - piCur[14]; sum += Distortion(( temp * temp ) >> shift);
-    sum += getWeightedMSE(
+    sum += rcDtParam.rdCost->getWeightedMSE(
       rcDtParam.compID, piOrg[15], piCur[15], shift,
       piOrgLuma[size_t(15) << cShift]);   // piOrg[15] - piCur[15]; sum += Distortion(( temp * temp ) >> shift);
     piOrg += strideOrg;
@@ -3416,52 +3536,52 @@ Distortion RdCost::xGetSSE16N_WTD( const DistParam &rcDtParam )
   {
     for (int n = 0; n < cols; n += 16)
     {
-      sum += getWeightedMSE(rcDtParam.compID, piOrg[n + 0], piCur[n + 0], shift,
+      sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[n + 0], piCur[n + 0], shift,
                             piOrgLuma[size_t(n + 0) << cShift]);   // temp = piOrg[n+ 0] - piCur[n+ 0]; sum +=
                                                                    // Distortion(( temp * temp ) >> shift);
-      sum += getWeightedMSE(rcDtParam.compID, piOrg[n + 1], piCur[n + 1], shift,
+      sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[n + 1], piCur[n + 1], shift,
                             piOrgLuma[size_t(n + 1) << cShift]);   // temp = piOrg[n+ 1] - piCur[n+ 1]; sum +=
                                                                    // Distortion(( temp * temp ) >> shift);
-      sum += getWeightedMSE(rcDtParam.compID, piOrg[n + 2], piCur[n + 2], shift,
+      sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[n + 2], piCur[n + 2], shift,
                             piOrgLuma[size_t(n + 2) << cShift]);   // temp = piOrg[n+ 2] - piCur[n+ 2]; sum +=
                                                                    // Distortion(( temp * temp ) >> shift);
-      sum += getWeightedMSE(rcDtParam.compID, piOrg[n + 3], piCur[n + 3], shift,
+      sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[n + 3], piCur[n + 3], shift,
                             piOrgLuma[size_t(n + 3) << cShift]);   // temp = piOrg[n+ 3] - piCur[n+ 3]; sum +=
                                                                    // Distortion(( temp * temp ) >> shift);
-      sum += getWeightedMSE(rcDtParam.compID, piOrg[n + 4], piCur[n + 4], shift,
+      sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[n + 4], piCur[n + 4], shift,
                             piOrgLuma[size_t(n + 4) << cShift]);   // temp = piOrg[n+ 4] - piCur[n+ 4]; sum +=
                                                                    // Distortion(( temp * temp ) >> shift);
-      sum += getWeightedMSE(rcDtParam.compID, piOrg[n + 5], piCur[n + 5], shift,
+      sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[n + 5], piCur[n + 5], shift,
                             piOrgLuma[size_t(n + 5) << cShift]);   // temp = piOrg[n+ 5] - piCur[n+ 5]; sum +=
                                                                    // Distortion(( temp * temp ) >> shift);
-      sum += getWeightedMSE(rcDtParam.compID, piOrg[n + 6], piCur[n + 6], shift,
+      sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[n + 6], piCur[n + 6], shift,
                             piOrgLuma[size_t(n + 6) << cShift]);   // temp = piOrg[n+ 6] - piCur[n+ 6]; sum +=
                                                                    // Distortion(( temp * temp ) >> shift);
-      sum += getWeightedMSE(rcDtParam.compID, piOrg[n + 7], piCur[n + 7], shift,
+      sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[n + 7], piCur[n + 7], shift,
                             piOrgLuma[size_t(n + 7) << cShift]);   // temp = piOrg[n+ 7] - piCur[n+ 7]; sum +=
                                                                    // Distortion(( temp * temp ) >> shift);
-      sum += getWeightedMSE(rcDtParam.compID, piOrg[n + 8], piCur[n + 8], shift,
+      sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[n + 8], piCur[n + 8], shift,
                             piOrgLuma[size_t(n + 8) << cShift]);   // temp = piOrg[n+ 8] - piCur[n+ 8]; sum +=
                                                                    // Distortion(( temp * temp ) >> shift);
-      sum += getWeightedMSE(rcDtParam.compID, piOrg[n + 9], piCur[n + 9], shift,
+      sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[n + 9], piCur[n + 9], shift,
                             piOrgLuma[size_t(n + 9) << cShift]);   // temp = piOrg[n+ 9] - piCur[n+ 9]; sum +=
                                                                    // Distortion(( temp * temp ) >> shift);
-      sum += getWeightedMSE(rcDtParam.compID, piOrg[n + 10], piCur[n + 10], shift,
+      sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[n + 10], piCur[n + 10], shift,
                             piOrgLuma[size_t(n + 10) << cShift]);   // temp = piOrg[n+10] - piCur[n+10]; sum +=
                                                                     // Distortion(( temp * temp ) >> shift);
-      sum += getWeightedMSE(rcDtParam.compID, piOrg[n + 11], piCur[n + 11], shift,
+      sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[n + 11], piCur[n + 11], shift,
                             piOrgLuma[size_t(n + 11) << cShift]);   // temp = piOrg[n+11] - piCur[n+11]; sum +=
                                                                     // Distortion(( temp * temp ) >> shift);
-      sum += getWeightedMSE(rcDtParam.compID, piOrg[n + 12], piCur[n + 12], shift,
+      sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[n + 12], piCur[n + 12], shift,
                             piOrgLuma[size_t(n + 12) << cShift]);   // temp = piOrg[n+12] - piCur[n+12]; sum +=
                                                                     // Distortion(( temp * temp ) >> shift);
-      sum += getWeightedMSE(rcDtParam.compID, piOrg[n + 13], piCur[n + 13], shift,
+      sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[n + 13], piCur[n + 13], shift,
                             piOrgLuma[size_t(n + 13) << cShift]);   // temp = piOrg[n+13] - piCur[n+13]; sum +=
                                                                     // Distortion(( temp * temp ) >> shift);
-      sum += getWeightedMSE(rcDtParam.compID, piOrg[n + 14], piCur[n + 14], shift,
+      sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[n + 14], piCur[n + 14], shift,
                             piOrgLuma[size_t(n + 14) << cShift]);   // temp = piOrg[n+14] - piCur[n+14]; sum +=
                                                                     // Distortion(( temp * temp ) >> shift);
-      sum += getWeightedMSE(rcDtParam.compID, piOrg[n + 15], piCur[n + 15], shift,
+      sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[n + 15], piCur[n + 15], shift,
                             piOrgLuma[size_t(n + 15) << cShift]);   // temp = piOrg[n+15] - piCur[n+15]; sum +=
                                                                     // Distortion(( temp * temp ) >> shift);
     }
@@ -3493,100 +3613,100 @@ Distortion RdCost::xGetSSE32_WTD( const DistParam &rcDtParam )
   uint32_t   shift   = DISTORTION_PRECISION_ADJUSTMENT(rcDtParam.bitDepth) << 1;
   for (; rows != 0; rows--)
   {
-    sum += getWeightedMSE(
+    sum += rcDtParam.rdCost->getWeightedMSE(
       rcDtParam.compID, piOrg[0], piCur[0], shift,
       piOrgLuma[size_t(0)]);   // temp = piOrg[ 0] - piCur[ 0]; sum += Distortion(( temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[1], piCur[1], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[1], piCur[1], shift,
                           piOrgLuma[size_t(1) << cShift]);   // temp = piOrg[ 1] - piCur[ 1]; sum += Distortion((
                                                              // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[2], piCur[2], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[2], piCur[2], shift,
                           piOrgLuma[size_t(2) << cShift]);   // temp = piOrg[ 2] - piCur[ 2]; sum += Distortion((
                                                              // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[3], piCur[3], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[3], piCur[3], shift,
                           piOrgLuma[size_t(3) << cShift]);   // temp = piOrg[ 3] - piCur[ 3]; sum += Distortion((
                                                              // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[4], piCur[4], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[4], piCur[4], shift,
                           piOrgLuma[size_t(4) << cShift]);   // temp = piOrg[ 4] - piCur[ 4]; sum += Distortion((
                                                              // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[5], piCur[5], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[5], piCur[5], shift,
                           piOrgLuma[size_t(5) << cShift]);   // temp = piOrg[ 5] - piCur[ 5]; sum += Distortion((
                                                              // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[6], piCur[6], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[6], piCur[6], shift,
                           piOrgLuma[size_t(6) << cShift]);   // temp = piOrg[ 6] - piCur[ 6]; sum += Distortion((
                                                              // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[7], piCur[7], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[7], piCur[7], shift,
                           piOrgLuma[size_t(7) << cShift]);   // temp = piOrg[ 7] - piCur[ 7]; sum += Distortion((
                                                              // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[8], piCur[8], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[8], piCur[8], shift,
                           piOrgLuma[size_t(8) << cShift]);   // temp = piOrg[ 8] - piCur[ 8]; sum += Distortion((
                                                              // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[9], piCur[9], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[9], piCur[9], shift,
                           piOrgLuma[size_t(9) << cShift]);   // temp = piOrg[ 9] - piCur[ 9]; sum += Distortion((
                                                              // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[10], piCur[10], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[10], piCur[10], shift,
                           piOrgLuma[size_t(10) << cShift]);   // temp = piOrg[10] - piCur[10]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[11], piCur[11], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[11], piCur[11], shift,
                           piOrgLuma[size_t(11) << cShift]);   // temp = piOrg[11] - piCur[11]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[12], piCur[12], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[12], piCur[12], shift,
                           piOrgLuma[size_t(12) << cShift]);   // temp = piOrg[12] - piCur[12]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[13], piCur[13], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[13], piCur[13], shift,
                           piOrgLuma[size_t(13) << cShift]);   // temp = piOrg[13] - piCur[13]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[14], piCur[14], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[14], piCur[14], shift,
                           piOrgLuma[size_t(14) << cShift]);   // temp = piOrg[14] - piCur[14]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[15], piCur[15], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[15], piCur[15], shift,
                           piOrgLuma[size_t(15) << cShift]);   // temp = piOrg[15] - piCur[15]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[16], piCur[16], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[16], piCur[16], shift,
                           piOrgLuma[size_t(16) << cShift]);   //  temp = piOrg[16] - piCur[16]; sum += Distortion((
                                                               //  temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[17], piCur[17], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[17], piCur[17], shift,
                           piOrgLuma[size_t(17) << cShift]);   //  temp = piOrg[17] - piCur[17]; sum += Distortion((
                                                               //  temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[18], piCur[18], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[18], piCur[18], shift,
                           piOrgLuma[size_t(18) << cShift]);   //  temp = piOrg[18] - piCur[18]; sum += Distortion((
                                                               //  temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[19], piCur[19], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[19], piCur[19], shift,
                           piOrgLuma[size_t(19) << cShift]);   //  temp = piOrg[19] - piCur[19]; sum += Distortion((
                                                               //  temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[20], piCur[20], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[20], piCur[20], shift,
                           piOrgLuma[size_t(20) << cShift]);   //  temp = piOrg[20] - piCur[20]; sum += Distortion((
                                                               //  temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[21], piCur[21], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[21], piCur[21], shift,
                           piOrgLuma[size_t(21) << cShift]);   //  temp = piOrg[21] - piCur[21]; sum += Distortion((
                                                               //  temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[22], piCur[22], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[22], piCur[22], shift,
                           piOrgLuma[size_t(22) << cShift]);   //  temp = piOrg[22] - piCur[22]; sum += Distortion((
                                                               //  temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[23], piCur[23], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[23], piCur[23], shift,
                           piOrgLuma[size_t(23) << cShift]);   //  temp = piOrg[23] - piCur[23]; sum += Distortion((
                                                               //  temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[24], piCur[24], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[24], piCur[24], shift,
                           piOrgLuma[size_t(24) << cShift]);   //  temp = piOrg[24] - piCur[24]; sum += Distortion((
                                                               //  temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[25], piCur[25], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[25], piCur[25], shift,
                           piOrgLuma[size_t(25) << cShift]);   //  temp = piOrg[25] - piCur[25]; sum += Distortion((
                                                               //  temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[26], piCur[26], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[26], piCur[26], shift,
                           piOrgLuma[size_t(26) << cShift]);   //  temp = piOrg[26] - piCur[26]; sum += Distortion((
                                                               //  temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[27], piCur[27], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[27], piCur[27], shift,
                           piOrgLuma[size_t(27) << cShift]);   //  temp = piOrg[27] - piCur[27]; sum += Distortion((
                                                               //  temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[28], piCur[28], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[28], piCur[28], shift,
                           piOrgLuma[size_t(28) << cShift]);   //  temp = piOrg[28] - piCur[28]; sum += Distortion((
                                                               //  temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[29], piCur[29], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[29], piCur[29], shift,
                           piOrgLuma[size_t(29) << cShift]);   //  temp = piOrg[29] - piCur[29]; sum += Distortion((
                                                               //  temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[30], piCur[30], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[30], piCur[30], shift,
                           piOrgLuma[size_t(30) << cShift]);   //  temp = piOrg[30] - piCur[30]; sum += Distortion((
                                                               //  temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[31], piCur[31], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[31], piCur[31], shift,
                           piOrgLuma[size_t(31) << cShift]);   //  temp = piOrg[31] - piCur[31]; sum += Distortion((
                                                               //  temp * temp ) >> shift);
     piOrg += strideOrg;
@@ -3617,196 +3737,196 @@ Distortion RdCost::xGetSSE64_WTD( const DistParam &rcDtParam )
   uint32_t   shift   = DISTORTION_PRECISION_ADJUSTMENT((rcDtParam.bitDepth)) << 1;
   for (; rows != 0; rows--)
   {
-    sum += getWeightedMSE(
+    sum += rcDtParam.rdCost->getWeightedMSE(
       rcDtParam.compID, piOrg[0], piCur[0], shift,
       piOrgLuma[size_t(0)]);   // temp = piOrg[ 0] - piCur[ 0]; sum += Distortion(( temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[1], piCur[1], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[1], piCur[1], shift,
                           piOrgLuma[size_t(1) << cShift]);   // temp = piOrg[ 1] - piCur[ 1]; sum += Distortion((
                                                              // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[2], piCur[2], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[2], piCur[2], shift,
                           piOrgLuma[size_t(2) << cShift]);   // temp = piOrg[ 2] - piCur[ 2]; sum += Distortion((
                                                              // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[3], piCur[3], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[3], piCur[3], shift,
                           piOrgLuma[size_t(3) << cShift]);   // temp = piOrg[ 3] - piCur[ 3]; sum += Distortion((
                                                              // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[4], piCur[4], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[4], piCur[4], shift,
                           piOrgLuma[size_t(4) << cShift]);   // temp = piOrg[ 4] - piCur[ 4]; sum += Distortion((
                                                              // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[5], piCur[5], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[5], piCur[5], shift,
                           piOrgLuma[size_t(5) << cShift]);   // temp = piOrg[ 5] - piCur[ 5]; sum += Distortion((
                                                              // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[6], piCur[6], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[6], piCur[6], shift,
                           piOrgLuma[size_t(6) << cShift]);   // temp = piOrg[ 6] - piCur[ 6]; sum += Distortion((
                                                              // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[7], piCur[7], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[7], piCur[7], shift,
                           piOrgLuma[size_t(7) << cShift]);   // temp = piOrg[ 7] - piCur[ 7]; sum += Distortion((
                                                              // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[8], piCur[8], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[8], piCur[8], shift,
                           piOrgLuma[size_t(8) << cShift]);   // temp = piOrg[ 8] - piCur[ 8]; sum += Distortion((
                                                              // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[9], piCur[9], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[9], piCur[9], shift,
                           piOrgLuma[size_t(9) << cShift]);   // temp = piOrg[ 9] - piCur[ 9]; sum += Distortion((
                                                              // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[10], piCur[10], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[10], piCur[10], shift,
                           piOrgLuma[size_t(10) << cShift]);   // temp = piOrg[10] - piCur[10]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[11], piCur[11], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[11], piCur[11], shift,
                           piOrgLuma[size_t(11) << cShift]);   // temp = piOrg[11] - piCur[11]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[12], piCur[12], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[12], piCur[12], shift,
                           piOrgLuma[size_t(12) << cShift]);   // temp = piOrg[12] - piCur[12]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[13], piCur[13], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[13], piCur[13], shift,
                           piOrgLuma[size_t(13) << cShift]);   // temp = piOrg[13] - piCur[13]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[14], piCur[14], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[14], piCur[14], shift,
                           piOrgLuma[size_t(14) << cShift]);   // temp = piOrg[14] - piCur[14]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[15], piCur[15], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[15], piCur[15], shift,
                           piOrgLuma[size_t(15) << cShift]);   // temp = piOrg[15] - piCur[15]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[16], piCur[16], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[16], piCur[16], shift,
                           piOrgLuma[size_t(16) << cShift]);   //  temp = piOrg[16] - piCur[16]; sum += Distortion((
                                                               //  temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[17], piCur[17], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[17], piCur[17], shift,
                           piOrgLuma[size_t(17) << cShift]);   //  temp = piOrg[17] - piCur[17]; sum += Distortion((
                                                               //  temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[18], piCur[18], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[18], piCur[18], shift,
                           piOrgLuma[size_t(18) << cShift]);   //  temp = piOrg[18] - piCur[18]; sum += Distortion((
                                                               //  temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[19], piCur[19], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[19], piCur[19], shift,
                           piOrgLuma[size_t(19) << cShift]);   //  temp = piOrg[19] - piCur[19]; sum += Distortion((
                                                               //  temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[20], piCur[20], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[20], piCur[20], shift,
                           piOrgLuma[size_t(20) << cShift]);   //  temp = piOrg[20] - piCur[20]; sum += Distortion((
                                                               //  temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[21], piCur[21], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[21], piCur[21], shift,
                           piOrgLuma[size_t(21) << cShift]);   //  temp = piOrg[21] - piCur[21]; sum += Distortion((
                                                               //  temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[22], piCur[22], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[22], piCur[22], shift,
                           piOrgLuma[size_t(22) << cShift]);   //  temp = piOrg[22] - piCur[22]; sum += Distortion((
                                                               //  temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[23], piCur[23], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[23], piCur[23], shift,
                           piOrgLuma[size_t(23) << cShift]);   //  temp = piOrg[23] - piCur[23]; sum += Distortion((
                                                               //  temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[24], piCur[24], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[24], piCur[24], shift,
                           piOrgLuma[size_t(24) << cShift]);   //  temp = piOrg[24] - piCur[24]; sum += Distortion((
                                                               //  temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[25], piCur[25], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[25], piCur[25], shift,
                           piOrgLuma[size_t(25) << cShift]);   //  temp = piOrg[25] - piCur[25]; sum += Distortion((
                                                               //  temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[26], piCur[26], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[26], piCur[26], shift,
                           piOrgLuma[size_t(26) << cShift]);   //  temp = piOrg[26] - piCur[26]; sum += Distortion((
                                                               //  temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[27], piCur[27], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[27], piCur[27], shift,
                           piOrgLuma[size_t(27) << cShift]);   //  temp = piOrg[27] - piCur[27]; sum += Distortion((
                                                               //  temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[28], piCur[28], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[28], piCur[28], shift,
                           piOrgLuma[size_t(28) << cShift]);   //  temp = piOrg[28] - piCur[28]; sum += Distortion((
                                                               //  temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[29], piCur[29], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[29], piCur[29], shift,
                           piOrgLuma[size_t(29) << cShift]);   //  temp = piOrg[29] - piCur[29]; sum += Distortion((
                                                               //  temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[30], piCur[30], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[30], piCur[30], shift,
                           piOrgLuma[size_t(30) << cShift]);   //  temp = piOrg[30] - piCur[30]; sum += Distortion((
                                                               //  temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[31], piCur[31], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[31], piCur[31], shift,
                           piOrgLuma[size_t(31) << cShift]);   //  temp = piOrg[31] - piCur[31]; sum += Distortion((
                                                               //  temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[32], piCur[32], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[32], piCur[32], shift,
                           piOrgLuma[size_t(32) << cShift]);   // temp = piOrg[32] - piCur[32]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[33], piCur[33], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[33], piCur[33], shift,
                           piOrgLuma[size_t(33) << cShift]);   // temp = piOrg[33] - piCur[33]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[34], piCur[34], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[34], piCur[34], shift,
                           piOrgLuma[size_t(34) << cShift]);   // temp = piOrg[34] - piCur[34]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[35], piCur[35], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[35], piCur[35], shift,
                           piOrgLuma[size_t(35) << cShift]);   // temp = piOrg[35] - piCur[35]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[36], piCur[36], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[36], piCur[36], shift,
                           piOrgLuma[size_t(36) << cShift]);   // temp = piOrg[36] - piCur[36]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[37], piCur[37], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[37], piCur[37], shift,
                           piOrgLuma[size_t(37) << cShift]);   // temp = piOrg[37] - piCur[37]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[38], piCur[38], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[38], piCur[38], shift,
                           piOrgLuma[size_t(38) << cShift]);   // temp = piOrg[38] - piCur[38]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[39], piCur[39], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[39], piCur[39], shift,
                           piOrgLuma[size_t(39) << cShift]);   // temp = piOrg[39] - piCur[39]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[40], piCur[40], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[40], piCur[40], shift,
                           piOrgLuma[size_t(40) << cShift]);   // temp = piOrg[40] - piCur[40]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[41], piCur[41], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[41], piCur[41], shift,
                           piOrgLuma[size_t(41) << cShift]);   // temp = piOrg[41] - piCur[41]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[42], piCur[42], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[42], piCur[42], shift,
                           piOrgLuma[size_t(42) << cShift]);   // temp = piOrg[42] - piCur[42]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[43], piCur[43], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[43], piCur[43], shift,
                           piOrgLuma[size_t(43) << cShift]);   // temp = piOrg[43] - piCur[43]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[44], piCur[44], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[44], piCur[44], shift,
                           piOrgLuma[size_t(44) << cShift]);   // temp = piOrg[44] - piCur[44]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[45], piCur[45], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[45], piCur[45], shift,
                           piOrgLuma[size_t(45) << cShift]);   // temp = piOrg[45] - piCur[45]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[46], piCur[46], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[46], piCur[46], shift,
                           piOrgLuma[size_t(46) << cShift]);   // temp = piOrg[46] - piCur[46]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[47], piCur[47], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[47], piCur[47], shift,
                           piOrgLuma[size_t(47) << cShift]);   // temp = piOrg[47] - piCur[47]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[48], piCur[48], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[48], piCur[48], shift,
                           piOrgLuma[size_t(48) << cShift]);   // temp = piOrg[48] - piCur[48]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[49], piCur[49], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[49], piCur[49], shift,
                           piOrgLuma[size_t(49) << cShift]);   // temp = piOrg[49] - piCur[49]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[50], piCur[50], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[50], piCur[50], shift,
                           piOrgLuma[size_t(50) << cShift]);   // temp = piOrg[50] - piCur[50]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[51], piCur[51], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[51], piCur[51], shift,
                           piOrgLuma[size_t(51) << cShift]);   // temp = piOrg[51] - piCur[51]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[52], piCur[52], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[52], piCur[52], shift,
                           piOrgLuma[size_t(52) << cShift]);   // temp = piOrg[52] - piCur[52]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[53], piCur[53], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[53], piCur[53], shift,
                           piOrgLuma[size_t(53) << cShift]);   // temp = piOrg[53] - piCur[53]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[54], piCur[54], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[54], piCur[54], shift,
                           piOrgLuma[size_t(54) << cShift]);   // temp = piOrg[54] - piCur[54]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[55], piCur[55], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[55], piCur[55], shift,
                           piOrgLuma[size_t(55) << cShift]);   // temp = piOrg[55] - piCur[55]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[56], piCur[56], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[56], piCur[56], shift,
                           piOrgLuma[size_t(56) << cShift]);   // temp = piOrg[56] - piCur[56]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[57], piCur[57], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[57], piCur[57], shift,
                           piOrgLuma[size_t(57) << cShift]);   // temp = piOrg[57] - piCur[57]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[58], piCur[58], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[58], piCur[58], shift,
                           piOrgLuma[size_t(58) << cShift]);   // temp = piOrg[58] - piCur[58]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[59], piCur[59], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[59], piCur[59], shift,
                           piOrgLuma[size_t(59) << cShift]);   // temp = piOrg[59] - piCur[59]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[60], piCur[60], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[60], piCur[60], shift,
                           piOrgLuma[size_t(60) << cShift]);   // temp = piOrg[60] - piCur[60]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[61], piCur[61], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[61], piCur[61], shift,
                           piOrgLuma[size_t(61) << cShift]);   // temp = piOrg[61] - piCur[61]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[62], piCur[62], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[62], piCur[62], shift,
                           piOrgLuma[size_t(62) << cShift]);   // temp = piOrg[62] - piCur[62]; sum += Distortion((
                                                               // temp * temp ) >> shift);
-    sum += getWeightedMSE(rcDtParam.compID, piOrg[63], piCur[63], shift,
+    sum += rcDtParam.rdCost->getWeightedMSE(rcDtParam.compID, piOrg[63], piCur[63], shift,
                           piOrgLuma[size_t(63) << cShift]);   // temp = piOrg[63] - piCur[63]; sum += Distortion((
                                                               // temp * temp ) >> shift);
     piOrg += strideOrg;
@@ -3903,4 +4023,72 @@ Distortion RdCost::xGetSADwMask( const DistParam& rcDtParam )
   sum <<= subShift;
   return (sum >> distortionShift );
 }
+
+void RdCost::xGetSADwMaskMulti(const DistParam &rcDtParam, const Pel *const *cur, const int numCand, Distortion *dist)
+{
+  DistParam dp = rcDtParam;
+  for (int k = 0; k < numCand; k++)
+  {
+    dp.cur.buf = cur[k];
+    dist[k]    = xGetSADwMask(dp);
+  }
+}
+
+uint64_t RdCost::xGetPlaneSSE(const Pel *org, const ptrdiff_t orgStride, const Pel *cur, const ptrdiff_t curStride,
+                              const int width, const int height)
+{
+  uint64_t sum = 0;
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      const Intermediate_Int diff = org[x] - cur[x];
+      sum += uint64_t(diff * diff);
+    }
+    org += orgStride;
+    cur += curStride;
+  }
+  return sum;
+}
+
+void RdCost::xGetSSIMWindows(const double *org, const double *rec, const ptrdiff_t stride, const double *weights,
+                             const int numWindows, const double c1, const double c2, const bool luminance,
+                             double *ssim)
+{
+  for (int i = 0; i < numWindows; i++)
+  {
+    double muOrg         = 0.0;
+    double muRec         = 0.0;
+    double muOrigSqr     = 0.0;
+    double muRecSqr      = 0.0;
+    double muOrigMultRec = 0.0;
+
+    for (int y = 0; y < SSIM_WINDOW_SIZE; y++)
+    {
+      for (int x = 0; x < SSIM_WINDOW_SIZE; x++)
+      {
+        const double gaussianWeight = weights[y * SSIM_WINDOW_SIZE + x];
+        const double orgPel         = org[y * stride + i + x];
+        const double recPel         = rec[y * stride + i + x];
+
+        muOrg         += orgPel * gaussianWeight;
+        muRec         += recPel * gaussianWeight;
+        muOrigSqr     += orgPel * orgPel * gaussianWeight;
+        muRecSqr      += recPel * recPel * gaussianWeight;
+        muOrigMultRec += orgPel * recPel * gaussianWeight;
+      }
+    }
+
+    const double sigmaSqrOrig = muOrigSqr - (muOrg * muOrg);
+    const double sigmaSqrRec  = muRecSqr - (muRec * muRec);
+    const double sigmaOrigRec = muOrigMultRec - (muOrg * muRec);
+
+    double blockSSIMVal = ((2.0 * sigmaOrigRec + c2) / (sigmaSqrOrig + sigmaSqrRec + c2));
+    if (luminance)
+    {
+      blockSSIMVal *= (2.0 * muOrg * muRec + c1) / (muOrg * muOrg + muRec * muRec + c1);
+    }
+    ssim[i] = blockSSIMVal;
+  }
+}
 //! \}
@@ -58,11 +58,19 @@ class EncCfg;
 // ====================================================================================================================
 
 using DistFunc = std::function<Distortion(const DistParam &)>;
+using DistFuncX4 = void (*)(const DistParam &, const Pel *const *, Distortion *);
+using DistFuncDmvr = void (*)(const DistParam &, Distortion *);
+using DistFuncMulti = void (*)(const DistParam &, const Pel *const *, int, Distortion *);
+using DistFuncPlane = uint64_t (*)(const Pel *, ptrdiff_t, const Pel *, ptrdiff_t, int, int);
+using SsimFuncWindows = void (*)(const double *, const double *, ptrdiff_t, const double *, int, double, double, bool,
+                                 double *);
 
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
 
+class RdCost;
+
 /// distortion parameter class
 class DistParam
 {
@@ -71,6 +79,7 @@ public:
   CPelBuf               cur;
 #if WCG_EXT
   CPelBuf               orgLuma;
+  const RdCost         *rdCost;          // provides the luma level weights of the weighted SSE
 #endif
   const Pel*            mask;
   ptrdiff_t             maskStride;
@@ -95,6 +104,9 @@ public:
   int                   cShiftY;
   DistParam() :
   org(), cur(),
+#if WCG_EXT
+  rdCost( nullptr ),
+#endif
   mask( nullptr ),
   maskStride( 0 ),
   stepX(0),
@@ -111,6 +123,11 @@ private:
   // for distortion
 
   static EnumArray<DistFunc, DFunc> m_distortionFunc;
+  static DistFuncX4                 m_sadX4Func;
+  static DistFuncDmvr               m_sadDmvrFunc;
+  static DistFuncMulti              m_sadMaskMultiFunc;
+  static DistFuncPlane              m_planeSseFunc;
+  static SsimFuncWindows            m_ssimWindowsFunc;
   CostMode                m_costMode;
   double                  m_distortionWeight[MAX_NUM_COMPONENT]; // only chroma values are used.
   double                  m_dLambda;
@@ -120,12 +137,13 @@ private:
   double                  m_dLambda_unadjusted; // TODO: check is necessary
   double                  m_distScaleUnadjusted;
 
-  static std::vector<int32_t> m_reshapeLumaLevelToWeightPLUT;   // scaled by MSE_WEIGHT_ONE
-  static std::vector<double>  m_lumaLevelToWeightPLUT;
+  // per instance, as the reshaper of each encoder updates them for every picture
+  std::vector<int32_t> m_reshapeLumaLevelToWeightPLUT;   // scaled by MSE_WEIGHT_ONE
+  std::vector<double>  m_lumaLevelToWeightPLUT;
 
-  static int32_t  m_chromaWeight;   // scaled by MSE_WEIGHT_ONE
-  static uint32_t m_signalType;
-  static int      m_lumaBD;
+  int32_t  m_chromaWeight;   // scaled by MSE_WEIGHT_ONE
+  uint32_t m_signalType;
+  int      m_lumaBD;
 
   ChromaFormat            m_cf;
 #endif
@@ -217,6 +235,46 @@ public:
   void setDistParam(DistParam &rcDP, const CPelBuf &org, const Pel *piRefY, ptrdiff_t iRefStride, const Pel *mask,
                     ptrdiff_t iMaskStride, int stepX, ptrdiff_t iMaskStride2, int bitDepth, ComponentID compID);
 
+  // SAD of the original block of a DistParam set up for SAD against several candidate positions with the stride of
+  // rcDP.cur, the original is shared by groups of four candidates. Returns false if the batched path does not apply.
+  bool getSADMulti(const DistParam &rcDP, const Pel *const *cur, int numCand, Distortion *dist) const;
+
+  // SADs of the whole DMVR search window in one pass: org and cur of rcDP address the unrefined positions of the two
+  // lists, candidate (dx, dy) compares org displaced by (dx, dy) with cur displaced by (-dx, -dy). dist is indexed
+  // (dy + DMVR_RANGE) * DMVR_SPAN + dx + DMVR_RANGE.
+  void getSADsDmvr(const DistParam &rcDP, Distortion *dist) const { m_sadDmvrFunc(rcDP, dist); }
+
+  // masked SADs of up to GEO_MAX_NUM_UNI_CANDS candidates with the stride of rcDP.cur against the original, the mask
+  // and the original set up as for DFunc::SAD_WITH_MASK are read once for all candidates
+  void getSADwMaskMulti(const DistParam &rcDP, const Pel *const *cur, const int numCand, Distortion *dist) const
+  {
+    m_sadMaskMultiFunc(rcDP, cur, numCand, dist);
+  }
+
+  // sum of squared differences of two planes of org.width x org.height samples, accumulated in 64 bits so that it is
+  // exact for whole pictures
+  static uint64_t getPlaneSSE(const CPelBuf &org, const CPelBuf &cur)
+  {
+    return m_planeSseFunc(org.buf, org.stride, cur.buf, cur.stride, org.width, org.height);
+  }
+
+  // SSIM of numWindows horizontally adjacent SSIM_WINDOW_SIZE x SSIM_WINDOW_SIZE windows, window i starts at org + i
+  // and rec + i. weights holds the SSIM_WINDOW_SIZE x SSIM_WINDOW_SIZE window weights row by row, the luminance term
+  // is only included if requested, as at the coarsest scale of MS-SSIM.
+  static void getSSIMWindows(const double *org, const double *rec, const ptrdiff_t stride, const double *weights,
+                             const int numWindows, const double c1, const double c2, const bool luminance, double *ssim)
+  {
+    m_ssimWindowsFunc(org, rec, stride, weights, numWindows, c1, c2, luminance, ssim);
+  }
+
+  // current entries of the distortion function tables, e.g. to compare the scalar and SIMD implementations
+  static const DistFunc &getDistFunc(const DFunc dFunc) { return m_distortionFunc[dFunc]; }
+  static DistFuncX4      getSADX4Func() { return m_sadX4Func; }
+  static DistFuncDmvr    getSADDmvrFunc() { return m_sadDmvrFunc; }
+  static DistFuncMulti   getSADwMaskMultiFunc() { return m_sadMaskMultiFunc; }
+  static DistFuncPlane   getPlaneSSEFunc() { return m_planeSseFunc; }
+  static SsimFuncWindows getSSIMWindowsFunc() { return m_ssimWindowsFunc; }
+
   double         getMotionLambda          ( )  { return m_dLambdaMotionSAD; }
   void           selectMotionLambda       ( )  { m_motionLambda = getMotionLambda( ); }
   void           setPredictor             ( const Mv& rcMv )
@@ -372,6 +430,7 @@ public:
   void           resetStore() { m_resetStore = true; }
 
 private:
+  void              xInitDistFuncs();
 
   static Distortion xGetSSE           ( const DistParam& pcDtParam );
   static Distortion xGetSSE4          ( const DistParam& pcDtParam );
@@ -382,7 +441,7 @@ private:
   static Distortion xGetSSE16N        ( const DistParam& pcDtParam );
 
 #if WCG_EXT
-  static Distortion getWeightedMSE(int compIdx, const Pel org, const Pel cur, const uint32_t shift, const Pel orgLuma);
+  Distortion getWeightedMSE(int compIdx, const Pel org, const Pel cur, const uint32_t shift, const Pel orgLuma) const;
   static Distortion xGetSSE_WTD       ( const DistParam& pcDtParam );
   static Distortion xGetSSE2_WTD      ( const DistParam& pcDtParam );
   static Distortion xGetSSE4_WTD      ( const DistParam& pcDtParam );
@@ -406,7 +465,13 @@ private:
   static Distortion xGetSAD48         ( const DistParam& pcDtParam );
 
   static Distortion xGetSAD_full      ( const DistParam& pcDtParam );
+  static void       xGetSADX4         ( const DistParam& pcDtParam, const Pel* const* cur, Distortion* dist );
+  static void       xGetSADDmvr       ( const DistParam& pcDtParam, Distortion* dist );
   static Distortion xGetSADwMask      ( const DistParam& pcDtParam );
+  static void       xGetSADwMaskMulti ( const DistParam& pcDtParam, const Pel* const* cur, int numCand, Distortion* dist );
+  static uint64_t   xGetPlaneSSE      ( const Pel* org, ptrdiff_t orgStride, const Pel* cur, ptrdiff_t curStride, int width, int height );
+  static void       xGetSSIMWindows   ( const double* org, const double* rec, ptrdiff_t stride, const double* weights, int numWindows,
+                                        double c1, double c2, bool luminance, double* ssim );
 
   static Distortion xGetMRSAD         ( const DistParam& pcDtParam );
   static Distortion xGetMRSAD4        ( const DistParam& pcDtParam );
@@ -447,6 +512,14 @@ private:
   template<int width, X86_VEXT vext> static Distortion xGetSAD_NxN_SIMD(const DistParam &pcDtParam);
   template<X86_VEXT vext>
   static Distortion xGetSAD_IBD_SIMD( const DistParam& pcDtParam );
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+  template<X86_VEXT vext>
+  static void       xGetSADX4_SIMD  ( const DistParam& pcDtParam, const Pel* const* cur, Distortion* dist );
+  template<X86_VEXT vext>
+  static void       xGetSADDmvr_SIMD( const DistParam& pcDtParam, Distortion* dist );
+  template<X86_VEXT vext>
+  static uint64_t   xGetPlaneSSE_SIMD( const Pel* org, ptrdiff_t orgStride, const Pel* cur, ptrdiff_t curStride, int width, int height );
+#endif
 #if RExt__HIGH_BIT_DEPTH_SUPPORT
   template<X86_VEXT vext>
   static Distortion xGetHADs_HBD_SIMD(const DistParam& pcDtParam);
@@ -457,6 +530,11 @@ private:
 
   template< X86_VEXT vext >
   static Distortion xGetSADwMask_SIMD( const DistParam& pcDtParam );
+  template< X86_VEXT vext >
+  static void       xGetSADwMaskMulti_SIMD( const DistParam& pcDtParam, const Pel* const* cur, int numCand, Distortion* dist );
+  template< X86_VEXT vext >
+  static void       xGetSSIMWindows_SIMD( const double* org, const double* rec, ptrdiff_t stride, const double* weights,
+                                          int numWindows, double c1, double c2, bool luminance, double* ssim );
 #if RExt__HIGH_BIT_DEPTH_SUPPORT
   template<X86_VEXT vext>
   static Distortion xGetSAD_HBD_SIMD(const DistParam& pcDtParam);
@@ -67,6 +67,10 @@ void  Reshape::createDec(int bitDepth)
   m_initCW = m_reshapeLUTSize / PIC_CODE_CW_BINS;
   m_fwdLUT.resize(m_reshapeLUTSize, 0);
   m_invLUT.resize(m_reshapeLUTSize, 0);
+  m_fwdPwl.lut    = m_fwdLUT.data();
+  m_fwdPwl.maxVal = m_reshapeLUTSize - 1;
+  m_invPwl.lut    = m_invLUT.data();
+  m_invPwl.maxVal = m_reshapeLUTSize - 1;
   if (m_binCW.empty())
   {
     m_binCW.resize(PIC_CODE_CW_BINS, 0);
@@ -314,6 +318,80 @@ void Reshape::constructReshaper()
     int invSample = m_inputPivot[idxYInv] + ((m_invScaleCoef[idxYInv] * (lumaSample - m_reshapePivot[idxYInv]) + (1 << (FP_PREC - 1))) >> FP_PREC);
     m_invLUT[lumaSample] = Clip3((Pel)0, (Pel)((1 << m_lumaBD) - 1), (Pel)(invSample));
   }
+  updatePwl();
+}
+
+/** derive the piecewise-linear form of the forward and inverse LUTs used by the vectorized mapping
+* \param void
+* \return void
+*/
+void Reshape::updatePwl()
+{
+  const int maxVal = m_reshapeLUTSize - 1;
+
+  m_fwdPwl.lut           = m_fwdLUT.data();
+  m_fwdPwl.maxVal        = maxVal;
+  m_fwdPwl.log2BinLen    = floorLog2(m_initCW);
+  m_fwdPwl.binBase       = 0;
+  m_fwdPwl.numThresholds = 0;
+
+  // inverse bin index as derived by getPWLIdxInv()
+  const int minBinIdx    = (int) m_sliceReshapeInfo.reshaperModelMinBinIdx;
+  const int maxBinIdx    = std::min((int) m_sliceReshapeInfo.reshaperModelMaxBinIdx, PIC_CODE_CW_BINS - 2);
+  m_invPwl.lut           = m_invLUT.data();
+  m_invPwl.maxVal        = maxVal;
+  m_invPwl.log2BinLen    = 0;
+  m_invPwl.binBase       = minBinIdx;
+  m_invPwl.numThresholds = std::max(0, maxBinIdx - minBinIdx + 1);
+
+  bool fitsInt16 = maxVal <= std::numeric_limits<int16_t>::max();
+  for (int i = 0; i < PIC_CODE_CW_BINS; i++)
+  {
+    fitsInt16 &= m_fwdScaleCoef[i] <= std::numeric_limits<int16_t>::max();
+    fitsInt16 &= m_invScaleCoef[i] <= std::numeric_limits<int16_t>::max();
+
+    m_fwdPwl.inPivot[i]  = (int16_t) m_inputPivot[i];
+    m_fwdPwl.outPivot[i] = (int16_t) m_reshapePivot[i];
+    m_fwdPwl.scale[i]    = (int16_t) m_fwdScaleCoef[i];
+    m_invPwl.inPivot[i]  = (int16_t) m_reshapePivot[i];
+    m_invPwl.outPivot[i] = (int16_t) m_inputPivot[i];
+    m_invPwl.scale[i]    = (int16_t) m_invScaleCoef[i];
+  }
+  for (int k = 0; k < m_invPwl.numThresholds; k++)
+  {
+    m_invPwl.thresholds[k] = (int16_t) m_reshapePivot[minBinIdx + 1 + k];
+  }
+
+  // the kernels evaluate the PWL in 16-bit lanes with saturation, only use them where that matches the LUTs
+  auto matchesLut = [&](const ReshapePwl &pwl)
+  {
+    for (int x = 0; x <= maxVal; x++)
+    {
+      int idx = pwl.binBase;
+      if (pwl.log2BinLen > 0)
+      {
+        idx = x >> pwl.log2BinLen;
+      }
+      else
+      {
+        for (int k = 0; k < pwl.numThresholds; k++)
+        {
+          idx += x >= pwl.thresholds[k] ? 1 : 0;
+        }
+      }
+      const int diff = x - pwl.inPivot[idx];
+      const int prod = Clip3<int>(-32768, 32767, (pwl.scale[idx] * diff + (1 << (FP_PREC - 1))) >> FP_PREC);
+      const int val  = Clip3<int>(-32768, 32767, prod + pwl.outPivot[idx]);
+      if (Clip3(0, maxVal, val) != pwl.lut[x])
+      {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  m_fwdPwl.valid = fitsInt16 && matchesLut(m_fwdPwl);
+  m_invPwl.valid = fitsInt16 && matchesLut(m_invPwl);
 }
 
 
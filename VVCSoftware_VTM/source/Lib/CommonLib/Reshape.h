@@ -70,6 +70,10 @@ protected:
   int                     m_chromaScale;
   int                     m_vpduX;
   int                     m_vpduY;
+  ReshapePwl              m_fwdPwl;
+  ReshapePwl              m_invPwl;
+
+  void updatePwl();
 public:
   Reshape();
   ~Reshape();
@@ -80,6 +84,8 @@ public:
   std::vector<Pel>&  getFwdLUT() { return m_fwdLUT; }
   std::vector<Pel>&  getInvLUT() { return m_invLUT; }
   std::vector<int>&  getChromaAdjHelpLUT() { return m_chromaAdjHelpLUT; }
+  const ReshapePwl&  getFwdPwl() const { return m_fwdPwl; }
+  const ReshapePwl&  getInvPwl() const { return m_invPwl; }
 
   bool getCTUFlag() { return m_ctuFlag; }
   void setCTUFlag(bool b) { m_ctuFlag = b; }
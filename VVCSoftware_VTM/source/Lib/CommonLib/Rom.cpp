@@ -43,6 +43,7 @@
 #include <stdio.h>
 #include <math.h>
 #include <iomanip>
+#include <mutex>
 
 constexpr int MmvdIdx::ADD_NUM;
 constexpr int MmvdIdx::BASE_MV_NUM;
@@ -276,8 +277,18 @@ Size g_log2TxSubblockSize[MAX_CU_DEPTH + 1][MAX_CU_DEPTH + 1] = {
 };
 
 // initialize ROM variables
+// the tables are shared by all encoder/decoder instances of the process and only built by the first user
+static std::mutex s_romMutex;
+static int        s_romUsers = 0;
+
 void initROM()
 {
+  std::lock_guard<std::mutex> lock(s_romMutex);
+  if (s_romUsers++ > 0)
+  {
+    return;
+  }
+
   gp_sizeIdxInfo = new SizeIndexInfoLog2();
   gp_sizeIdxInfo->init(MAX_CU_SIZE);
 
@@ -416,8 +427,6 @@ void initROM()
 
   initGeoTemplate();
 
-  ::memset(g_isReusedUniMVsFilled, 0, sizeof(g_isReusedUniMVsFilled));
-
   for (int qp = 0; qp < 57; qp++)
   {
     int qpRem = (qp + 12) % 6;
@@ -431,6 +440,13 @@ void initROM()
 
 void destroyROM()
 {
+  std::lock_guard<std::mutex> lock(s_romMutex);
+  CHECK(s_romUsers <= 0, "destroyROM() called without matching initROM()");
+  if (--s_romUsers > 0)
+  {
+    return;
+  }
+
   unsigned numWidths = gp_sizeIdxInfo->numAllWidths();
   unsigned numHeights = gp_sizeIdxInfo->numAllHeights();
 
@@ -610,8 +626,6 @@ const uint32_t g_scalingListId[SCALING_LIST_SIZE_NUM][SCALING_LIST_NUM] =
   {  0,  0,  0,  0,  0,  0},  // SCALING_LIST_128x128
 };
 
-RefSetArray<Mv> g_reusedUniMVs[MAX_CU_SIZE_IN_PARTS][MAX_CU_SIZE_IN_PARTS][MAX_NUM_SIZES][MAX_NUM_SIZES];
-bool g_isReusedUniMVsFilled[MAX_CU_SIZE_IN_PARTS][MAX_CU_SIZE_IN_PARTS][MAX_NUM_SIZES][MAX_NUM_SIZES];
 
 uint16_t g_paletteQuant[57];
 uint8_t g_paletteRunTopLut [5] = { 0, 1, 1, 2, 2 };
@@ -201,8 +201,6 @@ uint32_t deriveWeightIdxBits(uint8_t bcwIdx);
 extern bool g_mctsDecCheckEnabled;
 
 class  Mv;
-extern RefSetArray<Mv> g_reusedUniMVs[MAX_CU_SIZE_IN_PARTS][MAX_CU_SIZE_IN_PARTS][MAX_NUM_SIZES][MAX_NUM_SIZES];
-extern bool g_isReusedUniMVsFilled[MAX_CU_SIZE_IN_PARTS][MAX_CU_SIZE_IN_PARTS][MAX_NUM_SIZES][MAX_NUM_SIZES];
 
 extern uint16_t g_paletteQuant[57];
 extern uint8_t g_paletteRunTopLut[5];
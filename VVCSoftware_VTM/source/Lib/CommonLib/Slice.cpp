@@ -3020,7 +3020,7 @@ void Slice::scaleRefPicList( Picture *scaledRefPic[ ], PicHeader *picHeader, APS
             scaledRefPic[j]->reconstructed = false;
             scaledRefPic[j]->referenced = true;
 
-            scaledRefPic[j]->finalInit( m_pcPic->cs->vps, *sps, *pps, picHeader, apss, lmcsAps, scalingListAps );
+            scaledRefPic[j]->finalInit( m_pcPic->cs->getXuPool(), m_pcPic->cs->vps, *sps, *pps, picHeader, apss, lmcsAps, scalingListAps );
 
             scaledRefPic[j]->poc = NOT_VALID;
 
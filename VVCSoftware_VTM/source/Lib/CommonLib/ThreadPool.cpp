@@ -0,0 +1,154 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2023, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     ThreadPool.cpp
+    \brief    small pool of worker threads for data-parallel loops
+*/
+
+#include "ThreadPool.h"
+
+//! \ingroup CommonLib
+//! \{
+
+ThreadPool::ThreadPool(const int numThreads)
+  : m_body(nullptr), m_num(0), m_next(0), m_active(0), m_generation(0), m_terminate(false)
+{
+  CHECK(numThreads < 1, "A thread pool needs at least one thread");
+
+  for (int i = 1; i < numThreads; i++)
+  {
+    m_workers.emplace_back(&ThreadPool::xWorker, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_terminate = true;
+  }
+  m_startCond.notify_all();
+
+  for (auto &worker: m_workers)
+  {
+    worker.join();
+  }
+}
+
+void ThreadPool::parallelFor(const int num, const LoopBody &body)
+{
+  if (m_workers.empty() || num <= 1)
+  {
+    for (int i = 0; i < num; i++)
+    {
+      body(0, i);
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_body   = &body;
+    m_num    = num;
+    m_next   = 0;
+    m_active = int(m_workers.size()) + 1;
+    m_exception = nullptr;
+    m_generation++;
+  }
+  m_startCond.notify_all();
+
+  xRunIterations(0);
+
+  std::exception_ptr exception;
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneCond.wait(lock, [this] { return m_active == 0; });
+    m_body = nullptr;
+    std::swap(exception, m_exception);
+  }
+
+  if (exception)
+  {
+    std::rethrow_exception(exception);
+  }
+}
+
+void ThreadPool::xWorker(const int threadIdx)
+{
+  uint64_t generation = 0;
+
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_startCond.wait(lock, [&] { return m_terminate || m_generation != generation; });
+      if (m_terminate)
+      {
+        return;
+      }
+      generation = m_generation;
+    }
+
+    xRunIterations(threadIdx);
+  }
+}
+
+void ThreadPool::xRunIterations(const int threadIdx)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  while (m_next < m_num && !m_exception)
+  {
+    const int idx = m_next++;
+
+    lock.unlock();
+    try
+    {
+      (*m_body)(threadIdx, idx);
+    }
+    catch (...)
+    {
+      lock.lock();
+      m_exception = std::current_exception();
+      break;
+    }
+    lock.lock();
+  }
+
+  if (--m_active == 0)
+  {
+    m_doneCond.notify_all();
+  }
+}
+
+//! \}
@@ -0,0 +1,98 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2023, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     ThreadPool.h
+    \brief    small pool of worker threads for data-parallel loops (header)
+*/
+
+#ifndef __THREADPOOL__
+#define __THREADPOOL__
+
+#include "CommonDef.h"
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! \ingroup CommonLib
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// fixed set of worker threads executing the iterations of one loop at a time; the calling thread takes part in the
+/// loop, so a pool of N threads starts N - 1 workers
+class ThreadPool
+{
+public:
+  using LoopBody = std::function<void(int threadIdx, int idx)>;
+
+  explicit ThreadPool(int numThreads);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &)            = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  int numThreads() const { return int(m_workers.size()) + 1; }
+
+  /// calls body(threadIdx, idx) for every idx in [0, num) and returns when all calls have finished. threadIdx is in
+  /// [0, numThreads()) and identifies the executing thread, so that per-thread scratch data can be used. The order of
+  /// the calls is unspecified; an exception thrown by the body is rethrown to the caller.
+  void parallelFor(int num, const LoopBody &body);
+
+private:
+  void xWorker(int threadIdx);
+  void xRunIterations(int threadIdx);
+
+  std::vector<std::thread> m_workers;
+  std::mutex               m_mutex;
+  std::condition_variable  m_startCond;
+  std::condition_variable  m_doneCond;
+
+  // current loop, protected by m_mutex
+  const LoopBody    *m_body;
+  int                m_num;
+  int                m_next;
+  int                m_active;
+  uint64_t           m_generation;
+  bool               m_terminate;
+  std::exception_ptr m_exception;
+};
+
+//! \}
+
+#endif // __THREADPOOL__
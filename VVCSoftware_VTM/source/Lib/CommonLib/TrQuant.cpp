@@ -179,7 +179,7 @@ template<int signedMode> void invTransformCbCr( PelBuf &resCb, PelBuf &resCr )
 // ====================================================================================================================
 // TrQuant class member functions
 // ====================================================================================================================
-TrQuant::TrQuant() : m_quant( nullptr )
+TrQuant::TrQuant() : m_quant( nullptr ), m_perfCounters( nullptr )
 {
   // allocate temporary buffers
   {
@@ -516,6 +516,7 @@ void TrQuant::xFwdLfnst( const TransformUnit &tu, const ComponentID compID, cons
 
 void TrQuant::invTransformNxN( TransformUnit &tu, const ComponentID &compID, PelBuf &pResi, const QpParam &cQP )
 {
+  PerfTimer timer(m_perfCounters, PerfStage::TRANSFORM);
   const CompArea &area    = tu.blocks[compID];
   const uint32_t uiWidth      = area.width;
   const uint32_t uiHeight     = area.height;
@@ -903,6 +904,7 @@ void TrQuant::xQuant(TransformUnit &tu, const ComponentID &compID, const CCoeffB
 void TrQuant::transformNxN(TransformUnit &tu, const ComponentID &compID, const QpParam &cQP, TrModeList &trModes,
                            const int maxCand)
 {
+  PerfTimer timer(m_perfCounters, PerfStage::TRANSFORM);
         CodingStructure &cs = *tu.cs;
   const CompArea &rect      = tu.blocks[compID];
   const uint32_t width      = rect.width;
@@ -973,6 +975,7 @@ void TrQuant::transformNxN(TransformUnit &tu, const ComponentID &compID, const Q
 void TrQuant::transformNxN(TransformUnit &tu, const ComponentID &compID, const QpParam &cQP, TCoeff &absSum,
                            const Ctx &ctx, const bool loadTr)
 {
+  PerfTimer timer(m_perfCounters, PerfStage::TRANSFORM);
         CodingStructure &cs = *tu.cs;
   const SPS &sps            = *cs.sps;
   const CompArea &rect      = tu.blocks[compID];
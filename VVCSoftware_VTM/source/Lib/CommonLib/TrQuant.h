@@ -46,6 +46,7 @@
 
 #include "UnitPartitioner.h"
 #include "Quant.h"
+#include "PerfCounters.h"
 
 #include "DepQuant.h"
 //! \ingroup CommonLib
@@ -119,11 +120,14 @@ public:
   void   lambdaAdjustColorTrans(bool forward) { m_quant->lambdaAdjustColorTrans(forward); }
   void   resetStore() { m_quant->resetStore(); }
 
+  void   setPerfCounters(PerfCounters *perfCounters) { m_perfCounters = perfCounters; }
+
 protected:
   TCoeff   m_tempCoeff[MAX_TB_SIZEY * MAX_TB_SIZEY];
 
 private:
   DepQuant *m_quant;          //!< Quantizer
+  PerfCounters *m_perfCounters;
 
   EnumArray<TCoeff[MAX_TB_SIZEY * MAX_TB_SIZEY], MtsType> m_mtsCoeffs;
 
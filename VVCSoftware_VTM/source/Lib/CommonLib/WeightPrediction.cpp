@@ -171,6 +171,18 @@ void WeightPrediction::addWeightBi(const CPelUnitBuf &pcYuvSrc0, const CPelUnitB
     const ptrdiff_t src1Stride = pcYuvSrc1.bufs[compID].stride;
     const ptrdiff_t dstStride  = rpcYuvDst.bufs[compID].stride;
 
+#if ENABLE_SIMD_OPT_BUFFER && defined(TARGET_SIMD_X86)
+    if ((width & 3) == 0)
+    {
+      // the offsets of the intermediate samples and the weighting offset are folded into the rounding offset
+      const int sumOffset = (w0 + w1) * IF_INTERNAL_OFFS + round + offset * (1 << (shift - 1));
+      const auto addWeightedAvg = (width & 7) == 0 ? g_pelBufOP.addWeightedAvg8 : g_pelBufOP.addWeightedAvg4;
+      addWeightedAvg(pSrc0, src0Stride, pSrc1, src1Stride, pDst, dstStride, width, height, w0, w1, shift, sumOffset,
+                     clpRng);
+      continue;
+    }
+#endif
+
     for (int y = 0; y < height; y++)
     {
       for (int x = 0; x < width; x++)
@@ -216,6 +228,20 @@ void WeightPrediction::addWeightUni(const CPelUnitBuf &pcYuvSrc0, const ClpRngs
     const ptrdiff_t src0Stride = pcYuvSrc0.bufs[compID].stride;
     const ptrdiff_t dstStride  = rpcYuvDst.bufs[compID].stride;
 
+#if ENABLE_SIMD_OPT_BUFFER && defined(TARGET_SIMD_X86)
+    if ((width & 3) == 0)
+    {
+      // without weighting the block is only shifted back to the sample bit depth
+      const bool weighted  = w0 != 1 << wp0[compID].shift;
+      const int  weight    = weighted ? w0 : 1;
+      const int  shiftUni  = weighted ? shift : shiftNum;
+      const int  sumOffset = weight * IF_INTERNAL_OFFS + (1 << shiftUni >> 1);
+      const auto weightUni = (width & 7) == 0 ? g_pelBufOP.weightUni8 : g_pelBufOP.weightUni4;
+      weightUni(pSrc0, src0Stride, pDst, dstStride, width, height, weight, shiftUni, sumOffset, offset, clpRng);
+      continue;
+    }
+#endif
+
     if (w0 != 1 << wp0[compID].shift)
     {
       const int round = 1 << shift >> 1;
@@ -267,6 +267,12 @@ int CDTrace::addRule( std::string rulestring )
 
 bool CDTrace::update( state_type stateval )
 {
+  // nothing is ever written without a trace file, so the idle context stays read-only and can be shared by threads
+  if( !m_trace_file )
+  {
+    return true;
+  }
+
   state[stateval.first] = stateval.second;
 
   /* pass over all the channel rules */
@@ -1202,6 +1202,172 @@ void reco_SSE(const int16_t *src0, ptrdiff_t src0Stride, const int16_t *src1, pt
   }
 }
 
+template<X86_VEXT vext, int W>
+void addWeightedAvg_SSE(const int16_t *src0, ptrdiff_t src0Stride, const int16_t *src1, ptrdiff_t src1Stride,
+                        int16_t *dst, ptrdiff_t dstStride, int width, int height, int w0, int w1, int shift, int offset,
+                        const ClpRng &clpRng)
+{
+  static_assert(W == 4 || W == 8, "W must be 4 or 8");
+
+  // interleaved samples of both sources are weighted and summed with one madd
+  const __m128i vw       = _mm_unpacklo_epi16(_mm_set1_epi16(w0), _mm_set1_epi16(w1));
+  const __m128i voffset  = _mm_set1_epi32(offset);
+  const __m128i vibdimin = _mm_set1_epi16(clpRng.min);
+  const __m128i vibdimax = _mm_set1_epi16(clpRng.max);
+
+#ifdef USE_AVX2
+  if (W == 8 && vext >= AVX2 && (width & 15) == 0)
+  {
+    const __m256i vw256       = _mm256_broadcastsi128_si256(vw);
+    const __m256i voffset256  = _mm256_set1_epi32(offset);
+    const __m256i vibdimin256 = _mm256_set1_epi16(clpRng.min);
+    const __m256i vibdimax256 = _mm256_set1_epi16(clpRng.max);
+
+    for (int row = 0; row < height; row++)
+    {
+      for (int col = 0; col < width; col += 16)
+      {
+        const __m256i vsrc0 = _mm256_loadu_si256((const __m256i *) &src0[col]);
+        const __m256i vsrc1 = _mm256_loadu_si256((const __m256i *) &src1[col]);
+
+        __m256i lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(vsrc0, vsrc1), vw256);
+        __m256i hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(vsrc0, vsrc1), vw256);
+        lo         = _mm256_srai_epi32(_mm256_add_epi32(lo, voffset256), shift);
+        hi         = _mm256_srai_epi32(_mm256_add_epi32(hi, voffset256), shift);
+
+        __m256i res = _mm256_packs_epi32(lo, hi);
+        res         = _mm256_min_epi16(vibdimax256, _mm256_max_epi16(vibdimin256, res));
+        _mm256_storeu_si256((__m256i *) &dst[col], res);
+      }
+
+      src0 += src0Stride;
+      src1 += src1Stride;
+      dst += dstStride;
+    }
+    return;
+  }
+#endif
+
+  for (int row = 0; row < height; row++)
+  {
+    for (int col = 0; col < width; col += W)
+    {
+      if (W == 8)
+      {
+        const __m128i vsrc0 = _mm_loadu_si128((const __m128i *) &src0[col]);
+        const __m128i vsrc1 = _mm_loadu_si128((const __m128i *) &src1[col]);
+
+        __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi16(vsrc0, vsrc1), vw);
+        __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi16(vsrc0, vsrc1), vw);
+        lo         = _mm_srai_epi32(_mm_add_epi32(lo, voffset), shift);
+        hi         = _mm_srai_epi32(_mm_add_epi32(hi, voffset), shift);
+
+        __m128i res = _mm_packs_epi32(lo, hi);
+        res         = _mm_min_epi16(vibdimax, _mm_max_epi16(vibdimin, res));
+        _mm_storeu_si128((__m128i *) &dst[col], res);
+      }
+      else
+      {
+        const __m128i vsrc0 = _mm_loadl_epi64((const __m128i *) &src0[col]);
+        const __m128i vsrc1 = _mm_loadl_epi64((const __m128i *) &src1[col]);
+
+        __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi16(vsrc0, vsrc1), vw);
+        lo         = _mm_srai_epi32(_mm_add_epi32(lo, voffset), shift);
+
+        __m128i res = _mm_packs_epi32(lo, lo);
+        res         = _mm_min_epi16(vibdimax, _mm_max_epi16(vibdimin, res));
+        _mm_storel_epi64((__m128i *) &dst[col], res);
+      }
+    }
+
+    src0 += src0Stride;
+    src1 += src1Stride;
+    dst += dstStride;
+  }
+}
+
+template<X86_VEXT vext, int W>
+void weightUni_SSE(const int16_t *src, ptrdiff_t srcStride, int16_t *dst, ptrdiff_t dstStride, int width, int height,
+                   int w0, int shift, int offset, int postOffset, const ClpRng &clpRng)
+{
+  static_assert(W == 4 || W == 8, "W must be 4 or 8");
+
+  // the samples are interleaved with zeros, so that madd yields w0 * src in 32 bits
+  const __m128i vzero       = _mm_setzero_si128();
+  const __m128i vw          = _mm_unpacklo_epi16(_mm_set1_epi16(w0), vzero);
+  const __m128i voffset     = _mm_set1_epi32(offset);
+  const __m128i vpostOffset = _mm_set1_epi32(postOffset);
+  const __m128i vibdimin    = _mm_set1_epi16(clpRng.min);
+  const __m128i vibdimax    = _mm_set1_epi16(clpRng.max);
+
+#ifdef USE_AVX2
+  if (W == 8 && vext >= AVX2 && (width & 15) == 0)
+  {
+    const __m256i vzero256       = _mm256_setzero_si256();
+    const __m256i vw256          = _mm256_broadcastsi128_si256(vw);
+    const __m256i voffset256     = _mm256_set1_epi32(offset);
+    const __m256i vpostOffset256 = _mm256_set1_epi32(postOffset);
+    const __m256i vibdimin256    = _mm256_set1_epi16(clpRng.min);
+    const __m256i vibdimax256    = _mm256_set1_epi16(clpRng.max);
+
+    for (int row = 0; row < height; row++)
+    {
+      for (int col = 0; col < width; col += 16)
+      {
+        const __m256i vsrc = _mm256_loadu_si256((const __m256i *) &src[col]);
+
+        __m256i lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(vsrc, vzero256), vw256);
+        __m256i hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(vsrc, vzero256), vw256);
+        lo = _mm256_add_epi32(_mm256_srai_epi32(_mm256_add_epi32(lo, voffset256), shift), vpostOffset256);
+        hi = _mm256_add_epi32(_mm256_srai_epi32(_mm256_add_epi32(hi, voffset256), shift), vpostOffset256);
+
+        __m256i res = _mm256_packs_epi32(lo, hi);
+        res         = _mm256_min_epi16(vibdimax256, _mm256_max_epi16(vibdimin256, res));
+        _mm256_storeu_si256((__m256i *) &dst[col], res);
+      }
+
+      src += srcStride;
+      dst += dstStride;
+    }
+    return;
+  }
+#endif
+
+  for (int row = 0; row < height; row++)
+  {
+    for (int col = 0; col < width; col += W)
+    {
+      if (W == 8)
+      {
+        const __m128i vsrc = _mm_loadu_si128((const __m128i *) &src[col]);
+
+        __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi16(vsrc, vzero), vw);
+        __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi16(vsrc, vzero), vw);
+        lo         = _mm_add_epi32(_mm_srai_epi32(_mm_add_epi32(lo, voffset), shift), vpostOffset);
+        hi         = _mm_add_epi32(_mm_srai_epi32(_mm_add_epi32(hi, voffset), shift), vpostOffset);
+
+        __m128i res = _mm_packs_epi32(lo, hi);
+        res         = _mm_min_epi16(vibdimax, _mm_max_epi16(vibdimin, res));
+        _mm_storeu_si128((__m128i *) &dst[col], res);
+      }
+      else
+      {
+        const __m128i vsrc = _mm_loadl_epi64((const __m128i *) &src[col]);
+
+        __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi16(vsrc, vzero), vw);
+        lo         = _mm_add_epi32(_mm_srai_epi32(_mm_add_epi32(lo, voffset), shift), vpostOffset);
+
+        __m128i res = _mm_packs_epi32(lo, lo);
+        res         = _mm_min_epi16(vibdimax, _mm_max_epi16(vibdimin, res));
+        _mm_storel_epi64((__m128i *) &dst[col], res);
+      }
+    }
+
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+
 #if ENABLE_SIMD_OPT_BCW
 template<X86_VEXT vext, int W>
 void removeWeightHighFreq_SSE(int16_t *src0, ptrdiff_t src0Stride, const int16_t *src1, ptrdiff_t src1Stride, int width, int height,
@@ -1429,6 +1595,143 @@ void linTf_SSE(const Pel *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStrid
     }
   }
 }
+// 16-entry int16_t table lookup with the index in each 16-bit lane (0..15), using byte shuffles instead of gathers
+static inline __m128i lut16_SSE(const __m128i &tabLo, const __m128i &tabHi, const __m128i &idx)
+{
+  const __m128i vlo = _mm_shuffle_epi8(tabLo, idx);
+  const __m128i vhi = _mm_shuffle_epi8(tabHi, idx);
+  return _mm_or_si128(vlo, _mm_slli_epi16(vhi, 8));
+}
+
+static inline void splitLut16(const int16_t *tab, __m128i &tabLo, __m128i &tabHi)
+{
+  const __m128i v0 = _mm_loadu_si128((const __m128i *) &tab[0]);
+  const __m128i v1 = _mm_loadu_si128((const __m128i *) &tab[8]);
+  const __m128i sh = _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+  const __m128i s0 = _mm_shuffle_epi8(v0, sh);
+  const __m128i s1 = _mm_shuffle_epi8(v1, sh);
+  tabLo            = _mm_unpacklo_epi64(s0, s1);
+  tabHi            = _mm_unpackhi_epi64(s0, s1);
+}
+
+template<X86_VEXT vext, int W>
+void rspPwl_SSE(const Pel *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride, int width, int height,
+                const ReshapePwl &pwl)
+{
+  __m128i inPivLo, inPivHi, outPivLo, outPivHi, scaleLo, scaleHi;
+  splitLut16(pwl.inPivot, inPivLo, inPivHi);
+  splitLut16(pwl.outPivot, outPivLo, outPivHi);
+  splitLut16(pwl.scale, scaleLo, scaleHi);
+
+  // thresholds are compared as x > t - 1, i.e. x >= t
+  __m128i vthr[PIC_CODE_CW_BINS];
+  for (int k = 0; k < pwl.numThresholds; k++)
+  {
+    vthr[k] = _mm_set1_epi16(pwl.thresholds[k] - 1);
+  }
+
+  const bool    uniform = pwl.log2BinLen > 0;
+  const __m128i vzero   = _mm_setzero_si128();
+  const __m128i vmax    = _mm_set1_epi16(pwl.maxVal);
+  const __m128i vbase   = _mm_set1_epi16(pwl.binBase | 0x8000);   // 0x80 in the high byte zeroes it in the shuffle
+  const __m128i vhiZero = _mm_set1_epi16((int16_t) 0x8000);
+  const __m128i vround  = _mm_set1_epi16(1 << (FP_PREC - 1));
+  const __m128i vone    = _mm_set1_epi16(1);
+
+  auto mapPwl = [&](__m128i x)
+  {
+    x = _mm_min_epi16(vmax, _mm_max_epi16(vzero, x));
+
+    __m128i idx;
+    if (uniform)
+    {
+      idx = _mm_or_si128(_mm_srli_epi16(x, pwl.log2BinLen), vhiZero);
+    }
+    else
+    {
+      idx = vbase;
+      for (int k = 0; k < pwl.numThresholds; k++)
+      {
+        idx = _mm_sub_epi16(idx, _mm_cmpgt_epi16(x, vthr[k]));
+      }
+    }
+
+    const __m128i diff  = _mm_sub_epi16(x, lut16_SSE(inPivLo, inPivHi, idx));
+    const __m128i scale = lut16_SSE(scaleLo, scaleHi, idx);
+
+    // scale * diff + round in 32 bit
+    __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi16(diff, vone), _mm_unpacklo_epi16(scale, vround));
+    __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi16(diff, vone), _mm_unpackhi_epi16(scale, vround));
+    lo         = _mm_srai_epi32(lo, FP_PREC);
+    hi         = _mm_srai_epi32(hi, FP_PREC);
+
+    __m128i y = _mm_adds_epi16(_mm_packs_epi32(lo, hi), lut16_SSE(outPivLo, outPivHi, idx));
+    return _mm_min_epi16(vmax, _mm_max_epi16(vzero, y));
+  };
+
+  for (int row = 0; row < height; row++)
+  {
+    if (W == 8)
+    {
+      for (int col = 0; col < width; col += 8)
+      {
+        _mm_storeu_si128((__m128i *) &dst[col], mapPwl(_mm_loadu_si128((const __m128i *) &src[col])));
+      }
+    }
+    else
+    {
+      for (int col = 0; col < width; col += 4)
+      {
+        _mm_storel_epi64((__m128i *) &dst[col], mapPwl(_mm_loadl_epi64((const __m128i *) &src[col])));
+      }
+    }
+
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+
+template<X86_VEXT vext, int W>
+void crsInv_SSE(Pel *buf, ptrdiff_t stride, int width, int height, int scale, const ClpRng &clpRng)
+{
+  const int     maxAbsclipBD = (1 << clpRng.bd) - 1;
+  const __m128i vmin         = _mm_set1_epi16(-maxAbsclipBD - 1);
+  const __m128i vmax         = _mm_set1_epi16(maxAbsclipBD);
+  const __m128i vscale       = _mm_set1_epi32(scale);
+  const __m128i vround       = _mm_set1_epi32(1 << (CSCALE_FP_PREC - 1));
+
+  auto scaleAbs = [&](__m128i absval)
+  {
+    return _mm_srai_epi32(_mm_add_epi32(_mm_mullo_epi32(absval, vscale), vround), CSCALE_FP_PREC);
+  };
+
+  for (int row = 0; row < height; row++)
+  {
+    for (int col = 0; col < width; col += W)
+    {
+      __m128i val = W == 8 ? _mm_loadu_si128((const __m128i *) &buf[col]) : _mm_loadl_epi64((const __m128i *) &buf[col]);
+      val         = _mm_min_epi16(vmax, _mm_max_epi16(vmin, val));
+
+      // the absolute value of -32768 does not fit into 16 bit, so widen before taking it
+      const __m128i lo = _mm_cvtepi16_epi32(val);
+      const __m128i hi = _mm_cvtepi16_epi32(_mm_unpackhi_epi64(val, val));
+
+      __m128i res = _mm_packs_epi32(_mm_sign_epi32(scaleAbs(_mm_abs_epi32(lo)), lo),
+                                    _mm_sign_epi32(scaleAbs(_mm_abs_epi32(hi)), hi));
+
+      if (W == 8)
+      {
+        _mm_storeu_si128((__m128i *) &buf[col], res);
+      }
+      else
+      {
+        _mm_storel_epi64((__m128i *) &buf[col], res);
+      }
+    }
+
+    buf += stride;
+  }
+}
 #if RExt__HIGH_BIT_DEPTH_SUPPORT
 template<X86_VEXT vext, int W>
 void addAvg_HBD_SIMD(const Pel *src0, ptrdiff_t src0Stride, const Pel *src1, ptrdiff_t src1Stride, Pel *dst,
@@ -1831,6 +2134,11 @@ void PelBufferOps::_initPelBufOpsX86()
 
   linTf8 = linTf_SSE_entry<vext, 8>;
   linTf4 = linTf_SSE_entry<vext, 4>;
+
+  addWeightedAvg8 = addWeightedAvg_SSE<vext, 8>;
+  addWeightedAvg4 = addWeightedAvg_SSE<vext, 4>;
+  weightUni8      = weightUni_SSE<vext, 8>;
+  weightUni4      = weightUni_SSE<vext, 4>;
 #if ENABLE_SIMD_OPT_BCW
   removeWeightHighFreq8 = removeWeightHighFreq_SSE<vext, 8>;
   removeWeightHighFreq4 = removeWeightHighFreq_SSE<vext, 4>;
@@ -1839,6 +2147,11 @@ void PelBufferOps::_initPelBufOpsX86()
 #endif
   profGradFilter = gradFilter_SSE<vext, false>;
   applyPROF      = applyPROF_SSE<vext>;
+
+  rspPwl8 = rspPwl_SSE<vext, 8>;
+  rspPwl4 = rspPwl_SSE<vext, 4>;
+  crsInv8 = crsInv_SSE<vext, 8>;
+  crsInv4 = crsInv_SSE<vext, 4>;
 #endif
   roundIntVector = roundIntVector_SIMD<vext>;
 }
@@ -50,6 +50,8 @@
 
 #include "CommonLib/IbcHashMap.h"
 
+#include "CommonLib/IntraPrediction.h"
+
 #ifdef TARGET_SIMD_X86
 
 
@@ -167,6 +169,29 @@ void AdaptiveLoopFilter::initAdaptiveLoopFilterX86()
 }
 #endif
 
+#if ENABLE_SIMD_OPT_CCLM
+void IntraPrediction::initIntraPredictionX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext)
+  {
+  case AVX512:
+  case AVX2:
+    _initIntraPredictionX86<AVX2>();
+    break;
+  case AVX:
+    _initIntraPredictionX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initIntraPredictionX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
 #if ENABLE_SIMD_OPT_IBC
 void IbcHashMap::initIbcHashMapX86()
 {
@@ -0,0 +1,224 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2023, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ * \brief Implementation of the CCLM luma downsampling filters of the IntraPrediction class
+ */
+
+// ====================================================================================================================
+// Includes
+// ====================================================================================================================
+
+#include "CommonDefX86.h"
+#include "../IntraPrediction.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+
+#if defined _MSC_VER
+#include <tmmintrin.h>
+#else
+#include <immintrin.h>
+#endif
+
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+// Each filter returns the unrounded tap sums of 4 (128-bit) or 8 (256-bit) output samples starting at luma position s.
+// The taps are applied with _mm_madd_epi16 on interleaved even/odd luma samples, so every sum is exact in 32 bits.
+// 'above' points to the luma row used as upper neighbour of s (only used by the 5-tap filter).
+struct CclmDsFilter3Tap
+{
+  static constexpr int ROW_STEP = 1;
+  static constexpr int SHIFT    = 2;
+
+  static inline int sample(const Pel *s, ptrdiff_t stride, const Pel *above, int left)
+  {
+    return s[0] * 2 + s[-left] + s[1];
+  }
+
+  static inline __m128i sum4(const Pel *s, ptrdiff_t stride, const Pel *above)
+  {
+    const __m128i w21 = _mm_set1_epi32(0x00010002);
+    const __m128i w10 = _mm_set1_epi32(0x00000001);
+
+    return _mm_add_epi32(_mm_madd_epi16(_mm_loadu_si128((const __m128i *) s), w21),
+                         _mm_madd_epi16(_mm_loadu_si128((const __m128i *) (s - 1)), w10));
+  }
+
+#ifdef USE_AVX2
+  static inline __m256i sum8(const Pel *s, ptrdiff_t stride, const Pel *above)
+  {
+    const __m256i w21 = _mm256_set1_epi32(0x00010002);
+    const __m256i w10 = _mm256_set1_epi32(0x00000001);
+
+    return _mm256_add_epi32(_mm256_madd_epi16(_mm256_loadu_si256((const __m256i *) s), w21),
+                            _mm256_madd_epi16(_mm256_loadu_si256((const __m256i *) (s - 1)), w10));
+  }
+#endif
+};
+
+struct CclmDsFilter5Tap
+{
+  static constexpr int ROW_STEP = 2;
+  static constexpr int SHIFT    = 3;
+
+  static inline int sample(const Pel *s, ptrdiff_t stride, const Pel *above, int left)
+  {
+    return above[0] + s[0] * 4 + s[-left] + s[1] + s[stride];
+  }
+
+  static inline __m128i sum4(const Pel *s, ptrdiff_t stride, const Pel *above)
+  {
+    const __m128i w14 = _mm_set1_epi32(0x00040001);
+    const __m128i w01 = _mm_set1_epi32(0x00010000);
+    const __m128i w10 = _mm_set1_epi32(0x00000001);
+
+    __m128i sum = _mm_madd_epi16(_mm_loadu_si128((const __m128i *) (s - 1)), w14);
+    sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_loadu_si128((const __m128i *) s), w01));
+    sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_loadu_si128((const __m128i *) above), w10));
+    sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_loadu_si128((const __m128i *) (s + stride)), w10));
+    return sum;
+  }
+
+#ifdef USE_AVX2
+  static inline __m256i sum8(const Pel *s, ptrdiff_t stride, const Pel *above)
+  {
+    const __m256i w14 = _mm256_set1_epi32(0x00040001);
+    const __m256i w01 = _mm256_set1_epi32(0x00010000);
+    const __m256i w10 = _mm256_set1_epi32(0x00000001);
+
+    __m256i sum = _mm256_madd_epi16(_mm256_loadu_si256((const __m256i *) (s - 1)), w14);
+    sum = _mm256_add_epi32(sum, _mm256_madd_epi16(_mm256_loadu_si256((const __m256i *) s), w01));
+    sum = _mm256_add_epi32(sum, _mm256_madd_epi16(_mm256_loadu_si256((const __m256i *) above), w10));
+    sum = _mm256_add_epi32(sum, _mm256_madd_epi16(_mm256_loadu_si256((const __m256i *) (s + stride)), w10));
+    return sum;
+  }
+#endif
+};
+
+struct CclmDsFilter6Tap
+{
+  static constexpr int ROW_STEP = 2;
+  static constexpr int SHIFT    = 3;
+
+  static inline int sample(const Pel *s, ptrdiff_t stride, const Pel *above, int left)
+  {
+    return s[0] * 2 + s[1] + s[-left] + s[stride] * 2 + s[stride + 1] + s[stride - left];
+  }
+
+  static inline __m128i sum4(const Pel *s, ptrdiff_t stride, const Pel *above)
+  {
+    return _mm_add_epi32(CclmDsFilter3Tap::sum4(s, stride, above), CclmDsFilter3Tap::sum4(s + stride, stride, above));
+  }
+
+#ifdef USE_AVX2
+  static inline __m256i sum8(const Pel *s, ptrdiff_t stride, const Pel *above)
+  {
+    return _mm256_add_epi32(CclmDsFilter3Tap::sum8(s, stride, above), CclmDsFilter3Tap::sum8(s + stride, stride, above));
+  }
+#endif
+};
+
+template<X86_VEXT vext, typename F>
+void cclmDsFilter_SIMD(const Pel *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride, int width, int height,
+                       bool leftPadding, bool abovePadding)
+{
+  const __m128i offset = _mm_set1_epi32(1 << (F::SHIFT - 1));
+#ifdef USE_AVX2
+  const __m256i offset256 = _mm256_set1_epi32(1 << (F::SHIFT - 1));
+#endif
+
+  for (int j = 0; j < height; j++)
+  {
+    const Pel *above = j == 0 && abovePadding ? src : src - srcStride;
+
+    int i = 0;
+#ifdef USE_AVX2
+    if (vext >= AVX2)
+    {
+      for (; i + 16 <= width; i += 16)
+      {
+        const __m256i lo = _mm256_srai_epi32(
+          _mm256_add_epi32(F::sum8(src + 2 * i, srcStride, above + 2 * i), offset256), F::SHIFT);
+        const __m256i hi = _mm256_srai_epi32(
+          _mm256_add_epi32(F::sum8(src + 2 * i + 16, srcStride, above + 2 * i + 16), offset256), F::SHIFT);
+        _mm256_storeu_si256((__m256i *) (dst + i), _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), 0xd8));
+      }
+    }
+#endif
+    for (; i + 8 <= width; i += 8)
+    {
+      const __m128i lo =
+        _mm_srai_epi32(_mm_add_epi32(F::sum4(src + 2 * i, srcStride, above + 2 * i), offset), F::SHIFT);
+      const __m128i hi =
+        _mm_srai_epi32(_mm_add_epi32(F::sum4(src + 2 * i + 8, srcStride, above + 2 * i + 8), offset), F::SHIFT);
+      _mm_storeu_si128((__m128i *) (dst + i), _mm_packs_epi32(lo, hi));
+    }
+    if (i + 4 <= width)
+    {
+      const __m128i lo =
+        _mm_srai_epi32(_mm_add_epi32(F::sum4(src + 2 * i, srcStride, above + 2 * i), offset), F::SHIFT);
+      _mm_storel_epi64((__m128i *) (dst + i), _mm_packs_epi32(lo, lo));
+      i += 4;
+    }
+    for (; i < width; i++)
+    {
+      dst[i] = (F::sample(src + 2 * i, srcStride, above + 2 * i, 1) + (1 << (F::SHIFT - 1))) >> F::SHIFT;
+    }
+    if (leftPadding)
+    {
+      dst[0] = (F::sample(src, srcStride, above, 0) + (1 << (F::SHIFT - 1))) >> F::SHIFT;
+    }
+
+    src += F::ROW_STEP * srcStride;
+    dst += dstStride;
+  }
+}
+#endif
+
+template <X86_VEXT vext>
+void IntraPrediction::_initIntraPredictionX86()
+{
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+  m_cclmDsFilter3Tap = cclmDsFilter_SIMD<vext, CclmDsFilter3Tap>;
+  m_cclmDsFilter5Tap = cclmDsFilter_SIMD<vext, CclmDsFilter5Tap>;
+  m_cclmDsFilter6Tap = cclmDsFilter_SIMD<vext, CclmDsFilter6Tap>;
+#endif
+}
+
+template void IntraPrediction::_initIntraPredictionX86<SIMDX86>();
+
+#endif //#ifdef TARGET_SIMD_X86
+//! \}
@@ -528,6 +528,211 @@ template<int width, X86_VEXT vext> Distortion RdCost::xGetSAD_NxN_SIMD(const Dis
   return sum >> DISTORTION_PRECISION_ADJUSTMENT(rcDtParam.bitDepth);
 }
 
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+template<X86_VEXT vext>
+void RdCost::xGetSADX4_SIMD(const DistParam &rcDtParam, const Pel *const *cur, Distortion *dist)
+{
+  if (rcDtParam.bitDepth > 10)
+  {
+    RdCost::xGetSADX4(rcDtParam, cur, dist);
+    return;
+  }
+
+  const short    *pOrg      = (const short *) rcDtParam.org.buf;
+  const short    *pCur[4]   = { (const short *) cur[0], (const short *) cur[1], (const short *) cur[2],
+                                (const short *) cur[3] };
+  const int       rows      = rcDtParam.org.height;
+  const int       cols      = rcDtParam.org.width;
+  const int       subShift  = rcDtParam.subShift;
+  const int       subStep   = (1 << subShift);
+  const ptrdiff_t strideOrg = rcDtParam.org.stride * subStep;
+  const ptrdiff_t strideCur = rcDtParam.cur.stride * subStep;
+
+  uint32_t sum[4];
+
+  if (vext >= AVX2 && (cols & 15) == 0)
+  {
+#ifdef USE_AVX2
+    const __m256i vzero     = _mm256_setzero_si256();
+    __m256i       vsum32[4] = { vzero, vzero, vzero, vzero };
+    for (int y = 0; y < rows; y += subStep)
+    {
+      __m256i vsum16[4] = { vzero, vzero, vzero, vzero };
+      for (int x = 0; x < cols; x += 16)
+      {
+        const __m256i vorg = _mm256_lddqu_si256((const __m256i *) &pOrg[x]);
+        for (int k = 0; k < 4; k++)
+        {
+          const __m256i vcur = _mm256_lddqu_si256((const __m256i *) &pCur[k][x]);
+          vsum16[k]          = _mm256_add_epi16(vsum16[k], _mm256_abs_epi16(_mm256_sub_epi16(vorg, vcur)));
+        }
+      }
+      for (int k = 0; k < 4; k++)
+      {
+        vsum32[k] = _mm256_add_epi32(vsum32[k], _mm256_add_epi32(_mm256_unpacklo_epi16(vsum16[k], vzero),
+                                                                 _mm256_unpackhi_epi16(vsum16[k], vzero)));
+        pCur[k] += strideCur;
+      }
+      pOrg += strideOrg;
+    }
+    // reduce the four accumulators at once: lane k of the result holds the sum of candidate k
+    __m256i vsum01 = _mm256_hadd_epi32(vsum32[0], vsum32[1]);
+    __m256i vsum23 = _mm256_hadd_epi32(vsum32[2], vsum32[3]);
+    __m256i vsum   = _mm256_hadd_epi32(vsum01, vsum23);
+    __m128i vres   = _mm_add_epi32(_mm256_castsi256_si128(vsum), _mm256_extracti128_si256(vsum, 1));
+    _mm_storeu_si128((__m128i *) sum, vres);
+#endif
+  }
+  else if ((cols & 7) == 0)
+  {
+    const __m128i vzero     = _mm_setzero_si128();
+    __m128i       vsum32[4] = { vzero, vzero, vzero, vzero };
+    for (int y = 0; y < rows; y += subStep)
+    {
+      __m128i vsum16[4] = { vzero, vzero, vzero, vzero };
+      for (int x = 0; x < cols; x += 8)
+      {
+        const __m128i vorg = _mm_loadu_si128((const __m128i *) &pOrg[x]);
+        for (int k = 0; k < 4; k++)
+        {
+          const __m128i vcur = _mm_lddqu_si128((const __m128i *) &pCur[k][x]);
+          vsum16[k]          = _mm_add_epi16(vsum16[k], _mm_abs_epi16(_mm_sub_epi16(vorg, vcur)));
+        }
+      }
+      for (int k = 0; k < 4; k++)
+      {
+        vsum32[k] = _mm_add_epi32(vsum32[k],
+                                  _mm_add_epi32(_mm_unpacklo_epi16(vsum16[k], vzero), _mm_unpackhi_epi16(vsum16[k], vzero)));
+        pCur[k] += strideCur;
+      }
+      pOrg += strideOrg;
+    }
+    __m128i vres = _mm_hadd_epi32(_mm_hadd_epi32(vsum32[0], vsum32[1]), _mm_hadd_epi32(vsum32[2], vsum32[3]));
+    _mm_storeu_si128((__m128i *) sum, vres);
+  }
+  else
+  {
+    CHECK((cols & 3) != 0, "Not divisible by 4: " << cols);
+    const __m128i vzero     = _mm_setzero_si128();
+    __m128i       vsum32[4] = { vzero, vzero, vzero, vzero };
+    for (int y = 0; y < rows; y += subStep)
+    {
+      __m128i vsum16[4] = { vzero, vzero, vzero, vzero };
+      for (int x = 0; x < cols; x += 4)
+      {
+        const __m128i vorg = _mm_loadl_epi64((const __m128i *) &pOrg[x]);
+        for (int k = 0; k < 4; k++)
+        {
+          const __m128i vcur = _mm_loadl_epi64((const __m128i *) &pCur[k][x]);
+          vsum16[k]          = _mm_add_epi16(vsum16[k], _mm_abs_epi16(_mm_sub_epi16(vorg, vcur)));
+        }
+      }
+      for (int k = 0; k < 4; k++)
+      {
+        vsum32[k] = _mm_add_epi32(vsum32[k], _mm_unpacklo_epi16(vsum16[k], vzero));
+        pCur[k] += strideCur;
+      }
+      pOrg += strideOrg;
+    }
+    __m128i vres = _mm_hadd_epi32(_mm_hadd_epi32(vsum32[0], vsum32[1]), _mm_hadd_epi32(vsum32[2], vsum32[3]));
+    _mm_storeu_si128((__m128i *) sum, vres);
+  }
+
+  for (int k = 0; k < 4; k++)
+  {
+    dist[k] = Distortion(sum[k] << subShift) >> DISTORTION_PRECISION_ADJUSTMENT(rcDtParam.bitDepth);
+  }
+}
+
+template<X86_VEXT vext>
+void RdCost::xGetSADDmvr_SIMD(const DistParam &rcDtParam, Distortion *dist)
+{
+  const int cols = rcDtParam.org.width;
+
+  if ((cols & 7) != 0)
+  {
+    RdCost::xGetSADDmvr(rcDtParam, dist);
+    return;
+  }
+
+  // the DMVR samples are bilinear intermediates of IF_INTERNAL_PREC_BILINEAR bits, so the absolute differences of a
+  // row fit into 16 bits and are widened once per row
+  const int       rows      = rcDtParam.org.height;
+  const int       subShift  = rcDtParam.subShift;
+  const int       subStep   = (1 << subShift);
+  const ptrdiff_t strideOrg = rcDtParam.org.stride;
+  const ptrdiff_t strideCur = rcDtParam.cur.stride;
+
+  uint32_t sum[DMVR_AREA];
+
+  for (int dy = -DMVR_RANGE; dy <= DMVR_RANGE; dy++)
+  {
+    // the candidates of one search row are loads at horizontally shifted addresses of the same rows:
+    // candidate k compares pOrg[x + k] with pCur[x - k]
+    const short *pOrg = (const short *) (rcDtParam.org.buf + dy * strideOrg - DMVR_RANGE);
+    const short *pCur = (const short *) (rcDtParam.cur.buf - dy * strideCur + DMVR_RANGE);
+    uint32_t    *pSum = sum + (dy + DMVR_RANGE) * DMVR_SPAN;
+
+    if (vext >= AVX2 && (cols & 15) == 0)
+    {
+#ifdef USE_AVX2
+      const __m256i vone              = _mm256_set1_epi16(1);
+      __m256i       vsum32[DMVR_SPAN] = { _mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256(),
+                                          _mm256_setzero_si256(), _mm256_setzero_si256() };
+      for (int y = 0; y < rows; y += subStep)
+      {
+        for (int x = 0; x < cols; x += 16)
+        {
+          for (int k = 0; k < DMVR_SPAN; k++)
+          {
+            const __m256i vorg = _mm256_loadu_si256((const __m256i *) &pOrg[x + k]);
+            const __m256i vcur = _mm256_loadu_si256((const __m256i *) &pCur[x - k]);
+            vsum32[k] =
+              _mm256_add_epi32(vsum32[k], _mm256_madd_epi16(_mm256_abs_epi16(_mm256_sub_epi16(vorg, vcur)), vone));
+          }
+        }
+        pOrg += strideOrg * subStep;
+        pCur += strideCur * subStep;
+      }
+      __m256i vsum = _mm256_hadd_epi32(_mm256_hadd_epi32(vsum32[0], vsum32[1]), _mm256_hadd_epi32(vsum32[2], vsum32[3]));
+      __m256i vlast = _mm256_hadd_epi32(_mm256_hadd_epi32(vsum32[4], vsum32[4]), vsum32[4]);
+      _mm_storeu_si128((__m128i *) pSum,
+                       _mm_add_epi32(_mm256_castsi256_si128(vsum), _mm256_extracti128_si256(vsum, 1)));
+      pSum[4] = _mm_cvtsi128_si32(_mm_add_epi32(_mm256_castsi256_si128(vlast), _mm256_extracti128_si256(vlast, 1)));
+#endif
+    }
+    else
+    {
+      const __m128i vone              = _mm_set1_epi16(1);
+      __m128i       vsum32[DMVR_SPAN] = { _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128(),
+                                          _mm_setzero_si128(), _mm_setzero_si128() };
+      for (int y = 0; y < rows; y += subStep)
+      {
+        for (int x = 0; x < cols; x += 8)
+        {
+          for (int k = 0; k < DMVR_SPAN; k++)
+          {
+            const __m128i vorg = _mm_loadu_si128((const __m128i *) &pOrg[x + k]);
+            const __m128i vcur = _mm_loadu_si128((const __m128i *) &pCur[x - k]);
+            vsum32[k] = _mm_add_epi32(vsum32[k], _mm_madd_epi16(_mm_abs_epi16(_mm_sub_epi16(vorg, vcur)), vone));
+          }
+        }
+        pOrg += strideOrg * subStep;
+        pCur += strideCur * subStep;
+      }
+      _mm_storeu_si128((__m128i *) pSum, _mm_hadd_epi32(_mm_hadd_epi32(vsum32[0], vsum32[1]),
+                                                        _mm_hadd_epi32(vsum32[2], vsum32[3])));
+      pSum[4] = _mm_cvtsi128_si32(_mm_hadd_epi32(_mm_hadd_epi32(vsum32[4], vsum32[4]), vsum32[4]));
+    }
+  }
+
+  for (int k = 0; k < DMVR_AREA; k++)
+  {
+    dist[k] = Distortion(sum[k] << subShift) >> DISTORTION_PRECISION_ADJUSTMENT(rcDtParam.bitDepth);
+  }
+}
+#endif
+
 #if RExt__HIGH_BIT_DEPTH_SUPPORT
 static Distortion xCalcHAD2x2_HBD_SSE(const Torg *piOrg, const Tcur *piCur, const ptrdiff_t strideOrg,
                                       const ptrdiff_t strideCur)
@@ -3975,6 +4180,130 @@ Distortion RdCost::xGetSADwMask_SIMD( const DistParam &rcDtParam )
 
   return sum >> DISTORTION_PRECISION_ADJUSTMENT(rcDtParam.bitDepth);
 }
+
+template< X86_VEXT vext >
+void RdCost::xGetSADwMaskMulti_SIMD( const DistParam &rcDtParam, const Pel *const *cur, const int numCand, Distortion *dist )
+{
+  const int cols = rcDtParam.org.width;
+
+  if( ( cols & 7 ) != 0 || rcDtParam.bitDepth > 10 || rcDtParam.applyWeight )
+  {
+    RdCost::xGetSADwMaskMulti( rcDtParam, cur, numCand, dist );
+    return;
+  }
+
+  CHECK( numCand > GEO_MAX_NUM_UNI_CANDS, "Too many candidates: " << numCand );
+
+  const short* src1       = (const short*)rcDtParam.org.buf;
+  const short* weightMask = (const short*)rcDtParam.mask;
+  const int    rows       = rcDtParam.org.height;
+  const int    subShift   = rcDtParam.subShift;
+  const int    subStep    = ( 1 << subShift );
+  const ptrdiff_t strideSrc1 = rcDtParam.org.stride * subStep;
+  const ptrdiff_t strideSrc2 = rcDtParam.cur.stride * subStep;
+  const ptrdiff_t strideMask = rcDtParam.maskStride * subStep;
+
+  const short* src2[GEO_MAX_NUM_UNI_CANDS];
+  for( int k = 0; k < numCand; k++ )
+  {
+    src2[k] = (const short*)cur[k];
+  }
+
+  uint32_t sum[GEO_MAX_NUM_UNI_CANDS];
+  if( vext >= AVX2 && ( cols & 15 ) == 0 )
+  {
+#ifdef USE_AVX2
+    __m256i vsum32[GEO_MAX_NUM_UNI_CANDS];
+    for( int k = 0; k < numCand; k++ )
+    {
+      vsum32[k] = _mm256_setzero_si256();
+    }
+    for( int y = 0; y < rows; y += subStep )
+    {
+      for( int x = 0; x < cols; x += 16 )
+      {
+        __m256i vsrc1 = _mm256_lddqu_si256( ( __m256i* )( &src1[x] ) );
+        __m256i vmask;
+        if( rcDtParam.stepX == -1 )
+        {
+          vmask = _mm256_lddqu_si256( ( __m256i* )( ( &weightMask[x] ) - ( x << 1 ) - ( 16 - 1 ) ) );
+          const __m256i shuffle_mask = _mm256_set_epi8( 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14, 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 );
+          vmask = _mm256_shuffle_epi8( vmask, shuffle_mask );
+          vmask = _mm256_permute4x64_epi64( vmask, _MM_SHUFFLE( 1, 0, 3, 2 ) );
+        }
+        else
+        {
+          vmask = _mm256_lddqu_si256( ( __m256i* )( &weightMask[x] ) );
+        }
+        for( int k = 0; k < numCand; k++ )
+        {
+          __m256i vsrc2 = _mm256_lddqu_si256( ( __m256i* )( &src2[k][x] ) );
+          vsum32[k] = _mm256_add_epi32( vsum32[k], _mm256_madd_epi16( vmask, _mm256_abs_epi16( _mm256_sub_epi16( vsrc1, vsrc2 ) ) ) );
+        }
+      }
+      src1 += strideSrc1;
+      weightMask += strideMask;
+      for( int k = 0; k < numCand; k++ )
+      {
+        src2[k] += strideSrc2;
+      }
+    }
+    for( int k = 0; k < numCand; k++ )
+    {
+      __m128i vsum = _mm_add_epi32( _mm256_castsi256_si128( vsum32[k] ), _mm256_extracti128_si256( vsum32[k], 1 ) );
+      vsum         = _mm_hadd_epi32( vsum, vsum );
+      sum[k]       = _mm_cvtsi128_si32( _mm_hadd_epi32( vsum, vsum ) );
+    }
+#endif
+  }
+  else
+  {
+    __m128i vsum32[GEO_MAX_NUM_UNI_CANDS];
+    for( int k = 0; k < numCand; k++ )
+    {
+      vsum32[k] = _mm_setzero_si128();
+    }
+    for( int y = 0; y < rows; y += subStep )
+    {
+      for( int x = 0; x < cols; x += 8 )
+      {
+        __m128i vsrc1 = _mm_loadu_si128( ( const __m128i* )( &src1[x] ) );
+        __m128i vmask;
+        if( rcDtParam.stepX == -1 )
+        {
+          vmask = _mm_lddqu_si128( ( __m128i* )( ( &weightMask[x] ) - ( x << 1 ) - ( 8 - 1 ) ) );
+          const __m128i shuffle_mask = _mm_set_epi8( 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 );
+          vmask = _mm_shuffle_epi8( vmask, shuffle_mask );
+        }
+        else
+        {
+          vmask = _mm_lddqu_si128( ( const __m128i* )( &weightMask[x] ) );
+        }
+        for( int k = 0; k < numCand; k++ )
+        {
+          __m128i vsrc2 = _mm_lddqu_si128( ( const __m128i* )( &src2[k][x] ) );
+          vsum32[k] = _mm_add_epi32( vsum32[k], _mm_madd_epi16( vmask, _mm_abs_epi16( _mm_sub_epi16( vsrc1, vsrc2 ) ) ) );
+        }
+      }
+      src1 += strideSrc1;
+      weightMask += strideMask;
+      for( int k = 0; k < numCand; k++ )
+      {
+        src2[k] += strideSrc2;
+      }
+    }
+    for( int k = 0; k < numCand; k++ )
+    {
+      __m128i vsum = _mm_hadd_epi32( vsum32[k], vsum32[k] );
+      sum[k]       = _mm_cvtsi128_si32( _mm_hadd_epi32( vsum, vsum ) );
+    }
+  }
+
+  for( int k = 0; k < numCand; k++ )
+  {
+    dist[k] = Distortion( sum[k] << subShift ) >> DISTORTION_PRECISION_ADJUSTMENT( rcDtParam.bitDepth );
+  }
+}
 #if RExt__HIGH_BIT_DEPTH_SUPPORT
 template<X86_VEXT vext>
 Distortion RdCost::xGetHADs_HBD_SIMD(const DistParam &rcDtParam)
@@ -4604,6 +4933,185 @@ Distortion RdCost::xGetHADs_SIMD( const DistParam &rcDtParam )
   return sum >> DISTORTION_PRECISION_ADJUSTMENT(rcDtParam.bitDepth);
 }
 #endif
+
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+template<X86_VEXT vext>
+uint64_t RdCost::xGetPlaneSSE_SIMD(const Pel *org, const ptrdiff_t orgStride, const Pel *cur, const ptrdiff_t curStride,
+                                   const int width, const int height)
+{
+  static_assert(sizeof(Pel) == 2, "Pel must be 16-bit wide");
+
+  // the 32-bit partial sums are widened to 64 bits after at most 64 iterations, which keeps them exact up to 12 bits
+  const int maxIter = 64;
+
+  __m128i sum = _mm_setzero_si128();
+
+  for (int y = 0; y < height; y++)
+  {
+    int x = 0;
+#ifdef USE_AVX2
+    if (vext >= AVX2)
+    {
+      const int width16 = width & ~15;
+      while (x < width16)
+      {
+        const int end   = std::min(width16, x + 16 * maxIter);
+        __m256i   sum32 = _mm256_setzero_si256();
+        for (; x < end; x += 16)
+        {
+          const __m256i src1 = _mm256_loadu_si256((const __m256i *) (org + x));
+          const __m256i src2 = _mm256_loadu_si256((const __m256i *) (cur + x));
+          const __m256i diff = _mm256_sub_epi16(src1, src2);
+          sum32              = _mm256_add_epi32(sum32, _mm256_madd_epi16(diff, diff));
+        }
+        const __m256i sum64 = _mm256_add_epi64(_mm256_unpacklo_epi32(sum32, _mm256_setzero_si256()),
+                                               _mm256_unpackhi_epi32(sum32, _mm256_setzero_si256()));
+        sum = _mm_add_epi64(sum, _mm_add_epi64(_mm256_castsi256_si128(sum64), _mm256_extracti128_si256(sum64, 1)));
+      }
+    }
+#endif
+    const int width8 = width & ~7;
+    while (x < width8)
+    {
+      const int end   = std::min(width8, x + 8 * maxIter);
+      __m128i   sum32 = _mm_setzero_si128();
+      for (; x < end; x += 8)
+      {
+        const __m128i src1 = _mm_loadu_si128((const __m128i *) (org + x));
+        const __m128i src2 = _mm_loadu_si128((const __m128i *) (cur + x));
+        const __m128i diff = _mm_sub_epi16(src1, src2);
+        sum32              = _mm_add_epi32(sum32, _mm_madd_epi16(diff, diff));
+      }
+      sum = _mm_add_epi64(sum, _mm_add_epi64(_mm_unpacklo_epi32(sum32, _mm_setzero_si128()),
+                                             _mm_unpackhi_epi32(sum32, _mm_setzero_si128())));
+    }
+    uint64_t tail = 0;
+    for (; x < width; x++)
+    {
+      const int diff = org[x] - cur[x];
+      tail += uint64_t(diff * diff);
+    }
+    sum = _mm_add_epi64(sum, _mm_cvtsi64_si128(tail));
+
+    org += orgStride;
+    cur += curStride;
+  }
+
+  sum = _mm_add_epi64(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+
+  return _mm_cvtsi128_si64(sum);
+}
+#endif
+
+// The windows are processed in parallel lanes, every lane performs the multiplications and additions of the scalar
+// xGetSSIMWindows() in the same order, so that the result is identical.
+template<X86_VEXT vext>
+void RdCost::xGetSSIMWindows_SIMD(const double *org, const double *rec, const ptrdiff_t stride, const double *weights,
+                                  const int numWindows, const double c1, const double c2, const bool luminance,
+                                  double *ssim)
+{
+  int i = 0;
+#ifdef USE_AVX2
+  if (vext >= AVX2)
+  {
+    const __m256d vc1 = _mm256_set1_pd(c1);
+    const __m256d vc2 = _mm256_set1_pd(c2);
+    const __m256d two = _mm256_set1_pd(2.0);
+
+    for (; i + 4 <= numWindows; i += 4)
+    {
+      __m256d muOrg         = _mm256_setzero_pd();
+      __m256d muRec         = _mm256_setzero_pd();
+      __m256d muOrigSqr     = _mm256_setzero_pd();
+      __m256d muRecSqr      = _mm256_setzero_pd();
+      __m256d muOrigMultRec = _mm256_setzero_pd();
+
+      for (int y = 0; y < SSIM_WINDOW_SIZE; y++)
+      {
+        const double *o = org + y * stride + i;
+        const double *r = rec + y * stride + i;
+        for (int x = 0; x < SSIM_WINDOW_SIZE; x++)
+        {
+          const __m256d w      = _mm256_set1_pd(weights[y * SSIM_WINDOW_SIZE + x]);
+          const __m256d orgPel = _mm256_loadu_pd(o + x);
+          const __m256d recPel = _mm256_loadu_pd(r + x);
+
+          muOrg         = _mm256_add_pd(muOrg, _mm256_mul_pd(orgPel, w));
+          muRec         = _mm256_add_pd(muRec, _mm256_mul_pd(recPel, w));
+          muOrigSqr     = _mm256_add_pd(muOrigSqr, _mm256_mul_pd(_mm256_mul_pd(orgPel, orgPel), w));
+          muRecSqr      = _mm256_add_pd(muRecSqr, _mm256_mul_pd(_mm256_mul_pd(recPel, recPel), w));
+          muOrigMultRec = _mm256_add_pd(muOrigMultRec, _mm256_mul_pd(_mm256_mul_pd(orgPel, recPel), w));
+        }
+      }
+
+      const __m256d sigmaSqrOrig = _mm256_sub_pd(muOrigSqr, _mm256_mul_pd(muOrg, muOrg));
+      const __m256d sigmaSqrRec  = _mm256_sub_pd(muRecSqr, _mm256_mul_pd(muRec, muRec));
+      const __m256d sigmaOrigRec = _mm256_sub_pd(muOrigMultRec, _mm256_mul_pd(muOrg, muRec));
+
+      __m256d blockSSIMVal = _mm256_div_pd(_mm256_add_pd(_mm256_mul_pd(two, sigmaOrigRec), vc2),
+                                           _mm256_add_pd(_mm256_add_pd(sigmaSqrOrig, sigmaSqrRec), vc2));
+      if (luminance)
+      {
+        const __m256d num = _mm256_add_pd(_mm256_mul_pd(_mm256_mul_pd(two, muOrg), muRec), vc1);
+        const __m256d den =
+          _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(muOrg, muOrg), _mm256_mul_pd(muRec, muRec)), vc1);
+        blockSSIMVal = _mm256_mul_pd(blockSSIMVal, _mm256_div_pd(num, den));
+      }
+      _mm256_storeu_pd(ssim + i, blockSSIMVal);
+    }
+  }
+#endif
+  const __m128d vc1 = _mm_set1_pd(c1);
+  const __m128d vc2 = _mm_set1_pd(c2);
+  const __m128d two = _mm_set1_pd(2.0);
+
+  for (; i + 2 <= numWindows; i += 2)
+  {
+    __m128d muOrg         = _mm_setzero_pd();
+    __m128d muRec         = _mm_setzero_pd();
+    __m128d muOrigSqr     = _mm_setzero_pd();
+    __m128d muRecSqr      = _mm_setzero_pd();
+    __m128d muOrigMultRec = _mm_setzero_pd();
+
+    for (int y = 0; y < SSIM_WINDOW_SIZE; y++)
+    {
+      const double *o = org + y * stride + i;
+      const double *r = rec + y * stride + i;
+      for (int x = 0; x < SSIM_WINDOW_SIZE; x++)
+      {
+        const __m128d w      = _mm_set1_pd(weights[y * SSIM_WINDOW_SIZE + x]);
+        const __m128d orgPel = _mm_loadu_pd(o + x);
+        const __m128d recPel = _mm_loadu_pd(r + x);
+
+        muOrg         = _mm_add_pd(muOrg, _mm_mul_pd(orgPel, w));
+        muRec         = _mm_add_pd(muRec, _mm_mul_pd(recPel, w));
+        muOrigSqr     = _mm_add_pd(muOrigSqr, _mm_mul_pd(_mm_mul_pd(orgPel, orgPel), w));
+        muRecSqr      = _mm_add_pd(muRecSqr, _mm_mul_pd(_mm_mul_pd(recPel, recPel), w));
+        muOrigMultRec = _mm_add_pd(muOrigMultRec, _mm_mul_pd(_mm_mul_pd(orgPel, recPel), w));
+      }
+    }
+
+    const __m128d sigmaSqrOrig = _mm_sub_pd(muOrigSqr, _mm_mul_pd(muOrg, muOrg));
+    const __m128d sigmaSqrRec  = _mm_sub_pd(muRecSqr, _mm_mul_pd(muRec, muRec));
+    const __m128d sigmaOrigRec = _mm_sub_pd(muOrigMultRec, _mm_mul_pd(muOrg, muRec));
+
+    __m128d blockSSIMVal = _mm_div_pd(_mm_add_pd(_mm_mul_pd(two, sigmaOrigRec), vc2),
+                                      _mm_add_pd(_mm_add_pd(sigmaSqrOrig, sigmaSqrRec), vc2));
+    if (luminance)
+    {
+      const __m128d num = _mm_add_pd(_mm_mul_pd(_mm_mul_pd(two, muOrg), muRec), vc1);
+      const __m128d den = _mm_add_pd(_mm_add_pd(_mm_mul_pd(muOrg, muOrg), _mm_mul_pd(muRec, muRec)), vc1);
+      blockSSIMVal      = _mm_mul_pd(blockSSIMVal, _mm_div_pd(num, den));
+    }
+    _mm_storeu_pd(ssim + i, blockSSIMVal);
+  }
+
+  if (i < numWindows)
+  {
+    xGetSSIMWindows(org + i, rec + i, stride, weights, numWindows - i, c1, c2, luminance, ssim + i);
+  }
+}
+
 template <X86_VEXT vext>
 void RdCost::_initRdCostX86()
 {
@@ -4651,6 +5159,8 @@ void RdCost::_initRdCostX86()
   m_distortionFunc[DFunc::SSE64]  = xGetSSE_NxN_SIMD<64, vext>;
   m_distortionFunc[DFunc::SSE16N] = xGetSSE_SIMD<vext>;
 
+  m_planeSseFunc = xGetPlaneSSE_SIMD<vext>;
+
   m_distortionFunc[DFunc::SAD]    = xGetSAD_SIMD<vext>;
   m_distortionFunc[DFunc::SAD2]   = xGetSAD_SIMD<vext>;
   m_distortionFunc[DFunc::SAD4]   = xGetSAD_NxN_SIMD<4, vext>;
@@ -4676,7 +5186,13 @@ void RdCost::_initRdCostX86()
   m_distortionFunc[DFunc::SAD_INTERMEDIATE_BITDEPTH] = RdCost::xGetSAD_IBD_SIMD<vext>;
 
   m_distortionFunc[DFunc::SAD_WITH_MASK] = xGetSADwMask_SIMD<vext>;
+  m_sadMaskMultiFunc = xGetSADwMaskMulti_SIMD<vext>;
+
+  m_sadX4Func   = xGetSADX4_SIMD<vext>;
+  m_sadDmvrFunc = xGetSADDmvr_SIMD<vext>;
 #endif
+
+  m_ssimWindowsFunc = xGetSSIMWindows_SIMD<vext>;
 }
 
 template void RdCost::_initRdCostX86<SIMDX86>();
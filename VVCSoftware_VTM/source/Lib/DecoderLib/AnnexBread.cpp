@@ -204,4 +204,34 @@ bool byteStreamNALUnit(InputByteStream &bs, std::vector<uint8_t> &nalUnit, Annex
   stats.m_numBytesInNALUnit = uint32_t(nalUnit.size());
   return eof;
 }
+InputNALUnit *InputNALUnitQueue::peek(size_t idx)
+{
+  while (m_nalus.size() <= idx && !m_endOfStream)
+  {
+    AnnexBStats stats = AnnexBStats();
+    m_nalus.emplace_back();
+    InputNALUnit &nalu = m_nalus.back();
+    m_endOfStream      = byteStreamNALUnit(m_bytestream, nalu.getBitstream().getFifo(), stats);
+
+    if (!nalu.getBitstream().getFifo().empty())
+    {
+      read(nalu);
+    }
+  }
+
+  return idx < m_nalus.size() ? &m_nalus[idx] : nullptr;
+}
+
+bool InputNALUnitQueue::pop(InputNALUnit &nalu)
+{
+  if (peek() == nullptr)
+  {
+    return false;
+  }
+
+  nalu = std::move(m_nalus.front());
+  m_nalus.pop_front();
+  return true;
+}
+
 //! \}
@@ -39,10 +39,12 @@
 #pragma once
 
 #include <cstdint>
+#include <deque>
 #include <istream>
 #include <vector>
 
 #include "CommonLib/CommonDef.h"
+#include "NALread.h"
 
 //! \ingroup DecoderLib
 //! \{
@@ -188,4 +190,38 @@ struct AnnexBStats
 
 bool byteStreamNALUnit(InputByteStream& bs, std::vector<uint8_t>& nalUnit, AnnexBStats& stats);
 
+/**
+ * NAL units extracted from a byte stream ahead of decoding.
+ *
+ * Every NAL unit is extracted, converted to RBSP and has its header parsed
+ * exactly once. The decoder looks ahead through the queued units to find
+ * picture and access unit boundaries, so the input never has to be
+ * re-positioned and may be a non-seekable stream.
+ */
+class InputNALUnitQueue
+{
+public:
+  InputNALUnitQueue(InputByteStream &bs) : m_bytestream(bs), m_endOfStream(false) {}
+
+  /**
+   * returns the NAL unit idx positions after the next one to be popped,
+   * extracting NAL units from the byte stream as needed, or nullptr if the
+   * stream ends before. Empty NAL units are queued without being read.
+   */
+  InputNALUnit *peek(size_t idx = 0);
+
+  /**
+   * moves the next NAL unit into nalu. Returns false at the end of the stream.
+   */
+  bool pop(InputNALUnit &nalu);
+
+  /** returns true if all NAL units of the stream have been popped */
+  bool empty() { return peek() == nullptr; }
+
+private:
+  InputByteStream         &m_bytestream;
+  std::deque<InputNALUnit> m_nalus;
+  bool                     m_endOfStream;
+};
+
 //! \}
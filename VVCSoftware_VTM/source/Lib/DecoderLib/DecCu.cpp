@@ -637,7 +637,7 @@ void DecCu::xReconInter(CodingUnit &cu)
   {
     if (cu.cs->slice->getLmcsEnabledFlag() && m_pcReshape->getCTUFlag())
     {
-      cu.cs->getPredBuf(*cu.firstPU).Y().rspSignal(m_pcReshape->getFwdLUT());
+      cu.cs->getPredBuf(*cu.firstPU).Y().rspSignal(m_pcReshape->getFwdPwl());
     }
     m_pcIntraPred->geneWeightedPred(cu.cs->getPredBuf(*cu.firstPU).Y(), *cu.firstPU,
                                     m_pcIntraPred->getPredictorPtr2(COMPONENT_Y, 0));
@@ -677,7 +677,7 @@ void DecCu::xReconInter(CodingUnit &cu)
 #endif
       if (!cu.firstPU->ciipFlag && !CU::isIBC(cu))
       {
-        cs.getPredBuf(cu).get(COMPONENT_Y).rspSignal(m_pcReshape->getFwdLUT());
+        cs.getPredBuf(cu).get(COMPONENT_Y).rspSignal(m_pcReshape->getFwdPwl());
       }
     }
 #if KEEP_PRED_AND_RESI_SIGNALS
@@ -698,10 +698,15 @@ void DecCu::xReconInter(CodingUnit &cu)
   }
   else
   {
-    cs.getRecoBuf(cu).copyClip(cs.getPredBuf(cu), cs.slice->clpRngs());
     if (cs.slice->getLmcsEnabledFlag() && m_pcReshape->getCTUFlag() && !cu.firstPU->ciipFlag && !CU::isIBC(cu))
     {
-      cs.getRecoBuf(cu).get(COMPONENT_Y).rspSignal(m_pcReshape->getFwdLUT());
+      // the mapping clips its input, so luma is forward-mapped straight from the prediction
+      cs.getRecoBuf(cu).get(COMPONENT_Y).rspSignal(cs.getPredBuf(cu).get(COMPONENT_Y), m_pcReshape->getFwdPwl());
+      cs.getRecoBuf(cu).copyClip(cs.getPredBuf(cu), cs.slice->clpRngs(), false, true);
+    }
+    else
+    {
+      cs.getRecoBuf(cu).copyClip(cs.getPredBuf(cu), cs.slice->clpRngs());
     }
   }
 
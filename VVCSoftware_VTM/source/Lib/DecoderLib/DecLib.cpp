@@ -45,6 +45,7 @@
 #include "CommonLib/ProfileTierLevel.h"
 
 #include <fstream>
+#include <mutex>
 #include <set>
 #include <stdio.h>
 #include <fcntl.h>
@@ -65,16 +66,18 @@ bool tryDecodePicture(Picture *pcEncPic, const int expectedPoc, const std::strin
   int      poc;
   PicList *pcListPic = nullptr;
 
-  static bool bFirstCall      = true;             /* TODO: MT */
-  static bool loopFiltered[MAX_VPS_LAYERS] = { false };            /* TODO: MT */
-  static int  iPOCLastDisplay = -MAX_INT;         /* TODO: MT */
+  // the decoder state is kept per thread, encoders running concurrently in one process each decode their own bitstream
+  static thread_local bool bFirstCall      = true;
+  static thread_local bool loopFiltered[MAX_VPS_LAYERS] = { false };
+  static thread_local int  iPOCLastDisplay = -MAX_INT;
 
-  static std::ifstream* bitstreamFile = nullptr;  /* TODO: MT */
-  static InputByteStream* bytestream  = nullptr;  /* TODO: MT */
+  static thread_local std::ifstream* bitstreamFile = nullptr;
+  static thread_local InputByteStream* bytestream  = nullptr;
+  static thread_local InputNALUnitQueue* nalQueue  = nullptr;
   bool bRet = false;
 
   // create & initialize internal classes
-  static DecLib *pcDecLib = nullptr;              /* TODO: MT */
+  static thread_local DecLib *pcDecLib = nullptr;
 
   if( pcEncPic )
   {
@@ -82,6 +85,7 @@ bool tryDecodePicture(Picture *pcEncPic, const int expectedPoc, const std::strin
     {
       bitstreamFile = new std::ifstream( bitstreamFileName.c_str(), std::ifstream::in | std::ifstream::binary );
       bytestream    = new InputByteStream( *bitstreamFile );
+      nalQueue      = new InputNALUnitQueue( *bytestream );
 
       CHECK( !*bitstreamFile, "failed to open bitstream file " << bitstreamFileName.c_str() << " for reading" ) ;
       // create decoder class
@@ -107,20 +111,21 @@ bool tryDecodePicture(Picture *pcEncPic, const int expectedPoc, const std::strin
     bool goOn = true;
 
     // main decoder loop
-    while( !!*bitstreamFile && goOn )
+    while( !nalQueue->empty() && goOn )
     {
       InputNALUnit nalu;
       nalu.m_nalUnitType = NAL_UNIT_INVALID;
 
       // determine if next NAL unit will be the first one from a new picture
-      bool bNewPicture = pcDecLib->isNewPicture( bitstreamFile,  bytestream );
-      bool bNewAccessUnit = bNewPicture && pcDecLib->isNewAccessUnit( bNewPicture, bitstreamFile,  bytestream );
+      bool bNewPicture = pcDecLib->isNewPicture( *nalQueue );
+      bool bNewAccessUnit = bNewPicture && pcDecLib->isNewAccessUnit( bNewPicture, *nalQueue );
       bNewPicture = bNewPicture && bNewAccessUnit;
+      bool endOfStream = false;
 
       if( !bNewPicture )
       {
-        AnnexBStats stats = AnnexBStats();
-        byteStreamNALUnit(*bytestream, nalu.getBitstream().getFifo(), stats);
+        nalQueue->pop(nalu);
+        endOfStream = nalQueue->empty();
 
         // call actual decoding function
         if (nalu.getBitstream().getFifo().empty())
@@ -134,16 +139,15 @@ bool tryDecodePicture(Picture *pcEncPic, const int expectedPoc, const std::strin
         }
         else
         {
-          read(nalu);
           int iSkipFrame = 0;
 
           pcDecLib->decode(nalu, iSkipFrame, iPOCLastDisplay, 0);
         }
       }
 
-      if ((bNewPicture || !*bitstreamFile || nalu.m_nalUnitType == NAL_UNIT_EOS) && !pcDecLib->getFirstSliceInSequence(nalu.m_nuhLayerId))
+      if ((bNewPicture || endOfStream || nalu.m_nalUnitType == NAL_UNIT_EOS) && !pcDecLib->getFirstSliceInSequence(nalu.m_nuhLayerId))
       {
-        if (!loopFiltered[nalu.m_nuhLayerId] || *bitstreamFile)
+        if (!loopFiltered[nalu.m_nuhLayerId] || !endOfStream)
         {
           pcDecLib->finishPictureLight( poc, pcListPic );
 
@@ -344,7 +348,7 @@ bool tryDecodePicture(Picture *pcEncPic, const int expectedPoc, const std::strin
         }
 
       }
-      else if ((bNewPicture || !*bitstreamFile || nalu.m_nalUnitType == NAL_UNIT_EOS) && pcDecLib->getFirstSliceInSequence(nalu.m_nuhLayerId))
+      else if ((bNewPicture || endOfStream || nalu.m_nalUnitType == NAL_UNIT_EOS) && pcDecLib->getFirstSliceInSequence(nalu.m_nuhLayerId))
       {
         pcDecLib->setFirstSliceInPicture( true );
       }
@@ -368,6 +372,12 @@ bool tryDecodePicture(Picture *pcEncPic, const int expectedPoc, const std::strin
     }
     iPOCLastDisplay = -MAX_INT;
 
+    if( nalQueue )
+    {
+      delete nalQueue;
+      nalQueue = nullptr;
+    }
+
     if( bytestream )
     {
       delete bytestream;
@@ -390,6 +400,7 @@ bool tryDecodePicture(Picture *pcEncPic, const int expectedPoc, const std::strin
 
 DecLib::DecLib()
   : m_maxRefPicNum(0)
+  , m_peakPicBufferSize(0)
   , m_isFirstGeneralHrd(true)
   , m_prevGeneralHrdParams()
   , m_latestDRAPPOC(MAX_INT)
@@ -448,6 +459,8 @@ DecLib::DecLib()
 #endif
   , m_decodedPictureHashSEIEnabled(false)
   , m_numberOfChecksumErrorsDetected(0)
+  , m_numberOfPicturesDecoded(0)
+  , m_numberOfPicturesHashChecked(0)
   , m_warningMessageSkipPicture(false)
   , m_prefixSEINALUs()
   , m_debugPOC(-1)
@@ -469,7 +482,8 @@ DecLib::DecLib()
   , m_dci(nullptr)
 {
 #if ENABLE_SIMD_OPT_BUFFER
-  g_pelBufOP.initPelBufOpsX86();
+  static std::once_flag pelBufOpsInitialized;
+  std::call_once(pelBufOpsInitialized, [] { g_pelBufOP.initPelBufOpsX86(); });
 #endif
   memset(m_prevEOS, false, sizeof(m_prevEOS));
   memset(m_accessUnitEos, false, sizeof(m_accessUnitEos));
@@ -535,6 +549,7 @@ void DecLib::destroy()
   }
 
   m_cSliceDecoder.destroy();
+  m_perfCounters.close();
 }
 
 void DecLib::init(
@@ -544,6 +559,9 @@ void DecLib::init(
 )
 {
   m_cSliceDecoder.init( &m_CABACDecoder, &m_cCuDecoder );
+  m_cSliceDecoder.setPerfCounters( &m_perfCounters );
+  m_cTrQuant.setPerfCounters( &m_perfCounters );
+  m_cTrQuantScalingList.setPerfCounters( &m_perfCounters );
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
   m_cacheModel.create( cacheCfgFileName );
   m_cacheModel.clear( );
@@ -565,6 +583,12 @@ void DecLib::deletePicBuffer ( )
     delete pcPic;
     pcPic = nullptr;
   }
+  for (Picture *pic: m_picturePool)
+  {
+    pic->destroy();
+    delete pic;
+  }
+  m_picturePool.clear();
   m_cALF.destroy();
   m_cSAO.destroy();
   m_deblockingFilter.destroy();
@@ -576,6 +600,66 @@ void DecLib::deletePicBuffer ( )
   m_cReshaper.destroy();
 }
 
+void DecLib::recyclePicture( Picture *pic )
+{
+  // keep the picture buffers allocated, so that the next coded video sequence with the same format
+  // does not have to allocate and initialize the margins of every picture again
+  m_picturePool.push_back( pic );
+
+  while( m_picturePool.size() > (size_t) m_maxRefPicNum )
+  {
+    Picture *oldest = m_picturePool.front();
+    m_picturePool.pop_front();
+    oldest->destroy();
+    delete oldest;
+  }
+}
+
+Picture* DecLib::xCreatePicture( const SPS &sps, const PPS &pps, const int layerId )
+{
+  const Size     size( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples() );
+  const uint32_t margin = MAX_SCALING_RATIO * ( sps.getMaxCUWidth() + PIC_MARGIN );
+
+  for( auto it = m_picturePool.begin(); it != m_picturePool.end(); it++ )
+  {
+    Picture *pic = *it;
+    if( pic->chromaFormat == sps.getChromaFormatIdc() && pic->Y().Size::operator==( size ) && pic->margin == margin && pic->layerId == layerId
+#if JVET_Z0120_SII_SEI_PROCESSING
+        && pic->getPostRecBuf().bufs.empty() != getShutterFilterFlag()
+#endif
+      )
+    {
+      m_picturePool.erase( it );
+      pic->resetForReuse();
+      return pic;
+    }
+  }
+
+  Picture *pic = new Picture();
+
+#if JVET_Z0120_SII_SEI_PROCESSING
+  pic->create( sps.getChromaFormatIdc(), size, sps.getMaxCUWidth(), sps.getMaxCUWidth() + PIC_MARGIN, true, layerId, getShutterFilterFlag() );
+#else
+  pic->create( sps.getChromaFormatIdc(), size, sps.getMaxCUWidth(), sps.getMaxCUWidth() + PIC_MARGIN, true, layerId );
+#endif
+
+  return pic;
+}
+
+void DecLib::xUpdatePeakPicBufferSize()
+{
+  size_t picBufferSize = 0;
+  for( const Picture *pic: m_cListPic )
+  {
+    picBufferSize += pic->getBufferSize();
+  }
+  for( const Picture *pic: m_picturePool )
+  {
+    picBufferSize += pic->getBufferSize();
+  }
+  m_peakPicBufferSize = std::max( m_peakPicBufferSize, picBufferSize );
+}
+
 Picture* DecLib::xGetNewPicBuffer( const SPS &sps, const PPS &pps, const uint32_t temporalLayer, const int layerId )
 {
   Picture * pcPic = nullptr;
@@ -585,24 +669,19 @@ Picture* DecLib::xGetNewPicBuffer( const SPS &sps, const PPS &pps, const uint32_
                      : m_vps->getMaxDecPicBuffering(temporalLayer);
   if (m_cListPic.size() < (uint32_t) m_maxRefPicNum)
   {
-    pcPic = new Picture();
-
-#if JVET_Z0120_SII_SEI_PROCESSING
-    pcPic->create(sps.getChromaFormatIdc(), Size(pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples()),
-      sps.getMaxCUWidth(), sps.getMaxCUWidth() + PIC_MARGIN, true, layerId, getShutterFilterFlag() );
-#else
-    pcPic->create( sps.getChromaFormatIdc(), Size( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples() ), sps.getMaxCUWidth(), sps.getMaxCUWidth() + PIC_MARGIN, true, layerId );
-#endif
+    pcPic = xCreatePicture( sps, pps, layerId );
 
     m_cListPic.push_back( pcPic );
+    xUpdatePeakPicBufferSize();
 
     return pcPic;
   }
 
   bool bBufferIsAvailable = false;
-  for(auto * p: m_cListPic)
+  PicList::iterator iterPic = m_cListPic.begin();
+  for( ; iterPic != m_cListPic.end(); iterPic++ )
   {
-    pcPic = p;  // workaround because range-based for-loops don't work with existing variables
+    pcPic = *iterPic;
     if ( pcPic->reconstructed == false && ! pcPic->neededForOutput )
     {
       pcPic->neededForOutput = false;
@@ -624,27 +703,18 @@ Picture* DecLib::xGetNewPicBuffer( const SPS &sps, const PPS &pps, const uint32_
     //There is no room for this picture, either because of faulty encoder or dropped NAL. Extend the buffer.
     m_maxRefPicNum++;
 
-    pcPic = new Picture();
+    pcPic = xCreatePicture( sps, pps, layerId );
 
     m_cListPic.push_back( pcPic );
-
-#if JVET_Z0120_SII_SEI_PROCESSING
-    pcPic->create(sps.getChromaFormatIdc(), Size(pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples()), sps.getMaxCUWidth(), sps.getMaxCUWidth() + PIC_MARGIN, true, layerId, getShutterFilterFlag());
-#else
-    pcPic->create( sps.getChromaFormatIdc(), Size( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples() ), sps.getMaxCUWidth(), sps.getMaxCUWidth() + PIC_MARGIN, true, layerId );
-#endif
   }
   else
   {
     if( !pcPic->Y().Size::operator==( Size( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples() ) ) || pps.pcv->maxCUWidth != sps.getMaxCUWidth() || pps.pcv->maxCUHeight != sps.getMaxCUHeight() || pcPic->layerId != layerId )
     {
-      pcPic->destroy();
-
-#if JVET_Z0120_SII_SEI_PROCESSING
-      pcPic->create( sps.getChromaFormatIdc(), Size( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples() ), sps.getMaxCUWidth(), sps.getMaxCUWidth() + PIC_MARGIN, true, layerId, getShutterFilterFlag());
-#else
-      pcPic->create( sps.getChromaFormatIdc(), Size( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples() ), sps.getMaxCUWidth(), sps.getMaxCUWidth() + PIC_MARGIN, true, layerId );
-#endif
+      // park the mismatching picture in the pool, it is likely to be needed again when the resolution or layer switches back
+      recyclePicture( pcPic );
+      pcPic    = xCreatePicture( sps, pps, layerId );
+      *iterPic = pcPic;
     }
   }
 
@@ -652,6 +722,8 @@ Picture* DecLib::xGetNewPicBuffer( const SPS &sps, const PPS &pps, const uint32_
   pcPic->neededForOutput = false;
   pcPic->reconstructed = false;
 
+  xUpdatePeakPicBufferSize();
+
   return pcPic;
 }
 
@@ -664,6 +736,7 @@ void DecLib::executeLoopFilters()
   }
 
   m_pcPic->cs->slice->startProcessingTimer();
+  PerfTimer loopFilterTimer(&m_perfCounters, PerfStage::LOOP_FILTER);
 
   CodingStructure& cs = *m_pcPic->cs;
 
@@ -680,7 +753,7 @@ void DecLib::executeLoopFilters()
           const uint32_t width  = (xPos + pcv.maxCUWidth > pcv.lumaWidth) ? (pcv.lumaWidth - xPos) : pcv.maxCUWidth;
           const uint32_t height = (yPos + pcv.maxCUHeight > pcv.lumaHeight) ? (pcv.lumaHeight - yPos) : pcv.maxCUHeight;
           const UnitArea area(cs.area.chromaFormat, Area(xPos, yPos, width, height));
-          cs.getRecoBuf(area).get(COMPONENT_Y).rspSignal(m_cReshaper.getInvLUT());
+          cs.getRecoBuf(area).get(COMPONENT_Y).rspSignal(m_cReshaper.getInvPwl());
         }
       }
     }
@@ -800,6 +873,7 @@ void DecLib::finishPicture(int &poc, PicList *&rpcListPic, MsgLevel msgl, bool a
 
   Slice*  pcSlice = m_pcPic->cs->slice;
   m_prevPicPOC = pcSlice->getPOC();
+  m_numberOfPicturesDecoded++;
 #if GREEN_METADATA_SEI_ENABLED
   m_featureCounter.height = m_pcPic->Y().height;
   m_featureCounter.width = m_pcPic->Y().width;
@@ -827,6 +901,7 @@ void DecLib::finishPicture(int &poc, PicList *&rpcListPic, MsgLevel msgl, bool a
          c,
          pcSlice->getSliceQp() );
   msg( msgl, "[DT %6.3f] ", pcSlice->getProcessingTime() );
+  m_perfCounters.endPicture(pcSlice->getPOC(), m_pcPic->layerId, c, pcSlice->getSliceQp());
 
   for (int refList = 0; refList < 2; refList++)
   {
@@ -878,6 +953,10 @@ void DecLib::finishPicture(int &poc, PicList *&rpcListPic, MsgLevel msgl, bool a
       msg( WARNING, "Warning: Got multiple decoded picture hash SEI messages. Using first.");
     }
     m_numberOfChecksumErrorsDetected += calcAndPrintHashStatus(((const Picture*) m_pcPic)->getRecoBuf(), hash, pcSlice->getSPS()->getBitDepths(), msgl);
+    if (hash != nullptr)
+    {
+      m_numberOfPicturesHashChecked++;
+    }
 
     SEIMessages scalableNestingSeis = getSeisByType(m_pcPic->SEIs, SEI::PayloadType::SCALABLE_NESTING);
     for (auto seiIt : scalableNestingSeis)
@@ -1061,7 +1140,7 @@ void  DecLib::xCreateUnavailablePicture( const PPS *pps, const int iUnavailableP
   auto const sps = m_parameterSetManager.getSPS(pps->getSPSId());
   Picture* cFillPic = xGetNewPicBuffer( *sps, *pps, 0, layerId );
 
-  cFillPic->cs      = new CodingStructure(g_xuPool);
+  cFillPic->cs      = new CodingStructure(m_unitPool);
   cFillPic->cs->sps = sps;
   cFillPic->cs->pps = pps;
   cFillPic->cs->vps = m_parameterSetManager.getVPS(sps->getVPSId());
@@ -2062,7 +2141,7 @@ void DecLib::xActivateParameterSets( const InputNALUnit nalu )
     //  Get a new picture buffer. This will also set up m_pcPic, and therefore give us a SPS and PPS pointer that we can use.
     m_pcPic = xGetNewPicBuffer( *sps, *pps, m_apcSlicePilot->getTLayer(), layerId );
 
-    m_pcPic->finalInit( vps, *sps, *pps, &m_picHeader, apss, lmcsAPS, scalinglistAPS );
+    m_pcPic->finalInit( m_unitPool, vps, *sps, *pps, &m_picHeader, apss, lmcsAPS, scalinglistAPS );
 #if GDR_ENABLED
     m_apcSlicePilot->setPicHeader(m_pcPic->cs->picHeader);
 #endif
@@ -2294,7 +2373,6 @@ void DecLib::xCheckParameterSetConstraints(const int layerId)
     m_prevGeneralHrdParams = (sps->getGeneralHrdParametersPresentFlag() ? *sps->getGeneralHrdParameters() : *vps->getGeneralHrdParameters());
   }
   m_isFirstGeneralHrd = false;
-  static std::unordered_map<int, int> m_clvssSPSid;
 
   if( slice->isClvssPu() && m_bFirstSliceInPicture )
   {
@@ -2342,9 +2420,6 @@ void DecLib::xCheckParameterSetConstraints(const int layerId)
           "sps_bitdepth_minus8 shall be less than or equal to the value of vps_ols_dpb_bitdepth_minus8[ i ]");
   }
 
-  static std::unordered_map<int, ChromaFormat> m_layerChromaFormat;
-  static std::unordered_map<int, int> m_layerBitDepth;
-
   if (vps != nullptr && vps->getMaxLayers() > 1)
   {
     int curLayerIdx = vps->getGeneralLayerIdx(layerId);
@@ -3175,6 +3250,7 @@ bool DecLib::xDecodeSlice(InputNALUnit &nalu, int &iSkipFrame, int iPOCLastDispl
 
   if (m_bFirstSliceInPicture)
   {
+    m_perfCounters.beginPicture();
     m_pcPic->setDecodingOrderNumber(m_decodingOrderCounter);
     m_decodingOrderCounter++;
     m_pcPic->setPictureType(nalu.m_nalUnitType);
@@ -4010,7 +4086,7 @@ void DecLib::xCheckMixedNalUnit(Slice* pcSlice, SPS *sps, InputNALUnit &nalu)
 /**
 - lookahead through next NAL units to determine if current NAL unit is the first NAL unit in a new picture
 */
-bool DecLib::isNewPicture(std::ifstream *bitstreamFile, class InputByteStream *bytestream)
+bool DecLib::isNewPicture(InputNALUnitQueue &nalQueue)
 {
   bool ret = false;
   bool finished = false;
@@ -4021,97 +4097,74 @@ bool DecLib::isNewPicture(std::ifstream *bitstreamFile, class InputByteStream *b
     return false;
   }
 
-  // save stream position for backup
-#if RExt__DECODER_DEBUG_STATISTICS
-  CodingStatistics::CodingStatisticsData* backupStats = new CodingStatistics::CodingStatisticsData(CodingStatistics::GetStatistics());
-  std::streampos location = bitstreamFile->tellg() - std::streampos(bytestream->getNumBufferedBytes());
-#else
-  std::streampos location = bitstreamFile->tellg();
-#endif
-
-  // look ahead until picture start location is determined
-  while (!finished && !!(*bitstreamFile))
+  // look ahead through the queued NAL units until picture start location is determined
+  for (size_t idx = 0; !finished; idx++)
   {
-    AnnexBStats stats = AnnexBStats();
-    InputNALUnit nalu;
-    byteStreamNALUnit(*bytestream, nalu.getBitstream().getFifo(), stats);
-    if (nalu.getBitstream().getFifo().empty())
+    InputNALUnit *nalu = nalQueue.peek(idx);
+    if (nalu == nullptr)
     {
-      msg( ERROR, "Warning: Attempt to decode an empty NAL unit\n");
+      break;
     }
-    else
+    if (nalu->getBitstream().getFifo().empty())
     {
-      // get next NAL unit type
-      read(nalu);
-      switch (nalu.m_nalUnitType)
-      {
-      // NUT that indicate the start of a new picture
-      case NAL_UNIT_ACCESS_UNIT_DELIMITER:
-      case NAL_UNIT_OPI:
-      case NAL_UNIT_DCI:
-      case NAL_UNIT_VPS:
-      case NAL_UNIT_SPS:
-      case NAL_UNIT_PPS:
-      case NAL_UNIT_PH:
-        ret = true;
-        finished = true;
-        break;
+      continue;
+    }
 
-      // NUT that may be the start of a new picture - check first bit in slice header
-      case NAL_UNIT_CODED_SLICE_TRAIL:
-      case NAL_UNIT_CODED_SLICE_STSA:
-      case NAL_UNIT_CODED_SLICE_RASL:
-      case NAL_UNIT_CODED_SLICE_RADL:
-      case NAL_UNIT_RESERVED_VCL_4:
-      case NAL_UNIT_RESERVED_VCL_5:
-      case NAL_UNIT_RESERVED_VCL_6:
-      case NAL_UNIT_CODED_SLICE_IDR_W_RADL:
-      case NAL_UNIT_CODED_SLICE_IDR_N_LP:
-      case NAL_UNIT_CODED_SLICE_CRA:
-      case NAL_UNIT_CODED_SLICE_GDR:
-      case NAL_UNIT_RESERVED_IRAP_VCL_11:
-        ret = checkPictureHeaderInSliceHeaderFlag(nalu);
-        finished = true;
-        break;
+    switch (nalu->m_nalUnitType)
+    {
+    // NUT that indicate the start of a new picture
+    case NAL_UNIT_ACCESS_UNIT_DELIMITER:
+    case NAL_UNIT_OPI:
+    case NAL_UNIT_DCI:
+    case NAL_UNIT_VPS:
+    case NAL_UNIT_SPS:
+    case NAL_UNIT_PPS:
+    case NAL_UNIT_PH:
+      ret = true;
+      finished = true;
+      break;
 
-      // NUT that are not the start of a new picture
-      case NAL_UNIT_EOS:
-      case NAL_UNIT_EOB:
-      case NAL_UNIT_SUFFIX_APS:
-      case NAL_UNIT_SUFFIX_SEI:
-      case NAL_UNIT_FD:
-        ret = false;
-        finished = true;
-        break;
+    // NUT that may be the start of a new picture - check first bit in slice header
+    case NAL_UNIT_CODED_SLICE_TRAIL:
+    case NAL_UNIT_CODED_SLICE_STSA:
+    case NAL_UNIT_CODED_SLICE_RASL:
+    case NAL_UNIT_CODED_SLICE_RADL:
+    case NAL_UNIT_RESERVED_VCL_4:
+    case NAL_UNIT_RESERVED_VCL_5:
+    case NAL_UNIT_RESERVED_VCL_6:
+    case NAL_UNIT_CODED_SLICE_IDR_W_RADL:
+    case NAL_UNIT_CODED_SLICE_IDR_N_LP:
+    case NAL_UNIT_CODED_SLICE_CRA:
+    case NAL_UNIT_CODED_SLICE_GDR:
+    case NAL_UNIT_RESERVED_IRAP_VCL_11:
+      ret = checkPictureHeaderInSliceHeaderFlag(*nalu);
+      finished = true;
+      break;
 
-      // NUT that might indicate the start of a new picture - keep looking
-      case NAL_UNIT_PREFIX_APS:
-      case NAL_UNIT_PREFIX_SEI:
-      case NAL_UNIT_RESERVED_NVCL_26:
-      case NAL_UNIT_RESERVED_NVCL_27:
-      case NAL_UNIT_UNSPECIFIED_28:
-      case NAL_UNIT_UNSPECIFIED_29:
-      case NAL_UNIT_UNSPECIFIED_30:
-      case NAL_UNIT_UNSPECIFIED_31:
-      default:
-        break;
-      }
+    // NUT that are not the start of a new picture
+    case NAL_UNIT_EOS:
+    case NAL_UNIT_EOB:
+    case NAL_UNIT_SUFFIX_APS:
+    case NAL_UNIT_SUFFIX_SEI:
+    case NAL_UNIT_FD:
+      ret = false;
+      finished = true;
+      break;
+
+    // NUT that might indicate the start of a new picture - keep looking
+    case NAL_UNIT_PREFIX_APS:
+    case NAL_UNIT_PREFIX_SEI:
+    case NAL_UNIT_RESERVED_NVCL_26:
+    case NAL_UNIT_RESERVED_NVCL_27:
+    case NAL_UNIT_UNSPECIFIED_28:
+    case NAL_UNIT_UNSPECIFIED_29:
+    case NAL_UNIT_UNSPECIFIED_30:
+    case NAL_UNIT_UNSPECIFIED_31:
+    default:
+      break;
     }
   }
 
-  // restore previous stream location - minus 3 due to the need for the annexB parser to read three extra bytes
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-  bitstreamFile->clear();
-  bitstreamFile->seekg(location);
-  bytestream->reset();
-  CodingStatistics::SetStatistics(*backupStats);
-  delete backupStats;
-#else
-  bitstreamFile->clear();
-  bitstreamFile->seekg(location-std::streamoff(3));
-  bytestream->reset();
-#endif
-
   // return TRUE if next NAL unit is the start of a new picture
   return ret;
 }
@@ -4119,7 +4172,7 @@ bool DecLib::isNewPicture(std::ifstream *bitstreamFile, class InputByteStream *b
 /**
 - lookahead through next NAL units to determine if current NAL unit is the first NAL unit in a new access unit
 */
-bool DecLib::isNewAccessUnit( bool newPicture, std::ifstream *bitstreamFile, class InputByteStream *bytestream )
+bool DecLib::isNewAccessUnit( bool newPicture, InputNALUnitQueue &nalQueue )
 {
   bool ret = false;
   bool finished = false;
@@ -4130,79 +4183,65 @@ bool DecLib::isNewAccessUnit( bool newPicture, std::ifstream *bitstreamFile, cla
     return false;
   }
 
-  // save stream position for backup
-#if RExt__DECODER_DEBUG_STATISTICS
-  CodingStatistics::CodingStatisticsData* backupStats = new CodingStatistics::CodingStatisticsData(CodingStatistics::GetStatistics());
-  std::streampos location = bitstreamFile->tellg() - std::streampos(bytestream->getNumBufferedBytes());
-#else
-  std::streampos location = bitstreamFile->tellg();
-#endif
-
-  // look ahead until access unit start location is determined
-  while (!finished && !!(*bitstreamFile))
+  // look ahead through the queued NAL units until access unit start location is determined
+  for (size_t idx = 0; !finished; idx++)
   {
-    AnnexBStats stats = AnnexBStats();
-    InputNALUnit nalu;
-    byteStreamNALUnit(*bytestream, nalu.getBitstream().getFifo(), stats);
-    if (nalu.getBitstream().getFifo().empty())
+    InputNALUnit *nalu = nalQueue.peek(idx);
+    if (nalu == nullptr)
     {
-      msg( ERROR, "Warning: Attempt to decode an empty NAL unit\n");
+      break;
     }
-    else
+    if (nalu->getBitstream().getFifo().empty())
     {
-      // get next NAL unit type
-      read(nalu);
-      switch (nalu.m_nalUnitType)
-      {
-      // AUD always indicates the start of a new access unit
-      case NAL_UNIT_ACCESS_UNIT_DELIMITER:
-        ret = true;
-        finished = true;
-        break;
+      continue;
+    }
 
-      // slice types - check layer ID and POC
-      case NAL_UNIT_CODED_SLICE_TRAIL:
-      case NAL_UNIT_CODED_SLICE_STSA:
-      case NAL_UNIT_CODED_SLICE_RASL:
-      case NAL_UNIT_CODED_SLICE_RADL:
-      case NAL_UNIT_CODED_SLICE_IDR_W_RADL:
-      case NAL_UNIT_CODED_SLICE_IDR_N_LP:
-      case NAL_UNIT_CODED_SLICE_CRA:
-      case NAL_UNIT_CODED_SLICE_GDR:
-        ret = isSliceNaluFirstInAU( newPicture, nalu );
-        finished = true;
-        break;
+    switch (nalu->m_nalUnitType)
+    {
+    // AUD always indicates the start of a new access unit
+    case NAL_UNIT_ACCESS_UNIT_DELIMITER:
+      ret = true;
+      finished = true;
+      break;
 
-      // NUT that are not the start of a new access unit
-      case NAL_UNIT_EOS:
-      case NAL_UNIT_EOB:
-      case NAL_UNIT_SUFFIX_APS:
-      case NAL_UNIT_SUFFIX_SEI:
-      case NAL_UNIT_FD:
-        ret = false;
-        finished = true;
-        break;
+    // slice types - check layer ID and POC
+    case NAL_UNIT_CODED_SLICE_TRAIL:
+    case NAL_UNIT_CODED_SLICE_STSA:
+    case NAL_UNIT_CODED_SLICE_RASL:
+    case NAL_UNIT_CODED_SLICE_RADL:
+    case NAL_UNIT_CODED_SLICE_IDR_W_RADL:
+    case NAL_UNIT_CODED_SLICE_IDR_N_LP:
+    case NAL_UNIT_CODED_SLICE_CRA:
+    case NAL_UNIT_CODED_SLICE_GDR:
+    {
+      // the slice header is parsed again when the NAL unit is decoded - do not count its bits twice
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+      CodingStatistics::CodingStatisticsData backupStats(CodingStatistics::GetStatistics());
+#endif
+      ret = isSliceNaluFirstInAU( newPicture, *nalu );
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+      CodingStatistics::SetStatistics(backupStats);
+#endif
+      finished = true;
+      break;
+    }
 
-      // all other NUT - keep looking to find first VCL
-      default:
-        break;
-      }
+    // NUT that are not the start of a new access unit
+    case NAL_UNIT_EOS:
+    case NAL_UNIT_EOB:
+    case NAL_UNIT_SUFFIX_APS:
+    case NAL_UNIT_SUFFIX_SEI:
+    case NAL_UNIT_FD:
+      ret = false;
+      finished = true;
+      break;
+
+    // all other NUT - keep looking to find first VCL
+    default:
+      break;
     }
   }
 
-  // restore previous stream location
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-  bitstreamFile->clear();
-  bitstreamFile->seekg(location);
-  bytestream->reset();
-  CodingStatistics::SetStatistics(*backupStats);
-  delete backupStats;
-#else
-  bitstreamFile->clear();
-  bitstreamFile->seekg(location);
-  bytestream->reset();
-#endif
-
   // return TRUE if next NAL unit is the start of a new picture
   return ret;
 }
@@ -47,6 +47,7 @@
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/Picture.h"
 #include "CommonLib/TrQuant.h"
+#include "CommonLib/PerfCounters.h"
 #include "CommonLib/InterPrediction.h"
 #include "CommonLib/IntraPrediction.h"
 #include "CommonLib/DeblockingFilter.h"
@@ -72,8 +73,12 @@ class DecLib
 {
 private:
   int                     m_maxRefPicNum;
+  size_t                  m_peakPicBufferSize;   ///< peak memory of the picture buffers (DPB and pool) in bytes
   bool m_isFirstGeneralHrd;
   GeneralHrdParams        m_prevGeneralHrdParams;
+  std::unordered_map<int, int>          m_clvssSPSid;          ///< SPS ID referred to by the current CLVS of each layer
+  std::unordered_map<int, ChromaFormat> m_layerChromaFormat;   ///< chroma format of the current CLVS of each layer
+  std::unordered_map<int, int>          m_layerBitDepth;       ///< luma bit depth of the current CLVS of each layer
 
   int                     m_prevGDRInSameLayerPOC[MAX_VPS_LAYERS]; ///< POC number of the latest GDR picture
   int                     m_prevGDRInSameLayerRecoveryPOC[MAX_VPS_LAYERS]; ///< Recovery POC number of the latest GDR picture
@@ -96,6 +101,8 @@ private:
   bool                    m_prevEOS[MAX_VPS_LAYERS];
 
   PicList                 m_cListPic;         //  Dynamic buffer
+  PicList                 m_picturePool;      //  pictures released from the DPB, kept allocated for reuse
+  XuPool                  m_unitPool;         //  CU/PU/TU pool of the picture coding structures
   ParameterSetManager     m_parameterSetManager;  // storage for parameter sets
   PicHeader               m_picHeader;            // picture header
   Slice*                  m_apcSlicePilot;
@@ -112,6 +119,7 @@ private:
   TrQuant                 m_cTrQuant;
   DecSlice                m_cSliceDecoder;
   TrQuant                 m_cTrQuantScalingList;
+  PerfCounters            m_perfCounters;           ///< per-picture timing counters
   DecCu                   m_cCuDecoder;
   HLSyntaxReader          m_HLSReader;
   CABACDecoder            m_CABACDecoder;
@@ -161,6 +169,8 @@ private:
 
   int                     m_decodedPictureHashSEIEnabled;  ///< Checksum(3)/CRC(2)/MD5(1)/disable(0) acting on decoded picture hash SEI message
   uint32_t                m_numberOfChecksumErrorsDetected;
+  uint32_t                m_numberOfPicturesDecoded;
+  uint32_t                m_numberOfPicturesHashChecked;    ///< pictures for which a decoded picture hash SEI was verified
 
   bool                    m_warningMessageSkipPicture;
 
@@ -257,6 +267,8 @@ public:
   );
   bool  decode(InputNALUnit& nalu, int& iSkipFrame, int& iPOCLastDisplay, int iTargetOlsIdx);
   void  deletePicBuffer();
+  void  recyclePicture( Picture *pic );
+  size_t getPeakPicBufferSize() const { return m_peakPicBufferSize; }
 
   void  executeLoopFilters();
   void finishPicture(int &poc, PicList *&rpcListPic, MsgLevel msgl = INFO, bool associatedWithNewClvs = false);
@@ -276,10 +288,13 @@ public:
   bool  getFirstSliceInSequence(int layerId) const { return m_firstSliceInSequence[layerId]; }
   void  setFirstSliceInSequence(bool val, int layerId) { m_firstSliceInSequence[layerId] = val; }
   void  setDecodedSEIMessageOutputStream(std::ostream *pOpStream) { m_pDecodedSEIOutputStream = pOpStream; }
+  PerfCounters* getPerfCounters()           { return &m_perfCounters; }
 #if JVET_S0257_DUMP_360SEI_MESSAGE
   void  setDecoded360SEIMessageFileName(std::string &Dump360SeiFileName) { m_decoded360SeiDumpFileName = Dump360SeiFileName; }
 #endif
   uint32_t  getNumberOfChecksumErrorsDetected() const { return m_numberOfChecksumErrorsDetected; }
+  uint32_t  getNumberOfPicturesDecoded() const        { return m_numberOfPicturesDecoded; }
+  uint32_t  getNumberOfPicturesHashChecked() const    { return m_numberOfPicturesHashChecked; }
 
 #if GDR_ENABLED
   void setLastGdrPoc(int poc) { m_lastGdrPoc = poc;  }
@@ -333,8 +348,8 @@ public:
   }
 
   void  setAPSMapEnc(EnumArray<ParameterSetMap<APS>, ApsType> *apsMap) { m_apsMapEnc = apsMap; }
-  bool  isNewPicture( std::ifstream *bitstreamFile, class InputByteStream *bytestream );
-  bool  isNewAccessUnit( bool newPicture, std::ifstream *bitstreamFile, class InputByteStream *bytestream );
+  bool  isNewPicture( class InputNALUnitQueue &nalQueue );
+  bool  isNewAccessUnit( bool newPicture, class InputNALUnitQueue &nalQueue );
 
   bool      getHTidExternalSetFlag()               const { return m_mTidExternalSet; }
   void      setHTidExternalSetFlag(bool mTidExternalSet)  { m_mTidExternalSet = mTidExternalSet; }
@@ -369,6 +384,8 @@ protected:
   void  xUpdateRasInit(Slice* slice);
 
   Picture * xGetNewPicBuffer( const SPS &sps, const PPS &pps, const uint32_t temporalLayer, const int layerId );
+  Picture * xCreatePicture( const SPS &sps, const PPS &pps, const int layerId );
+  void  xUpdatePeakPicBufferSize();
   void  xCreateLostPicture( int iLostPOC, const int layerId );
   void  xCreateUnavailablePicture( const PPS *pps, const int iUnavailablePoc, const bool longTermFlag, const int temporalId, const int layerId, const bool interLayerRefPicFlag );
   void  checkParameterSetsInclusionSEIconstraints(const InputNALUnit nalu);
@@ -48,7 +48,7 @@
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
 
-DecSlice::DecSlice()
+DecSlice::DecSlice() : m_perfCounters(nullptr)
 {
 }
 
@@ -226,14 +226,19 @@ void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int deb
     {
       pic->mctsInfo.init( &cs, getCtuAddr( ctuArea.lumaPos(), *( cs.pcv ) ) );
     }
+    cs.initNeighbourStrip( ctuArea.Y() );
 
     if( ctuRsAddr == debugCTU )
     {
       break;
     }
+    PerfTimer parseTimer(m_perfCounters, PerfStage::ENTROPY_CODING);
     cabacReader.coding_tree_unit( cs, ctuArea, pic->m_prevQP, ctuRsAddr );
+    parseTimer.stop();
 
+    PerfTimer reconTimer(m_perfCounters, PerfStage::RECONSTRUCTION);
     m_pcCuDecoder->decompressCtu( cs, ctuArea );
+    reconTimer.stop();
 #if GREEN_METADATA_SEI_ENABLED
     FeatureCounterStruct featureCounter = slice->getFeatureCounter();
     countFeatures( featureCounter, cs,ctuArea);
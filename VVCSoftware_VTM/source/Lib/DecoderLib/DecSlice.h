@@ -41,6 +41,7 @@
 #pragma once
 
 #include "CommonLib/CommonDef.h"
+#include "CommonLib/PerfCounters.h"
 #include "CommonLib/BitStream.h"
 #include "DecCu.h"
 #include "CABACReader.h"
@@ -59,6 +60,7 @@ private:
   // access channel
   CABACDecoder*   m_CABACDecoder;
   DecCu*          m_pcCuDecoder;
+  PerfCounters*   m_perfCounters;
 
   Ctx             m_entropyCodingSyncContextState;      ///< context storage for state of contexts at the wavefront/WPP/entropy-coding-sync second CTU of tile-row
   PLTBuf          m_palettePredictorSyncState;      /// palette predictor storage at wavefront/WPP
@@ -68,6 +70,7 @@ public:
   virtual ~DecSlice();
 
   void  init              ( CABACDecoder* cabacDecoder, DecCu* pcMbDecoder );
+  void  setPerfCounters   ( PerfCounters* perfCounters ) { m_perfCounters = perfCounters; }
   void  create            ();
   void  destroy           ();
 
@@ -39,6 +39,7 @@
 
 #include <vector>
 #include <algorithm>
+#include <cstring>
 #include <ostream>
 
 #include "NALread.h"
@@ -56,42 +57,67 @@
 //! \{
 static void convertPayloadToRBSP(std::vector<uint8_t> &nalUnitBuf, InputBitstream *bitstream, bool isVclNalUnit)
 {
-  uint32_t zeroCount = 0;
-  std::vector<uint8_t>::iterator it_read, it_write;
+  uint8_t     *buf  = nalUnitBuf.data();
+  const size_t size = nalUnitBuf.size();
+
+  size_t readPos  = 0;   // first byte not yet moved to its RBSP position
+  size_t writePos = 0;
+  size_t scanPos  = 0;   // no two-zero sequence starts before scanPos
 
-  uint32_t pos = 0;
   bitstream->clearEmulationPreventionByteLocation();
-  for (it_read = it_write = nalUnitBuf.begin(); it_read != nalUnitBuf.end(); it_read++, it_write++, pos++)
+
+  // emulation_prevention_three_byte (and any invalid sequence) can only follow two zero bytes, so only zero bytes
+  // need to be looked at. memchr skips the runs of non-zero bytes, which make up nearly all entropy-coded data.
+  // Bytes are only moved once an emulation prevention byte has been found.
+  while (scanPos + 2 < size)
   {
-    CHECK(zeroCount >= 2 && *it_read < 0x03, "Zero count is '2' and read value is small than '3'");
-    if (zeroCount == 2 && *it_read == 0x03)
+    const uint8_t *zero = (const uint8_t *) memchr(buf + scanPos, 0x00, size - 2 - scanPos);
+    if (zero == nullptr)
+    {
+      break;
+    }
+
+    const size_t pos = zero - buf;
+    if (buf[pos + 1] != 0x00)
     {
-      bitstream->pushEmulationPreventionByteLocation( pos );
-      pos++;
-      it_read++;
-      zeroCount = 0;
+      scanPos = pos + 2;
+      continue;
+    }
+
+    const uint8_t nextByte = buf[pos + 2];
+    CHECK(nextByte < 0x03, "Zero count is '2' and read value is small than '3'");
+    if (nextByte == 0x03)
+    {
+      bitstream->pushEmulationPreventionByteLocation((uint32_t) (pos + 2));
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
       CodingStatistics::IncrementStatisticEP(STATS__EMULATION_PREVENTION_3_BYTES, 8, 0);
 #endif
-      if (it_read == nalUnitBuf.end())
+      if (writePos != readPos)
       {
-        break;
+        memmove(buf + writePos, buf + readPos, pos + 2 - readPos);
       }
-      CHECK(*it_read > 0x03, "Read a value bigger than '3'");
+      writePos += pos + 2 - readPos;
+      readPos = pos + 3;
+      CHECK(readPos < size && buf[readPos] > 0x03, "Read a value bigger than '3'");
     }
-    zeroCount = (*it_read == 0x00) ? zeroCount+1 : 0;
-    *it_write = *it_read;
+    scanPos = pos + 3;
+  }
+  CHECK(size > 0 && buf[size - 1] == 0x00, "Zero count not '0'");
+
+  if (writePos != readPos)
+  {
+    memmove(buf + writePos, buf + readPos, size - readPos);
   }
-  CHECK(zeroCount != 0, "Zero count not '0'");
+  writePos += size - readPos;
 
   if (isVclNalUnit)
   {
     // Remove cabac_zero_word from payload if present
     int n = 0;
 
-    while (it_write[-1] == 0x00)
+    while (writePos > 0 && buf[writePos - 1] == 0x00)
     {
-      it_write--;
+      writePos--;
       n++;
     }
 
@@ -101,7 +127,7 @@ static void convertPayloadToRBSP(std::vector<uint8_t> &nalUnitBuf, InputBitstrea
     }
   }
 
-  nalUnitBuf.resize(it_write - nalUnitBuf.begin());
+  nalUnitBuf.resize(writePos);
 }
 
 #if ENABLE_TRACING
@@ -172,6 +198,6 @@ bool checkPictureHeaderInSliceHeaderFlag(InputNALUnit& nalu)
 {
   InputBitstream& bitstream = nalu.getBitstream();
   CHECK(bitstream.getByteLocation() != 2, "The picture_header_in_slice_header_flag is the first bit after the NAL unit header");
-  return (bool)bitstream.read(1);
+  return (bool)bitstream.peekBits(1);
 }
 //! \}
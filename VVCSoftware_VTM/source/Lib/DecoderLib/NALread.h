@@ -59,6 +59,9 @@ class InputNALUnit : public NALUnit
 
   public:
     InputNALUnit(const InputNALUnit &src) : NALUnit(src), m_bitstream(src.m_bitstream){};
+    InputNALUnit(InputNALUnit &&src) : NALUnit(src), m_bitstream(std::move(src.m_bitstream)){};
+    InputNALUnit &operator=(const InputNALUnit &src) = default;
+    InputNALUnit &operator=(InputNALUnit &&src)      = default;
     InputNALUnit() : NALUnit(NAL_UNIT_INVALID), m_bitstream(){};
     virtual ~InputNALUnit() { }
     const InputBitstream &getBitstream() const { return m_bitstream; }
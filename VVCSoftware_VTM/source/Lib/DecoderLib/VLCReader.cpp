@@ -83,33 +83,8 @@ void  VLCReader::xReadUvlc(uint32_t& value, const char *symbolName )
 void  VLCReader::xReadUvlc(uint32_t& value, const char* )
 #endif
 {
-  uint32_t suffix    = 0;
-  uint32_t prefixBit = 0;
-  m_pcBitstream->read( 1, prefixBit );
-
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-  uint32_t totalLen=1;
-#endif
-
-  if( 0 == prefixBit )
-  {
-    uint32_t length = 0;
-
-    while( prefixBit == 0 )
-    {
-      m_pcBitstream->read( 1, prefixBit );
-      length++;
-    }
-
-    m_pcBitstream->read(length, suffix);
-    suffix += (1 << length) - 1;
-
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-    totalLen += length + length;
-#endif
-  }
-
-  value = suffix;
+  uint32_t totalLen;
+  value = m_pcBitstream->readExpGolomb(totalLen);
 
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
   CodingStatistics::IncrementStatisticEP(symbolName, int(totalLen), value);
@@ -126,38 +101,13 @@ void  VLCReader::xReadSvlc( int& value, const char *symbolName )
 void  VLCReader::xReadSvlc( int& value, const char* )
 #endif
 {
-  uint32_t prefixBit = 0;
-  uint32_t suffix = 0;
-
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-  uint32_t totalLen=1;
-#endif
-
-  m_pcBitstream->read(1, prefixBit);
-
-  if (0 == prefixBit)
-  {
-    uint32_t length = 0;
-
-    while ( prefixBit == 0 )
-    {
-      m_pcBitstream->read(1, prefixBit);
-      length++;
-    }
+  uint32_t totalLen;
+  const uint32_t codeNum = m_pcBitstream->readExpGolomb(totalLen);
 
-    m_pcBitstream->read(length, suffix);
+  // codeNum 2k-1 maps to k, 2k to -k
+  const uint32_t suffix = codeNum ? codeNum + 1 : 0;
+  value = (suffix & 1) ? -(int) (suffix >> 1) : (int) (suffix >> 1);
 
-    suffix += (1 << length);
-    value = (suffix & 1) ? -(int) (suffix >> 1) : (int) (suffix >> 1);
-
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-    totalLen += length + length;
-#endif
-  }
-  else
-  {
-    value = 0;
-  }
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
   CodingStatistics::IncrementStatisticEP(symbolName, int(totalLen), suffix);
 #endif
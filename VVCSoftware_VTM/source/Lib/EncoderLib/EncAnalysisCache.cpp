@@ -0,0 +1,236 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2023, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     EncAnalysisCache.cpp
+    \brief    CU decision cache shared between encodes of the same source
+*/
+
+#include "EncAnalysisCache.h"
+#include "CommonLib/CodingStructure.h"
+#include "CommonLib/Picture.h"
+#include "CommonLib/UnitTools.h"
+
+//! \ingroup EncoderLib
+//! \{
+
+// ====================================================================================================================
+// Constructor / destructor / initialization / destroy
+// ====================================================================================================================
+
+const uint32_t EncAnalysisCache::m_magic    = 0x414d5456;   // "VTMA"
+const uint32_t EncAnalysisCache::m_version  = 1;
+const int      EncAnalysisCache::m_gridLog2 = MIN_CU_LOG2;
+
+static_assert( sizeof( AnalysisCu ) == 40, "AnalysisCu is stored unpadded in the analysis file" );
+
+EncAnalysisCache::EncAnalysisCache()
+  : m_saveFile(nullptr)
+  , m_width(0)
+  , m_height(0)
+  , m_ctuSize(0)
+  , m_reuseLevel(0)
+  , m_activePoc(-MAX_INT)
+  , m_activeCus(nullptr)
+{
+}
+
+EncAnalysisCache::~EncAnalysisCache()
+{
+  destroy();
+}
+
+void EncAnalysisCache::openSave(const std::string &filename, const int width, const int height, const int ctuSize)
+{
+  CHECK(m_saveFile != nullptr, "Analysis file already open");
+  m_saveFile = fopen(filename.c_str(), "wb");
+  CHECK(m_saveFile == nullptr, "Cannot create analysis file " << filename);
+
+  const uint32_t header[5] = { m_magic, m_version, uint32_t(width), uint32_t(height), uint32_t(ctuSize) };
+  fwrite(header, sizeof(header), 1, m_saveFile);
+}
+
+void EncAnalysisCache::load(const std::string &filename, const int width, const int height, const int ctuSize,
+                            const int reuseLevel)
+{
+  FILE *file = fopen(filename.c_str(), "rb");
+  CHECK(file == nullptr, "Cannot open analysis file " << filename);
+
+  uint32_t header[5];
+  CHECK(fread(header, sizeof(header), 1, file) != 1 || header[0] != m_magic, filename << " is not an analysis file");
+  CHECK(header[1] != m_version, "Unsupported analysis file version " << header[1]);
+  CHECK(header[2] != uint32_t(width) || header[3] != uint32_t(height),
+        "Analysis file was written for a " << header[2] << "x" << header[3] << " source");
+  CHECK(header[4] != uint32_t(ctuSize), "Analysis file was written with CTU size " << header[4]);
+
+  const uint32_t maxNumCus = (uint32_t(width) * uint32_t(height)) >> (2 * MIN_CU_LOG2);
+
+  int32_t  poc;
+  uint32_t numCus;
+  while (fread(&poc, sizeof(poc), 1, file) == 1)
+  {
+    CHECK(fread(&numCus, sizeof(numCus), 1, file) != 1, "Truncated analysis file");
+    CHECK(numCus > maxNumCus, "Invalid number of CUs (" << numCus << ") for POC " << poc << " in analysis file");
+    std::vector<AnalysisCu> &cus = m_pictures[poc];
+    cus.resize(numCus);
+    CHECK(numCus > 0 && fread(cus.data(), sizeof(AnalysisCu), numCus, file) != numCus, "Truncated analysis file");
+    for (const AnalysisCu &cu: cus)
+    {
+      CHECK(cu.x >= width || cu.y >= height || cu.width == 0 || cu.height == 0 || cu.width > ctuSize
+              || cu.height > ctuSize || cu.x + cu.width > width || cu.y + cu.height > height,
+            "Invalid CU " << cu.width << "x" << cu.height << " at (" << cu.x << "," << cu.y << ") for POC " << poc
+                          << " in analysis file");
+    }
+  }
+  fclose(file);
+
+  m_width      = width;
+  m_height     = height;
+  m_ctuSize    = ctuSize;
+  m_reuseLevel = reuseLevel;
+  msg(VERBOSE, "Loaded CU decisions of %d pictures from %s\n", (int) m_pictures.size(), filename.c_str());
+}
+
+void EncAnalysisCache::destroy()
+{
+  if (m_saveFile != nullptr)
+  {
+    fclose(m_saveFile);
+    m_saveFile = nullptr;
+  }
+  m_pictures.clear();
+  m_activeGrid.clear();
+  m_activeCus  = nullptr;
+  m_activePoc  = -MAX_INT;
+  m_reuseLevel = 0;
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+void EncAnalysisCache::storePicture(const CodingStructure &cs)
+{
+  std::vector<AnalysisCu> cus;
+  cus.reserve(cs.cus.size());
+
+  for (const CodingUnit *cu: cs.cus)
+  {
+    if (!isLuma(cu->chType) || !cu->Y().valid())
+    {
+      continue;
+    }
+    const PredictionUnit &pu = *cu->firstPU;
+
+    AnalysisCu entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.x        = uint16_t(cu->Y().x);
+    entry.y        = uint16_t(cu->Y().y);
+    entry.width    = uint16_t(cu->Y().width);
+    entry.height   = uint16_t(cu->Y().height);
+    entry.predMode = uint8_t(cu->predMode);
+    entry.skip     = cu->skip;
+    if (CU::isIntra(*cu))
+    {
+      entry.intraDir = uint8_t(pu.intraDir[ChannelType::LUMA]);
+      entry.mipFlag  = cu->mipFlag;
+    }
+    else if (CU::isInter(*cu))
+    {
+      entry.interDir = pu.interDir;
+      for (const auto l: { REF_PIC_LIST_0, REF_PIC_LIST_1 })
+      {
+        if (pu.interDir & (1 << l))
+        {
+          entry.refPoc[l] = cu->slice->getRefPic(l, pu.refIdx[l])->getPOC();
+          entry.mv[l][0]  = pu.mv[l].hor;
+          entry.mv[l][1]  = pu.mv[l].ver;
+        }
+      }
+    }
+    cus.push_back(entry);
+  }
+
+  const int32_t  poc    = cs.slice->getPOC();
+  const uint32_t numCus = uint32_t(cus.size());
+  fwrite(&poc, sizeof(poc), 1, m_saveFile);
+  fwrite(&numCus, sizeof(numCus), 1, m_saveFile);
+  fwrite(cus.data(), sizeof(AnalysisCu), numCus, m_saveFile);
+  fflush(m_saveFile);
+}
+
+void EncAnalysisCache::activatePicture(const int poc)
+{
+  if (m_activeCus != nullptr)
+  {
+    m_pictures.erase(m_activePoc);
+  }
+  m_activePoc = poc;
+  m_activeCus = nullptr;
+
+  auto it = m_pictures.find(poc);
+  if (it == m_pictures.end())
+  {
+    return;
+  }
+  m_activeCus = &it->second;
+
+  const int gridWidth  = (m_width + (1 << m_gridLog2) - 1) >> m_gridLog2;
+  const int gridHeight = (m_height + (1 << m_gridLog2) - 1) >> m_gridLog2;
+  m_activeGrid.assign(gridWidth * gridHeight, -1);
+
+  for (int i = 0; i < (int) m_activeCus->size(); i++)
+  {
+    const AnalysisCu &cu = (*m_activeCus)[i];
+    const int x0 = std::min<int>(gridWidth, cu.x >> m_gridLog2);
+    const int y0 = std::min<int>(gridHeight, cu.y >> m_gridLog2);
+    const int x1 = std::min<int>(gridWidth, (cu.x + cu.width) >> m_gridLog2);
+    const int y1 = std::min<int>(gridHeight, (cu.y + cu.height) >> m_gridLog2);
+    for (int y = y0; y < y1; y++)
+    {
+      std::fill(m_activeGrid.begin() + y * gridWidth + x0, m_activeGrid.begin() + y * gridWidth + x1, i);
+    }
+  }
+}
+
+const AnalysisCu *EncAnalysisCache::getCu(const int poc, const Position &pos) const
+{
+  if (poc != m_activePoc || m_activeCus == nullptr || pos.x >= m_width || pos.y >= m_height)
+  {
+    return nullptr;
+  }
+  const int gridWidth = (m_width + (1 << m_gridLog2) - 1) >> m_gridLog2;
+  const int idx       = m_activeGrid[(pos.y >> m_gridLog2) * gridWidth + (pos.x >> m_gridLog2)];
+  return idx < 0 ? nullptr : &(*m_activeCus)[idx];
+}
+
+//! \}
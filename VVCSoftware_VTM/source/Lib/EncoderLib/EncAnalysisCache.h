@@ -0,0 +1,121 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2023, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     EncAnalysisCache.h
+    \brief    CU decision cache shared between encodes of the same source (header)
+*/
+
+#ifndef __ENCANALYSISCACHE__
+#define __ENCANALYSISCACHE__
+
+#include "CommonLib/CommonDef.h"
+#include "CommonLib/Unit.h"
+
+#include <cstdio>
+#include <map>
+#include <vector>
+
+//! \ingroup EncoderLib
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// final decision of one luma coding unit as stored in the analysis file
+struct AnalysisCu
+{
+  uint16_t x;
+  uint16_t y;
+  uint16_t width;
+  uint16_t height;
+  uint8_t  predMode;     // PredMode of the CU
+  uint8_t  skip;
+  uint8_t  intraDir;     // luma intra mode (MIP mode index if mipFlag is set)
+  uint8_t  mipFlag;
+  uint8_t  interDir;     // 1: L0, 2: L1, 3: bi
+  uint8_t  reserved[3];
+  int32_t  refPoc[NUM_REF_PIC_LIST_01];
+  int32_t  mv[NUM_REF_PIC_LIST_01][2];   // internal precision
+};
+
+/// Writes the partitioning, prediction modes and motion of every encoded picture to a file, and serves the decisions
+/// loaded from such a file to the mode control and the motion search of another encode of the same source, e.g. at a
+/// different QP. The level of reuse trades encoding speed against RD fidelity:
+///   1: reference motion vectors are only added as motion search start candidates and reference luma intra modes
+///      are added to the modes tested with full RD
+///   2: in addition, partitions are restricted to the reference partitioning with a tolerance of one split level
+///   3: in addition, the reference partitioning is followed exactly and leaf CUs are restricted to the reference
+///      intra/inter decision
+class EncAnalysisCache
+{
+public:
+  EncAnalysisCache();
+  ~EncAnalysisCache();
+
+  void   openSave(const std::string &filename, const int width, const int height, const int ctuSize);
+  void   load(const std::string &filename, const int width, const int height, const int ctuSize, const int reuseLevel);
+  void   destroy();
+
+  bool   isSaving() const { return m_saveFile != nullptr; }
+  bool   isLoaded() const { return m_reuseLevel > 0; }
+  int    getReuseLevel() const { return m_reuseLevel; }
+
+  /// appends the final luma CU decisions of an encoded picture to the analysis file
+  void   storePicture(const CodingStructure &cs);
+  /// makes the loaded decisions of a picture available to getCu(), releasing those of the previous picture
+  void   activatePicture(const int poc);
+  /// loaded CU covering the given luma position of the active picture, nullptr if none
+  const AnalysisCu *getCu(const int poc, const Position &pos) const;
+
+private:
+  // Private static member variables
+  static const uint32_t m_magic;
+  static const uint32_t m_version;
+  static const int      m_gridLog2;
+
+  // Private member variables
+  FILE                                 *m_saveFile;
+  int                                   m_width;
+  int                                   m_height;
+  int                                   m_ctuSize;
+  int                                   m_reuseLevel;
+  std::map<int, std::vector<AnalysisCu>> m_pictures;
+  int                                   m_activePoc;
+  const std::vector<AnalysisCu>        *m_activeCus;
+  std::vector<int32_t>                  m_activeGrid;    // index of the CU covering each 4x4 block of the active picture
+}; // END CLASS DEFINITION EncAnalysisCache
+
+//! \}
+
+#endif // __ENCANALYSISCACHE__
@@ -176,6 +176,7 @@ protected:
   bool      m_printSequenceMSE;
   bool      m_printMSSSIM;
   bool      m_printWPSNR;
+  int       m_metricThreads;
   bool      m_printHighPrecEncTime = false;
   bool      m_cabacZeroWordPaddingEnabled;
 #if JVET_Z0120_SII_SEI_PROCESSING
@@ -409,6 +410,7 @@ protected:
   bool      m_useFastLCTU;
   bool      m_useFastMrg;
   int       m_maxMergeRdCandNumTotal;
+  int       m_subPelMECacheSize;
   int       m_mergeRdCandQuotaRegular;
   int       m_mergeRdCandQuotaRegularSmallBlk;
   int       m_mergeRdCandQuotaSubBlk;
@@ -424,6 +426,8 @@ protected:
   bool      m_MRL;
   bool      m_MIP;
   bool      m_useFastMIP;
+  int       m_intraSearchThreads;
+  int       m_numSplitThreads;
   int       m_fastLocalDualTreeMode;
   int       m_fastAdaptCostPredMode;
   bool      m_disableFastDecisionTT;
@@ -544,6 +548,11 @@ protected:
   bool      m_gopBasedTemporalFilterEnabled;
   bool      m_bimEnabled;
   std::map<int, int*> m_adaptQPmap;
+  int       m_lookaheadFrames;
+  double    m_lookaheadQpStrength;
+  std::string m_analysisSaveFile;                             ///< file receiving the CU decisions of this encode
+  std::string m_analysisLoadFile;                             ///< CU decisions of a previous encode of the same source
+  int       m_analysisReuseLevel;
   bool      m_noPicPartitionFlag;                             ///< no picture partitioning flag (single tile, single slice)
   bool      m_mixedLossyLossless;                             ///< enable mixed lossy/lossless coding
 
@@ -1250,6 +1259,9 @@ public:
   bool      getPrintWPSNR                   ()         const { return m_printWPSNR;               }
   void      setPrintWPSNR                   (bool value)     { m_printWPSNR = value;              }
 
+  int       getMetricThreads                ()         const { return m_metricThreads;             }
+  void      setMetricThreads                (int i)          { m_metricThreads = i;                }
+
   bool getPrintHighPrecEncTime() const { return m_printHighPrecEncTime; }
   void setPrintHightPrecEncTime(bool val) { m_printHighPrecEncTime = val; }
 
@@ -1584,6 +1596,8 @@ public:
   bool      getUseFastMerge                 () const         { return m_useFastMrg; }
   void      setMaxMergeRdCandNumTotal       ( int n )        { m_maxMergeRdCandNumTotal = n;}
   int       getMaxMergeRdCandNumTotal       () const         { return m_maxMergeRdCandNumTotal;}
+  void      setSubPelMECacheSize            ( int n )        { m_subPelMECacheSize = n; }
+  int       getSubPelMECacheSize            () const         { return m_subPelMECacheSize; }
   void      setMergeRdCandQuotaRegular      ( int n )        { m_mergeRdCandQuotaRegular = n;}
   int       getMergeRdCandQuotaRegular      () const         { return m_mergeRdCandQuotaRegular;}
   void      setMergeRdCandQuotaRegularSmallBlk( int n )      { m_mergeRdCandQuotaRegularSmallBlk = n;}
@@ -1615,6 +1629,10 @@ public:
   bool      getUseMIP                       () const         { return m_MIP; }
   void      setUseFastMIP                   ( bool b )       { m_useFastMIP = b; }
   bool      getUseFastMIP                   () const         { return m_useFastMIP; }
+  void      setIntraSearchThreads           ( int i )        { m_intraSearchThreads = i; }
+  int       getIntraSearchThreads           () const         { return m_intraSearchThreads; }
+  void      setNumSplitThreads              ( int i )        { m_numSplitThreads = i; }
+  int       getNumSplitThreads              () const         { return m_numSplitThreads; }
   void      setFastLocalDualTreeMode        ( int i )        { m_fastLocalDualTreeMode = i; }
   int       getFastLocalDualTreeMode        () const         { return m_fastLocalDualTreeMode; }
   void      setFastAdaptCostPredMode        (int i)          { m_fastAdaptCostPredMode = i; }
@@ -1623,6 +1641,7 @@ public:
   bool      getDisableFastDecisionTT        () const         { return m_disableFastDecisionTT; }
 
   void      setLog2MaxTbSize                ( uint32_t  u )   { m_log2MaxTbSize = u; }
+  uint32_t  getLog2MaxTbSize                () const          { return m_log2MaxTbSize; }
 
   //====== Loop/Deblock Filter ========
   void      setDeblockingFilterDisable      ( bool  b )      { m_deblockingFilterDisable           = b; }
@@ -1642,6 +1661,7 @@ public:
     m_searchRange = i;
   }
   void      setBipredSearchRange            ( int   i )      { m_bipredSearchRange = i; }
+  int       getBipredSearchRange            () const         { return m_bipredSearchRange; }
   void      setClipForBiPredMeEnabled       ( bool  b )      { m_bClipForBiPredMeEnabled = b; }
   void      setFastMEAssumingSmootherMVEnabled ( bool b )    { m_bFastMEAssumingSmootherMVEnabled = b; }
   void      setMinSearchWindow              ( int   i )      { m_minSearchWindow = i; }
@@ -1837,6 +1857,16 @@ public:
   void      setAdaptQPmap                   (std::map<int, int*> map) { m_adaptQPmap = map; }
   int*      getAdaptQPmap                   (int poc)                 { return m_adaptQPmap[poc]; }
   std::map<int, int*> *getAdaptQPmap        ()                        { return &m_adaptQPmap; }
+  void      setLookaheadFrames              (int i)                   { m_lookaheadFrames = i; }
+  int       getLookaheadFrames              () const                  { return m_lookaheadFrames; }
+  void      setLookaheadQpStrength          (double d)                { m_lookaheadQpStrength = d; }
+  double    getLookaheadQpStrength          () const                  { return m_lookaheadQpStrength; }
+  void      setAnalysisSaveFile             (const std::string &s)    { m_analysisSaveFile = s; }
+  const std::string& getAnalysisSaveFile    () const                  { return m_analysisSaveFile; }
+  void      setAnalysisLoadFile             (const std::string &s)    { m_analysisLoadFile = s; }
+  const std::string& getAnalysisLoadFile    () const                  { return m_analysisLoadFile; }
+  void      setAnalysisReuseLevel           (int i)                   { m_analysisReuseLevel = i; }
+  int       getAnalysisReuseLevel           () const                  { return m_analysisReuseLevel; }
 
   bool      getUseReconBasedCrossCPredictionEstimate ()                const { return m_reconBasedCrossCPredictionEstimate;  }
   void      setUseReconBasedCrossCPredictionEstimate (const bool value)      { m_reconBasedCrossCPredictionEstimate = value; }
@@ -54,6 +54,7 @@
 #include <stdio.h>
 #include <cmath>
 #include <algorithm>
+#include <mutex>
 
 //! \ingroup EncoderLib
 //! \{
@@ -69,7 +70,44 @@ const MergeIdxPair EncCu::m_geoModeTest[GEO_MAX_NUM_CANDS] = {
   MergeIdxPair{ 5, 0 }, MergeIdxPair{ 5, 1 }, MergeIdxPair{ 5, 2 }, MergeIdxPair{ 5, 3 }, MergeIdxPair{ 5, 4 }
 };
 
-EncCu::EncCu() {}
+// Root-level mode groups evaluated by the split jobs: the non-split modes and one group per split type
+static constexpr int NUM_SPLIT_JOBS = 6;
+
+static int getSplitJobGroup( const EncTestModeType type )
+{
+  switch( type )
+  {
+  case ETM_SPLIT_QT:   return 1;
+  case ETM_SPLIT_BT_H: return 2;
+  case ETM_SPLIT_BT_V: return 3;
+  case ETM_SPLIT_TT_H: return 4;
+  case ETM_SPLIT_TT_V: return 5;
+  default:             return 0;
+  }
+}
+
+// keeps the CU trace lines of concurrent split jobs from interleaving
+static std::mutex s_cuTraceMutex;
+// the local dual tree temporarily codes luma into the picture-level CS, which is shared by all split jobs
+static std::mutex s_localDualTreeMutex;
+
+// Independent search stack evaluating one group of root-level modes of a CTU
+struct EncCu::SplitJob
+{
+  EncCu            cuEnc;
+  IntraSearch      intraSearch;
+  InterSearch      interSearch;
+  TrQuant          trQuant;
+  RdCost           rdCost;
+  CABACEncoder     cabacEncoder;
+  CtxPool          ctxPool;
+  DeblockingFilter deblockingFilter;
+
+  CodingStructure *tempCS = nullptr;
+  CodingStructure *bestCS = nullptr;
+};
+
+EncCu::EncCu() : m_splitJobGroup( -1 ) {}
 
 void EncCu::create( EncCfg* encCfg )
 {
@@ -197,6 +235,13 @@ void EncCu::destroy()
   delete m_modeCtrl;
   m_modeCtrl = nullptr;
 
+  for( auto &job: m_splitJobs )
+  {
+    job->cuEnc.destroy();
+    job->deblockingFilter.destroy();
+  }
+  m_splitJobPool.reset();
+  m_splitJobs.clear();
 }
 
 EncCu::~EncCu()
@@ -218,6 +263,7 @@ void EncCu::init( EncLib* pcEncLib, const SPS& sps )
   m_pcRateCtrl         = pcEncLib->getRateCtrl();
   m_pcSliceEncoder     = pcEncLib->getSliceEncoder();
   m_deblockingFilter   = pcEncLib->getDeblockingFilter();
+  m_perfCounters       = pcEncLib->getPerfCounters();
   m_geoCostList.init(m_pcEncCfg->getMaxNumGeoCand());
   m_AFFBestSATDCost = MAX_DOUBLE;
 
@@ -225,6 +271,7 @@ void EncCu::init( EncLib* pcEncLib, const SPS& sps )
 
   m_modeCtrl->init( m_pcEncCfg, m_pcRateCtrl, m_pcRdCost );
   m_modeCtrl->setBIMQPMap( m_pcEncCfg->getAdaptQPmap() );
+  m_modeCtrl->setAnalysisCache( pcEncLib->getAnalysisCache() );
 
   m_pcInterSearch->setModeCtrl( m_modeCtrl );
   m_modeCtrl->setInterSearch(m_pcInterSearch);
@@ -232,6 +279,115 @@ void EncCu::init( EncLib* pcEncLib, const SPS& sps )
 
   m_pcGOPEncoder = pcEncLib->getGOPEncoder();
   m_pcGOPEncoder->setModeCtrl( m_modeCtrl );
+
+  if( m_pcEncCfg->getNumSplitThreads() > 1 && m_splitJobs.empty() )
+  {
+    xInitSplitJobs( pcEncLib, sps );
+  }
+}
+
+void EncCu::xInitSplitJobs( EncLib* pcEncLib, const SPS& sps )
+{
+  const int maxLog2TrDynamicRange[MAX_NUM_CHANNEL_TYPE] = { sps.getMaxLog2TrDynamicRange(ChannelType::LUMA),
+                                                            sps.getMaxLog2TrDynamicRange(ChannelType::CHROMA) };
+  const unsigned maxCUWidth      = m_pcEncCfg->getMaxCUWidth();
+  const unsigned maxCUHeight     = m_pcEncCfg->getMaxCUHeight();
+  const unsigned maxTotalCUDepth = floorLog2( maxCUWidth ) - m_pcEncCfg->getLog2MinCodingBlockSize();
+
+  for( int jobIdx = 0; jobIdx < NUM_SPLIT_JOBS; jobIdx++ )
+  {
+    m_splitJobs.emplace_back( new SplitJob );
+    SplitJob &job = *m_splitJobs.back();
+
+    job.cuEnc.create( m_pcEncCfg );
+
+    job.trQuant.init( nullptr, 1 << m_pcEncCfg->getLog2MaxTbSize(), m_pcEncCfg->getUseRDOQ(), m_pcEncCfg->getUseRDOQTS(),
+                      m_pcEncCfg->getUseSelectiveRDOQ(), true );
+    job.trQuant.getQuant()->setFlatScalingList( maxLog2TrDynamicRange, sps.getBitDepths() );
+    job.trQuant.getQuant()->setUseScalingList( false );
+
+    CABACWriter* cabacEstimator = job.cabacEncoder.getCABACEstimator( &sps );
+    job.intraSearch.init( m_pcEncCfg, &job.trQuant, &job.rdCost, cabacEstimator, &job.ctxPool, maxCUWidth, maxCUHeight,
+                          maxTotalCUDepth, pcEncLib->getReshaper(), sps.getBitDepth( ChannelType::LUMA ) );
+    job.interSearch.init( m_pcEncCfg, &job.trQuant, m_pcEncCfg->getSearchRange(), m_pcEncCfg->getBipredSearchRange(),
+                          m_pcEncCfg->getMotionEstimationSearchMethod(), m_pcEncCfg->getUseCompositeRef(), maxCUWidth,
+                          maxCUHeight, maxTotalCUDepth, &job.rdCost, cabacEstimator, &job.ctxPool, pcEncLib->getReshaper() );
+
+    job.trQuant.    setPerfCounters( m_perfCounters );
+    job.intraSearch.setPerfCounters( m_perfCounters );
+    job.interSearch.setPerfCounters( m_perfCounters );
+    job.interSearch.setTempBuffers( job.intraSearch.getSplitCSBuf(), job.intraSearch.getFullCSBuf(), job.intraSearch.getSaveCSBuf() );
+
+    job.deblockingFilter.create( floorLog2( maxCUWidth ) - MIN_CU_LOG2 );
+    if( !m_pcEncCfg->getDeblockingFilterDisable() && m_pcEncCfg->getUseEncDbOpt() )
+    {
+      job.deblockingFilter.initEncPicYuvBuffer( m_pcEncCfg->getChromaFormatIdc(),
+                                                Size( m_pcEncCfg->getSourceWidth(), m_pcEncCfg->getSourceHeight() ), maxCUWidth );
+    }
+
+    // same links as in init(), but to the job's own search stack
+    EncCu &cuEnc = job.cuEnc;
+    cuEnc.m_pcEncCfg         = m_pcEncCfg;
+    cuEnc.m_pcIntraSearch    = &job.intraSearch;
+    cuEnc.m_pcInterSearch    = &job.interSearch;
+    cuEnc.m_pcTrQuant        = &job.trQuant;
+    cuEnc.m_pcRdCost         = &job.rdCost;
+    cuEnc.m_CABACEstimator   = cabacEstimator;
+    cuEnc.m_CABACEstimator->setEncCu( &cuEnc );
+    cuEnc.m_ctxPool          = &job.ctxPool;
+    cuEnc.m_pcRateCtrl       = m_pcRateCtrl;
+    cuEnc.m_pcSliceEncoder   = m_pcSliceEncoder;
+    cuEnc.m_deblockingFilter = &job.deblockingFilter;
+    cuEnc.m_perfCounters     = m_perfCounters;
+    cuEnc.m_pcGOPEncoder     = m_pcGOPEncoder;
+    cuEnc.m_geoCostList.init( m_pcEncCfg->getMaxNumGeoCand() );
+    cuEnc.m_AFFBestSATDCost  = MAX_DOUBLE;
+    cuEnc.m_splitJobGroup    = jobIdx;
+
+    cuEnc.DecCu::init( &job.trQuant, &job.intraSearch, &job.interSearch );
+
+    cuEnc.m_modeCtrl->init( m_pcEncCfg, m_pcRateCtrl, &job.rdCost );
+    cuEnc.m_modeCtrl->setBIMQPMap( m_pcEncCfg->getAdaptQPmap() );
+    cuEnc.m_modeCtrl->setAnalysisCache( pcEncLib->getAnalysisCache() );
+
+    job.interSearch.setModeCtrl( cuEnc.m_modeCtrl );
+    cuEnc.m_modeCtrl->setInterSearch( &job.interSearch );
+    job.intraSearch.setModeCtrl( cuEnc.m_modeCtrl );
+  }
+
+  m_splitJobPool.reset( new ThreadPool( m_pcEncCfg->getNumSplitThreads() ) );
+}
+
+void EncCu::initSplitJobsSlice( const Picture* pic )
+{
+  for( auto &job: m_splitJobs )
+  {
+    job->interSearch.resetAffineMVList();
+    job->interSearch.resetUniMvList();
+    job->interSearch.resetSubPelCache( pic );
+    job->interSearch.resetReusedUniMvs();
+  }
+}
+
+bool EncCu::xUseSplitJobs( const CodingStructure& cs ) const
+{
+  if( m_splitJobs.empty() )
+  {
+    return false;
+  }
+
+  // tools whose encoder state is shared between the root-level hypotheses are only searched sequentially
+  const SPS&   sps   = *cs.sps;
+  const PPS&   pps   = *cs.pps;
+  const Slice& slice = *cs.slice;
+
+  return !pps.getUseDQP() && !slice.getUseChromaQpAdj() && !sps.getIBCFlag() && !sps.getPLTMode()
+         && !sps.getUseColorTrans() && !sps.getScalingListFlag()
+         && !sps.getSpsRangeExtension().getTSRCRicePresentFlag()
+         && !sps.getSpsRangeExtension().getPersistentRiceAdaptationEnabledFlag()
+         && !m_pcEncCfg->getBIM() && !m_pcEncCfg->getLumaLevelToDeltaQPMapping().isEnabled()
+         && !m_pcEncCfg->getSmoothQPReductionEnable() && !m_pcEncCfg->getMCTSEncConstraint()
+         && !(m_pcEncCfg->getLookaheadFrames() > 0 && m_pcEncCfg->getLookaheadQpStrength() > 0);
 }
 
 // ====================================================================================================================
@@ -241,6 +397,7 @@ void EncCu::init( EncLib* pcEncLib, const SPS& sps )
 void EncCu::compressCtu(CodingStructure &cs, const UnitArea &area, const unsigned ctuRsAddr,
                         const EnumArray<int, ChannelType> &prevQP, const EnumArray<int, ChannelType> &currQP)
 {
+  PerfTimer timer(m_perfCounters, PerfStage::MODE_DECISION);
   m_modeCtrl->initCTUEncoding( *cs.slice );
   cs.treeType = TREE_D;
 
@@ -276,6 +433,8 @@ void EncCu::compressCtu(CodingStructure &cs, const UnitArea &area, const unsigne
   // init current context pointer
   m_CurrCtx = m_ctxBuffer.data();
 
+  const bool useSplitJobs = xUseSplitJobs( cs );
+
   CodingStructure *tempCS = m_pTempCS[gp_sizeIdxInfo->idxFrom( area.lumaSize().width )][gp_sizeIdxInfo->idxFrom( area.lumaSize().height )];
   CodingStructure *bestCS = m_pBestCS[gp_sizeIdxInfo->idxFrom( area.lumaSize().width )][gp_sizeIdxInfo->idxFrom( area.lumaSize().height )];
 
@@ -285,13 +444,25 @@ void EncCu::compressCtu(CodingStructure &cs, const UnitArea &area, const unsigne
     currQP[ChannelType::LUMA];
   tempCS->prevQP[ChannelType::LUMA] = bestCS->prevQP[ChannelType::LUMA] = prevQP[ChannelType::LUMA];
 
-  xCompressCU(tempCS, bestCS, partitioner);
+  int splitJobId = 0;
+  if( useSplitJobs )
+  {
+    splitJobId = xCompressCUParallel( tempCS, bestCS, partitioner );
+  }
+  else
+  {
+    xCompressCU( tempCS, bestCS, partitioner );
+  }
   cs.slice->m_mapPltCost[0].clear();
   cs.slice->m_mapPltCost[1].clear();
   // all signals were already copied during compression if the CTU was split - at this point only the structures are copied to the top level CS
   const bool copyUnsplitCTUSignals = bestCS->cus.size() == 1;
   cs.useSubStructure(*bestCS, partitioner.chType, CS::getArea(*bestCS, area, partitioner.chType), copyUnsplitCTUSignals,
                      false, false, copyUnsplitCTUSignals, true);
+  if( useSplitJobs )
+  {
+    cs.picture->finishSplitJob( splitJobId, clipArea( CS::getArea( *bestCS, area, partitioner.chType ), *cs.picture ) );
+  }
 
   if (CS::isDualITree (cs) && isChromaEnabled (cs.pcv->chrFormat))
   {
@@ -305,11 +476,27 @@ void EncCu::compressCtu(CodingStructure &cs, const UnitArea &area, const unsigne
       currQP[ChannelType::CHROMA];
     tempCS->prevQP[ChannelType::CHROMA] = bestCS->prevQP[ChannelType::CHROMA] = prevQP[ChannelType::CHROMA];
 
-    xCompressCU(tempCS, bestCS, partitioner);
+    if( useSplitJobs )
+    {
+      splitJobId = xCompressCUParallel( tempCS, bestCS, partitioner );
+    }
+    else
+    {
+      xCompressCU( tempCS, bestCS, partitioner );
+    }
 
     const bool copyUnsplitCTUSignals = bestCS->cus.size() == 1;
     cs.useSubStructure(*bestCS, partitioner.chType, CS::getArea(*bestCS, area, partitioner.chType),
                        copyUnsplitCTUSignals, false, false, copyUnsplitCTUSignals, true);
+    if( useSplitJobs )
+    {
+      cs.picture->finishSplitJob( splitJobId, clipArea( CS::getArea( *bestCS, area, partitioner.chType ), *cs.picture ) );
+    }
+  }
+  if( !useSplitJobs && cs.picture->getNumSplitJobs() > 0 )
+  {
+    // keep the job reconstructions in sync for CTUs searched sequentially
+    cs.picture->finishSplitJob( 0, clipArea( area, *cs.picture ) );
   }
 
   if (m_pcEncCfg->getUseRateCtrl())
@@ -328,6 +515,114 @@ void EncCu::compressCtu(CodingStructure &cs, const UnitArea &area, const unsigne
   CHECK( bestCS->cost             == MAX_DOUBLE                , "No possible encoding found3" );
 }
 
+/** Evaluate the root-level mode groups of a CTU concurrently, one group per split job.
+ *  Each job searches on its own encoder stack and reconstruction buffers; returns the (1-based) id of the winning job
+ *  whose best CS is handed back in bestCS.
+ */
+int EncCu::xCompressCUParallel( CodingStructure*& tempCS, CodingStructure*& bestCS, Partitioner& partitioner )
+{
+  CodingStructure  &cs      = *tempCS->parent;
+  Picture          &picture = *cs.picture;
+  const Slice      &slice   = *cs.slice;
+  const UnitArea   &area    = partitioner.currArea();
+  const ChannelType chType  = partitioner.chType;
+  const unsigned    wIdx    = gp_sizeIdxInfo->idxFrom( area.lumaSize().width );
+  const unsigned    hIdx    = gp_sizeIdxInfo->idxFrom( area.lumaSize().height );
+  const int         numJobs = (int) m_splitJobs.size();
+
+  m_CurrCtx->start = m_CABACEstimator->getCtx();
+
+  if( picture.getNumSplitJobs() != numJobs )
+  {
+    picture.createSplitJobBuffers( numJobs, m_pcEncCfg->getMaxCUWidth() );
+  }
+
+  // the local dual tree codes luma into the picture-level CS from within a job: keep its unit lists from
+  // reallocating while the other jobs read their neighbours from it
+  cs.cus.reserve( cs.cus.size() + MAX_NUM_PARTS_IN_CTU );
+  cs.pus.reserve( cs.pus.size() + MAX_NUM_PARTS_IN_CTU );
+  cs.tus.reserve( cs.tus.size() + MAX_NUM_PARTS_IN_CTU );
+
+  double lambdas[MAX_NUM_COMPONENT];
+  m_pcTrQuant->getLambdas( lambdas );
+
+  // tempCS may alias a job CS of the previous pass, which is re-initialized below
+  const int currQP = tempCS->currQP[chType];
+  const int prevQP = tempCS->prevQP[chType];
+  const int baseQP = tempCS->baseQP;
+
+  for( auto &job: m_splitJobs )
+  {
+    EncCu &cuEnc = job->cuEnc;
+
+    job->rdCost = *m_pcRdCost;
+    job->trQuant.setLambdas( lambdas );
+    job->trQuant.setLambda( m_pcTrQuant->getLambda() );
+    job->interSearch.copySliceSearchSettings( *m_pcInterSearch );
+    if( slice.getSPS()->getUseLmcs() )
+    {
+      cuEnc.initDecCuReshaper( m_pcReshape, slice.getSPS()->getChromaFormatIdc() );
+    }
+
+    cuEnc.m_modeCtrl->setFastDeltaQp( m_modeCtrl->getFastDeltaQp() );
+    cuEnc.m_modeCtrl->setPltEnc( m_modeCtrl->getPltEnc() );
+    cuEnc.m_modeCtrl->setUseHashME( m_modeCtrl->getUseHashME() );
+    if( isLuma( chType ) )
+    {
+      cuEnc.m_modeCtrl->initCTUEncoding( slice );
+    }
+
+    cuEnc.m_CABACEstimator->initCtxModels( slice );
+    cuEnc.m_CABACEstimator->getCtx() = m_CABACEstimator->getCtx();
+    cuEnc.m_CurrCtx = cuEnc.m_ctxBuffer.data();
+
+    job->tempCS = cuEnc.m_pTempCS[wIdx][hIdx];
+    job->bestCS = cuEnc.m_pBestCS[wIdx][hIdx];
+    cs.initSubStructure( *job->tempCS, chType, area, false );
+    cs.initSubStructure( *job->bestCS, chType, area, false );
+    job->tempCS->currQP[chType] = job->bestCS->currQP[chType] = currQP;
+    job->tempCS->prevQP[chType] = job->bestCS->prevQP[chType] = prevQP;
+    job->tempCS->baseQP = job->bestCS->baseQP = baseQP;
+  }
+
+  m_splitJobPool->parallelFor( numJobs, [&]( int, int jobIdx )
+  {
+    SplitJob &job = *m_splitJobs[jobIdx];
+
+    QTBTPartitioner jobPartitioner;
+    jobPartitioner.initCtu( area, chType, slice );
+
+    Picture::setSplitJobId( jobIdx + 1 );
+    job.cuEnc.xCompressCU( job.tempCS, job.bestCS, jobPartitioner );
+    Picture::setSplitJobId( 0 );
+    job.cuEnc.m_CurrCtx = nullptr;
+  } );
+
+  // pick the best hypothesis, on equal cost the one the sequential search would have tested first
+  int    bestJobIdx = -1;
+  double bestCost   = MAX_DOUBLE;
+  for( int jobIdx = 0; jobIdx < numJobs; jobIdx++ )
+  {
+    const CodingStructure &jobBestCS = *m_splitJobs[jobIdx]->bestCS;
+    if( jobBestCS.cus.empty() || jobBestCS.cost == MAX_DOUBLE )
+    {
+      continue;
+    }
+    const double cost = jobBestCS.cost + ( jobBestCS.useDbCost ? jobBestCS.costDbOffset : 0 );
+    if( cost < bestCost )
+    {
+      bestCost   = cost;
+      bestJobIdx = jobIdx;
+    }
+  }
+  CHECK( bestJobIdx < 0, "No possible encoding found" );
+
+  bestCS = m_splitJobs[bestJobIdx]->bestCS;
+  tempCS = m_splitJobs[bestJobIdx]->tempCS;
+
+  return bestJobIdx + 1;
+}
+
 // ====================================================================================================================
 // Protected member functions
 // ====================================================================================================================
@@ -603,6 +898,8 @@ bool isChildrenAffineCompatible_BAK(CodingStructure*& cs, EncTestModeType type){
 
 void EncCu::xCompressCU( CodingStructure*& tempCS, CodingStructure*& bestCS, Partitioner& partitioner, double maxCostAllowed )
 {
+  m_perfCounters->increment(PerfCount::CU);
+
   CHECK(maxCostAllowed < 0, "Wrong value of maxCostAllowed!");
 
   uint32_t compBegin;
@@ -665,6 +962,8 @@ void EncCu::xCompressCU( CodingStructure*& tempCS, CodingStructure*& bestCS, Par
 
 
   
+  std::unique_lock<std::mutex> traceLock( s_cuTraceMutex );
+
   // Print POC, XY position, dimensions
   printf("POC=%d,%d,%d,%d,%d,", tempCS->picture->poc, tempCS->area.lx(), tempCS->area.ly(), tempCS->area.lwidth(), tempCS->area.lheight());
 
@@ -692,6 +991,7 @@ void EncCu::xCompressCU( CodingStructure*& tempCS, CodingStructure*& bestCS, Par
   }
   //*/
   cout << endl;    
+  traceLock.unlock();
     
 
 #if GDR_ENABLED
@@ -864,6 +1164,12 @@ void EncCu::xCompressCU( CodingStructure*& tempCS, CodingStructure*& bestCS, Par
     EncTestMode currTestMode = m_modeCtrl->currTestMode();
     currTestMode.maxCostAllowed = maxCostAllowed;
 
+    if( m_splitJobGroup >= 0 && partitioner.currDepth == 0 && getSplitJobGroup( currTestMode.type ) != m_splitJobGroup )
+    {
+      // root-level mode evaluated by another split job
+      continue;
+    }
+
     if (pps.getUseDQP() && partitioner.isSepTree(*tempCS) && isChroma( partitioner.chType ))
     {
       const Position chromaCentral(tempCS->area.Cb().chromaPos().offset(tempCS->area.Cb().chromaSize().width >> 1, tempCS->area.Cb().chromaSize().height >> 1));
@@ -884,6 +1190,7 @@ void EncCu::xCompressCU( CodingStructure*& tempCS, CodingStructure*& bestCS, Par
         (m_pcEncCfg->getLumaLevelToDeltaQPMapping().isEnabled()) ||
 #endif
         (m_pcEncCfg->getSmoothQPReductionEnable()) ||
+        (m_pcEncCfg->getLookaheadFrames() > 0 && m_pcEncCfg->getLookaheadQpStrength() > 0 && !m_pcEncCfg->getUseRateCtrl()) ||
 #if ENABLE_QPA_SUB_CTU
         (m_pcEncCfg->getUsePerceptQPA() && !m_pcEncCfg->getUseRateCtrl() && pps.getUseDQP())
 #else
@@ -1512,6 +1819,11 @@ void EncCu::xCheckModeSplit(CodingStructure *&tempCS, CodingStructure *&bestCS,
       }
     }
     assert( tempCS->treeType == TREE_L );
+    std::unique_lock<std::mutex> localDualTreeLock( s_localDualTreeMutex, std::defer_lock );
+    if( m_splitJobGroup >= 0 )
+    {
+      localDualTreeLock.lock();
+    }
     uint32_t numCuPuTu[6];
     tempCS->picture->cs->getNumCuPuTuOffset( numCuPuTu );
     tempCS->picture->cs->useSubStructure( *tempCS, partitioner.chType, CS::getArea( *tempCS, partitioner.currArea(), partitioner.chType ), false, true, false, false, false );
@@ -1663,6 +1975,7 @@ void EncCu::xCheckModeSplit(CodingStructure *&tempCS, CodingStructure *&bestCS,
 
 bool EncCu::xCheckRDCostIntra(CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &partitioner, const EncTestMode& encTestMode, bool adaptiveColorTrans)
 {
+  m_perfCounters->increment(PerfCount::INTRA);
   double          bestInterCost             = m_modeCtrl->getBestInterCost();
   double          costSize2Nx2NmtsFirstPass = m_modeCtrl->getMtsSize2Nx2NFirstPassCost();
   bool            skipSecondMtsPass         = m_modeCtrl->getSkipSecondMTSPass();
@@ -2051,6 +2364,7 @@ bool EncCu::xCheckRDCostIntra(CodingStructure *&tempCS, CodingStructure *&bestCS
 
 void EncCu::xCheckPLT(CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &partitioner, const EncTestMode& encTestMode)
 {
+  m_perfCounters->increment(PerfCount::PALETTE);
   if (((partitioner.currArea().lumaSize().width * partitioner.currArea().lumaSize().height <= 16) && (isLuma(partitioner.chType)) )
         || ((partitioner.currArea().chromaSize().width * partitioner.currArea().chromaSize().height <= 16) && (!isLuma(partitioner.chType)) && partitioner.isSepTree(*tempCS) )
       || (partitioner.isLocalSepTree(*tempCS)  && (!isLuma(partitioner.chType))  )  )
@@ -2276,6 +2590,7 @@ void EncCu::xCheckChromaQPOffset( CodingStructure& cs, Partitioner& partitioner
 
 void EncCu::xCheckRDCostHashInter( CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &partitioner, const EncTestMode& encTestMode )
 {
+  m_perfCounters->increment(PerfCount::INTER);
   bool isPerfectMatch = false;
 
   tempCS->initStructData(encTestMode.qp);
@@ -2325,6 +2640,7 @@ int getDmvrMvdNum(const PredictionUnit& pu)
 
 void EncCu::xCheckRDCostUnifiedMerge(CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &partitioner, const EncTestMode& encTestMode)
 {
+  m_perfCounters->increment(PerfCount::MERGE);
   const Slice &slice = *tempCS->slice;
 
   CHECK(slice.getSliceType() == I_SLICE, "Merge modes not available for I-slices");
@@ -2613,6 +2929,7 @@ void EncCu::xCheckRDCostUnifiedMerge(CodingStructure *&tempCS, CodingStructure *
 // ibc merge/skip mode check
 void EncCu::xCheckRDCostIBCModeMerge2Nx2N(CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &partitioner, const EncTestMode& encTestMode)
 {
+  m_perfCounters->increment(PerfCount::IBC);
   CHECK(partitioner.chType == ChannelType::CHROMA, "chroma IBC is derived");
 
   // don't use IBC for large CUs
@@ -2717,8 +3034,7 @@ void EncCu::xCheckRDCostIBCModeMerge2Nx2N(CodingStructure *&tempCS, CodingStruct
       const CompArea &area = cu.blocks[COMPONENT_Y];
       CompArea        tmpArea(COMPONENT_Y, area.chromaFormat, Position(0, 0), area.size());
       PelBuf          tmpLuma = m_tmpStorageCtu->getBuf(tmpArea);
-      tmpLuma.copyFrom(tempCS->getOrgBuf().Y());
-      tmpLuma.rspSignal(m_pcReshape->getFwdLUT());
+      tmpLuma.rspSignal(tempCS->getOrgBuf().Y(), m_pcReshape->getFwdPwl());
       m_pcRdCost->setDistParam(distParam, tmpLuma, refBuf, sps.getBitDepth(ChannelType::LUMA), COMPONENT_Y,
                                bUseHadamard);
     }
@@ -3012,10 +3328,13 @@ void EncCu::generateMergePrediction(const UnitArea& unitArea, MergeItem* mergeIt
     CHECK(predBuf1 == nullptr, "Invalid input buffer to CIIP");
     if (luma)
     {
-      dstBuf.Y().copyFrom(predBuf1->Y());
       if (pu.cs->slice->getLmcsEnabledFlag() && m_pcReshape->getCTUFlag())
       {
-        dstBuf.Y().rspSignal(m_pcReshape->getFwdLUT());
+        dstBuf.Y().rspSignal(predBuf1->Y(), m_pcReshape->getFwdPwl());
+      }
+      else
+      {
+        dstBuf.Y().copyFrom(predBuf1->Y());
       }
       m_pcIntraSearch->geneWeightedPred(dstBuf.Y(), pu, m_pcIntraSearch->getPredictorPtr2(COMPONENT_Y, 0));
     }
@@ -3230,7 +3549,7 @@ void EncCu::addCiipCandsToPruningList(const MergeCtx& mergeCtx, const UnitArea&
       // distortion is calculated in the original domain
       PelUnitBuf* tmp = m_pelUnitBufPool.getPelUnitBuf(localUnitArea);
       tmp->copyFrom(dstBuf, true, false);
-      tmp->Y().rspSignal(m_pcReshape->getInvLUT());
+      tmp->Y().rspSignal(m_pcReshape->getInvPwl());
       ciipMerge->cost = calcLumaCost4MergePrediction(ctxStart, *tmp, sqrtLambdaForFirstPassIntra, *pu, distParam);
       m_pelUnitBufPool.giveBack(tmp);
     }
@@ -3430,6 +3749,13 @@ bool EncCu::prepareGpmComboList(const MergeCtx& mergeCtx, const UnitArea& localU
   const int wIdx = floorLog2(pu->lwidth()) - GEO_MIN_CU_LOG2;
   const int hIdx = floorLog2(pu->lheight()) - GEO_MIN_CU_LOG2;
 
+  const Pel *candBufs[GEO_MAX_NUM_UNI_CANDS];
+  for (uint8_t mergeCand = 0; mergeCand < maxNumMergeCandidates; mergeCand++)
+  {
+    CHECK(geoTempBuf[mergeCand]->Y().stride != geoTempBuf[0]->Y().stride, "GPM candidates must share the stride");
+    candBufs[mergeCand] = geoTempBuf[mergeCand]->Y().buf;
+  }
+
   for (int splitDir = 0; splitDir < GEO_NUM_PARTITION_MODE; splitDir++)
   {
     int maskStride = 0, maskStride2 = 0;
@@ -3463,12 +3789,16 @@ bool EncCu::prepareGpmComboList(const MergeCtx& mergeCtx, const UnitArea& localU
         + g_weightOffset[splitDir][hIdx][wIdx][0]];
     }
 
+    // all candidates share the mask of the split direction
+    m_pcRdCost->setDistParam(distParam, pu->cs->getOrgBuf().Y(), geoTempBuf[0]->Y().buf, geoTempBuf[0]->Y().stride,
+                             sadMask, maskStride, stepX, maskStride2, pu->cs->sps->getBitDepth(ChannelType::LUMA),
+                             COMPONENT_Y);
+    Distortion sadMasked[GEO_MAX_NUM_UNI_CANDS];
+    m_pcRdCost->getSADwMaskMulti(distParam, candBufs, maxNumMergeCandidates, sadMasked);
+
     for (uint8_t mergeCand = 0; mergeCand < maxNumMergeCandidates; mergeCand++)
     {
-      m_pcRdCost->setDistParam(distParam, pu->cs->getOrgBuf().Y(), geoTempBuf[mergeCand]->Y().buf,
-        geoTempBuf[mergeCand]->Y().stride, sadMask, maskStride, stepX, maskStride2,
-        pu->cs->sps->getBitDepth(ChannelType::LUMA), COMPONENT_Y);
-      const Distortion sadLarge = distParam.distFunc(distParam);
+      const Distortion sadLarge = sadMasked[mergeCand];
       const Distortion sadSmall = sadWholeBlk[mergeCand] - sadLarge;
 
       const int bitsCand = mergeCand + 1;
@@ -3522,6 +3852,7 @@ bool EncCu::prepareGpmComboList(const MergeCtx& mergeCtx, const UnitArea& localU
 
 void EncCu::xCheckRDCostIBCMode(CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &partitioner, const EncTestMode& encTestMode)
 {
+  m_perfCounters->increment(PerfCount::IBC);
   if (tempCS->area.lwidth() > IBC_MAX_CU_SIZE || tempCS->area.lheight() > IBC_MAX_CU_SIZE)
   {
     // disable IBC mode larger than 64x64
@@ -3610,6 +3941,7 @@ void EncCu::xCheckRDCostIBCMode(CodingStructure *&tempCS, CodingStructure *&best
 
 void EncCu::xCheckRDCostInter( CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &partitioner, const EncTestMode& encTestMode )
 {
+  m_perfCounters->increment(PerfCount::INTER);
   m_pcInterSearch->setAffineModeSelected(false);
 
   m_pcInterSearch->resetBufferedUniMotions();
@@ -3787,6 +4119,7 @@ void EncCu::xCheckRDCostInter( CodingStructure *&tempCS, CodingStructure *&bestC
 bool EncCu::xCheckRDCostInterAmvr(CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &partitioner,
                                   const EncTestMode &encTestMode, double &bestIntPelCost)
 {
+  m_perfCounters->increment(PerfCount::INTER);
   const auto amvrSearchMode = encTestMode.getAmvrSearchMode();
   m_pcInterSearch->setAffineModeSelected(false);
   // Only Half-Pel, int-Pel, 4-Pel and fast 4-Pel allowed
@@ -4100,7 +4433,7 @@ void EncCu::xCalDebCost( CodingStructure &cs, Partitioner &partitioner, bool cal
       picDbBuf.getBuf( curCompArea ).copyFrom( cs.getRecoBuf( curCompArea ) );
       if (cs.slice->getLmcsEnabledFlag() && m_pcReshape->getSliceReshaperInfo().getUseSliceReshaper() && isLuma(compId))
       {
-        picDbBuf.getBuf( curCompArea ).rspSignal( m_pcReshape->getInvLUT() );
+        picDbBuf.getBuf( curCompArea ).rspSignal( m_pcReshape->getInvPwl() );
       }
 
       //left neighbour
@@ -4110,7 +4443,7 @@ void EncCu::xCalDebCost( CodingStructure &cs, Partitioner &partitioner, bool cal
         picDbBuf.getBuf( compArea ).copyFrom( cs.picture->getRecoBuf( compArea ) );
         if (cs.slice->getLmcsEnabledFlag() && m_pcReshape->getSliceReshaperInfo().getUseSliceReshaper() && isLuma(compId))
         {
-          picDbBuf.getBuf( compArea ).rspSignal( m_pcReshape->getInvLUT() );
+          picDbBuf.getBuf( compArea ).rspSignal( m_pcReshape->getInvPwl() );
         }
       }
       //top neighbour
@@ -4120,7 +4453,7 @@ void EncCu::xCalDebCost( CodingStructure &cs, Partitioner &partitioner, bool cal
         picDbBuf.getBuf( compArea ).copyFrom( cs.picture->getRecoBuf( compArea ) );
         if (cs.slice->getLmcsEnabledFlag() && m_pcReshape->getSliceReshaperInfo().getUseSliceReshaper() && isLuma(compId))
         {
-          picDbBuf.getBuf( compArea ).rspSignal( m_pcReshape->getInvLUT() );
+          picDbBuf.getBuf( compArea ).rspSignal( m_pcReshape->getInvPwl() );
         }
       }
     }
@@ -4197,7 +4530,7 @@ Distortion EncCu::getDistortionDb( CodingStructure &cs, CPelBuf org, CPelBuf rec
       CompArea tmpArea(COMPONENT_Y, cs.area.chromaFormat, Position(0, 0), compArea.size());
       PelBuf   tmpRecLuma = m_tmpStorageCtu->getBuf(tmpArea);
       tmpRecLuma.copyFrom( reco );
-      tmpRecLuma.rspSignal( m_pcReshape->getInvLUT() );
+      tmpRecLuma.rspSignal( m_pcReshape->getInvPwl() );
       dist += m_pcRdCost->getDistPart(org, tmpRecLuma, cs.sps->getBitDepth(toChannelType(compID)), compID,
                                       DFunc::SSE_WTD, &orgLuma);
     }
@@ -4214,7 +4547,7 @@ Distortion EncCu::getDistortionDb( CodingStructure &cs, CPelBuf org, CPelBuf rec
       CompArea tmpArea(COMPONENT_Y, cs.area.chromaFormat, Position(0, 0), compArea.size());
       PelBuf   tmpRecLuma = m_tmpStorageCtu->getBuf(tmpArea);
       tmpRecLuma.copyFrom( reco );
-      tmpRecLuma.rspSignal( m_pcReshape->getFwdLUT() );
+      tmpRecLuma.rspSignal( m_pcReshape->getFwdPwl() );
       dist += m_pcRdCost->getDistPart(org, tmpRecLuma, cs.sps->getBitDepth(toChannelType(compID)), compID, DFunc::SSE);
     }
     else
@@ -4682,7 +5015,7 @@ void EncCu::xReuseCachedResult( CodingStructure *&tempCS, CodingStructure *&best
             CompArea tmpArea(COMPONENT_Y, area.chromaFormat, Position(0, 0), area.size());
             PelBuf   tmpRecLuma = m_tmpStorageCtu->getBuf(tmpArea);
             tmpRecLuma.copyFrom(reco);
-            tmpRecLuma.rspSignal(m_pcReshape->getInvLUT());
+            tmpRecLuma.rspSignal(m_pcReshape->getInvPwl());
             finalDistortion += m_pcRdCost->getDistPart(org, tmpRecLuma, sps.getBitDepth(toChannelType(compID)), compID,
                                                        DFunc::SSE_WTD, &orgLuma);
           }
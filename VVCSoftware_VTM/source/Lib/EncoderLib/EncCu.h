@@ -47,6 +47,7 @@
 #include "CommonLib/UnitPartitioner.h"
 #include "CommonLib/IbcHashMap.h"
 #include "CommonLib/DeblockingFilter.h"
+#include "CommonLib/ThreadPool.h"
 
 #include "DecoderLib/DecCu.h"
 
@@ -55,6 +56,9 @@
 #include "InterSearch.h"
 #include "RateCtrl.h"
 #include "EncModeCtrl.h"
+
+#include <memory>
+
 //! \ingroup EncoderLib
 //! \{
 
@@ -255,6 +259,7 @@ private:
   EncSlice*             m_pcSliceEncoder;
   DeblockingFilter*     m_deblockingFilter;
   EncGOP*               m_pcGOPEncoder;
+  PerfCounters*         m_perfCounters;
 
   CABACWriter*          m_CABACEstimator;
   RateCtrl*             m_pcRateCtrl;
@@ -286,6 +291,12 @@ private:
   GeoComboCostList m_comboList;
   MergeItemList         m_mergeItemList;
 
+  // concurrent evaluation of the CTU-level split hypotheses
+  struct SplitJob;
+  std::vector<std::unique_ptr<SplitJob>> m_splitJobs;
+  std::unique_ptr<ThreadPool>            m_splitJobPool;
+  int                                    m_splitJobGroup;   // root-level mode group tested by a job encoder, -1: all
+
 public:
   /// copy parameters from encoder class
   void  init                ( EncLib* pcEncLib, const SPS& sps );
@@ -300,6 +311,9 @@ public:
   /// destroy internal buffers
   void  destroy             ();
 
+  /// reset the picture-level search state of the split job encoders
+  void  initSplitJobsSlice  ( const Picture* pic );
+
   /// CTU analysis function
   void compressCtu(CodingStructure &cs, const UnitArea &area, const unsigned ctuRsAddr,
                    const EnumArray<int, ChannelType> &prevQP, const EnumArray<int, ChannelType> &currQP);
@@ -326,6 +340,10 @@ protected:
 
   void xCompressCU            ( CodingStructure*& tempCS, CodingStructure*& bestCS, Partitioner& pm, double maxCostAllowed = MAX_DOUBLE );
 
+  void xInitSplitJobs         ( EncLib* pcEncLib, const SPS& sps );
+  bool xUseSplitJobs          ( const CodingStructure& cs ) const;
+  int  xCompressCUParallel    ( CodingStructure*& tempCS, CodingStructure*& bestCS, Partitioner& pm );
+
   bool
     xCheckBestMode         ( CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &pm, const EncTestMode& encTestmode );
 
@@ -42,6 +42,7 @@
 #include "EncLib.h"
 #include "EncGOP.h"
 #include "Analyze.h"
+#include "EncLookahead.h"
 #include "libmd5/MD5.h"
 #include "CommonLib/SEI.h"
 #include "CommonLib/NAL.h"
@@ -199,7 +200,7 @@ void  EncGOP::destroy()
     delete m_pcRefLayerRescaledPicYuv;
     m_pcRefLayerRescaledPicYuv= nullptr;
   }
-
+  m_metricThreadPool.reset();
 }
 
 void EncGOP::init ( EncLib* pcEncLib )
@@ -219,6 +220,11 @@ void EncGOP::init ( EncLib* pcEncLib )
   m_HRD                = pcEncLib->getHRD();
   m_AUWriterIf = pcEncLib->getAUWriterIf();
 
+  if (m_pcCfg->getMetricThreads() > 1)
+  {
+    m_metricThreadPool = std::make_unique<ThreadPool>(m_pcCfg->getMetricThreads());
+  }
+
   if (m_pcCfg->getFilmGrainAnalysisEnabled())
   {
     m_fgAnalyzer.init(m_pcCfg->getSourceWidth(), m_pcCfg->getSourceHeight(), m_pcCfg->getSourcePadding(0),
@@ -1810,7 +1816,7 @@ void trySkipOrDecodePicture(bool &decPic, bool &encPic, const EncCfg &cfg, Pictu
   // check if we should decode a leading bitstream
   if( !cfg.getDecodeBitstream( 0 ).empty() )
   {
-    static bool bDecode1stPart = true; /* TODO: MT */
+    static thread_local bool bDecode1stPart = true;   // per thread like the decoder state of tryDecodePicture()
     if( bDecode1stPart )
     {
       if( cfg.getForceDecodeBitstream1() )
@@ -2000,7 +2006,54 @@ void EncGOP::xPicInitHashME( Picture *pic, const PPS *pps, PicList &rcListPic )
   }
 }
 
-void EncGOP::xPicInitRateControl(int &estimatedBits, int gopId, double &lambda, Picture *pic, Slice *slice)
+void EncGOP::xPicInitLookahead(int pocLast, int numPicRcvd, int gopId, Picture *pic, double &rcPicWeight,
+                               std::vector<double> &ctuQpOffsets)
+{
+  rcPicWeight = 1.0;
+  ctuQpOffsets.clear();
+
+  EncLookahead *lookahead = m_pcEncLib->getLookahead();
+  if ( lookahead == nullptr )
+  {
+    return;
+  }
+
+  const int poc = pic->getPOC();
+  // pictures of the highest of several temporal layers are not referenced, so nothing propagates into them
+  const int  temporalId = m_pcCfg->getGOPEntry( gopId ).m_temporalId;
+  const bool isTopLayer = temporalId > 0 && temporalId == m_pcCfg->getMaxTempLayer() - 1;
+
+  if ( m_pcCfg->getLookaheadQpStrength() > 0.0 && !isTopLayer )
+  {
+    lookahead->getCtuQpOffsets( poc, ctuQpOffsets );
+
+    if ( !m_pcCfg->getUseRateCtrl() )
+    {
+      // applied to the quantization groups through the same CTU QP map as the block importance mapping
+      int *qpMap = new int[ctuQpOffsets.size()];
+      for ( int i = 0; i < (int) ctuQpOffsets.size(); i++ )
+      {
+        qpMap[i] = int( floor( ctuQpOffsets[i] + 0.5 ) );
+      }
+      std::map<int, int *> *adaptQPmap = m_pcEncLib->getAdaptQPmap();
+      auto it = adaptQPmap->find( poc );
+      if ( it != adaptQPmap->end() )
+      {
+        delete[] it->second;
+        adaptQPmap->erase( it );
+      }
+      adaptQPmap->insert( { poc, qpMap } );
+    }
+  }
+
+  if ( m_pcCfg->getUseRateCtrl() )
+  {
+    rcPicWeight = lookahead->getPicWeight( poc, pocLast - numPicRcvd + 1, numPicRcvd );
+  }
+}
+
+void EncGOP::xPicInitRateControl(int &estimatedBits, int gopId, double &lambda, Picture *pic, Slice *slice,
+                                 const double rcPicWeight, const std::vector<double> &ctuQpOffsets)
 {
   if ( !m_pcCfg->getUseRateCtrl() ) // TODO: does this work with multiple slices and slice-segments?
   {
@@ -2011,7 +2064,11 @@ void EncGOP::xPicInitRateControl(int &estimatedBits, int gopId, double &lambda,
   {
     frameLevel = 0;
   }
-  m_pcRateCtrl->initRCPic( frameLevel );
+  m_pcRateCtrl->initRCPic( frameLevel, rcPicWeight );
+  if ( !ctuQpOffsets.empty() )
+  {
+    m_pcRateCtrl->getRCPic()->setLCUQpOffsets( ctuQpOffsets );
+  }
   estimatedBits = m_pcRateCtrl->getRCPic()->getTargetBits();
 
   if (m_pcRateCtrl->getCpbSaturationEnabled() && frameLevel != 0)
@@ -2417,6 +2474,7 @@ void EncGOP::compressGOP(int pocLast, int numPicRcvd, PicList &rcListPic, std::l
       }
       continue;
     }
+    m_pcEncLib->getPerfCounters()->beginPicture();
 
     if( getNalUnitType(pocCurr, m_iLastIDR, isField) == NAL_UNIT_CODED_SLICE_IDR_W_RADL || getNalUnitType(pocCurr, m_iLastIDR, isField) == NAL_UNIT_CODED_SLICE_IDR_N_LP )
     {
@@ -3167,7 +3225,14 @@ void EncGOP::compressGOP(int pocLast, int numPicRcvd, PicList &rcListPic, std::l
     int estimatedBits        = 0;
     int tmpBitsBeforeWriting = 0;
 
-    xPicInitRateControl(estimatedBits, gopId, lambda, pcPic, pcSlice);
+    double              rcPicWeight = 1.0;
+    std::vector<double> ctuQpOffsets;
+    xPicInitLookahead(pocLast, numPicRcvd, gopId, pcPic, rcPicWeight, ctuQpOffsets);
+    xPicInitRateControl(estimatedBits, gopId, lambda, pcPic, pcSlice, rcPicWeight, ctuQpOffsets);
+    if (m_pcEncLib->getAnalysisCache()->isLoaded())
+    {
+      m_pcEncLib->getAnalysisCache()->activatePicture(pcPic->getPOC());
+    }
 
     uint32_t numSliceSegments = 1;
 
@@ -3396,7 +3461,7 @@ void EncGOP::compressGOP(int pocLast, int numPicRcvd, PicList &rcListPic, std::l
 
             if (pcSlice->getLmcsEnabledFlag())
             {
-              pcPic->getOrigBuf(COMPONENT_Y).rspSignal(m_pcReshaper->getFwdLUT());
+              pcPic->getOrigBuf(COMPONENT_Y).rspSignal(m_pcReshaper->getFwdPwl());
               m_pcReshaper->setSrcReshaped(true);
               m_pcReshaper->setRecReshaped(true);
             }
@@ -3505,6 +3570,11 @@ void EncGOP::compressGOP(int pocLast, int numPicRcvd, PicList &rcListPic, std::l
       CodingStructure& cs = *pcPic->cs;
       pcSlice = pcPic->slices[0];
 
+      if (m_pcEncLib->getAnalysisCache()->isSaving())
+      {
+        m_pcEncLib->getAnalysisCache()->storePicture(cs);
+      }
+
       if (cs.sps->getUseLmcs() && m_pcReshaper->getSliceReshaperInfo().getUseSliceReshaper())
       {
         picHeader->setLmcsEnabledFlag(true);
@@ -3528,7 +3598,7 @@ void EncGOP::compressGOP(int pocLast, int numPicRcvd, PicList &rcListPic, std::l
               const uint32_t width = (xPos + pcv.maxCUWidth > pcv.lumaWidth) ? (pcv.lumaWidth - xPos) : pcv.maxCUWidth;
               const uint32_t height = (yPos + pcv.maxCUHeight > pcv.lumaHeight) ? (pcv.lumaHeight - yPos) : pcv.maxCUHeight;
               const UnitArea area(cs.area.chromaFormat, Area(xPos, yPos, width, height));
-              cs.getRecoBuf(area).get(COMPONENT_Y).rspSignal(m_pcReshaper->getInvLUT());
+              cs.getRecoBuf(area).get(COMPONENT_Y).rspSignal(m_pcReshaper->getInvPwl());
             }
           }
         }
@@ -3570,6 +3640,8 @@ void EncGOP::compressGOP(int pocLast, int numPicRcvd, PicList &rcListPic, std::l
         picHeader->setScalingListAPSId( apsId );
       }
 
+      PerfTimer loopFilterTimer(m_pcEncLib->getPerfCounters(), PerfStage::LOOP_FILTER);
+
       // SAO parameter estimation using non-deblocked pixels for CTU bottom and right boundary areas
       if( pcSlice->getSPS()->getSAOEnabledFlag() && m_pcCfg->getSaoCtuBoundary() )
       {
@@ -4491,6 +4563,9 @@ void EncGOP::compressGOP(int pocLast, int numPicRcvd, PicList &rcListPic, std::l
     pcPic->reconstructed = true;
     m_first              = false;
     m_numPicsCoded++;
+    m_pcEncLib->getPerfCounters()->endPicture(pcSlice->getPOC(), pcPic->layerId,
+                                              pcSlice->isIntra() ? 'I' : pcSlice->isInterP() ? 'P' : 'B',
+                                              pcSlice->getSliceQp());
     if (!(m_pcCfg->getUseCompositeRef() && isEncodeLtRef))
     {
       for( int i = pcSlice->getTLayer() ; i < pcSlice->getSPS()->getMaxTLayers() ; i ++ )
@@ -4778,20 +4853,13 @@ static inline double calcWeightedSquaredError(const CPelBuf& org,        const C
 
   const int hAct = offsetY + (uint32_t)blockHeight < imageHeight ? blockHeight : blockHeight - 1;
   const int wAct = offsetX + (uint32_t)blockWidth  < imageWidth  ? blockWidth  : blockWidth  - 1;
-  uint64_t ssErr = 0; // sum of squared diffs
+  // calculate image differences and activity
+  const uint64_t ssErr = RdCost::getPlaneSSE(CPelBuf(o, O, blockWidth, blockHeight),
+                                             CPelBuf(r, R, blockWidth, blockHeight)); // sum of squared diffs
   uint64_t saAct = 0; // sum of abs. activity
   double msAct;
   int x, y;
 
-  // calculate image differences and activity
-  for (y = 0; y < blockHeight; y++)  // error
-  {
-    for (x = 0; x < blockWidth; x++)
-    {
-      const     int64_t iDiff = (int64_t)o[y*O + x] - (int64_t)r[y*R + x];
-      ssErr += uint64_t(iDiff * iDiff);
-    }
-  }
   if (wAct <= xAct || hAct <= yAct)
   {
     return (double) ssErr;
@@ -4853,18 +4921,7 @@ uint64_t EncGOP::xFindDistortionPlane(const CPelBuf& pic0, const CPelBuf& pic1,
 
       if (B < 4) // image is too small to use WPSNR, resort to traditional PSNR
       {
-        totalDiff = 0;
-        for (y = 0; y < H; y++)
-        {
-          for (x = 0; x < W; x++)
-          {
-            const           int64_t iDiff = (int64_t)pSrc0[x] - (int64_t)pSrc1[x];
-            totalDiff += uint64_t(iDiff * iDiff);
-          }
-          pSrc0 += pic0.stride;
-          pSrc1 += pic1.stride;
-        }
-        return totalDiff;
+        return RdCost::getPlaneSSE(pic0, pic1);
       }
 
       double wmse = 0.0, sumAct = 0.0; // compute activity normalized SNR value
@@ -4901,17 +4958,7 @@ uint64_t EncGOP::xFindDistortionPlane(const CPelBuf& pic0, const CPelBuf& pic1,
   }
   else
   {
-    totalDiff = 0;
-    for (int y = 0; y < pic0.height; y++)
-    {
-      for (int x = 0; x < pic0.width; x++)
-      {
-        Intermediate_Int temp = pSrc0[x] - pSrc1[x];
-        totalDiff += uint64_t(temp * temp);
-      }
-      pSrc0 += pic0.stride;
-      pSrc1 += pic1.stride;
-    }
+    totalDiff = RdCost::getPlaneSSE(pic0, pic1);
   }
 
   return totalDiff;
@@ -4930,6 +4977,9 @@ double EncGOP::xFindDistortionPlaneWPSNR(const CPelBuf& pic0, const CPelBuf& pic
   const  Pel*  pSrc0 = pic0.bufAt(0, 0);
   const  Pel*  pSrc1 = pic1.bufAt(0, 0);
   const  Pel*  pSrcLuma = picLuma0.bufAt(0, 0);
+  const double *lumaLevelWeight = m_pcEncLib->getRdCost()->getLumaLevelWeightTable().data();
+  const int     scaleX          = getComponentScaleX(compID, chfmt);
+  const ptrdiff_t lumaStride    = picLuma0.stride << getComponentScaleY(compID, chfmt);
   CHECK(pic0.width  != pic1.width , "Unspecified error");
   CHECK(pic0.height != pic1.height, "Unspecified error");
 
@@ -4941,12 +4991,12 @@ double EncGOP::xFindDistortionPlaneWPSNR(const CPelBuf& pic0, const CPelBuf& pic
       for (int x = 0; x < pic0.width; x++)
       {
         Intermediate_Int temp = pSrc0[x] - pSrc1[x];
-        double dW = m_pcEncLib->getRdCost()->getWPSNRLumaLevelWeight(pSrcLuma[(x << getComponentScaleX(compID, chfmt))]);
+        double dW = lumaLevelWeight[pSrcLuma[x << scaleX]];
         totalDiffWpsnr += ((dW * (double) temp * (double) temp)) * (double) (1 >> rshift);
       }
       pSrc0 += pic0.stride;
       pSrc1 += pic1.stride;
-      pSrcLuma += picLuma0.stride << getComponentScaleY(compID, chfmt);
+      pSrcLuma += lumaStride;
     }
   }
   else
@@ -4957,12 +5007,12 @@ double EncGOP::xFindDistortionPlaneWPSNR(const CPelBuf& pic0, const CPelBuf& pic
       for (int x = 0; x < pic0.width; x++)
       {
         Intermediate_Int temp = pSrc0[x] - pSrc1[x];
-        double dW = m_pcEncLib->getRdCost()->getWPSNRLumaLevelWeight(pSrcLuma[x << getComponentScaleX(compID, chfmt)]);
+        double dW = lumaLevelWeight[pSrcLuma[x << scaleX]];
         totalDiffWpsnr += dW * (double) temp * (double) temp;
       }
       pSrc0 += pic0.stride;
       pSrc1 += pic1.stride;
-      pSrcLuma += picLuma0.stride << getComponentScaleY(compID, chfmt);
+      pSrcLuma += lumaStride;
     }
   }
 
@@ -5160,7 +5210,11 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
     }
   }
 
-  for (int comp = 0; comp < ::getNumberValidComponents(formatD); comp++)
+  // planes of the reconstruction and the original compared by the metrics, without the padding
+  const int numComp = ::getNumberValidComponents(formatD);
+  CPelBuf   recPB[MAX_NUM_COMPONENT];
+  CPelBuf   orgPB[MAX_NUM_COMPONENT];
+  for (int comp = 0; comp < numComp; comp++)
   {
     const ComponentID compID = ComponentID(comp);
     const CPelBuf&    p = picC.get(compID);
@@ -5185,35 +5239,78 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
     const uint32_t height = p.height - ( padY >> ( !!bPicIsField + ::getComponentScaleY( compID, format ) ) );
 
     // create new buffers with correct dimensions
-    const CPelBuf recPB(p.bufAt(0, 0), p.stride, width, height);
-    const CPelBuf orgPB(o.bufAt(0, 0), o.stride, width, height);
+    recPB[comp] = CPelBuf(p.bufAt(0, 0), p.stride, width, height);
+    orgPB[comp] = CPelBuf(o.bufAt(0, 0), o.stride, width, height);
+  }
+
+  // the metrics of the planes do not depend on each other and are computed concurrently if there is a metric thread
+  // pool, the MS-SSIM tasks come first as the luma one takes longest
+  uint64_t ssd[MAX_NUM_COMPONENT] = { 0, 0, 0 };
+#if WCG_WPSNR
+  double   ssdWeighted[MAX_NUM_COMPONENT] = { 0.0, 0.0, 0.0 };
+#endif
+  const int numMetricTasks = 3 * numComp;
+  auto      calcMetric     = [&](int, int idx)
+  {
+    const int         comp     = idx % numComp;
+    const ComponentID compID   = ComponentID(comp);
     const uint32_t    bitDepth = sps.getBitDepth(toChannelType(compID));
+    switch (idx / numComp)
+    {
+    case 0:
+      if (printMSSSIM)
+      {
+        msssim[comp] = xCalculateMSSSIM(orgPB[comp].buf, orgPB[comp].stride, recPB[comp].buf, recPB[comp].stride,
+                                        orgPB[comp].width, orgPB[comp].height, bitDepth);
+      }
+      break;
+    case 1:
 #if ENABLE_QPA
-    const uint64_t ssdTemp =
-      xFindDistortionPlane(recPB, orgPB, useWPSNR ? bitDepth : 0, ::getComponentScaleX(compID, format),
-                           ::getComponentScaleY(compID, format));
+      ssd[comp] = xFindDistortionPlane(recPB[comp], orgPB[comp], useWPSNR ? bitDepth : 0,
+                                       ::getComponentScaleX(compID, format), ::getComponentScaleY(compID, format));
 #else
-    const uint64_t ssdTemp = xFindDistortionPlane(recPB, orgPB, 0);
+      ssd[comp] = xFindDistortionPlane(recPB[comp], orgPB[comp], 0);
+#endif
+      break;
+    default:
+#if WCG_WPSNR
+      ssdWeighted[comp] = xFindDistortionPlaneWPSNR(recPB[comp], orgPB[comp], 0, org.get(COMPONENT_Y), compID, format);
 #endif
+      break;
+    }
+  };
+  if (m_metricThreadPool)
+  {
+    m_metricThreadPool->parallelFor(numMetricTasks, calcMetric);
+  }
+  else
+  {
+    for (int idx = 0; idx < numMetricTasks; idx++)
+    {
+      calcMetric(0, idx);
+    }
+  }
+
+  for (int comp = 0; comp < numComp; comp++)
+  {
+    const ComponentID compID = ComponentID(comp);
+    const uint32_t    width    = orgPB[comp].width;
+    const uint32_t    height   = orgPB[comp].height;
+    const uint32_t    bitDepth = sps.getBitDepth(toChannelType(compID));
+    const uint64_t    ssdTemp  = ssd[comp];
     const uint32_t maxval = 255 << (bitDepth - 8);
     const uint32_t size   = width * height;
     const double fRefValue = (double)maxval * maxval * size;
     dPSNR[comp]              = ssdTemp ? 10.0 * log10(fRefValue / (double) ssdTemp) : 999.99;
     mseYuvFrame[comp]        = (double) ssdTemp / size;
-    if(printMSSSIM)
-    {
-      msssim[comp] = xCalculateMSSSIM (o.bufAt(0, 0), o.stride, p.bufAt(0, 0), p.stride, width, height, bitDepth);
-    }
 #if WCG_WPSNR
-    const double uiSSDtempWeighted = xFindDistortionPlaneWPSNR(recPB, orgPB, 0, org.get(COMPONENT_Y), compID, format);
+    const double uiSSDtempWeighted = ssdWeighted[comp];
     if (useLumaWPSNR)
     {
       dPSNRWeighted[comp] = uiSSDtempWeighted ? 10.0 * log10(fRefValue / (double)uiSSDtempWeighted) : 999.99;
       MSEyuvframeWeighted[comp] = (double)uiSSDtempWeighted / size;
     }
 #endif
-
-
     if (m_pcEncLib->isResChangeInClvsEnabled())
     {
       const CPelBuf& upscaledOrg = (sps.getUseLmcs() || m_pcCfg->getGopBasedTemporalFilterEnabled()) ? pcPic->M_BUFS( 0, PIC_TRUE_ORIGINAL_INPUT).get( compID ) : pcPic->M_BUFS( 0, PIC_ORIGINAL_INPUT).get( compID );
@@ -5247,7 +5344,7 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
   }
 
 #if EXTENSION_360_VIDEO
-  m_ext360.calculatePSNRs(pcPic);
+  m_ext360.calculatePSNRs(pcPic, m_metricThreadPool.get());
 #endif
 
 #if JVET_O0756_CALCULATE_HDRMETRICS
@@ -5666,7 +5763,8 @@ double EncGOP::xCalculateMSSSIM(const Pel *org, const ptrdiff_t orgStride, const
 {
   const int MAX_MSSSIM_SCALE  = 5;
   const int WEIGHTING_MID_TAP = 5;
-  const int WEIGHTING_SIZE    = WEIGHTING_MID_TAP*2+1;
+  const int WEIGHTING_SIZE    = SSIM_WINDOW_SIZE;
+  static_assert(WEIGHTING_SIZE == WEIGHTING_MID_TAP * 2 + 1, "the SSIM window is centered at the middle tap");
 
   uint32_t maxScale;
 
@@ -5783,44 +5881,15 @@ double EncGOP::xCalculateMSSSIM(const Pel *org, const ptrdiff_t orgStride, const
 
     double meanSSIM= 0.0;
 
+    std::vector<double> blockSSIMVal(std::max(blocksPerRow, 0));
     for(int blockIndexY=0; blockIndexY<blocksPerColumn; blockIndexY++)
     {
+      RdCost::getSSIMWindows(&original[scale][blockIndexY * scaledWidth], &recon[scale][blockIndexY * scaledWidth],
+                             scaledWidth, &weights[0][0], blocksPerRow, c1, c2, scale == maxScale - 1,
+                             blockSSIMVal.data());
       for(int blockIndexX=0; blockIndexX<blocksPerRow; blockIndexX++)
       {
-        double muOrg          =0.0;
-        double muRec          =0.0;
-        double muOrigSqr      =0.0;
-        double muRecSqr       =0.0;
-        double muOrigMultRec  =0.0;
-
-        for(int y=0; y<WEIGHTING_SIZE; y++)
-        {
-          for(int x=0;x<WEIGHTING_SIZE; x++)
-          {
-            const double gaussianWeight=weights[y][x];
-            const int    sampleOffset=(blockIndexY+y)*scaledWidth+(blockIndexX+x);
-            const double orgPel=original[scale][sampleOffset];
-            const double recPel=   recon[scale][sampleOffset];
-
-            muOrg        +=orgPel*       gaussianWeight;
-            muRec        +=recPel*       gaussianWeight;
-            muOrigSqr    +=orgPel*orgPel*gaussianWeight;
-            muRecSqr     +=recPel*recPel*gaussianWeight;
-            muOrigMultRec+=orgPel*recPel*gaussianWeight;
-          }
-        }
-
-        const double sigmaSqrOrig = muOrigSqr    -(muOrg*muOrg);
-        const double sigmaSqrRec  = muRecSqr     -(muRec*muRec);
-        const double sigmaOrigRec = muOrigMultRec-(muOrg*muRec);
-
-        double blockSSIMVal = ((2.0*sigmaOrigRec + c2)/(sigmaSqrOrig+sigmaSqrRec + c2));
-        if(scale == maxScale-1)
-        {
-          blockSSIMVal*=(2.0*muOrg*muRec + c1)/(muOrg*muOrg+muRec*muRec + c1);
-        }
-
-        meanSSIM += blockSSIMVal;
+        meanSSIM += blockSSIMVal[blockIndexX];
       }
     }
 
@@ -39,12 +39,14 @@
 #define __ENCGOP__
 
 #include <list>
+#include <memory>
 
 #include <stdlib.h>
 
 #include "CommonLib/Picture.h"
 #include "CommonLib/DeblockingFilter.h"
 #include "CommonLib/NAL.h"
+#include "CommonLib/ThreadPool.h"
 #include "EncSampleAdaptiveOffset.h"
 #include "EncAdaptiveLoopFilter.h"
 #include "EncReshape.h"
@@ -192,6 +194,7 @@ private:
     int8_t tcOffsetDiv2;
   } m_deblockParam[MAX_ENCODER_DEBLOCKING_QUALITY_LAYERS];
   PelStorage*             m_pcRefLayerRescaledPicYuv;
+  std::unique_ptr<ThreadPool> m_metricThreadPool;   ///< computes the distortion metrics of the picture planes in parallel
 
   // members needed for adaptive max BT size
   struct BlkStat
@@ -302,7 +305,10 @@ protected:
 protected:
   void  xInitGOP(int pocLast, int numPicRcvd, bool isField, bool isEncodeLtRef);
   void  xPicInitHashME( Picture *pic, const PPS *pps, PicList &rcListPic );
-  void  xPicInitRateControl(int &estimatedBits, int gopId, double &lambda, Picture *pic, Slice *slice);
+  void  xPicInitLookahead  (int pocLast, int numPicRcvd, int gopId, Picture *pic, double &rcPicWeight,
+                            std::vector<double> &ctuQpOffsets);
+  void  xPicInitRateControl(int &estimatedBits, int gopId, double &lambda, Picture *pic, Slice *slice,
+                            const double rcPicWeight, const std::vector<double> &ctuQpOffsets);
   void  xPicInitLMCS       (Picture *pic, PicHeader *picHeader, Slice *slice);
   void  xGetBuffer(PicList &rcListPic, std::list<PelUnitBuf *> &rcListPicYuvRecOut, int numPicRcvd, int timeOffset,
                    Picture *&rpcPic, int pocCurr, bool isField);
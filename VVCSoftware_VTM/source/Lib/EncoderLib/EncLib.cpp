@@ -38,6 +38,7 @@
 
 #include "EncModeCtrl.h"
 #include "AQp.h"
+#include "EncLookahead.h"
 #include "EncCu.h"
 
 #include "CommonLib/Picture.h"
@@ -46,6 +47,8 @@
 #include "EncLibCommon.h"
 #include "CommonLib/ProfileTierLevel.h"
 
+#include <mutex>
+
 //! \ingroup EncoderLib
 //! \{
 
@@ -55,9 +58,11 @@
 
 EncLib::EncLib(EncLibCommon *encLibCommon)
   : m_cListPic(encLibCommon->getPictureBuffer())
+  , m_unitPool(encLibCommon->getUnitPool())
   , m_spsMap(encLibCommon->getSpsMap())
   , m_ppsMap(encLibCommon->getPpsMap())
   , m_apsMaps(encLibCommon->getApsMaps())
+  , m_lookahead(nullptr)
   , m_AUWriterIf(nullptr)
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
   , m_cacheModel()
@@ -75,7 +80,8 @@ EncLib::EncLib(EncLibCommon *encLibCommon)
   m_maxRefPicNum = 0;
 
 #if ENABLE_SIMD_OPT_BUFFER
-  g_pelBufOP.initPelBufOpsX86();
+  static std::once_flag pelBufOpsInitialized;
+  std::call_once(pelBufOpsInitialized, [] { g_pelBufOP.initPelBufOpsX86(); });
 #endif
 
 #if JVET_O0756_CALCULATE_HDRMETRICS
@@ -124,7 +130,14 @@ void EncLib::create( const int layerId )
                      m_sourceHeight, m_maxCUWidth, m_maxCUHeight, getBitDepth(ChannelType::LUMA),
                      m_rcKeepHierarchicalBit, m_rcUseCtuSeparateModel, m_GOPList);
   }
-
+  if (!m_analysisSaveFile.empty())
+  {
+    m_analysisCache.openSave(m_analysisSaveFile, m_sourceWidth, m_sourceHeight, m_maxCUWidth);
+  }
+  if (!m_analysisLoadFile.empty() && m_analysisReuseLevel > 0)
+  {
+    m_analysisCache.load(m_analysisLoadFile, m_sourceWidth, m_sourceHeight, m_maxCUWidth, m_analysisReuseLevel);
+  }
 }
 
 void EncLib::destroy ()
@@ -144,6 +157,8 @@ void EncLib::destroy ()
   m_cReshaper.          destroy();
   m_cInterSearch.       destroy();
   m_cIntraSearch.destroy();
+  m_perfCounters.       close();
+  m_analysisCache.      destroy();
 }
 
 void EncLib::init(AUWriterIf *auWriterIf)
@@ -482,6 +497,10 @@ void EncLib::init(AUWriterIf *auWriterIf)
                       getUseCompositeRef(), m_maxCUWidth, m_maxCUHeight, floorLog2(m_maxCUWidth) - m_log2MinCUSize,
                       &m_cRdCost, cabacEstimator, getCtxCache(), &m_cReshaper);
 
+  m_cTrQuant.    setPerfCounters( &m_perfCounters );
+  m_cIntraSearch.setPerfCounters( &m_perfCounters );
+  m_cInterSearch.setPerfCounters( &m_perfCounters );
+
   // link temporary buffets from intra search with inter search to avoid unneccessary memory overhead
   m_cInterSearch.setTempBuffers( m_cIntraSearch.getSplitCSBuf(), m_cIntraSearch.getFullCSBuf(), m_cIntraSearch.getSaveCSBuf() );
 
@@ -509,7 +528,7 @@ void EncLib::init(AUWriterIf *auWriterIf)
                   sps0.getMaxCUWidth(), sps0.getMaxCUWidth() + 16, false, m_layerId,
                   getGopBasedTemporalFilterEnabled());
     picBg->getRecoBuf().fill(0);
-    picBg->finalInit( m_vps, sps0, pps0, &m_picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS );
+    picBg->finalInit( m_unitPool, m_vps, sps0, pps0, &m_picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS );
     picBg->allocateNewSlice();
     picBg->createSpliceIdx(pps0.pcv->sizeInCtus);
     m_cGOPEncoder.setPicBg(picBg);
@@ -626,7 +645,7 @@ bool EncLib::encodePrep(bool flush, PelStorage *pcPicYuvOrg, PelStorage *cPicYuv
     const SPS *sps = m_spsMap.getPS( pps->getSPSId() );
 
     picCurr->M_BUFS( 0, PIC_ORIGINAL ).copyFrom( m_cGOPEncoder.getPicBg()->getRecoBuf() );
-    picCurr->finalInit( m_vps, *sps, *pps, &m_picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS );
+    picCurr->finalInit( m_unitPool, m_vps, *sps, *pps, &m_picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS );
     picCurr->poc = m_pocLast - 1;
     m_pocLast -= 2;
 
@@ -868,7 +887,7 @@ bool EncLib::encodePrep(bool flush, PelStorage *pcPicYuvOrg, PelStorage *cPicYuv
         pcPicCurr->M_BUFS( 0, PIC_FILTERED_ORIGINAL_FG ).swap( *pcPicYuvFilteredOrgForFG );
       }
     }
-    pcPicCurr->finalInit( m_vps, *pSPS, *pPPS, &m_picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS );
+    pcPicCurr->finalInit( m_unitPool, m_vps, *pSPS, *pPPS, &m_picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS );
 
     pcPicCurr->poc = m_pocLast;
 
@@ -897,6 +916,10 @@ bool EncLib::encodePrep(bool flush, PelStorage *pcPicYuvOrg, PelStorage *cPicYuv
 
   if (m_rcEnableRateControl)
   {
+    if (m_lookahead != nullptr)
+    {
+      m_cRateCtrl.setLookaheadGOPWeight(m_lookahead->getGOPWeight(m_pocLast - m_receivedPicCount + 1, m_receivedPicCount));
+    }
     m_cRateCtrl.initRCGOP(m_receivedPicCount);
   }
 
@@ -943,6 +966,11 @@ bool EncLib::encode(const InputColourSpaceConversion snrCSC, std::list<PelUnitBu
     m_cRateCtrl.destroyRCGOP();
   }
 
+  if (m_lookahead != nullptr)
+  {
+    m_lookahead->releaseFrames(m_pocLast + 1);
+  }
+
   numEncoded         = m_receivedPicCount;
   m_receivedPicCount = 0;
   m_codedPicCount += numEncoded;
@@ -1024,7 +1052,7 @@ bool EncLib::encodePrep(bool flush, PelStorage *pcPicYuvOrg, PelStorage *pcPicYu
       const PPS *pPPS = ( ppsID < 0 ) ? m_ppsMap.getFirstPS() : m_ppsMap.getPS( ppsID );
       const SPS *pSPS = m_spsMap.getPS( pPPS->getSPSId() );
 
-      pcField->finalInit( m_vps, *pSPS, *pPPS, &m_picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS );
+      pcField->finalInit( m_unitPool, m_vps, *pSPS, *pPPS, &m_picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS );
       pcField->poc           = m_pocLast;
       pcField->reconstructed = false;
 
@@ -1803,6 +1831,10 @@ void EncLib::xInitPPS(PPS &pps, const SPS &sps)
   {
     useDeltaQp = true;
   }
+  if (m_lookaheadFrames > 0 && m_lookaheadQpStrength > 0.0)
+  {
+    useDeltaQp = true;
+  }
 
   if (m_costMode==COST_SEQUENCE_LEVEL_LOSSLESS || m_costMode==COST_LOSSLESS_CODING)
   {
@@ -42,6 +42,7 @@
 #include "CommonLib/TrQuant.h"
 #include "CommonLib/DeblockingFilter.h"
 #include "CommonLib/NAL.h"
+#include "CommonLib/PerfCounters.h"
 
 #include "Utilities/VideoIOYuv.h"
 
@@ -57,10 +58,12 @@
 #include "EncReshape.h"
 #include "EncAdaptiveLoopFilter.h"
 #include "RateCtrl.h"
+#include "EncAnalysisCache.h"
 
 #include "CommonLib/SEINeuralNetworkPostFiltering.h"
 
 class EncLibCommon;
+class EncLookahead;
 
 //! \ingroup EncoderLib
 //! \{
@@ -78,6 +81,7 @@ private:
   int                       m_receivedPicCount;                   ///< number of received pictures
   uint32_t                  m_codedPicCount;                      ///< number of coded pictures
   PicList&                  m_cListPic;                           ///< dynamic list of pictures
+  XuPool&                   m_unitPool;                           ///< CU/PU/TU pool of the picture coding structures
   int                       m_layerId;
 
   // encoder search
@@ -107,6 +111,9 @@ private:
   CtxPool                   m_ctxPool;                            ///< buffer for temporarily stored context models
   // quality control
   RateCtrl                  m_cRateCtrl;                          ///< Rate control class
+  PerfCounters              m_perfCounters;                       ///< per-picture timing and mode evaluation counters
+  EncLookahead*             m_lookahead;                          ///< first-pass lookahead analysis, owned by the application
+  EncAnalysisCache          m_analysisCache;                      ///< CU decisions saved for or loaded from other encodes
 
   AUWriterIf*               m_AUWriterIf;
 
@@ -196,6 +203,10 @@ public:
   RdCost*                 getRdCost             ()              { return  &m_cRdCost;              }
   CtxPool                *getCtxCache() { return &m_ctxPool; }
   RateCtrl*               getRateCtrl           ()              { return  &m_cRateCtrl;            }
+  PerfCounters*           getPerfCounters       ()              { return  &m_perfCounters;         }
+  EncLookahead*           getLookahead          ()              { return  m_lookahead;             }
+  void                    setLookahead          ( EncLookahead* lookahead ) { m_lookahead = lookahead; }
+  EncAnalysisCache*       getAnalysisCache      ()              { return  &m_analysisCache;        }
   void                    setRefLayerRescaledAvailable(bool b)  { m_refLayerRescaledAvailable = b; }
   bool                    isRefLayerRescaledAvailable() const   { return m_refLayerRescaledAvailable; }
 
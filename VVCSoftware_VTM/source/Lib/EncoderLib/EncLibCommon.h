@@ -38,6 +38,7 @@
 #pragma once
 #include <list>
 #include <fstream>
+#include "CommonLib/CodingStructure.h"
 #include "CommonLib/Slice.h"
 #include "CommonLib/ParameterSetManager.h"
 
@@ -48,6 +49,7 @@ private:
   ParameterSetMap<PPS>      m_ppsMap;             ///< PPS, it is shared across all layers
   EnumArray<ParameterSetMap<APS>, ApsType> m_apsMaps;            ///< APS, it is shared across all layers
   PicList                   m_cListPic;           ///< DPB, it is shared across all layers
+  XuPool                    m_unitPool;           ///< CU/PU/TU pool of the DPB pictures, it is shared across all layers
   VPS                       m_vps;
   int                       m_layerDecPicBuffering[MAX_VPS_LAYERS*MAX_TLAYER];  // to store number of required DPB pictures per layer
 
@@ -56,6 +58,7 @@ public:
   virtual ~EncLibCommon();
 
   PicList&                 getPictureBuffer()      { return m_cListPic;   }
+  XuPool&                  getUnitPool()           { return m_unitPool;   }
   ParameterSetMap<SPS>&    getSpsMap()             { return m_spsMap;     }
   ParameterSetMap<PPS>&    getPpsMap()             { return m_ppsMap;     }
   EnumArray<ParameterSetMap<APS>, ApsType> &getApsMaps() { return m_apsMaps; }
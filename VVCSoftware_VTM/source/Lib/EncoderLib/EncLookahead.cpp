@@ -0,0 +1,625 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2023, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     EncLookahead.cpp
+    \brief    first-pass lookahead analysis for rate control and QP adaptation
+*/
+
+#include "EncLookahead.h"
+#include "Utilities/VideoIOYuv.h"
+
+#include <cmath>
+
+//! \ingroup EncoderLib
+//! \{
+
+// ====================================================================================================================
+// Constructor / destructor / initialization / destroy
+// ====================================================================================================================
+
+const int    EncLookahead::m_blkSize     = 8;      // block size at half resolution
+const int    EncLookahead::m_padding     = 64;
+const int    EncLookahead::m_searchRange = 32;
+const double EncLookahead::m_rcCompress  = 0.4;    // bits grow with the estimated complexity to this power
+const double EncLookahead::m_maxQpOffset = 6.0;
+
+static uint32_t calcHadamard8x8( const int *diff )
+{
+  int m1[8][8], m2[8][8];
+
+  for( int j = 0; j < 8; j++ )
+  {
+    const int *d = diff + j * 8;
+    const int a0 = d[0] + d[4], a1 = d[1] + d[5], a2 = d[2] + d[6], a3 = d[3] + d[7];
+    const int a4 = d[0] - d[4], a5 = d[1] - d[5], a6 = d[2] - d[6], a7 = d[3] - d[7];
+    const int b0 = a0 + a2, b1 = a1 + a3, b2 = a0 - a2, b3 = a1 - a3;
+    const int b4 = a4 + a6, b5 = a5 + a7, b6 = a4 - a6, b7 = a5 - a7;
+    m1[j][0] = b0 + b1; m1[j][1] = b0 - b1; m1[j][2] = b2 + b3; m1[j][3] = b2 - b3;
+    m1[j][4] = b4 + b5; m1[j][5] = b4 - b5; m1[j][6] = b6 + b7; m1[j][7] = b6 - b7;
+  }
+  for( int i = 0; i < 8; i++ )
+  {
+    const int a0 = m1[0][i] + m1[4][i], a1 = m1[1][i] + m1[5][i], a2 = m1[2][i] + m1[6][i], a3 = m1[3][i] + m1[7][i];
+    const int a4 = m1[0][i] - m1[4][i], a5 = m1[1][i] - m1[5][i], a6 = m1[2][i] - m1[6][i], a7 = m1[3][i] - m1[7][i];
+    const int b0 = a0 + a2, b1 = a1 + a3, b2 = a0 - a2, b3 = a1 - a3;
+    const int b4 = a4 + a6, b5 = a5 + a7, b6 = a4 - a6, b7 = a5 - a7;
+    m2[0][i] = b0 + b1; m2[1][i] = b0 - b1; m2[2][i] = b2 + b3; m2[3][i] = b2 - b3;
+    m2[4][i] = b4 + b5; m2[5][i] = b4 - b5; m2[6][i] = b6 + b7; m2[7][i] = b6 - b7;
+  }
+
+  uint32_t sad = 0;
+  for( int j = 0; j < 8; j++ )
+  {
+    for( int i = 0; i < 8; i++ )
+    {
+      sad += abs( m2[j][i] );
+    }
+  }
+  return ( sad + 2 ) >> 2;
+}
+
+static inline int floorDiv( const int a, const int b )
+{
+  return a >= 0 ? a / b : -( ( b - 1 - a ) / b );
+}
+
+EncLookahead::EncLookahead()
+  : m_frameSkip( 0 )
+  , m_chromaFormatIdc( ChromaFormat::UNDEFINED )
+  , m_inputColourSpaceConvert( NUMBER_INPUT_COLOUR_SPACE_CONVERSIONS )
+  , m_clipInputVideoToRec709Range( false )
+  , m_sourceWidth( 0 )
+  , m_sourceHeight( 0 )
+  , m_lookaheadFrames( 0 )
+  , m_gopSize( 1 )
+  , m_ctuSize( 0 )
+  , m_numCtus( 0 )
+  , m_widthInBlks( 0 )
+  , m_heightInBlks( 0 )
+  , m_qpStrength( 0.0 )
+  , m_mvLambda( 0.0 )
+  , m_stop( false )
+  , m_numFrames( 0 )
+  , m_numAnalysed( 0 )
+  , m_maxRequested( 0 )
+{
+  m_pad[0] = m_pad[1] = 0;
+}
+
+EncLookahead::~EncLookahead()
+{
+  destroy();
+}
+
+void EncLookahead::init(const int frameSkip, const BitDepths &inputBitDepth, const BitDepths &msbExtendedBitDepth,
+                        const BitDepths &internalBitDepth, const int width, const int height, const int *pad,
+                        const bool rec709, const std::string &filename, const ChromaFormat inputChromaFormatIDC,
+                        const InputColourSpaceConversion colorSpaceConv, const int qp, const int numFrames,
+                        const int lookaheadFrames, const int gopSize, const int ctuSize, const double qpStrength)
+{
+  m_frameSkip                   = frameSkip;
+  m_inputBitDepth               = inputBitDepth;
+  m_msbExtendedBitDepth         = msbExtendedBitDepth;
+  m_internalBitDepth            = internalBitDepth;
+  m_sourceWidth                 = width;
+  m_sourceHeight                = height;
+  m_pad[0]                      = pad[0];
+  m_pad[1]                      = pad[1];
+  m_clipInputVideoToRec709Range = rec709;
+  m_inputFileName               = filename;
+  m_chromaFormatIdc             = inputChromaFormatIDC;
+  m_inputColourSpaceConvert     = colorSpaceConv;
+
+  m_lookaheadFrames = lookaheadFrames;
+  m_gopSize         = std::max( gopSize, 1 );
+  m_ctuSize         = ctuSize;
+  m_numCtus         = ( ( width + ctuSize - 1 ) / ctuSize ) * ( ( height + ctuSize - 1 ) / ctuSize );
+  m_widthInBlks     = ( width / 2 + m_blkSize - 1 ) / m_blkSize;
+  m_heightInBlks    = ( height / 2 + m_blkSize - 1 ) / m_blkSize;
+  m_qpStrength      = qpStrength;
+
+  // square root of the lambda of the slice QP, at the internal bit depth
+  const int lumaBitDepth = internalBitDepth[ChannelType::LUMA];
+  m_mvLambda = sqrt( 0.57 * pow( 2.0, ( qp - 12 ) / 3.0 ) ) * ( 1 << std::max( lumaBitDepth - 8, 0 ) );
+
+  m_stop         = false;
+  m_numFrames    = numFrames;
+  m_numAnalysed  = 0;
+  m_maxRequested = 0;
+  m_frames.clear();
+
+  m_thread = std::thread( &EncLookahead::xAnalyseFrames, this );
+}
+
+void EncLookahead::destroy()
+{
+  if( m_thread.joinable() )
+  {
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_stop = true;
+    }
+    m_cond.notify_all();
+    m_thread.join();
+  }
+  m_frames.clear();
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+double EncLookahead::getGOPWeight(const int firstPoc, const int numPics)
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  const int lastPoc = firstPoc + std::max( m_lookaheadFrames, numPics ) - 1;
+  xWaitForFrames( lock, firstPoc );
+  xWaitForFrames( lock, lastPoc );
+
+  // the first picture has no inter estimate and is left to the intra bit allocation of rate control
+  double gopCost = 0.0, windowCost = 0.0;
+  int    gopPics = 0, windowPics = 0;
+  for( int poc = std::max( firstPoc, 1 ); poc <= std::min( lastPoc, m_numAnalysed - 1 ); poc++ )
+  {
+    const auto it = m_frames.find( poc );
+    if( it == m_frames.end() )
+    {
+      continue;
+    }
+    if( poc < firstPoc + numPics )
+    {
+      gopCost += it->second.cost;
+      gopPics++;
+    }
+    windowCost += it->second.cost;
+    windowPics++;
+  }
+
+  if( gopPics == 0 || windowCost <= 0.0 )
+  {
+    return 1.0;
+  }
+  const double ratio = ( gopCost / gopPics ) / ( windowCost / windowPics );
+  return Clip3( 0.5, 2.0, pow( std::max( ratio, 0.01 ), m_rcCompress ) );
+}
+
+double EncLookahead::getPicWeight(const int poc, const int firstPoc, const int numPics)
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  xWaitForFrames( lock, firstPoc + numPics - 1 );
+
+  const auto itPic = m_frames.find( poc );
+  if( poc < 1 || itPic == m_frames.end() )
+  {
+    return 1.0;
+  }
+
+  double gopCost = 0.0;
+  int    gopPics = 0;
+  for( int i = std::max( firstPoc, 1 ); i < std::min( firstPoc + numPics, m_numAnalysed ); i++ )
+  {
+    const auto it = m_frames.find( i );
+    if( it != m_frames.end() )
+    {
+      gopCost += it->second.cost;
+      gopPics++;
+    }
+  }
+
+  if( gopCost <= 0.0 )
+  {
+    return 1.0;
+  }
+  const double ratio = itPic->second.cost / ( gopCost / gopPics );
+  return Clip3( 0.5, 2.0, pow( std::max( ratio, 0.01 ), m_rcCompress ) );
+}
+
+void EncLookahead::getCtuQpOffsets(const int poc, std::vector<double> &ctuQpOffsets)
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  xWaitForFrames( lock, poc + m_lookaheadFrames );
+
+  ctuQpOffsets.assign( m_numCtus, 0.0 );
+  if( m_frames.find( poc ) == m_frames.end() )
+  {
+    return;
+  }
+
+  // propagate the information each picture inherits from its reference back to the requested picture
+  const int numBlks = m_widthInBlks * m_heightInBlks;
+  std::vector<double> propagateIn( numBlks, 0.0 );
+  std::vector<double> propagateRef( numBlks );
+
+  for( int f = std::min( poc + m_lookaheadFrames, m_numAnalysed - 1 ); f > poc; f-- )
+  {
+    const auto it = m_frames.find( f );
+    if( it == m_frames.end() )
+    {
+      continue;
+    }
+    std::fill( propagateRef.begin(), propagateRef.end(), 0.0 );
+
+    const std::vector<LookaheadBlock> &blocks = it->second.blocks;
+    for( int by = 0; by < m_heightInBlks; by++ )
+    {
+      for( int bx = 0; bx < m_widthInBlks; bx++ )
+      {
+        const int             blkIdx = by * m_widthInBlks + bx;
+        const LookaheadBlock &blk    = blocks[blkIdx];
+        if( blk.interCost >= blk.intraCost )
+        {
+          continue;
+        }
+        const double amount = ( blk.intraCost + propagateIn[blkIdx] ) * ( blk.intraCost - blk.interCost ) / blk.intraCost;
+
+        // distribute over the up to four blocks covered by the motion compensated reference block
+        const int refX = bx * m_blkSize + blk.mvX;
+        const int refY = by * m_blkSize + blk.mvY;
+        const int refBx = floorDiv( refX, m_blkSize );
+        const int refBy = floorDiv( refY, m_blkSize );
+        const int fracX = refX - refBx * m_blkSize;
+        const int fracY = refY - refBy * m_blkSize;
+        const int weights[4] = { ( m_blkSize - fracX ) * ( m_blkSize - fracY ), fracX * ( m_blkSize - fracY ),
+                                 ( m_blkSize - fracX ) * fracY, fracX * fracY };
+        for( int k = 0; k < 4; k++ )
+        {
+          const int x = refBx + ( k & 1 );
+          const int y = refBy + ( k >> 1 );
+          if( weights[k] > 0 && x >= 0 && y >= 0 && x < m_widthInBlks && y < m_heightInBlks )
+          {
+            propagateRef[y * m_widthInBlks + x] += amount * weights[k] / ( m_blkSize * m_blkSize );
+          }
+        }
+      }
+    }
+    propagateIn.swap( propagateRef );
+  }
+
+  const std::vector<LookaheadBlock> &blocks = m_frames[poc].blocks;
+  const int widthInCtus = ( m_sourceWidth + m_ctuSize - 1 ) / m_ctuSize;
+  const int blkSizeFull = m_blkSize * 2;
+  std::vector<int> numCtuBlks( m_numCtus, 0 );
+  double sumOffset = 0.0;
+
+  for( int by = 0; by < m_heightInBlks; by++ )
+  {
+    for( int bx = 0; bx < m_widthInBlks; bx++ )
+    {
+      const int    blkIdx = by * m_widthInBlks + bx;
+      const double intra  = blocks[blkIdx].intraCost;
+      const double offset = -m_qpStrength * std::log2( ( intra + propagateIn[blkIdx] ) / intra );
+      const int    ctuIdx = ( by * blkSizeFull / m_ctuSize ) * widthInCtus + bx * blkSizeFull / m_ctuSize;
+      ctuQpOffsets[ctuIdx] += offset;
+      numCtuBlks[ctuIdx]++;
+      sumOffset += offset;
+    }
+  }
+
+  // only redistribute the bits within the picture, the picture level is left to the QP cascade and rate control
+  const double meanOffset = sumOffset / numBlks;
+  for( int i = 0; i < m_numCtus; i++ )
+  {
+    if( numCtuBlks[i] > 0 )
+    {
+      ctuQpOffsets[i] = Clip3( -m_maxQpOffset, m_maxQpOffset, ctuQpOffsets[i] / numCtuBlks[i] - meanOffset );
+    }
+  }
+}
+
+void EncLookahead::releaseFrames(const int poc)
+{
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_frames.erase( m_frames.begin(), m_frames.lower_bound( poc ) );
+    m_maxRequested = std::max( m_maxRequested, poc );
+  }
+  m_cond.notify_all();
+}
+
+// ====================================================================================================================
+// Private member functions
+// ====================================================================================================================
+
+void EncLookahead::xWaitForFrames(std::unique_lock<std::mutex> &lock, const int lastPoc)
+{
+  if( lastPoc > m_maxRequested )
+  {
+    m_maxRequested = lastPoc;
+    m_cond.notify_all();
+  }
+  m_cond.wait( lock, [&]() { return m_numAnalysed > std::min( lastPoc, m_numFrames - 1 ); } );
+}
+
+void EncLookahead::xAnalyseFrames()
+{
+  VideoIOYuv yuvFrames;
+  yuvFrames.open( m_inputFileName, false, m_inputBitDepth, m_msbExtendedBitDepth, m_internalBitDepth );
+  yuvFrames.skipFrames( m_frameSkip, m_sourceWidth - m_pad[0], m_sourceHeight - m_pad[1], m_chromaFormatIdc );
+
+  const Area area( 0, 0, m_sourceWidth, m_sourceHeight );
+  PelStorage orgPic;
+  PelStorage dummyPicBufferTO;   // Only used temporary in yuvFrames.read
+  orgPic.create( m_chromaFormatIdc, area );
+  dummyPicBufferTO.create( m_chromaFormatIdc, area );
+
+  PelStorage subsampled[2];
+  for( int i = 0; i < 2; i++ )
+  {
+    subsampled[i].create( ChromaFormat::_400, Area( 0, 0, m_sourceWidth / 2, m_sourceHeight / 2 ), 0, m_padding );
+  }
+
+  for( int poc = 0;; poc++ )
+  {
+    {
+      // stay a bounded number of pictures ahead of the encoder
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_cond.wait( lock, [&]() { return m_stop || poc >= m_numFrames || poc <= m_maxRequested + m_lookaheadFrames + 2 * m_gopSize; } );
+      if( m_stop || poc >= m_numFrames )
+      {
+        break;
+      }
+    }
+
+    if( !yuvFrames.read( orgPic, dummyPicBufferTO, m_inputColourSpaceConvert, m_pad, m_chromaFormatIdc,
+                         m_clipInputVideoToRec709Range ) )
+    {
+      // eof or read fail
+      {
+        std::unique_lock<std::mutex> lock( m_mutex );
+        m_numFrames = poc;
+      }
+      m_cond.notify_all();
+      break;
+    }
+
+    PelStorage &curr = subsampled[poc & 1];
+    xSubsampleLuma( orgPic, curr );
+
+    LookaheadFrame frame;
+    xAnalyseFrame( curr, poc > 0 ? &subsampled[1 - ( poc & 1 )] : nullptr, frame );
+
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_frames[poc] = std::move( frame );
+      m_numAnalysed = poc + 1;
+    }
+    m_cond.notify_all();
+  }
+
+  yuvFrames.close();
+}
+
+void EncLookahead::xSubsampleLuma(const PelStorage &input, PelStorage &output) const
+{
+  const CPelBuf src = input.get( COMPONENT_Y );
+  PelBuf        dst = output.get( COMPONENT_Y );
+
+  for( int y = 0; y < dst.height; y++ )
+  {
+    const Pel *srcRow0 = src.bufAt( 0, 2 * y );
+    const Pel *srcRow1 = src.bufAt( 0, 2 * y + 1 );
+    Pel       *dstRow  = dst.bufAt( 0, y );
+    for( int x = 0; x < dst.width; x++ )
+    {
+      dstRow[x] = ( srcRow0[2 * x] + srcRow0[2 * x + 1] + srcRow1[2 * x] + srcRow1[2 * x + 1] + 2 ) >> 2;
+    }
+  }
+  output.extendBorderPel( m_padding, m_padding );
+}
+
+void EncLookahead::xAnalyseFrame(const PelStorage &curr, const PelStorage *prev, LookaheadFrame &frame) const
+{
+  const CPelBuf currBuf = curr.get( COMPONENT_Y );
+
+  frame.blocks.resize( m_widthInBlks * m_heightInBlks );
+  frame.intraCost = 0.0;
+  frame.cost      = 0.0;
+
+  for( int by = 0; by < m_heightInBlks; by++ )
+  {
+    for( int bx = 0; bx < m_widthInBlks; bx++ )
+    {
+      LookaheadBlock &blk = frame.blocks[by * m_widthInBlks + bx];
+      blk.intraCost = std::max<uint32_t>( xIntraCost( currBuf, bx * m_blkSize, by * m_blkSize ), 1 );
+      blk.interCost = blk.intraCost;
+      blk.mvX       = 0;
+      blk.mvY       = 0;
+
+      if( prev != nullptr )
+      {
+        // median of the left, above and above right motion as search start
+        const LookaheadBlock *left       = bx > 0 ? &frame.blocks[by * m_widthInBlks + bx - 1] : nullptr;
+        const LookaheadBlock *above      = by > 0 ? &frame.blocks[( by - 1 ) * m_widthInBlks + bx] : nullptr;
+        const LookaheadBlock *aboveRight = by > 0 && bx + 1 < m_widthInBlks ? &frame.blocks[( by - 1 ) * m_widthInBlks + bx + 1] : above;
+        int predX = 0, predY = 0;
+        if( left && above )
+        {
+          predX = std::max( std::min( left->mvX, above->mvX ), std::min( std::max( left->mvX, above->mvX ), aboveRight->mvX ) );
+          predY = std::max( std::min( left->mvY, above->mvY ), std::min( std::max( left->mvY, above->mvY ), aboveRight->mvY ) );
+        }
+        else if( left || above )
+        {
+          predX = left ? left->mvX : above->mvX;
+          predY = left ? left->mvY : above->mvY;
+        }
+        blk.interCost = xInterCost( currBuf, prev->get( COMPONENT_Y ), bx * m_blkSize, by * m_blkSize, blk.mvX, blk.mvY, predX, predY );
+      }
+
+      frame.intraCost += blk.intraCost;
+      frame.cost      += std::min( blk.intraCost, blk.interCost );
+    }
+  }
+}
+
+uint32_t EncLookahead::xIntraCost(const CPelBuf &pic, const int x, const int y) const
+{
+  const bool topAvail  = y > 0;
+  const bool leftAvail = x > 0;
+  const Pel *top       = pic.bufAt( x, y - 1 );
+  int        left[8];
+  int        dc = 0;
+  for( int i = 0; i < m_blkSize; i++ )
+  {
+    left[i] = *pic.bufAt( x - 1, y + i );
+    dc += ( topAvail ? top[i] : 0 ) + ( leftAvail ? left[i] : 0 );
+  }
+  const int numRef = ( topAvail ? m_blkSize : 0 ) + ( leftAvail ? m_blkSize : 0 );
+  dc = numRef > 0 ? ( dc + numRef / 2 ) / numRef : 1 << ( m_internalBitDepth[ChannelType::LUMA] - 1 );
+
+  // DC, vertical, horizontal and the average of vertical and horizontal prediction
+  uint32_t best = MAX_UINT;
+  int      diff[64];
+  for( int mode = 0; mode < 4; mode++ )
+  {
+    if( ( mode == 1 && !topAvail ) || ( mode == 2 && !leftAvail ) || ( mode == 3 && !( topAvail && leftAvail ) ) )
+    {
+      continue;
+    }
+    for( int j = 0; j < m_blkSize; j++ )
+    {
+      const Pel *org = pic.bufAt( x, y + j );
+      for( int i = 0; i < m_blkSize; i++ )
+      {
+        const int pred = mode == 0 ? dc : mode == 1 ? top[i] : mode == 2 ? left[j] : ( top[i] + left[j] + 1 ) >> 1;
+        diff[j * m_blkSize + i] = org[i] - pred;
+      }
+    }
+    best = std::min( best, calcHadamard8x8( diff ) );
+  }
+  return best;
+}
+
+int EncLookahead::xMvCost(const int dx, const int dy) const
+{
+  const int bits = 2 * floorLog2( abs( dx ) + 1 ) + 1 + 2 * floorLog2( abs( dy ) + 1 ) + 1;
+  return int( m_mvLambda * bits + 0.5 );
+}
+
+uint32_t EncLookahead::xInterCost(const CPelBuf &curr, const CPelBuf &ref, const int x, const int y, int &mvX,
+                                  int &mvY, const int predX, const int predY) const
+{
+  auto blockSad = [&]( const int mx, const int my )
+  {
+    uint32_t sad = 0;
+    for( int j = 0; j < m_blkSize; j++ )
+    {
+      const Pel *org = curr.bufAt( x, y + j );
+      const Pel *pred = ref.bufAt( x + mx, y + my + j );
+      for( int i = 0; i < m_blkSize; i++ )
+      {
+        sad += abs( org[i] - pred[i] );
+      }
+    }
+    return sad + xMvCost( mx - predX, my - predY );
+  };
+
+  int      bestX    = 0;
+  int      bestY    = 0;
+  uint32_t bestCost = blockSad( 0, 0 );
+  const int startX  = Clip3( -m_searchRange, m_searchRange, predX );
+  const int startY  = Clip3( -m_searchRange, m_searchRange, predY );
+  if( startX != 0 || startY != 0 )
+  {
+    const uint32_t cost = blockSad( startX, startY );
+    if( cost < bestCost )
+    {
+      bestCost = cost;
+      bestX    = startX;
+      bestY    = startY;
+    }
+  }
+
+  // small diamond search followed by a square refinement
+  static const int diamond[4][2] = { { 0, -1 }, { -1, 0 }, { 1, 0 }, { 0, 1 } };
+  static const int square[8][2]  = { { -1, -1 }, { 0, -1 }, { 1, -1 }, { -1, 0 }, { 1, 0 }, { -1, 1 }, { 0, 1 }, { 1, 1 } };
+  for( int iter = 0; iter < 2 * m_searchRange; iter++ )
+  {
+    const int centerX = bestX;
+    const int centerY = bestY;
+    for( int k = 0; k < 4; k++ )
+    {
+      const int mx = centerX + diamond[k][0];
+      const int my = centerY + diamond[k][1];
+      if( abs( mx ) > m_searchRange || abs( my ) > m_searchRange )
+      {
+        continue;
+      }
+      const uint32_t cost = blockSad( mx, my );
+      if( cost < bestCost )
+      {
+        bestCost = cost;
+        bestX    = mx;
+        bestY    = my;
+      }
+    }
+    if( bestX == centerX && bestY == centerY )
+    {
+      break;
+    }
+  }
+  const int centerX = bestX;
+  const int centerY = bestY;
+  for( int k = 0; k < 8; k++ )
+  {
+    const int mx = centerX + square[k][0];
+    const int my = centerY + square[k][1];
+    if( abs( mx ) > m_searchRange || abs( my ) > m_searchRange )
+    {
+      continue;
+    }
+    const uint32_t cost = blockSad( mx, my );
+    if( cost < bestCost )
+    {
+      bestCost = cost;
+      bestX    = mx;
+      bestY    = my;
+    }
+  }
+
+  mvX = bestX;
+  mvY = bestY;
+
+  int diff[64];
+  for( int j = 0; j < m_blkSize; j++ )
+  {
+    const Pel *org = curr.bufAt( x, y + j );
+    const Pel *pred = ref.bufAt( x + mvX, y + mvY + j );
+    for( int i = 0; i < m_blkSize; i++ )
+    {
+      diff[j * m_blkSize + i] = org[i] - pred[i];
+    }
+  }
+  return std::max<uint32_t>( calcHadamard8x8( diff ) + xMvCost( mvX - predX, mvY - predY ), 1 );
+}
+
+//! \}
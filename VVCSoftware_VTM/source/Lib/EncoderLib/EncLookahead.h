@@ -0,0 +1,152 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2023, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     EncLookahead.h
+    \brief    first-pass lookahead analysis for rate control and QP adaptation (header)
+*/
+
+#ifndef __ENCLOOKAHEAD__
+#define __ENCLOOKAHEAD__
+
+#include "CommonLib/CommonDef.h"
+#include "CommonLib/Unit.h"
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! \ingroup EncoderLib
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// cost estimate of one lookahead block (16x16 luma samples, analysed at half resolution)
+struct LookaheadBlock
+{
+  int      mvX;
+  int      mvY;
+  uint32_t intraCost;
+  uint32_t interCost;
+};
+
+struct LookaheadFrame
+{
+  std::vector<LookaheadBlock> blocks;
+  double                      intraCost;
+  double                      cost;
+};
+
+/// Reads the input file ahead of the encoder on a background thread and estimates, on a 2x downsampled luma plane,
+/// the intra and inter (previous frame) cost of each picture and block. The encoder derives from these a complexity
+/// weight for the bit allocation of rate control and a propagation based (MB-tree like) QP offset per CTU.
+class EncLookahead
+{
+public:
+  EncLookahead();
+  ~EncLookahead();
+
+  void init(const int frameSkip, const BitDepths &inputBitDepth, const BitDepths &msbExtendedBitDepth,
+            const BitDepths &internalBitDepth, const int width, const int height, const int *pad, const bool rec709,
+            const std::string &filename, const ChromaFormat inputChroma,
+            const InputColourSpaceConversion colorSpaceConv, const int qp, const int numFrames,
+            const int lookaheadFrames, const int gopSize, const int ctuSize, const double qpStrength);
+  void destroy();
+
+  int    getNumCtus() const { return m_numCtus; }
+
+  /// bit allocation weight of a GOP relative to the pictures in the lookahead window following its first picture
+  double getGOPWeight(const int firstPoc, const int numPics);
+  /// bit allocation weight of a picture relative to the other pictures of its GOP
+  double getPicWeight(const int poc, const int firstPoc, const int numPics);
+  /// QP offset per CTU derived from the propagated importance of the picture's blocks, zero mean over the picture
+  void   getCtuQpOffsets(const int poc, std::vector<double> &ctuQpOffsets);
+  /// analysis data of pictures before the given POC is no longer needed
+  void   releaseFrames(const int poc);
+
+private:
+  // Private static member variables
+  static const int    m_blkSize;
+  static const int    m_padding;
+  static const int    m_searchRange;
+  static const double m_rcCompress;
+  static const double m_maxQpOffset;
+
+  // Private member variables
+  int         m_frameSkip;
+  std::string m_inputFileName;
+  BitDepths   m_inputBitDepth;
+  BitDepths   m_msbExtendedBitDepth;
+  BitDepths   m_internalBitDepth;
+  ChromaFormat m_chromaFormatIdc;
+  InputColourSpaceConversion m_inputColourSpaceConvert;
+  bool        m_clipInputVideoToRec709Range;
+  int         m_pad[2];
+  int         m_sourceWidth;
+  int         m_sourceHeight;
+
+  int         m_lookaheadFrames;
+  int         m_gopSize;
+  int         m_ctuSize;
+  int         m_numCtus;
+  int         m_widthInBlks;
+  int         m_heightInBlks;
+  double      m_qpStrength;
+  double      m_mvLambda;
+
+  std::thread                   m_thread;
+  std::mutex                    m_mutex;
+  std::condition_variable       m_cond;
+  bool                          m_stop;
+  int                           m_numFrames;       // frames to analyse, reduced when the input ends early
+  int                           m_numAnalysed;
+  int                           m_maxRequested;
+  std::map<int, LookaheadFrame> m_frames;
+
+  // Private functions
+  void   xAnalyseFrames();
+  void   xSubsampleLuma(const PelStorage &input, PelStorage &output) const;
+  void   xAnalyseFrame(const PelStorage &curr, const PelStorage *prev, LookaheadFrame &frame) const;
+  uint32_t xIntraCost(const CPelBuf &pic, const int x, const int y) const;
+  uint32_t xInterCost(const CPelBuf &curr, const CPelBuf &ref, const int x, const int y, int &mvX, int &mvY,
+                      const int predX, const int predY) const;
+  int    xMvCost(const int dx, const int dy) const;
+  void   xWaitForFrames(std::unique_lock<std::mutex> &lock, const int lastPoc);
+}; // END CLASS DEFINITION EncLookahead
+
+//! \}
+
+#endif // __ENCLOOKAHEAD__
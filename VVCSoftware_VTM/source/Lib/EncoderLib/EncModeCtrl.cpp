@@ -58,6 +58,7 @@ void EncModeCtrl::init( EncCfg *pCfg, RateCtrl *pRateCtrl, RdCost* pRdCost )
   m_pcEncCfg      = pCfg;
   m_pcRateCtrl    = pRateCtrl;
   m_pcRdCost      = pRdCost;
+  m_analysisCache = nullptr;
   m_fastDeltaQP   = false;
 #if SHARP_LUMA_DELTA_QP
   m_lumaQPOffset  = 0;
@@ -131,6 +132,17 @@ void EncModeCtrl::setBest( CodingStructure& cs )
   }
 }
 
+int EncModeCtrl::getAnalysisIntraMode( const CodingStructure &cs, const Partitioner &partitioner ) const
+{
+  if( m_analysisCache == nullptr || !isLuma( partitioner.chType ) )
+  {
+    return -1;
+  }
+  // MIP modes are not seeded, their mode index depends on the block size and the transposition is not stored
+  const AnalysisCu *refCu = m_analysisCache->getCu( cs.slice->getPOC(), partitioner.currArea().Y().center() );
+  return refCu && refCu->predMode == MODE_INTRA && !refCu->mipFlag ? refCu->intraDir : -1;
+}
+
 void EncModeCtrl::xGetMinMaxQP( int& minQP, int& maxQP, const CodingStructure& cs, const Partitioner &partitioner, const int baseQP, const SPS& sps, const PPS& pps, const PartSplit splitMode )
 {
   if( m_pcEncCfg->getUseRateCtrl() )
@@ -1486,6 +1498,15 @@ bool EncModeCtrlMTnoRQT::tryMode( const EncTestMode& encTestmode, const CodingSt
     return false;
   }
 
+  if( m_analysisCache )
+  {
+    const int analysisDecision = xCheckAnalysis( encTestmode, cs, partitioner );
+    if( analysisDecision >= 0 )
+    {
+      return analysisDecision > 0;
+    }
+  }
+
   if( bestCS && bestCS->cus.size() == 1 )
   {
     // update the best non-split cost
@@ -1890,12 +1911,10 @@ bool EncModeCtrlMTnoRQT::tryMode( const EncTestMode& encTestmode, const CodingSt
     if (cuECtx.get<double>(BEST_NO_IMV_COST) == UNSET_IMV_COST && !slice.isIntra())
 #endif
     {
-      unsigned idx1, idx2, idx3, idx4;
-      getAreaIdx(partitioner.currArea().Y(), *slice.getPPS()->pcv, idx1, idx2, idx3, idx4);
-      CHECKD(idx3 >= MAX_NUM_SIZES || idx4 >= MAX_NUM_SIZES, "MAX_NUM_SIZES is too small");
-      if (g_isReusedUniMVsFilled[idx1][idx2][idx3][idx4])
+      RefSetArray<Mv> *reusedUniMvs = m_pcInterSearch->getReusedUniMvs(partitioner.currArea().Y(), *slice.getPPS()->pcv);
+      if (reusedUniMvs)
       {
-        m_pcInterSearch->insertUniMvCands(partitioner.currArea().Y(), g_reusedUniMVs[idx1][idx2][idx3][idx4]);
+        m_pcInterSearch->insertUniMvCands(partitioner.currArea().Y(), *reusedUniMvs);
       }
     }
     if( !bestCS || ( bestCS && isModeSplit( bestMode ) ) )
@@ -2102,6 +2121,169 @@ bool EncModeCtrlMTnoRQT::checkSkipOtherLfnst( const EncTestMode& encTestmode, Co
   return skipOtherLfnst;
 }
 
+bool EncModeCtrlMTnoRQT::xSplitFollowsAnalysis( const PartSplit split, const CodingStructure &cs, const Partitioner &partitioner ) const
+{
+  // the split follows the reference partitioning if no reference CU crosses the boundaries of the sub-partitions
+  const Partitioning subAreas = PartitionerImpl::getCUSubPartitions( partitioner.currArea(), cs, split );
+
+  for( const UnitArea &subArea : subAreas )
+  {
+    const CompArea   &subY  = subArea.Y();
+    const AnalysisCu *refCu = m_analysisCache->getCu( m_slice->getPOC(), subY.pos() );
+
+    if( !refCu || refCu->x != subY.x || refCu->y != subY.y || refCu->width > subY.width || refCu->height > subY.height )
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool EncModeCtrlMTnoRQT::xAnalysisSplitAvailable( const ComprCUCtx &cuECtx, const CodingStructure &cs, Partitioner &partitioner ) const
+{
+  static const PartSplit splits[] = { CU_QUAD_SPLIT, CU_HORZ_SPLIT, CU_VERT_SPLIT, CU_TRIH_SPLIT, CU_TRIV_SPLIT };
+
+  for( const PartSplit split : splits )
+  {
+    if( split == CU_QUAD_SPLIT && cuECtx.maxDepth <= partitioner.currQtDepth )
+    {
+      continue;
+    }
+    if( partitioner.canSplit( split, cs ) && xSplitFollowsAnalysis( split, cs, partitioner ) )
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// -1: no decision, 0: the mode is ruled out by the loaded analysis, 1: the split follows the loaded partitioning
+int EncModeCtrlMTnoRQT::xCheckAnalysis( const EncTestMode& encTestmode, const CodingStructure &cs, Partitioner& partitioner )
+{
+  if( !isLuma( partitioner.chType ) || partitioner.treeType == TREE_C )
+  {
+    return -1;
+  }
+
+  if( encTestmode.type == ETM_INTER_ME && encTestmode.opts == ETO_STANDARD )
+  {
+    xSeedAnalysisMvs( cs, partitioner );
+  }
+
+  const int reuseLevel = m_analysisCache->getReuseLevel();
+#if REUSE_CU_RESULTS
+  if( reuseLevel < 2 || encTestmode.type == ETM_POST_DONT_SPLIT || encTestmode.type == ETM_RECO_CACHED )
+#else
+  if( reuseLevel < 2 || encTestmode.type == ETM_POST_DONT_SPLIT )
+#endif
+  {
+    return -1;
+  }
+
+  const CompArea   &area  = partitioner.currArea().Y();
+  const AnalysisCu *refCu = m_analysisCache->getCu( m_slice->getPOC(), area.pos() );
+  if( !refCu )
+  {
+    return -1;
+  }
+
+  ComprCUCtx    &cuECtx    = m_ComprCUCtxList.back();
+  const unsigned refArea   = refCu->width * refCu->height;
+  const bool     refCovers = refCu->x <= area.x && refCu->y <= area.y && refCu->x + refCu->width >= area.x + area.width
+                             && refCu->y + refCu->height >= area.y + area.height;
+  // at level 2 one split level of deviation from the reference partitioning is tolerated in either direction
+  const bool     tolerated = reuseLevel == 2 && ( refCovers ? 2 * area.area() >= refArea : 2 * refArea >= area.area() );
+
+  if( isModeSplit( encTestmode ) )
+  {
+    const PartSplit split = getPartSplit( encTestmode );
+    if( !partitioner.canSplit( split, cs ) )
+    {
+      return -1;
+    }
+    if( !refCovers && xSplitFollowsAnalysis( split, cs, partitioner ) )
+    {
+      if( tolerated )
+      {
+        return -1;
+      }
+      // the unsplit modes were ruled out, so the split must not be dropped by the fast split heuristics
+      if( split == CU_QUAD_SPLIT )
+      {
+        cuECtx.set( DID_QUAD_SPLIT, true );
+      }
+      return 1;
+    }
+    return tolerated ? -1 : 0;
+  }
+
+  if( !refCovers )
+  {
+    // only rule out the unsplit modes if a split following the reference remains to be tested
+    return !tolerated && xAnalysisSplitAvailable( cuECtx, cs, partitioner ) ? 0 : -1;
+  }
+
+  if( reuseLevel >= 3 && !getFastDeltaQp() )
+  {
+    const bool refIntra = refCu->predMode == MODE_INTRA || refCu->predMode == MODE_PLT;
+    if( refIntra && isModeInter( encTestmode ) && !partitioner.isConsInter() && area.area() <= 4096 )
+    {
+      return 0;
+    }
+    if( refCu->predMode == MODE_INTER && ( encTestmode.type == ETM_INTRA || encTestmode.type == ETM_PALETTE )
+        && !m_slice->isIntra() && !partitioner.isConsIntra() )
+    {
+      return 0;
+    }
+  }
+  return -1;
+}
+
+void EncModeCtrlMTnoRQT::xSeedAnalysisMvs( const CodingStructure &cs, const Partitioner &partitioner )
+{
+  const CompArea   &area  = partitioner.currArea().Y();
+  const AnalysisCu *refCu = m_analysisCache->getCu( m_slice->getPOC(), area.center() );
+  if( !refCu || refCu->predMode != MODE_INTER )
+  {
+    return;
+  }
+
+  // motion of the reference CU, scaled to the temporal distance of each reference picture of the current slice
+  const int         poc      = m_slice->getPOC();
+  const int         numLists = m_slice->isInterB() ? 2 : 1;
+  RefSetArray<Mv>   mvs;
+  RefSetArray<bool> valid    = {};
+  bool              found    = false;
+
+  for( int l = 0; l < numLists; l++ )
+  {
+    const RefPicList refList = RefPicList( l );
+    for( int refIdx = 0; refIdx < m_slice->getNumRefIdx( refList ); refIdx++ )
+    {
+      const int currDist = poc - m_slice->getRefPic( refList, refIdx )->getPOC();
+      for( const int src : { l, 1 - l } )
+      {
+        const int refDist = poc - refCu->refPoc[src];
+        if( ( refCu->interDir & ( 1 << src ) ) && refDist != 0 && currDist != 0 )
+        {
+          mvs[l][refIdx] = Mv( int( std::lround( double( refCu->mv[src][0] ) * currDist / refDist ) ),
+                               int( std::lround( double( refCu->mv[src][1] ) * currDist / refDist ) ) );
+          mvs[l][refIdx].clipToStorageBitDepth();
+          valid[l][refIdx] = true;
+          found            = true;
+          break;
+        }
+      }
+    }
+  }
+
+  if( found )
+  {
+    // entries without a motion vector of the reference CU are marked invalid, so they are not tested as zero MVs
+    m_pcInterSearch->insertUniMvCands( area, mvs, &valid );
+  }
+}
+
 bool EncModeCtrlMTnoRQT::useModeResult( const EncTestMode& encTestmode, CodingStructure*& tempCS, Partitioner& partitioner )
 {
   xExtractFeatures( encTestmode, *tempCS );
@@ -44,6 +44,7 @@
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/CodingStructure.h"
 #include "InterSearch.h"
+#include "EncAnalysisCache.h"
 
 #include <typeinfo>
 #include <vector>
@@ -287,6 +288,7 @@ protected:
   int                   m_lumaQPOffset;
 #endif
   std::map<int, int*>  *m_bimQPMap;
+  const EncAnalysisCache *m_analysisCache;
   bool                  m_fastDeltaQP;
   //static_vector<ComprCUCtx, ( MAX_CU_DEPTH << 2 )> m_ComprCUCtxList;
   InterSearch*          m_pcInterSearch;
@@ -397,6 +399,9 @@ public:
     auto it = m_bimQPMap->find(poc);
     return (it == m_bimQPMap->end()) ? 0 : (*m_bimQPMap)[poc][ctuId];
   }
+  void   setAnalysisCache             ( const EncAnalysisCache *cache ) { m_analysisCache = cache->isLoaded() ? cache : nullptr; }
+  /// luma intra mode of the loaded CU covering the centre of the current area, -1 if none is available
+  int    getAnalysisIntraMode         ( const CodingStructure &cs, const Partitioner &partitioner ) const;
 
 #if GDR_ENABLED
 void forceIntraMode()
@@ -867,6 +872,12 @@ public:
   virtual bool checkSkipOtherLfnst( const EncTestMode& encTestmode, CodingStructure*& tempCS, Partitioner& partitioner );
 
   bool xSkipTreeCandidate(const PartSplit split, const double* splitRdCostBest, const SliceType& sliceType) const;
+
+private:
+  bool xSplitFollowsAnalysis   ( const PartSplit split, const CodingStructure &cs, const Partitioner &partitioner ) const;
+  bool xAnalysisSplitAvailable ( const ComprCUCtx &cuECtx, const CodingStructure &cs, Partitioner &partitioner ) const;
+  int  xCheckAnalysis          ( const EncTestMode& encTestmode, const CodingStructure &cs, Partitioner& partitioner );
+  void xSeedAnalysisMvs        ( const CodingStructure &cs, const Partitioner &partitioner );
 };
 
 //! \}
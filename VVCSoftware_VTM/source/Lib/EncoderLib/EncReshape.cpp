@@ -76,6 +76,10 @@ void  EncReshape::createEnc(int picWidth, int picHeight, uint32_t maxCUWidth, ui
   {
     m_invLUT.resize(m_reshapeLUTSize,0);
   }
+  m_fwdPwl.lut    = m_fwdLUT.data();
+  m_fwdPwl.maxVal = m_reshapeLUTSize - 1;
+  m_invPwl.lut    = m_invLUT.data();
+  m_invPwl.maxVal = m_reshapeLUTSize - 1;
   if (m_binCW.empty())
   {
     m_binCW.resize(PIC_ANALYZE_CW_BINS);
@@ -1320,6 +1324,7 @@ void EncReshape::initLUTfromdQPModel()
     int invSample = m_inputPivot[idxYInv] + ((m_invScaleCoef[idxYInv] * (lumaSample - m_reshapePivot[idxYInv]) + (1 << (FP_PREC - 1))) >> FP_PREC);
     m_invLUT[lumaSample] = Clip3((Pel)0, (Pel)((1 << m_lumaBD) - 1), (Pel)(invSample));
   }
+  updatePwl();
 }
 
 void EncReshape::constructReshaperLMCS()
@@ -1417,6 +1422,7 @@ void EncReshape::constructReshaperLMCS()
     int invSample = m_inputPivot[idxYInv] + ((m_invScaleCoef[idxYInv] * (lumaSample - m_reshapePivot[idxYInv]) + (1 << (FP_PREC - 1))) >> FP_PREC);
     m_invLUT[lumaSample] = Clip3((Pel)0, (Pel)((1 << m_lumaBD) - 1), (Pel)(invSample));
   }
+  updatePwl();
   for (i = 0; i < PIC_CODE_CW_BINS; i++)
   {
     int start = i*histLenth;
@@ -1558,7 +1558,9 @@ void EncSlice::compressSlice( Picture* pcPic, const bool bCompressEntireSlice, c
 #endif
   m_pcInterSearch->resetAffineMVList();
   m_pcInterSearch->resetUniMvList();
-  ::memset(g_isReusedUniMVsFilled, 0, sizeof(g_isReusedUniMVsFilled));
+  m_pcInterSearch->resetSubPelCache(pcPic);
+  m_pcInterSearch->resetReusedUniMvs();
+  m_pcCuEncoder->initSplitJobsSlice(pcPic);
   encodeCtus( pcPic, bCompressEntireSlice, bFastDeltaQP, m_pcLib );
   if (checkPLTRatio)
   {
@@ -1883,6 +1885,7 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
     {
       pcPic->mctsInfo.init( &cs, ctuRsAddr );
     }
+    cs.initNeighbourStrip( ctuArea.Y() );
 
     if (pCfg->getSwitchPOC() != pcPic->poc || ctuRsAddr >= pCfg->getDebugCTU())
     {
@@ -2001,6 +2004,7 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
 
 void EncSlice::encodeSlice   ( Picture* pcPic, OutputBitstream* pcSubstreams, uint32_t &numBinsCoded )
 {
+  PerfTimer timer(m_pcLib->getPerfCounters(), PerfStage::ENTROPY_CODING);
 
   Slice *const pcSlice                 = pcPic->slices[getSliceSegmentIdx()];
   const bool wavefrontsEnabled         = pcSlice->getSPS()->getEntropyCodingSyncEnabledFlag();
@@ -84,6 +84,7 @@ static const Mv s_acMvRefineQ[9] =
 
 InterSearch::InterSearch()
   : m_modeCtrl(nullptr)
+  , m_perfCounters(nullptr)
   , m_pSplitCS(nullptr)
   , m_pFullCS(nullptr)
   , m_pcEncCfg(nullptr)
@@ -140,6 +141,7 @@ void InterSearch::destroy()
   }
   m_tmpStorageCtu.destroy();
   m_tmpAffiStorage.destroy();
+  m_subPelCache.destroy();
 
   if (m_tmpAffiError != nullptr)
   {
@@ -175,9 +177,34 @@ void InterSearch::destroy()
   }
   m_uniMvListIdx = 0;
   m_uniMvListSize = 0;
+  m_reusedUniMvs.reset();
+  m_reusedUniMvsFilled.clear();
   m_isInitialized = false;
 }
 
+static constexpr size_t REUSED_UNI_MV_ENTRIES = MAX_CU_SIZE_IN_PARTS * MAX_CU_SIZE_IN_PARTS * MAX_NUM_SIZES * MAX_NUM_SIZES;
+
+static size_t getReusedUniMvIdx(const Area &area, const PreCalcValues &pcv)
+{
+  unsigned idx1, idx2, idx3, idx4;
+  getAreaIdx(area, pcv, idx1, idx2, idx3, idx4);
+  CHECKD(idx3 >= MAX_NUM_SIZES || idx4 >= MAX_NUM_SIZES, "MAX_NUM_SIZES is too small");
+  return ((size_t(idx1) * MAX_CU_SIZE_IN_PARTS + idx2) * MAX_NUM_SIZES + idx3) * MAX_NUM_SIZES + idx4;
+}
+
+void InterSearch::setReusedUniMvs(const Area &area, const PreCalcValues &pcv, const RefSetArray<Mv> &mvs)
+{
+  const size_t idx = getReusedUniMvIdx(area, pcv);
+  ::memcpy(m_reusedUniMvs[idx], mvs, sizeof(RefSetArray<Mv>));
+  m_reusedUniMvsFilled[idx] = true;
+}
+
+RefSetArray<Mv> *InterSearch::getReusedUniMvs(const Area &area, const PreCalcValues &pcv)
+{
+  const size_t idx = getReusedUniMvIdx(area, pcv);
+  return m_reusedUniMvsFilled[idx] ? &m_reusedUniMvs[idx] : nullptr;
+}
+
 void InterSearch::setTempBuffers( CodingStructure ****pSplitCS, CodingStructure ****pFullCS, CodingStructure **pSaveCS )
 {
   m_pSplitCS = pSplitCS;
@@ -267,6 +294,10 @@ void InterSearch::init(EncCfg *pcEncCfg, TrQuant *pcTrQuant, int searchRange, in
   }
   m_uniMvListIdx = 0;
   m_uniMvListSize = 0;
+  m_reusedUniMvs.reset(new RefSetArray<Mv>[REUSED_UNI_MV_ENTRIES]);
+  m_reusedUniMvsFilled.assign(REUSED_UNI_MV_ENTRIES, false);
+  m_subPelCache.init(size_t(pcEncCfg->getSubPelMECacheSize()) << 20, maxCUWidth, &m_if);
+  m_subPelCacheCtx.refPic = nullptr;
   m_isInitialized = true;
 }
 
@@ -339,7 +370,7 @@ void InterSearch::storeAffineMotion(Mv acAffineMv[2][3], int16_t affineRefIdx[2]
   }
 }
 
-inline void InterSearch::xTZSearchHelp( IntTZSearchStruct& rcStruct, const int iSearchX, const int iSearchY, const uint8_t ucPointNr, const uint32_t uiDistance )
+inline void InterSearch::xTZSearchHelp( IntTZSearchStruct& rcStruct, const int iSearchX, const int iSearchY, const uint8_t ucPointNr, const uint32_t uiDistance, const Distortion* precalcSad )
 {
   Distortion  uiSad = 0;
 
@@ -357,7 +388,7 @@ inline void InterSearch::xTZSearchHelp( IntTZSearchStruct& rcStruct, const int i
     // Skip search if bit cost is already larger than best SAD
     if (uiBitCost < rcStruct.uiBestSad)
     {
-      Distortion uiTempSad = m_cDistParam.distFunc( m_cDistParam );
+      Distortion uiTempSad = precalcSad != nullptr ? *precalcSad : m_cDistParam.distFunc( m_cDistParam );
 
       if((uiTempSad + uiBitCost) < rcStruct.uiBestSad)
       {
@@ -406,7 +437,7 @@ inline void InterSearch::xTZSearchHelp( IntTZSearchStruct& rcStruct, const int i
   }
   else
   {
-    uiSad = m_cDistParam.distFunc( m_cDistParam );
+    uiSad = precalcSad != nullptr ? *precalcSad : m_cDistParam.distFunc( m_cDistParam );
 
     // only add motion cost if uiSad is smaller than best. Otherwise pointless
     // to add motion cost.
@@ -430,10 +461,47 @@ inline void InterSearch::xTZSearchHelp( IntTZSearchStruct& rcStruct, const int i
 }
 
 
+inline void InterSearch::xTZSearchHelpBatch( IntTZSearchStruct& rcStruct, const TZSearchCandList& cands )
+{
+  const int  numCand = (int) cands.size();
+  const Pel *cur[TZ_SEARCH_MAX_CANDS];
+  Distortion sad[TZ_SEARCH_MAX_CANDS];
+  int        batchIdx[TZ_SEARCH_MAX_CANDS];
+  int        numBatch = 0;
+
+  for (int i = 0; i < numCand; i++)
+  {
+    batchIdx[i] = -1;
+
+    // keep the bit cost early-out of xTZSearchHelp, the best SAD only decreases while the batch is evaluated, so a
+    // candidate rejected here would be rejected there as well
+    if (1 == rcStruct.subShiftMode
+        && m_pcRdCost->getCostOfVectorWithPredictor(cands[i].x, cands[i].y, rcStruct.imvShift) >= rcStruct.uiBestSad)
+    {
+      continue;
+    }
+
+    batchIdx[i]     = numBatch;
+    cur[numBatch++] = rcStruct.piRefY + cands[i].y * rcStruct.iRefStride + cands[i].x;
+  }
+
+  // the SADs do not depend on the order of evaluation, so they are computed up front with the original block shared
+  // between the candidates, the decisions are then taken in the original order. Unlike distFunc, the batch computes the
+  // full SAD without the maximumDistortionForEarlyExit exit, but that bound is the best cost, so a candidate that
+  // would have exited early is rejected with its full SAD as well
+  const bool batched = numBatch > 1 && m_pcRdCost->getSADMulti( m_cDistParam, cur, numBatch, sad );
+
+  for (int i = 0; i < numCand; i++)
+  {
+    const Distortion *precalcSad = batched && batchIdx[i] >= 0 ? &sad[batchIdx[i]] : nullptr;
+    xTZSearchHelp( rcStruct, cands[i].x, cands[i].y, cands[i].pointNr, cands[i].distance, precalcSad );
+  }
+}
 
 inline void InterSearch::xTZ2PointSearch( IntTZSearchStruct& rcStruct )
 {
   const SearchRange& sr = rcStruct.searchRange;
+  TZSearchCandList   cands;
 
   static const int xOffset[2][9] = { {  0, -1, -1,  0, -1, +1, -1, -1, +1 }, {  0,  0, +1, +1, -1, +1,  0, +1,  0 } };
   static const int yOffset[2][9] = { {  0,  0, -1, -1, +1, -1,  0, +1,  0 }, {  0, -1, -1,  0, -1, +1, +1, +1, +1 } };
@@ -449,19 +517,22 @@ inline void InterSearch::xTZ2PointSearch( IntTZSearchStruct& rcStruct )
 
   if( iX1 >= sr.left && iX1 <= sr.right && iY1 >= sr.top && iY1 <= sr.bottom )
   {
-    xTZSearchHelp( rcStruct, iX1, iY1, 0, 2 );
+    cands.push_back( TZSearchCand( iX1, iY1, 0, 2 ) );
   }
 
   if( iX2 >= sr.left && iX2 <= sr.right && iY2 >= sr.top && iY2 <= sr.bottom )
   {
-    xTZSearchHelp( rcStruct, iX2, iY2, 0, 2 );
+    cands.push_back( TZSearchCand( iX2, iY2, 0, 2 ) );
   }
+
+  xTZSearchHelpBatch( rcStruct, cands );
 }
 
 
 inline void InterSearch::xTZ8PointSquareSearch( IntTZSearchStruct& rcStruct, const int iStartX, const int iStartY, const int iDist )
 {
   const SearchRange& sr = rcStruct.searchRange;
+  TZSearchCandList   cands;
   // 8 point search,                   //   1 2 3
   // search around the start point     //   4 0 5
   // with the required  distance       //   6 7 8
@@ -476,38 +547,40 @@ inline void InterSearch::xTZ8PointSquareSearch( IntTZSearchStruct& rcStruct, con
   {
     if ( iLeft >= sr.left ) // check top left
     {
-      xTZSearchHelp( rcStruct, iLeft, iTop, 1, iDist );
+      cands.push_back( TZSearchCand( iLeft, iTop, 1, iDist ) );
     }
     // top middle
-    xTZSearchHelp( rcStruct, iStartX, iTop, 2, iDist );
+    cands.push_back( TZSearchCand( iStartX, iTop, 2, iDist ) );
 
     if ( iRight <= sr.right ) // check top right
     {
-      xTZSearchHelp( rcStruct, iRight, iTop, 3, iDist );
+      cands.push_back( TZSearchCand( iRight, iTop, 3, iDist ) );
     }
   } // check top
   if ( iLeft >= sr.left ) // check middle left
   {
-    xTZSearchHelp( rcStruct, iLeft, iStartY, 4, iDist );
+    cands.push_back( TZSearchCand( iLeft, iStartY, 4, iDist ) );
   }
   if ( iRight <= sr.right ) // check middle right
   {
-    xTZSearchHelp( rcStruct, iRight, iStartY, 5, iDist );
+    cands.push_back( TZSearchCand( iRight, iStartY, 5, iDist ) );
   }
   if ( iBottom <= sr.bottom ) // check bottom
   {
     if ( iLeft >= sr.left ) // check bottom left
     {
-      xTZSearchHelp( rcStruct, iLeft, iBottom, 6, iDist );
+      cands.push_back( TZSearchCand( iLeft, iBottom, 6, iDist ) );
     }
     // check bottom middle
-    xTZSearchHelp( rcStruct, iStartX, iBottom, 7, iDist );
+    cands.push_back( TZSearchCand( iStartX, iBottom, 7, iDist ) );
 
     if ( iRight <= sr.right ) // check bottom right
     {
-      xTZSearchHelp( rcStruct, iRight, iBottom, 8, iDist );
+      cands.push_back( TZSearchCand( iRight, iBottom, 8, iDist ) );
     }
   } // check bottom
+
+  xTZSearchHelpBatch( rcStruct, cands );
 }
 
 inline void InterSearch::xTZ8PointDiamondSearch( IntTZSearchStruct& rcStruct,
@@ -517,6 +590,7 @@ inline void InterSearch::xTZ8PointDiamondSearch( IntTZSearchStruct& rcStruct,
                                                  const bool bCheckCornersAtDist1 )
 {
   const SearchRange& sr = rcStruct.searchRange;
+  TZSearchCandList   cands;
   // 8 point search,                   //   1 2 3
   // search around the start point     //   4 0 5
   // with the required  distance       //   6 7 8
@@ -535,26 +609,26 @@ inline void InterSearch::xTZ8PointDiamondSearch( IntTZSearchStruct& rcStruct,
       {
         if ( iLeft >= sr.left) // check top-left
         {
-          xTZSearchHelp( rcStruct, iLeft, iTop, 1, iDist );
+          cands.push_back( TZSearchCand( iLeft, iTop, 1, iDist ) );
         }
-        xTZSearchHelp( rcStruct, iStartX, iTop, 2, iDist );
+        cands.push_back( TZSearchCand( iStartX, iTop, 2, iDist ) );
         if ( iRight <= sr.right ) // check middle right
         {
-          xTZSearchHelp( rcStruct, iRight, iTop, 3, iDist );
+          cands.push_back( TZSearchCand( iRight, iTop, 3, iDist ) );
         }
       }
       else
       {
-        xTZSearchHelp( rcStruct, iStartX, iTop, 2, iDist );
+        cands.push_back( TZSearchCand( iStartX, iTop, 2, iDist ) );
       }
     }
     if ( iLeft >= sr.left ) // check middle left
     {
-      xTZSearchHelp( rcStruct, iLeft, iStartY, 4, iDist );
+      cands.push_back( TZSearchCand( iLeft, iStartY, 4, iDist ) );
     }
     if ( iRight <= sr.right ) // check middle right
     {
-      xTZSearchHelp( rcStruct, iRight, iStartY, 5, iDist );
+      cands.push_back( TZSearchCand( iRight, iStartY, 5, iDist ) );
     }
     if ( iBottom <= sr.bottom ) // check bottom
     {
@@ -562,17 +636,17 @@ inline void InterSearch::xTZ8PointDiamondSearch( IntTZSearchStruct& rcStruct,
       {
         if ( iLeft >= sr.left) // check top-left
         {
-          xTZSearchHelp( rcStruct, iLeft, iBottom, 6, iDist );
+          cands.push_back( TZSearchCand( iLeft, iBottom, 6, iDist ) );
         }
-        xTZSearchHelp( rcStruct, iStartX, iBottom, 7, iDist );
+        cands.push_back( TZSearchCand( iStartX, iBottom, 7, iDist ) );
         if ( iRight <= sr.right ) // check middle right
         {
-          xTZSearchHelp( rcStruct, iRight, iBottom, 8, iDist );
+          cands.push_back( TZSearchCand( iRight, iBottom, 8, iDist ) );
         }
       }
       else
       {
-        xTZSearchHelp( rcStruct, iStartX, iBottom, 7, iDist );
+        cands.push_back( TZSearchCand( iStartX, iBottom, 7, iDist ) );
       }
     }
   }
@@ -588,54 +662,54 @@ inline void InterSearch::xTZ8PointDiamondSearch( IntTZSearchStruct& rcStruct,
       if (  iTop >= sr.top && iLeft >= sr.left &&
            iRight <= sr.right && iBottom <= sr.bottom ) // check border
       {
-        xTZSearchHelp( rcStruct, iStartX,  iTop,      2, iDist    );
-        xTZSearchHelp( rcStruct, iLeft_2,  iTop_2,    1, iDist>>1 );
-        xTZSearchHelp( rcStruct, iRight_2, iTop_2,    3, iDist>>1 );
-        xTZSearchHelp( rcStruct, iLeft,    iStartY,   4, iDist    );
-        xTZSearchHelp( rcStruct, iRight,   iStartY,   5, iDist    );
-        xTZSearchHelp( rcStruct, iLeft_2,  iBottom_2, 6, iDist>>1 );
-        xTZSearchHelp( rcStruct, iRight_2, iBottom_2, 8, iDist>>1 );
-        xTZSearchHelp( rcStruct, iStartX,  iBottom,   7, iDist    );
+        cands.push_back( TZSearchCand( iStartX,  iTop,      2, iDist    ) );
+        cands.push_back( TZSearchCand( iLeft_2,  iTop_2,    1, iDist>>1 ) );
+        cands.push_back( TZSearchCand( iRight_2, iTop_2,    3, iDist>>1 ) );
+        cands.push_back( TZSearchCand( iLeft,    iStartY,   4, iDist    ) );
+        cands.push_back( TZSearchCand( iRight,   iStartY,   5, iDist    ) );
+        cands.push_back( TZSearchCand( iLeft_2,  iBottom_2, 6, iDist>>1 ) );
+        cands.push_back( TZSearchCand( iRight_2, iBottom_2, 8, iDist>>1 ) );
+        cands.push_back( TZSearchCand( iStartX,  iBottom,   7, iDist    ) );
       }
       else // check border
       {
         if ( iTop >= sr.top ) // check top
         {
-          xTZSearchHelp( rcStruct, iStartX, iTop, 2, iDist );
+          cands.push_back( TZSearchCand( iStartX, iTop, 2, iDist ) );
         }
         if ( iTop_2 >= sr.top ) // check half top
         {
           if ( iLeft_2 >= sr.left ) // check half left
           {
-            xTZSearchHelp( rcStruct, iLeft_2, iTop_2, 1, (iDist>>1) );
+            cands.push_back( TZSearchCand( iLeft_2, iTop_2, 1, (iDist>>1) ) );
           }
           if ( iRight_2 <= sr.right ) // check half right
           {
-            xTZSearchHelp( rcStruct, iRight_2, iTop_2, 3, (iDist>>1) );
+            cands.push_back( TZSearchCand( iRight_2, iTop_2, 3, (iDist>>1) ) );
           }
         } // check half top
         if ( iLeft >= sr.left ) // check left
         {
-          xTZSearchHelp( rcStruct, iLeft, iStartY, 4, iDist );
+          cands.push_back( TZSearchCand( iLeft, iStartY, 4, iDist ) );
         }
         if ( iRight <= sr.right ) // check right
         {
-          xTZSearchHelp( rcStruct, iRight, iStartY, 5, iDist );
+          cands.push_back( TZSearchCand( iRight, iStartY, 5, iDist ) );
         }
         if ( iBottom_2 <= sr.bottom ) // check half bottom
         {
           if ( iLeft_2 >= sr.left ) // check half left
           {
-            xTZSearchHelp( rcStruct, iLeft_2, iBottom_2, 6, (iDist>>1) );
+            cands.push_back( TZSearchCand( iLeft_2, iBottom_2, 6, (iDist>>1) ) );
           }
           if ( iRight_2 <= sr.right ) // check half right
           {
-            xTZSearchHelp( rcStruct, iRight_2, iBottom_2, 8, (iDist>>1) );
+            cands.push_back( TZSearchCand( iRight_2, iBottom_2, 8, (iDist>>1) ) );
           }
         } // check half bottom
         if ( iBottom <= sr.bottom ) // check bottom
         {
-          xTZSearchHelp( rcStruct, iStartX, iBottom, 7, iDist );
+          cands.push_back( TZSearchCand( iStartX, iBottom, 7, iDist ) );
         }
       } // check border
     }
@@ -644,39 +718,39 @@ inline void InterSearch::xTZ8PointDiamondSearch( IntTZSearchStruct& rcStruct,
       if ( iTop >= sr.top && iLeft >= sr.left &&
            iRight <= sr.right && iBottom <= sr.bottom ) // check border
       {
-        xTZSearchHelp( rcStruct, iStartX, iTop,    0, iDist );
-        xTZSearchHelp( rcStruct, iLeft,   iStartY, 0, iDist );
-        xTZSearchHelp( rcStruct, iRight,  iStartY, 0, iDist );
-        xTZSearchHelp( rcStruct, iStartX, iBottom, 0, iDist );
+        cands.push_back( TZSearchCand( iStartX, iTop,    0, iDist ) );
+        cands.push_back( TZSearchCand( iLeft,   iStartY, 0, iDist ) );
+        cands.push_back( TZSearchCand( iRight,  iStartY, 0, iDist ) );
+        cands.push_back( TZSearchCand( iStartX, iBottom, 0, iDist ) );
         for ( int index = 1; index < 4; index++ )
         {
           const int iPosYT = iTop    + ((iDist>>2) * index);
           const int iPosYB = iBottom - ((iDist>>2) * index);
           const int iPosXL = iStartX - ((iDist>>2) * index);
           const int iPosXR = iStartX + ((iDist>>2) * index);
-          xTZSearchHelp( rcStruct, iPosXL, iPosYT, 0, iDist );
-          xTZSearchHelp( rcStruct, iPosXR, iPosYT, 0, iDist );
-          xTZSearchHelp( rcStruct, iPosXL, iPosYB, 0, iDist );
-          xTZSearchHelp( rcStruct, iPosXR, iPosYB, 0, iDist );
+          cands.push_back( TZSearchCand( iPosXL, iPosYT, 0, iDist ) );
+          cands.push_back( TZSearchCand( iPosXR, iPosYT, 0, iDist ) );
+          cands.push_back( TZSearchCand( iPosXL, iPosYB, 0, iDist ) );
+          cands.push_back( TZSearchCand( iPosXR, iPosYB, 0, iDist ) );
         }
       }
       else // check border
       {
         if ( iTop >= sr.top ) // check top
         {
-          xTZSearchHelp( rcStruct, iStartX, iTop, 0, iDist );
+          cands.push_back( TZSearchCand( iStartX, iTop, 0, iDist ) );
         }
         if ( iLeft >= sr.left ) // check left
         {
-          xTZSearchHelp( rcStruct, iLeft, iStartY, 0, iDist );
+          cands.push_back( TZSearchCand( iLeft, iStartY, 0, iDist ) );
         }
         if ( iRight <= sr.right ) // check right
         {
-          xTZSearchHelp( rcStruct, iRight, iStartY, 0, iDist );
+          cands.push_back( TZSearchCand( iRight, iStartY, 0, iDist ) );
         }
         if ( iBottom <= sr.bottom ) // check bottom
         {
-          xTZSearchHelp( rcStruct, iStartX, iBottom, 0, iDist );
+          cands.push_back( TZSearchCand( iStartX, iBottom, 0, iDist ) );
         }
         for ( int index = 1; index < 4; index++ )
         {
@@ -689,28 +763,30 @@ inline void InterSearch::xTZ8PointDiamondSearch( IntTZSearchStruct& rcStruct,
           {
             if ( iPosXL >= sr.left ) // check left
             {
-              xTZSearchHelp( rcStruct, iPosXL, iPosYT, 0, iDist );
+              cands.push_back( TZSearchCand( iPosXL, iPosYT, 0, iDist ) );
             }
             if ( iPosXR <= sr.right ) // check right
             {
-              xTZSearchHelp( rcStruct, iPosXR, iPosYT, 0, iDist );
+              cands.push_back( TZSearchCand( iPosXR, iPosYT, 0, iDist ) );
             }
           } // check top
           if ( iPosYB <= sr.bottom ) // check bottom
           {
             if ( iPosXL >= sr.left ) // check left
             {
-              xTZSearchHelp( rcStruct, iPosXL, iPosYB, 0, iDist );
+              cands.push_back( TZSearchCand( iPosXL, iPosYB, 0, iDist ) );
             }
             if ( iPosXR <= sr.right ) // check right
             {
-              xTZSearchHelp( rcStruct, iPosXR, iPosYB, 0, iDist );
+              cands.push_back( TZSearchCand( iPosXR, iPosYB, 0, iDist ) );
             }
           } // check bottom
         } // for ...
       } // check border
     } // iDist <= 8
   } // iDist == 1
+
+  xTZSearchHelpBatch( rcStruct, cands );
 }
 
 #if GDR_ENABLED
@@ -738,9 +814,10 @@ Distortion InterSearch::xPatternRefinement( const CPelBuf* pcPatternKey,
   bool                   distBestOk       = false;
   bool allOk = true;
 #endif
-  Pel*  piRefPos;
+  const Pel* piRefPos;
   int iRefStride = pcPatternKey->width + 1;
   m_pcRdCost->setDistParam( m_cDistParam, *pcPatternKey, m_filteredBlock[0][0][0], iRefStride, m_lumaClpRng.bd, COMPONENT_Y, 0, 1, m_pcEncCfg->getUseHADME() && bAllowUseOfHadamard );
+  const SubPelCacheCtx &cacheCtx = m_subPelCacheCtx;
 
   const Mv* pcMvRefine = (iFrac == 2 ? s_acMvRefineH : s_acMvRefineQ);
 #if GDR_ENABLED
@@ -760,15 +837,33 @@ Distortion InterSearch::xPatternRefinement( const CPelBuf* pcPatternKey,
 
     int horVal = cMvTest.getHor() * iFrac;
     int verVal = cMvTest.getVer() * iFrac;
-    piRefPos = m_filteredBlock[verVal & 3][horVal & 3][0];
-
-    if (horVal == 2 && (verVal & 1) == 0)
+    if (cacheCtx.refPic != nullptr)
     {
-      piRefPos += 1;
+      // horVal and verVal are quarter-pel offsets relative to the integer-pel position of the block
+      const Position pos = cacheCtx.pos.offset(horVal >> 2, verVal >> 2);
+      if ((horVal & 3) == 0 && (verVal & 3) == 0)
+      {
+        piRefPos                = cacheCtx.intRef + (verVal >> 2) * cacheCtx.intRefStride + (horVal >> 2);
+        m_cDistParam.cur.stride = cacheCtx.intRefStride;
+      }
+      else
+      {
+        piRefPos = m_subPelCache.getBlock(*cacheCtx.refPic, horVal & 3, verVal & 3, cacheCtx.useAltHpelIf,
+                                          Area(pos, Size(pcPatternKey->width, pcPatternKey->height)), m_lumaClpRng, m_cDistParam.cur.stride);
+      }
     }
-    if ((horVal & 1) == 0 && verVal == 2)
+    else
     {
-      piRefPos += iRefStride;
+      piRefPos = m_filteredBlock[verVal & 3][horVal & 3][0];
+
+      if (horVal == 2 && (verVal & 1) == 0)
+      {
+        piRefPos += 1;
+      }
+      if ((horVal & 1) == 0 && verVal == 2)
+      {
+        piRefPos += iRefStride;
+      }
     }
     cMvTest = pcMvRefine[i];
     cMvTest += rcMvFrac;
@@ -1441,7 +1536,7 @@ void InterSearch::xIBCEstimation(PredictionUnit& pu, PelUnitBuf& origBuf,
     CompArea    tmpArea(COMPONENT_Y, area.chromaFormat, Position(0, 0), area.size());
     tmpOrgLuma = m_tmpStorageCtu.getBuf(tmpArea);
     tmpOrgLuma.copyFrom(tmpPattern);
-    tmpOrgLuma.rspSignal(m_pcReshape->getFwdLUT());
+    tmpOrgLuma.rspSignal(m_pcReshape->getFwdPwl());
     pcPatternKey = (CPelBuf*)&tmpOrgLuma;
   }
 
@@ -2684,6 +2779,7 @@ bool InterSearch::predInterHashSearch(CodingUnit& cu, Partitioner& partitioner,
 //! search of the best candidate for inter prediction
 void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner)
 {
+  PerfTimer timer(m_perfCounters, PerfStage::INTER_SEARCH);
   CodingStructure& cs = *cu.cs;
 
   AMVPInfo     amvp[NUM_REF_PIC_LIST_01];
@@ -3229,13 +3325,7 @@ void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner)
       if (cu.imv == 0 && (!cu.slice->getSPS()->getUseBcw() || bcwIdx == BCW_DEFAULT))
       {
         insertUniMvCands(pu.Y(), cMvTemp);
-
-        unsigned idx1, idx2, idx3, idx4;
-        getAreaIdx(cu.Y(), *cu.slice->getPPS()->pcv, idx1, idx2, idx3, idx4);
-        CHECKD(idx3 >= MAX_NUM_SIZES || idx4 >= MAX_NUM_SIZES, "MAX_NUM_SIZES is too small");
-        ::memcpy(&(g_reusedUniMVs[idx1][idx2][idx3][idx4][0][0]), cMvTemp,
-                 sizeof(cMvTemp));
-        g_isReusedUniMVsFilled[idx1][idx2][idx3][idx4] = true;
+        setReusedUniMvs(cu.Y(), *cu.slice->getPPS()->pcv, cMvTemp);
       }
       //  Bi-predictive Motion estimation
       if( ( cs.slice->isInterB() ) && ( PU::isBipredRestriction( pu ) == false )
@@ -3811,7 +3901,10 @@ void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner)
           for (int i = 0; i < m_uniMvListSize && symmvdCands.size() < symmvdCands.capacity(); i++)
           {
             BlkUniMvInfo* curMvInfo = m_uniMvList + ((m_uniMvListIdx - 1 - i + m_uniMvListMaxSize) % (m_uniMvListMaxSize));
-            smmvdCandsGen(curMvInfo->uniMvs[curRefList][refIdxCur], true);
+            if (curMvInfo->uniMvValid[curRefList][refIdxCur])
+            {
+              smmvdCandsGen(curMvInfo->uniMvs[curRefList][refIdxCur], true);
+            }
           }
 
           for (auto mvStart : symmvdCands)
@@ -5029,12 +5122,17 @@ void InterSearch::xMotionEstimation(PredictionUnit &pu, PelUnitBuf &origBuf, Ref
     for (int i = 0; i < m_uniMvListSize; i++)
     {
       BlkUniMvInfo* curMvInfo = m_uniMvList + ((m_uniMvListIdx - 1 - i + m_uniMvListMaxSize) % (m_uniMvListMaxSize));
+      if (!curMvInfo->uniMvValid[eRefPicList][refIdxPred])
+      {
+        continue;
+      }
 
       int j = 0;
       for (; j < i; j++)
       {
         BlkUniMvInfo *prevMvInfo = m_uniMvList + ((m_uniMvListIdx - 1 - j + m_uniMvListMaxSize) % (m_uniMvListMaxSize));
-        if (curMvInfo->uniMvs[eRefPicList][refIdxPred] == prevMvInfo->uniMvs[eRefPicList][refIdxPred])
+        if (prevMvInfo->uniMvValid[eRefPicList][refIdxPred]
+            && curMvInfo->uniMvs[eRefPicList][refIdxPred] == prevMvInfo->uniMvs[eRefPicList][refIdxPred])
         {
           break;
         }
@@ -5431,15 +5529,26 @@ void InterSearch::xTZSearch(const PredictionUnit &pu, RefPicList eRefPicList, in
     }
   }
 
+  // collect the distinct uni-prediction MVs of previously searched blocks and compute their SADs in one batch
+  static_vector<Mv, TZ_SEARCH_MAX_CANDS> uniMvCands;
+  const Pel                              *uniMvCur[TZ_SEARCH_MAX_CANDS];
+  Distortion                              uniMvSad[TZ_SEARCH_MAX_CANDS];
+  CHECK(m_uniMvListSize > TZ_SEARCH_MAX_CANDS, "Too many uni-prediction MV candidates");
+
   for (int i = 0; i < m_uniMvListSize; i++)
   {
     BlkUniMvInfo* curMvInfo = m_uniMvList + ((m_uniMvListIdx - 1 - i + m_uniMvListMaxSize) % (m_uniMvListMaxSize));
+    if (!curMvInfo->uniMvValid[eRefPicList][refIdxPred])
+    {
+      continue;
+    }
 
     int j = 0;
     for (; j < i; j++)
     {
       BlkUniMvInfo *prevMvInfo = m_uniMvList + ((m_uniMvListIdx - 1 - j + m_uniMvListMaxSize) % (m_uniMvListMaxSize));
-      if (curMvInfo->uniMvs[eRefPicList][refIdxPred] == prevMvInfo->uniMvs[eRefPicList][refIdxPred])
+      if (prevMvInfo->uniMvValid[eRefPicList][refIdxPred]
+          && curMvInfo->uniMvs[eRefPicList][refIdxPred] == prevMvInfo->uniMvs[eRefPicList][refIdxPred])
       {
         break;
       }
@@ -5452,9 +5561,19 @@ void InterSearch::xTZSearch(const PredictionUnit &pu, RefPicList eRefPicList, in
     Mv cTmpMv = curMvInfo->uniMvs[eRefPicList][refIdxPred];
     clipMv( cTmpMv, pu.cu->lumaPos(), pu.cu->lumaSize(), *pu.cs->sps, *pu.cs->pps );
     cTmpMv.changePrecision(MvPrecision::INTERNAL, MvPrecision::ONE);
-    m_cDistParam.cur.buf = cStruct.piRefY + (cTmpMv.ver * cStruct.iRefStride) + cTmpMv.hor;
+    uniMvCur[uniMvCands.size()] = cStruct.piRefY + (cTmpMv.ver * cStruct.iRefStride) + cTmpMv.hor;
+    uniMvCands.push_back(cTmpMv);
+  }
+
+  const bool uniMvBatched =
+    uniMvCands.size() > 1 && m_pcRdCost->getSADMulti(m_cDistParam, uniMvCur, (int) uniMvCands.size(), uniMvSad);
 
-    Distortion uiSad = m_cDistParam.distFunc(m_cDistParam);
+  for (int i = 0; i < (int) uniMvCands.size(); i++)
+  {
+    const Mv &cTmpMv     = uniMvCands[i];
+    m_cDistParam.cur.buf = uniMvCur[i];
+
+    Distortion uiSad = uniMvBatched ? uniMvSad[i] : m_cDistParam.distFunc(m_cDistParam);
     uiSad += m_pcRdCost->getCostOfVectorWithPredictor(cTmpMv.hor, cTmpMv.ver, cStruct.imvShift);
 #if GDR_ENABLED
     bool allOk = (uiSad < cStruct.uiBestSad);
@@ -5615,26 +5734,40 @@ void InterSearch::xTZSearch(const PredictionUnit &pu, RefPicList eRefPicList, in
       localsr.bottom /= 2;
     }
     cStruct.uiBestDistance = iWindowSize;
+    TZSearchCandList cands;
     for ( iStartY = localsr.top; iStartY <= localsr.bottom; iStartY += iWindowSize )
     {
       for ( iStartX = localsr.left; iStartX <= localsr.right; iStartX += iWindowSize )
       {
-        xTZSearchHelp( cStruct, iStartX, iStartY, 0, iWindowSize );
+        cands.push_back( TZSearchCand( iStartX, iStartY, 0, iWindowSize ) );
+        if ( cands.size() == TZ_SEARCH_MAX_CANDS )
+        {
+          xTZSearchHelpBatch( cStruct, cands );
+          cands.clear();
+        }
       }
     }
+    xTZSearchHelpBatch( cStruct, cands );
   }
   else
   {
     if ( bEnableRasterSearch && ( ((int)(cStruct.uiBestDistance) >= iRaster) || bAlwaysRasterSearch ) )
     {
       cStruct.uiBestDistance = iRaster;
+      TZSearchCandList cands;
       for ( iStartY = sr.top; iStartY <= sr.bottom; iStartY += iRaster )
       {
         for ( iStartX = sr.left; iStartX <= sr.right; iStartX += iRaster )
         {
-          xTZSearchHelp( cStruct, iStartX, iStartY, 0, iRaster );
+          cands.push_back( TZSearchCand( iStartX, iStartY, 0, iRaster ) );
+          if ( cands.size() == TZ_SEARCH_MAX_CANDS )
+          {
+            xTZSearchHelpBatch( cStruct, cands );
+            cands.clear();
+          }
         }
       }
+      xTZSearchHelpBatch( cStruct, cands );
     }
   }
 
@@ -5766,15 +5899,26 @@ void InterSearch::xTZSearchSelective(const PredictionUnit &pu, RefPicList eRefPi
     xTZSearchHelp( cStruct, integerMv2Nx2NPred.getHor(), integerMv2Nx2NPred.getVer(), 0, 0);
   }
 
+  // collect the distinct uni-prediction MVs of previously searched blocks and compute their SADs in one batch
+  static_vector<Mv, TZ_SEARCH_MAX_CANDS> uniMvCands;
+  const Pel                              *uniMvCur[TZ_SEARCH_MAX_CANDS];
+  Distortion                              uniMvSad[TZ_SEARCH_MAX_CANDS];
+  CHECK(m_uniMvListSize > TZ_SEARCH_MAX_CANDS, "Too many uni-prediction MV candidates");
+
   for (int i = 0; i < m_uniMvListSize; i++)
   {
     BlkUniMvInfo* curMvInfo = m_uniMvList + ((m_uniMvListIdx - 1 - i + m_uniMvListMaxSize) % (m_uniMvListMaxSize));
+    if (!curMvInfo->uniMvValid[eRefPicList][refIdxPred])
+    {
+      continue;
+    }
 
     int j = 0;
     for (; j < i; j++)
     {
       BlkUniMvInfo *prevMvInfo = m_uniMvList + ((m_uniMvListIdx - 1 - j + m_uniMvListMaxSize) % (m_uniMvListMaxSize));
-      if (curMvInfo->uniMvs[eRefPicList][refIdxPred] == prevMvInfo->uniMvs[eRefPicList][refIdxPred])
+      if (prevMvInfo->uniMvValid[eRefPicList][refIdxPred]
+          && curMvInfo->uniMvs[eRefPicList][refIdxPred] == prevMvInfo->uniMvs[eRefPicList][refIdxPred])
       {
         break;
       }
@@ -5787,9 +5931,19 @@ void InterSearch::xTZSearchSelective(const PredictionUnit &pu, RefPicList eRefPi
     Mv cTmpMv = curMvInfo->uniMvs[eRefPicList][refIdxPred];
     clipMv( cTmpMv, pu.cu->lumaPos(), pu.cu->lumaSize(), *pu.cs->sps, *pu.cs->pps );
     cTmpMv.changePrecision(MvPrecision::INTERNAL, MvPrecision::ONE);
-    m_cDistParam.cur.buf = cStruct.piRefY + (cTmpMv.ver * cStruct.iRefStride) + cTmpMv.hor;
+    uniMvCur[uniMvCands.size()] = cStruct.piRefY + (cTmpMv.ver * cStruct.iRefStride) + cTmpMv.hor;
+    uniMvCands.push_back(cTmpMv);
+  }
 
-    Distortion uiSad = m_cDistParam.distFunc(m_cDistParam);
+  const bool uniMvBatched =
+    uniMvCands.size() > 1 && m_pcRdCost->getSADMulti(m_cDistParam, uniMvCur, (int) uniMvCands.size(), uniMvSad);
+
+  for (int i = 0; i < (int) uniMvCands.size(); i++)
+  {
+    const Mv &cTmpMv     = uniMvCands[i];
+    m_cDistParam.cur.buf = uniMvCur[i];
+
+    Distortion uiSad = uniMvBatched ? uniMvSad[i] : m_cDistParam.distFunc(m_cDistParam);
     uiSad += m_pcRdCost->getCostOfVectorWithPredictor(cTmpMv.hor, cTmpMv.ver, cStruct.imvShift);
     if (uiSad < cStruct.uiBestSad)
     {
@@ -6106,9 +6260,27 @@ void InterSearch::xPatternSearchFracDIF(const PredictionUnit &pu, RefPicList eRe
     return;
   }
 
+  // the interpolated samples only depend on the reference picture, so they can be shared between blocks
+  const Picture *refPic   = pu.cu->slice->getRefPic(eRefPicList, refIdx);
+  const Position blkPos   = pu.lumaPos().offset(rcMvInt.getHor(), rcMvInt.getVer());
+  const Area     ctxArea(blkPos.x - 1, blkPos.y - 1, cStruct.pcPatternKey->width + 2, cStruct.pcPatternKey->height + 2);
+  const bool     useCache = m_subPelCache.isEnabled() && !cStruct.inCtuSearch
+                        && !refPic->isWrapAroundEnabled(pu.cs->pps) && m_subPelCache.covers(*refPic, ctxArea);
+  if (useCache)
+  {
+    m_subPelCacheCtx.refPic       = refPic;
+    m_subPelCacheCtx.pos          = blkPos;
+    m_subPelCacheCtx.intRef       = cPatternRoi.buf;
+    m_subPelCacheCtx.intRefStride = cPatternRoi.stride;
+    m_subPelCacheCtx.useAltHpelIf = cStruct.useAltHpelIf;
+  }
+
   //  Half-pel refinement
   m_pcRdCost->setCostScale(1);
-  xExtDIFUpSamplingH(&cPatternRoi, cStruct.useAltHpelIf);
+  if (!useCache)
+  {
+    xExtDIFUpSamplingH(&cPatternRoi, cStruct.useAltHpelIf);
+  }
 
   rcMvHalf = rcMvInt;   rcMvHalf <<= 1;    // for mv-cost
   Mv baseRefMv(0, 0);
@@ -6123,7 +6295,10 @@ void InterSearch::xPatternSearchFracDIF(const PredictionUnit &pu, RefPicList eRe
   if (cStruct.imvShift == IMV_OFF)
   {
     m_pcRdCost->setCostScale(0);
-    xExtDIFUpSamplingQ(&cPatternRoi, rcMvHalf);
+    if (!useCache)
+    {
+      xExtDIFUpSamplingQ(&cPatternRoi, rcMvHalf);
+    }
     baseRefMv = rcMvHalf;
     baseRefMv <<= 1;
 
@@ -6138,6 +6313,8 @@ void InterSearch::xPatternSearchFracDIF(const PredictionUnit &pu, RefPicList eRe
     ruiCost = xPatternRefinement(cStruct.pcPatternKey, baseRefMv, 1, rcMvQter, (!pu.cs->slice->getDisableSATDForRD()));
 #endif
   }
+
+  m_subPelCacheCtx.refPic = nullptr;
 }
 
 Distortion InterSearch::xGetSymmetricCost( PredictionUnit& pu, PelUnitBuf& origBuf, RefPicList eCurRefPicList, const MvField& cCurMvField, MvField& cTarMvField, int bcwIdx )
@@ -10582,7 +10759,7 @@ void InterSearch::encodeResAndCalcRdInterCU(CodingStructure &cs, Partitioner &pa
       cs.getRecoBuf().copyFrom(cs.getPredBuf() );
       if (m_pcEncCfg->getLmcs() && (cs.slice->getLmcsEnabledFlag() && m_pcReshape->getCTUFlag()) && !cu.firstPU->ciipFlag && !CU::isIBC(cu))
       {
-        cs.getRecoBuf().Y().rspSignal(m_pcReshape->getFwdLUT());
+        cs.getRecoBuf().Y().rspSignal(m_pcReshape->getFwdPwl());
       }
     }
 
@@ -10616,7 +10793,7 @@ void InterSearch::encodeResAndCalcRdInterCU(CodingStructure &cs, Partitioner &pa
           CompArea tmpArea1(COMPONENT_Y, areaY.chromaFormat, Position(0, 0), areaY.size());
           PelBuf   tmpRecLuma = m_tmpStorageCtu.getBuf(tmpArea1);
           tmpRecLuma.copyFrom(reco);
-          tmpRecLuma.rspSignal(m_pcReshape->getInvLUT());
+          tmpRecLuma.rspSignal(m_pcReshape->getInvPwl());
           distortion += m_pcRdCost->getDistPart(org, tmpRecLuma, sps.getBitDepth(toChannelType(compID)), compID,
                                                 DFunc::SSE_WTD, &orgLuma);
         }
@@ -10656,13 +10833,15 @@ void InterSearch::encodeResAndCalcRdInterCU(CodingStructure &cs, Partitioner &pa
       const CompArea &areaY = cu.Y();
       CompArea      tmpArea(COMPONENT_Y, areaY.chromaFormat, Position(0, 0), areaY.size());
       PelBuf          tmpPred = m_tmpStorageCtu.getBuf(tmpArea);
-      tmpPred.copyFrom(cs.getPredBuf(COMPONENT_Y));
-
       if (!cu.firstPU->ciipFlag && !CU::isIBC(cu))
       {
-        tmpPred.rspSignal(m_pcReshape->getFwdLUT());
+        tmpPred.rspSignal(cs.getPredBuf(COMPONENT_Y), m_pcReshape->getFwdPwl());
       }
-      cs.getResiBuf(COMPONENT_Y).rspSignal(m_pcReshape->getFwdLUT());
+      else
+      {
+        tmpPred.copyFrom(cs.getPredBuf(COMPONENT_Y));
+      }
+      cs.getResiBuf(COMPONENT_Y).rspSignal(m_pcReshape->getFwdPwl());
       cs.getResiBuf(COMPONENT_Y).subtract(tmpPred);
     }
     else
@@ -10908,11 +11087,13 @@ void InterSearch::encodeResAndCalcRdInterCU(CodingStructure &cs, Partitioner &pa
       const CompArea &areaY = cu.Y();
       CompArea      tmpArea(COMPONENT_Y, areaY.chromaFormat, Position(0, 0), areaY.size());
       PelBuf          tmpPred = m_tmpStorageCtu.getBuf(tmpArea);
-      tmpPred.copyFrom(cs.getPredBuf(COMPONENT_Y));
-
       if (!cu.firstPU->ciipFlag && !CU::isIBC(cu))
       {
-        tmpPred.rspSignal(m_pcReshape->getFwdLUT());
+        tmpPred.rspSignal(cs.getPredBuf(COMPONENT_Y), m_pcReshape->getFwdPwl());
+      }
+      else
+      {
+        tmpPred.copyFrom(cs.getPredBuf(COMPONENT_Y));
       }
 
       cs.getRecoBuf(COMPONENT_Y).reconstruct(tmpPred, cs.getResiBuf(COMPONENT_Y), cs.slice->clpRng(COMPONENT_Y));
@@ -10922,7 +11103,7 @@ void InterSearch::encodeResAndCalcRdInterCU(CodingStructure &cs, Partitioner &pa
       cs.getRecoBuf().bufs[0].reconstruct(cs.getPredBuf().bufs[0], cs.getResiBuf().bufs[0], cs.slice->clpRngs().comp[0]);
       if (cs.slice->getLmcsEnabledFlag() && m_pcReshape->getCTUFlag() && !cu.firstPU->ciipFlag && !CU::isIBC(cu))
       {
-        cs.getRecoBuf().bufs[0].rspSignal(m_pcReshape->getFwdLUT());
+        cs.getRecoBuf().bufs[0].rspSignal(m_pcReshape->getFwdPwl());
       }
     }
   }
@@ -10961,7 +11142,7 @@ void InterSearch::encodeResAndCalcRdInterCU(CodingStructure &cs, Partitioner &pa
         CompArea tmpArea1(COMPONENT_Y, areaY.chromaFormat, Position(0, 0), areaY.size());
         PelBuf   tmpRecLuma = m_tmpStorageCtu.getBuf(tmpArea1);
         tmpRecLuma.copyFrom(reco);
-        tmpRecLuma.rspSignal(m_pcReshape->getInvLUT());
+        tmpRecLuma.rspSignal(m_pcReshape->getInvPwl());
         finalDistortion += m_pcRdCost->getDistPart(org, tmpRecLuma, sps.getBitDepth(toChannelType(compID)), compID,
                                                    DFunc::SSE_WTD, &orgLuma);
       }
@@ -11132,6 +11313,13 @@ void InterSearch::initWeightIdxBits()
   }
 }
 
+void InterSearch::copySliceSearchSettings(const InterSearch &other)
+{
+  ::memcpy(m_adaptSR, other.m_adaptSR, sizeof(m_adaptSR));
+  ::memcpy(m_estWeightIdxBits, other.m_estWeightIdxBits, sizeof(m_estWeightIdxBits));
+  m_clipMvInSubPic = other.m_clipMvInSubPic;
+}
+
 void InterSearch::xClipMv( Mv& rcMv, const Position& pos, const struct Size& size, const SPS& sps, const PPS& pps )
 {
   int mvShift = MV_FRACTIONAL_BITS_INTERNAL;
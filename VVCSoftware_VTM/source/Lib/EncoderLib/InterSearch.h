@@ -45,6 +45,7 @@
 #include "CommonLib/MotionInfo.h"
 #include "CommonLib/InterPrediction.h"
 #include "CommonLib/TrQuant.h"
+#include "CommonLib/PerfCounters.h"
 #include "CommonLib/Unit.h"
 #include "CommonLib/UnitPartitioner.h"
 #include "CommonLib/RdCost.h"
@@ -54,7 +55,9 @@
 #include "CommonLib/Hash.h"
 #include <unordered_map>
 #include <vector>
+#include <memory>
 #include "EncReshape.h"
+#include "SubPelPlaneCache.h"
 //! \ingroup EncoderLib
 //! \{
 
@@ -85,7 +88,8 @@ struct AffineMVInfoSolid
 #endif
 struct BlkUniMvInfo
 {
-  RefSetArray<Mv> uniMvs;
+  RefSetArray<Mv>   uniMvs;
+  RefSetArray<bool> uniMvValid;   // false for entries without a motion vector, e.g. when seeded from an analysis file
   int x, y, w, h;
 };
 
@@ -111,6 +115,7 @@ class InterSearch : public InterPrediction, AffineGradientSearch
 {
 private:
   EncModeCtrl     *m_modeCtrl;
+  PerfCounters    *m_perfCounters;
 
   PelStorage      m_tmpPredStorage              [NUM_REF_PIC_LIST_01];
   PelStorage      m_tmpStorageCtu;
@@ -139,6 +144,8 @@ private:
   int             m_uniMvListIdx;
   int             m_uniMvListSize;
   int             m_uniMvListMaxSize;
+  std::unique_ptr<RefSetArray<Mv>[]> m_reusedUniMvs;   // uni-prediction MVs per block position and size in the CTU
+  std::vector<bool>                  m_reusedUniMvsFilled;
   Distortion      m_hevcCost;
 #if GDR_ENABLED
   bool            m_hevcCostOk;
@@ -168,6 +175,17 @@ protected:
   int             m_currRefPicIndex;
   bool            m_skipFracME;
 
+  struct SubPelCacheCtx
+  {
+    const Picture *refPic;      // nullptr if the current fractional refinement does not use the cache
+    Position       pos;         // integer-pel position of the block in the reference picture
+    const Pel     *intRef;      // integer-pel reference samples at pos
+    ptrdiff_t      intRefStride;
+    bool           useAltHpelIf;
+  };
+  SubPelPlaneCache m_subPelCache;
+  SubPelCacheCtx   m_subPelCacheCtx;
+
   RefSetArray<int>                         m_numHashMVStoreds;
   RefSetArray<Mv[Hash::NUM_LOG_BLK_SIZES]> m_hashMVStoreds;
 
@@ -281,7 +299,11 @@ public:
     }
   }
   void resetUniMvList() { m_uniMvListIdx = 0; m_uniMvListSize = 0; }
-  void insertUniMvCands(CompArea blkArea, RefSetArray<Mv> &cMvTemp)
+  void resetReusedUniMvs() { std::fill(m_reusedUniMvsFilled.begin(), m_reusedUniMvsFilled.end(), false); }
+  void setReusedUniMvs(const Area &area, const PreCalcValues &pcv, const RefSetArray<Mv> &mvs);
+  RefSetArray<Mv> *getReusedUniMvs(const Area &area, const PreCalcValues &pcv);
+  void resetSubPelCache(const Picture *pic) { m_subPelCache.invalidate(pic); }
+  void insertUniMvCands(CompArea blkArea, RefSetArray<Mv> &cMvTemp, const RefSetArray<bool> *valid = nullptr)
   {
     BlkUniMvInfo* curMvInfo = m_uniMvList + m_uniMvListIdx;
     int j = 0;
@@ -300,6 +322,14 @@ public:
     }
 
     ::memcpy(curMvInfo->uniMvs, cMvTemp, sizeof(cMvTemp));
+    if (valid != nullptr)
+    {
+      ::memcpy(curMvInfo->uniMvValid, *valid, sizeof(curMvInfo->uniMvValid));
+    }
+    else
+    {
+      std::fill_n(&curMvInfo->uniMvValid[0][0], NUM_REF_PIC_LIST_01 * MAX_NUM_REF, true);
+    }
     if (j == m_uniMvListSize)  // new element
     {
       curMvInfo->x = blkArea.x;
@@ -363,6 +393,8 @@ public:
 
   bool searchBv(PredictionUnit& pu, int xPos, int yPos, int width, int height, int picWidth, int picHeight, int xBv, int yBv, int ctuSize);
   void setClipMvInSubPic(bool flag) { m_clipMvInSubPic = flag; }
+  /// take over the search settings that are set per slice (adaptive search range, sub-picture MV clipping, BCW index bits)
+  void copySliceSearchSettings(const InterSearch &other);
 protected:
 
   /// sub-function for motion vector refinement used in fractional-pel accuracy
@@ -401,8 +433,23 @@ protected:
     bool        zeroMV;
   } IntTZSearchStruct;
 
+  // search point of a TZ pattern, the points of a pattern are evaluated as one batch
+  struct TZSearchCand
+  {
+    TZSearchCand() = default;
+    TZSearchCand(int x, int y, uint8_t pointNr, uint32_t distance) : x(x), y(y), pointNr(pointNr), distance(distance) {}
+
+    int      x;
+    int      y;
+    uint8_t  pointNr;
+    uint32_t distance;
+  };
+  static constexpr int TZ_SEARCH_MAX_CANDS = 16;
+  typedef static_vector<TZSearchCand, TZ_SEARCH_MAX_CANDS> TZSearchCandList;
+
   // sub-functions for ME
-  inline void xTZSearchHelp         ( IntTZSearchStruct& rcStruct, const int iSearchX, const int iSearchY, const uint8_t ucPointNr, const uint32_t uiDistance );
+  inline void xTZSearchHelp         ( IntTZSearchStruct& rcStruct, const int iSearchX, const int iSearchY, const uint8_t ucPointNr, const uint32_t uiDistance, const Distortion* precalcSad = nullptr );
+  inline void xTZSearchHelpBatch    ( IntTZSearchStruct& rcStruct, const TZSearchCandList& cands );
   inline void xTZ2PointSearch       ( IntTZSearchStruct& rcStruct );
   inline void xTZ8PointSquareSearch ( IntTZSearchStruct& rcStruct, const int iStartX, const int iStartY, const int iDist );
   inline void xTZ8PointDiamondSearch( IntTZSearchStruct& rcStruct, const int iStartX, const int iStartY, const int iDist, const bool bCheckCornersAtDist1 );
@@ -413,6 +460,7 @@ public:
   /// encoder estimation - inter prediction (non-skip)
 
   void setModeCtrl( EncModeCtrl *modeCtrl ) { m_modeCtrl = modeCtrl;}
+  void setPerfCounters( PerfCounters *perfCounters ) { m_perfCounters = perfCounters; }
 
   void predInterSearch(CodingUnit& cu, Partitioner& partitioner );
 
@@ -53,7 +53,8 @@
  //! \{
 #define PLTCtx(c) SubCtx( Ctx::Palette, c )
 IntraSearch::IntraSearch()
-  : m_pSplitCS(nullptr)
+  : m_perfCounters(nullptr)
+  , m_pSplitCS(nullptr)
   , m_pFullCS(nullptr)
   , m_pBestCS(nullptr)
   , m_pcEncCfg(nullptr)
@@ -159,6 +160,8 @@ void IntraSearch::destroy()
 
   m_tmpStorageCtu.destroy();
   m_colorTransResiBuf.destroy();
+  m_modeThreadPool.reset();
+  m_modeCostWorkers.clear();
   m_isInitialized = false;
   if (m_indexError[0] != nullptr)
   {
@@ -215,6 +218,18 @@ void IntraSearch::init(EncCfg *pcEncCfg, TrQuant *pcTrQuant, RdCost *pcRdCost, C
     m_pSharedPredTransformSkip[ch] = new Pel[MAX_CU_SIZE * MAX_CU_SIZE];
   }
 
+  if (pcEncCfg->getIntraSearchThreads() > 1)
+  {
+    m_modeThreadPool = std::make_unique<ThreadPool>(pcEncCfg->getIntraSearchThreads());
+    m_modeCostWorkers.resize(m_modeThreadPool->numThreads());
+    for (auto &worker: m_modeCostWorkers)
+    {
+      worker = std::make_unique<ModeCostWorker>();
+      worker->intraPred.init(cform, pcEncCfg->getBitDepth(ChannelType::LUMA));
+      worker->predBuf.resize(MAX_CU_SIZE * MAX_CU_SIZE);
+    }
+  }
+
   const uint32_t numWidths  = gp_sizeIdxInfo->numWidths();
   const uint32_t numHeights = gp_sizeIdxInfo->numHeights();
 
@@ -500,8 +515,59 @@ bool IntraSearch::isValidIntraPredChroma(PredictionUnit &pu, int lumaDirMode, in
 }
 #endif
 
+void IntraSearch::xGetSadHadOfModes(PredictionUnit &pu, const ModeInfo *modes, const int numModes,
+                                    const DistParam &distParamSad, const DistParam &distParamHad, Distortion *minSadHad)
+{
+  // Use the min between SAD and HAD as the cost criterion
+  // SAD is scaled by 2 to align with the scaling of HAD
+  if (!m_modeThreadPool || numModes < 2)
+  {
+    PelBuf piPred = pu.cs->getPredBuf(pu.Y());
+
+    for (int i = 0; i < numModes; i++)
+    {
+      pu.intraDir[ChannelType::LUMA] = modes[i].modeId;
+      pu.multiRefIdx                 = modes[i].mRefId;
+      if (pu.cu->mipFlag)
+      {
+        pu.mipTransposedFlag = modes[i].mipTrFlg;
+      }
+      predIntraLumaCand(piPred, pu);
+      minSadHad[i] = std::min(distParamSad.distFunc(distParamSad) * 2, distParamHad.distFunc(distParamHad));
+    }
+    return;
+  }
+
+  // every thread predicts from its own copy of the reference samples into its own buffer, the costs are written to
+  // the slot of the mode, so the result does not depend on the number of threads
+  for (auto &worker: m_modeCostWorkers)
+  {
+    PelBuf predBuf(worker->predBuf.data(), pu.lwidth(), pu.lheight());
+
+    worker->intraPred.copyIntraPattern(*this, COMPONENT_Y);
+    worker->distParamSad     = distParamSad;
+    worker->distParamSad.cur = predBuf;
+    worker->distParamHad     = distParamHad;
+    worker->distParamHad.cur = predBuf;
+  }
+
+  m_modeThreadPool->parallelFor(numModes, [&](int threadIdx, int idx) {
+    ModeCostWorker &worker = *m_modeCostWorkers[threadIdx];
+    PelBuf          predBuf(worker.predBuf.data(), pu.lwidth(), pu.lheight());
+    PredictionUnit  candPu(pu);
+
+    candPu.intraDir[ChannelType::LUMA] = modes[idx].modeId;
+    candPu.multiRefIdx                 = modes[idx].mRefId;
+    candPu.mipTransposedFlag           = modes[idx].mipTrFlg;
+    worker.intraPred.predIntraLumaCand(predBuf, candPu);
+    minSadHad[idx] = std::min(worker.distParamSad.distFunc(worker.distParamSad) * 2,
+                              worker.distParamHad.distFunc(worker.distParamHad));
+  });
+}
+
 bool IntraSearch::estIntraPredLumaQT(CodingUnit &cu, Partitioner &partitioner, const double bestCostSoFar, bool mtsCheckRangeFlag, int mtsFirstCheckId, int mtsLastCheckId, bool moreProbMTSIdxFirst, CodingStructure* bestCS)
 {
+  PerfTimer timer(m_perfCounters, PerfStage::INTRA_SEARCH);
   CodingStructure &cs  = *cu.cs;
   const SPS       &sps = *cs.sps;
 
@@ -651,7 +717,7 @@ bool IntraSearch::estIntraPredLumaQT(CodingUnit &cu, Partitioner &partitioner, c
             CompArea tmpArea(COMPONENT_Y, area.chromaFormat, Position(0, 0), area.size());
             PelBuf   tmpOrg = m_tmpStorageCtu.getBuf(tmpArea);
             tmpOrg.copyFrom(piOrg);
-            tmpOrg.rspSignal(m_pcReshape->getFwdLUT());
+            tmpOrg.rspSignal(m_pcReshape->getFwdPwl());
             m_pcRdCost->setDistParam(distParamSad, tmpOrg, piPred, sps.getBitDepth(ChannelType::LUMA), COMPONENT_Y,
                                      false);   // Use SAD cost
             m_pcRdCost->setDistParam(distParamHad, tmpOrg, piPred, sps.getBitDepth(ChannelType::LUMA), COMPONENT_Y,
@@ -684,12 +750,17 @@ bool IntraSearch::estIntraPredLumaQT(CodingUnit &cu, Partitioner &partitioner, c
           bool satdChecked[NUM_INTRA_MODE];
           std::fill_n(satdChecked, NUM_INTRA_MODE, false);
 
+          // SAD/SATD of each group of candidates is computed in one batch, followed by the cost update in candidate
+          // order
+          static_vector<ModeInfo, NUM_LUMA_MODE> satdModes;
+          Distortion                             satdCosts[NUM_LUMA_MODE];
+
           if (!lfnstLoadFlag)
           {
+            satdModes.clear();
             for (int modeIdx = 0; modeIdx < numModesAvailable; modeIdx++)
             {
-              uint32_t   mode      = modeIdx;
-              Distortion minSadHad = 0;
+              uint32_t mode = modeIdx;
 
               // Skip checking extended Angular modes in the first round of SATD
               if (mode > DC_IDX && (mode & 1))
@@ -698,14 +769,16 @@ bool IntraSearch::estIntraPredLumaQT(CodingUnit &cu, Partitioner &partitioner, c
               }
 
               satdChecked[mode] = true;
+              satdModes.push_back(ModeInfo(false, false, 0, ISPType::NONE, mode));
+            }
+            xGetSadHadOfModes(pu, satdModes.data(), int(satdModes.size()), distParamSad, distParamHad, satdCosts);
 
-              pu.intraDir[ChannelType::LUMA] = modeIdx;
+            for (int i = 0; i < int(satdModes.size()); i++)
+            {
+              const uint32_t   mode      = satdModes[i].modeId;
+              const Distortion minSadHad = satdCosts[i];
 
-              initPredIntraParams(pu, pu.Y(), sps);
-              predIntraAng(COMPONENT_Y, piPred, pu);
-              // Use the min between SAD and HAD as the cost criterion
-              // SAD is scaled by 2 to align with the scaling of HAD
-              minSadHad += std::min(distParamSad.distFunc(distParamSad) * 2, distParamHad.distFunc(distParamHad));
+              pu.intraDir[ChannelType::LUMA] = mode;
 
               // NB xFracModeBitsIntra will not affect the mode for chroma that may have already been pre-estimated.
               m_CABACEstimator->getCtx() = SubCtx( Ctx::MipFlag, ctxStartMipFlag );
@@ -756,6 +829,8 @@ bool IntraSearch::estIntraPredLumaQT(CodingUnit &cu, Partitioner &partitioner, c
           {
             static_vector<ModeInfo, FAST_UDI_MAX_RDMODE_NUM> parentCandList = rdModeList;
 
+            satdModes.clear();
+
             // Second round of SATD for extended Angular modes
 #if GDR_ENABLED
             int nn = numModesForFullRD;
@@ -778,40 +853,40 @@ bool IntraSearch::estIntraPredLumaQT(CodingUnit &cu, Partitioner &partitioner, c
 
                   if (!satdChecked[mode])
                   {
-                    pu.intraDir[ChannelType::LUMA] = mode;
+                    satdModes.push_back(ModeInfo(false, false, 0, ISPType::NONE, mode));
+                    satdChecked[mode] = true;
+                  }
+                }
+              }
+            }
+            xGetSadHadOfModes(pu, satdModes.data(), int(satdModes.size()), distParamSad, distParamHad, satdCosts);
 
-                    initPredIntraParams(pu, pu.Y(), sps);
-                    predIntraAng(COMPONENT_Y, piPred, pu);
+            for (int i = 0; i < int(satdModes.size()); i++)
+            {
+              const uint32_t   mode      = satdModes[i].modeId;
+              const Distortion minSadHad = satdCosts[i];
 
-                    // Use the min between SAD and SATD as the cost criterion
-                    // SAD is scaled by 2 to align with the scaling of HAD
-                    Distortion minSadHad =
-                      std::min(distParamSad.distFunc(distParamSad) * 2, distParamHad.distFunc(distParamHad));
+              pu.intraDir[ChannelType::LUMA] = mode;
 
-                    // NB xFracModeBitsIntra will not affect the mode for chroma that may have already been
-                    // pre-estimated.
-                    m_CABACEstimator->getCtx() = SubCtx(Ctx::MipFlag, ctxStartMipFlag);
-                    m_CABACEstimator->getCtx() = SubCtx(Ctx::ISPMode, ctxStartIspMode);
-                    m_CABACEstimator->getCtx() = SubCtx(Ctx::IntraLumaPlanarFlag, ctxStartPlanarFlag);
-                    m_CABACEstimator->getCtx() = SubCtx(Ctx::IntraLumaMpmFlag, ctxStartIntraMode);
-                    m_CABACEstimator->getCtx() = SubCtx(Ctx::MultiRefLineIdx, ctxStartMrlIdx);
+              // NB xFracModeBitsIntra will not affect the mode for chroma that may have already been
+              // pre-estimated.
+              m_CABACEstimator->getCtx() = SubCtx(Ctx::MipFlag, ctxStartMipFlag);
+              m_CABACEstimator->getCtx() = SubCtx(Ctx::ISPMode, ctxStartIspMode);
+              m_CABACEstimator->getCtx() = SubCtx(Ctx::IntraLumaPlanarFlag, ctxStartPlanarFlag);
+              m_CABACEstimator->getCtx() = SubCtx(Ctx::IntraLumaMpmFlag, ctxStartIntraMode);
+              m_CABACEstimator->getCtx() = SubCtx(Ctx::MultiRefLineIdx, ctxStartMrlIdx);
 
-                    uint64_t fracModeBits = xFracModeBitsIntra(pu, mode, ChannelType::LUMA);
+              uint64_t fracModeBits = xFracModeBitsIntra(pu, mode, ChannelType::LUMA);
 
-                    double cost = (double) minSadHad + (double) fracModeBits * sqrtLambdaForFirstPass;
+              double cost = (double) minSadHad + (double) fracModeBits * sqrtLambdaForFirstPass;
 
 #if GDR_ENABLED
-                    if (!isEncodeGdrClean || isValidIntraPredLuma(pu, mode))
+              if (!isEncodeGdrClean || isValidIntraPredLuma(pu, mode))
 #endif
-                    {
-                      const ModeInfo mi(false, false, 0, ISPType::NONE, mode);
-                      updateCandList(mi, cost, rdModeList, candCostList, numModesForFullRD);
-                      updateCandList(mi, double(minSadHad), hadModeList, candHadList, numHadCand);
-                    }
-
-                    satdChecked[mode] = true;
-                  }
-                }
+              {
+                const ModeInfo mi(false, false, 0, ISPType::NONE, mode);
+                updateCandList(mi, cost, rdModeList, candCostList, numModesForFullRD);
+                updateCandList(mi, double(minSadHad), hadModeList, candHadList, numHadCand);
               }
             }
             if (saveDataForISP)
@@ -831,19 +906,20 @@ bool IntraSearch::estIntraPredLumaQT(CodingUnit &cu, Partitioner &partitioner, c
               {
                 initIntraPatternChType(cu, pu.Y(), true);
               }
+              satdModes.clear();
+              for (int x = 1; x < numMPMs; x++)
+              {
+                satdModes.push_back(ModeInfo(false, false, multiRefIdx, ISPType::NONE, multiRefMPM[x]));
+              }
+              xGetSadHadOfModes(pu, satdModes.data(), int(satdModes.size()), distParamSad, distParamHad, satdCosts);
+
               for (int x = 1; x < numMPMs; x++)
               {
                 uint32_t mode = multiRefMPM[x];
                 {
-                  pu.intraDir[ChannelType::LUMA] = mode;
-                  initPredIntraParams(pu, pu.Y(), sps);
+                  const Distortion minSadHad = satdCosts[x - 1];
 
-                  predIntraAng(COMPONENT_Y, piPred, pu);
-
-                  // Use the min between SAD and SATD as the cost criterion
-                  // SAD is scaled by 2 to align with the scaling of HAD
-                  Distortion minSadHad =
-                    std::min(distParamSad.distFunc(distParamSad) * 2, distParamHad.distFunc(distParamHad));
+                  pu.intraDir[ChannelType::LUMA] = mode;
 
                   // NB xFracModeBitsIntra will not affect the mode for chroma that may have already been pre-estimated.
                   m_CABACEstimator->getCtx() = SubCtx(Ctx::MipFlag, ctxStartMipFlag);
@@ -918,6 +994,16 @@ bool IntraSearch::estIntraPredLumaQT(CodingUnit &cu, Partitioner &partitioner, c
 
               const int transpOff    = MatrixIntraPrediction::getNumModesMip(pu.Y());
               const int numModesFull = (transpOff << 1);
+
+              satdModes.clear();
+              for (uint32_t modeFull = 0; modeFull < numModesFull; modeFull++)
+              {
+                const bool isTransposed = (modeFull >= transpOff ? true : false);
+                satdModes.push_back(
+                  ModeInfo(true, isTransposed, 0, ISPType::NONE, isTransposed ? modeFull - transpOff : modeFull));
+              }
+              xGetSadHadOfModes(pu, satdModes.data(), int(satdModes.size()), distParamSad, distParamHad, satdCosts);
+
               for (uint32_t modeFull = 0; modeFull < numModesFull; modeFull++)
               {
                 const bool     isTransposed = (modeFull >= transpOff ? true : false);
@@ -925,12 +1011,8 @@ bool IntraSearch::estIntraPredLumaQT(CodingUnit &cu, Partitioner &partitioner, c
 
                 pu.mipTransposedFlag           = isTransposed;
                 pu.intraDir[ChannelType::LUMA] = mode;
-                predIntraMip(COMPONENT_Y, piPred, pu);
 
-                // Use the min between SAD and HAD as the cost criterion
-                // SAD is scaled by 2 to align with the scaling of HAD
-                Distortion minSadHad =
-                  std::min(distParamSad.distFunc(distParamSad) * 2, distParamHad.distFunc(distParamHad));
+                const Distortion minSadHad = satdCosts[modeFull];
 
                 m_CABACEstimator->getCtx() = SubCtx(Ctx::MipFlag, ctxStartMipFlag);
 
@@ -1044,6 +1126,23 @@ bool IntraSearch::estIntraPredLumaQT(CodingUnit &cu, Partitioner &partitioner, c
         {
           THROW("Full search not supported for MIP");
         }
+        // the mode chosen by the encode the loaded analysis file was written by is always tested with full RD
+        const int analysisMode = m_modeCtrl->getAnalysisIntraMode(cs, partitioner);
+        if (analysisMode >= 0)
+        {
+          const ModeInfo analysisModeInfo(false, false, 0, ISPType::NONE, analysisMode);
+#if GDR_ENABLED
+          if (!isEncodeGdrClean
+              && std::find(rdModeList.begin(), rdModeList.end(), analysisModeInfo) == rdModeList.end())
+#else
+          if (std::find(rdModeList.begin(), rdModeList.end(), analysisModeInfo) == rdModeList.end())
+#endif
+          {
+            numModesForFullRD++;
+            rdModeList.push_back(analysisModeInfo);
+            candCostList.push_back(0);
+          }
+        }
         if (sps.getUseLFNST() && mtsUsageFlag == 1)
         {
           // Store the modes to be checked with RD
@@ -1422,6 +1521,7 @@ bool IntraSearch::estIntraPredLumaQT(CodingUnit &cu, Partitioner &partitioner, c
 
 void IntraSearch::estIntraPredChromaQT( CodingUnit &cu, Partitioner &partitioner, const double maxCostAllowed )
 {
+  PerfTimer timer(m_perfCounters, PerfStage::INTRA_SEARCH);
   const ChromaFormat format   = cu.chromaFormat;
   const uint32_t    numberValidComponents = getNumberValidComponents(format);
   CodingStructure &cs = *cu.cs;
@@ -1778,7 +1878,7 @@ void IntraSearch::PLTSearch(CodingStructure &cs, Partitioner& partitioner, Compo
   if (m_pcEncCfg->getLmcs() && (cs.slice->getLmcsEnabledFlag() && m_pcReshape->getCTUFlag()))
   {
     cs.getPredBuf().copyFrom(cs.getOrgBuf());
-    cs.getPredBuf().Y().rspSignal(m_pcReshape->getFwdLUT());
+    cs.getPredBuf().Y().rspSignal(m_pcReshape->getFwdPwl());
   }
   if( cu.isLocalSepTree() )
   {
@@ -1937,7 +2037,7 @@ void IntraSearch::PLTSearch(CodingStructure &cs, Partitioner& partitioner, Compo
         CompArea tmpArea1(COMPONENT_Y, areaY.chromaFormat, Position(0, 0), areaY.size());
         PelBuf   tmpRecLuma = m_tmpStorageCtu.getBuf(tmpArea1);
         tmpRecLuma.copyFrom(reco);
-        tmpRecLuma.rspSignal(m_pcReshape->getInvLUT());
+        tmpRecLuma.rspSignal(m_pcReshape->getInvPwl());
         distortion += m_pcRdCost->getDistPart(org, tmpRecLuma, cs.sps->getBitDepth(toChannelType(compID)), compID,
                                               DFunc::SSE_WTD, &orgLuma);
       }
@@ -3330,7 +3430,7 @@ void IntraSearch::xIntraCodingTUBlock(TransformUnit &tu, const ComponentID &comp
       CompArea      tmpArea(COMPONENT_Y, area.chromaFormat, Position(0, 0), area.size());
       PelBuf        tmpPred = m_tmpStorageCtu.getBuf(tmpArea);
       tmpPred.copyFrom(piPred);
-      piResi.rspSignal(m_pcReshape->getFwdLUT());
+      piResi.rspSignal(m_pcReshape->getFwdPwl());
       piResi.subtract(tmpPred);
     }
     else
@@ -3537,7 +3637,7 @@ void IntraSearch::xIntraCodingTUBlock(TransformUnit &tu, const ComponentID &comp
       CompArea tmpArea1(COMPONENT_Y, area.chromaFormat, Position(0, 0), area.size());
       PelBuf   tmpRecLuma = m_tmpStorageCtu.getBuf(tmpArea1);
       tmpRecLuma.copyFrom(piReco);
-      tmpRecLuma.rspSignal(m_pcReshape->getInvLUT());
+      tmpRecLuma.rspSignal(m_pcReshape->getInvPwl());
       dist += m_pcRdCost->getDistPart(piOrg, tmpRecLuma, sps.getBitDepth(toChannelType(compID)), compID, DFunc::SSE_WTD,
                                       &orgLuma);
     }
@@ -4378,7 +4478,7 @@ bool IntraSearch::xRecurIntraCodingACTQT(CodingStructure &cs, Partitioner &parti
         CompArea tmpArea(COMPONENT_Y, area.chromaFormat, Position(0, 0), area.size());
         PelBuf   tmpPred = m_tmpStorageCtu.getBuf(tmpArea);
         tmpPred.copyFrom(piPred);
-        piResi.rspSignal(m_pcReshape->getFwdLUT());
+        piResi.rspSignal(m_pcReshape->getFwdPwl());
         piResi.subtract(tmpPred);
       }
       else if (doReshaping && (compID != COMPONENT_Y))
@@ -4850,7 +4950,7 @@ bool IntraSearch::xRecurIntraCodingACTQT(CodingStructure &cs, Partitioner &parti
           CompArea tmpArea1(COMPONENT_Y, area.chromaFormat, Position(0, 0), area.size());
           PelBuf   tmpRecLuma = m_tmpStorageCtu.getBuf(tmpArea1);
           tmpRecLuma.copyFrom(piReco);
-          tmpRecLuma.rspSignal(m_pcReshape->getInvLUT());
+          tmpRecLuma.rspSignal(m_pcReshape->getInvPwl());
           totalDist += m_pcRdCost->getDistPart(piOrg, tmpRecLuma, sps.getBitDepth(toChannelType(compID)), compID,
                                                DFunc::SSE_WTD, &orgLuma);
         }
@@ -4967,7 +5067,7 @@ bool IntraSearch::xRecurIntraCodingACTQT(CodingStructure &cs, Partitioner &parti
                 CompArea tmpArea1(COMPONENT_Y, area.chromaFormat, Position(0, 0), area.size());
                 PelBuf   tmpRecLuma = m_tmpStorageCtu.getBuf(tmpArea1);
                 tmpRecLuma.copyFrom(piReco);
-                tmpRecLuma.rspSignal(m_pcReshape->getInvLUT());
+                tmpRecLuma.rspSignal(m_pcReshape->getInvPwl());
                 distTmp += m_pcRdCost->getDistPart(piOrg, tmpRecLuma, sps.getBitDepth(toChannelType(compID)), compID,
                                                    DFunc::SSE_WTD, &orgLuma);
               }
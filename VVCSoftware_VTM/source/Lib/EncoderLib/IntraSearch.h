@@ -45,10 +45,14 @@
 
 #include "CommonLib/IntraPrediction.h"
 #include "CommonLib/TrQuant.h"
+#include "CommonLib/PerfCounters.h"
 #include "CommonLib/Unit.h"
 #include "CommonLib/RdCost.h"
+#include "CommonLib/ThreadPool.h"
 #include "EncReshape.h"
 
+#include <memory>
+
 //! \ingroup EncoderLib
 //! \{
 
@@ -191,6 +195,7 @@ class IntraSearch : public IntraPrediction
 {
 private:
   EncModeCtrl    *m_modeCtrl;
+  PerfCounters   *m_perfCounters;
   Pel*            m_pSharedPredTransformSkip[MAX_NUM_TBLOCKS];
 
   XuPool m_unitPool;
@@ -384,6 +389,17 @@ private:
 
   std::vector<TransformUnit *> m_orgTUs;
 
+  // per-thread data for computing the SAD/SATD of the intra mode candidates in parallel
+  struct ModeCostWorker
+  {
+    IntraPrediction  intraPred;
+    std::vector<Pel> predBuf;
+    DistParam        distParamSad;
+    DistParam        distParamHad;
+  };
+  std::unique_ptr<ThreadPool>                  m_modeThreadPool;
+  std::vector<std::unique_ptr<ModeCostWorker>> m_modeCostWorkers;
+
 protected:
   // interface to option
   EncCfg*         m_pcEncCfg;
@@ -423,6 +439,7 @@ public:
   CodingStructure  **getSaveCSBuf () { return m_pSaveCS; }
 
   void setModeCtrl                ( EncModeCtrl *modeCtrl ) { m_modeCtrl = modeCtrl; }
+  void setPerfCounters            ( PerfCounters *perfCounters ) { m_perfCounters = perfCounters; }
 
   bool getSaveCuCostInSCIPU       ()               { return m_saveCuCostInSCIPU; }
   void setSaveCuCostInSCIPU       ( bool b )       { m_saveCuCostInSCIPU = b;  }
@@ -480,6 +497,9 @@ protected:
   bool       xRecurIntraCodingACTQT(CodingStructure &cs, Partitioner& pm, bool mtsCheckRangeFlag = false, int mtsFirstCheckId = 0, int mtsLastCheckId = 0, bool moreProbMTSIdxFirst = false);
   bool       xIntraCodingLumaISP      ( CodingStructure& cs, Partitioner& pm, const double bestCostSoFar = MAX_DOUBLE );
 
+  void xGetSadHadOfModes(PredictionUnit &pu, const ModeInfo *modes, const int numModes, const DistParam &distParamSad,
+                         const DistParam &distParamHad, Distortion *minSadHad);
+
   template<typename T, size_t N>
   void reduceHadCandList(static_vector<T, N>& candModeList, static_vector<double, N>& candCostList, int& numModesForFullRD, const double thresholdHadCost, const double* mipHadCost, const PredictionUnit &pu, const bool fastMip);
   void   derivePLTLossy  (      CodingStructure& cs, Partitioner& partitioner, ComponentID compBegin, uint32_t numComp);
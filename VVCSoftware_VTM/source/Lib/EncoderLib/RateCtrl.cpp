@@ -317,10 +317,14 @@ EncRCGOP::~EncRCGOP()
   destroy();
 }
 
-void EncRCGOP::create(EncRCSeq *encRCSeq, int numPic, bool useAdaptiveBitsRatio)
+void EncRCGOP::create(EncRCSeq *encRCSeq, int numPic, bool useAdaptiveBitsRatio, double complexityWeight)
 {
   destroy();
   int targetBits = xEstGOPTargetBits( encRCSeq, numPic );
+  if ( complexityWeight != 1.0 )
+  {
+    targetBits = std::max( 200, int( targetBits * complexityWeight + 0.5 ) );
+  }
   int bitdepth_luma_scale =
     2 * (encRCSeq->getbitDepth() - 8
       - DISTORTION_PRECISION_ADJUSTMENT(encRCSeq->getbitDepth()));
@@ -770,13 +774,17 @@ void EncRCPic::addToPictureLsit(std::list<EncRCPic *> &listPreviousPictures)
 }
 
 void EncRCPic::create(EncRCSeq *encRCSeq, EncRCGOP *encRCGOP, int frameLevel,
-                      std::list<EncRCPic *> &listPreviousPictures)
+                      std::list<EncRCPic *> &listPreviousPictures, double complexityWeight)
 {
   destroy();
   m_encRCSeq = encRCSeq;
   m_encRCGOP = encRCGOP;
 
   int targetBits    = xEstPicTargetBits( encRCSeq, encRCGOP );
+  if ( complexityWeight != 1.0 )
+  {
+    targetBits = std::max( 100, int( targetBits * complexityWeight + 0.5 ) );
+  }
   int estHeaderBits = xEstPicHeaderBits( listPreviousPictures, frameLevel );
 
   if ( targetBits < estHeaderBits + 100 )
@@ -818,6 +826,7 @@ void EncRCPic::create(EncRCSeq *encRCSeq, EncRCGOP *encRCGOP, int frameLevel,
       m_LCUs[LCUIdx].m_lambda     = 0.0;
       m_LCUs[LCUIdx].m_targetBits = 0;
       m_LCUs[LCUIdx].m_bitWeight  = 1.0;
+      m_LCUs[LCUIdx].m_lookaheadWeight = 1.0;
       int currWidth  = ( (i == picWidthInLCU -1) ? picWidth  - LCUWidth *(picWidthInLCU -1) : LCUWidth  );
       int currHeight = ( (j == picHeightInLCU-1) ? picHeight - LCUHeight*(picHeightInLCU-1) : LCUHeight );
       m_LCUs[LCUIdx].m_numberOfPixel = currWidth * currHeight;
@@ -936,7 +945,7 @@ double EncRCPic::estimatePicLambda(std::list<EncRCPic *> &listPreviousPictures,
       betaLCU  = m_encRCSeq->getPicPara( m_frameLevel ).m_beta;
     }
 
-    m_LCUs[i].m_bitWeight =  m_LCUs[i].m_numberOfPixel * pow( estLambda/alphaLCU, 1.0/betaLCU );
+    m_LCUs[i].m_bitWeight =  m_LCUs[i].m_numberOfPixel * pow( estLambda/alphaLCU, 1.0/betaLCU ) * m_LCUs[i].m_lookaheadWeight;
 
     if ( m_LCUs[i].m_bitWeight < 0.01 )
     {
@@ -1005,7 +1014,7 @@ double EncRCPic::getLCUTargetBpp(bool isIRAP)
   if (isIRAP)
   {
     int    bitrateWindow = std::min(4, m_LCULeft);
-    double MAD      = getLCU(LCUIdx).m_costIntra;
+    double MAD      = getLCU(LCUIdx).m_costIntra * getLCU(LCUIdx).m_lookaheadWeight;
 
     if (m_remainingCostIntra > 0.1 )
     {
@@ -1364,14 +1373,31 @@ void EncRCPic::getLCUInitTargetBits()
 {
   int iAvgBits     = 0;
 
-  m_remainingCostIntra = m_totalCostIntra;
+  // the lookahead weights only redistribute the bits between the CTUs
+  m_remainingCostIntra = 0.0;
+  for (int i = 0; i < m_numberOfLCU; i++)
+  {
+    m_remainingCostIntra += getLCU(i).m_costIntra * getLCU(i).m_lookaheadWeight;
+  }
   for (int i=m_numberOfLCU-1; i>=0; i--)
   {
-    iAvgBits += int(m_targetBits * getLCU(i).m_costIntra/m_totalCostIntra);
+    iAvgBits += int(m_targetBits * getLCU(i).m_costIntra * getLCU(i).m_lookaheadWeight / m_remainingCostIntra);
     getLCU(i).m_targetBitsLeft = iAvgBits;
   }
 }
 
+void EncRCPic::setLCUQpOffsets(const std::vector<double> &qpOffsets)
+{
+  CHECK( (int)qpOffsets.size() != m_numberOfLCU, "Number of QP offsets does not match the number of CTUs" );
+
+  // with the R-lambda model, a QP offset of dQP scales the rate by 2^(-dQP / (3 * |beta|))
+  const double beta = std::max( 0.5, fabs( m_encRCSeq->getPicPara( m_frameLevel ).m_beta ) );
+  for (int i = 0; i < m_numberOfLCU; i++)
+  {
+    m_LCUs[i].m_lookaheadWeight = pow( 2.0, -qpOffsets[i] / ( 3.0 * beta ) );
+  }
+}
+
 
 double EncRCPic::getLCUEstLambdaAndQP(double bpp, int clipPicQP, int *estQP)
 {
@@ -1426,6 +1452,7 @@ RateCtrl::RateCtrl()
   m_encRCSeq = nullptr;
   m_encRCGOP = nullptr;
   m_encRCPic = nullptr;
+  m_lookaheadGOPWeight = 1.0;
 }
 
 RateCtrl::~RateCtrl()
@@ -1906,17 +1933,17 @@ void RateCtrl::init(int totalFrames, int targetBitrate, const Fraction& frameRat
   delete[] GOPID2Level;
 }
 
-void RateCtrl::initRCPic( int frameLevel )
+void RateCtrl::initRCPic( int frameLevel, double complexityWeight )
 {
   m_encRCPic = new EncRCPic;
-  m_encRCPic->create( m_encRCSeq, m_encRCGOP, frameLevel, m_listRCPictures );
+  m_encRCPic->create( m_encRCSeq, m_encRCGOP, frameLevel, m_listRCPictures, complexityWeight );
 }
 
 void RateCtrl::initRCGOP( int numberOfPictures )
 {
   m_encRCGOP = new EncRCGOP;
   bool useAdaptiveBitsRatio = (m_encRCSeq->getAdaptiveBits() > 0) && (m_listRCPictures.size() >= m_encRCSeq->getGOPSize());
-  m_encRCGOP->create(m_encRCSeq, numberOfPictures, useAdaptiveBitsRatio);
+  m_encRCGOP->create(m_encRCSeq, numberOfPictures, useAdaptiveBitsRatio, m_lookaheadGOPWeight);
 }
 
 int  RateCtrl::updateCpbState(int actualBits)
@@ -82,6 +82,7 @@ struct TRCLCU
   int m_targetBitsLeft;
   double m_actualSSE;
   double m_actualMSE;
+  double m_lookaheadWeight;
 };
 
 struct TRCParameter
@@ -192,7 +193,7 @@ public:
   ~EncRCGOP();
 
 public:
-  void create(EncRCSeq *encRCSeq, int numPic, bool useAdaptiveBitsRatio);
+  void create(EncRCSeq *encRCSeq, int numPic, bool useAdaptiveBitsRatio, double complexityWeight = 1.0);
   void destroy();
   void updateAfterPicture( int bitsCost );
 
@@ -229,7 +230,8 @@ public:
   ~EncRCPic();
 
 public:
-  void create(EncRCSeq *encRCSeq, EncRCGOP *encRCGOP, int frameLevel, std::list<EncRCPic *> &listPreviousPictures);
+  void create(EncRCSeq *encRCSeq, EncRCGOP *encRCGOP, int frameLevel, std::list<EncRCPic *> &listPreviousPictures,
+              double complexityWeight = 1.0);
   void destroy();
 
   int    estimatePicQP(double lambda, std::list<EncRCPic *> &listPreviousPictures);
@@ -280,6 +282,7 @@ public:
   void setTargetBits( int bits )                          { m_targetBits = bits; m_bitsLeft = bits;}
   void setTotalIntraCost(double cost)                     { m_totalCostIntra = cost; }
   void getLCUInitTargetBits();
+  void setLCUQpOffsets(const std::vector<double> &qpOffsets);
 
   int  getPicActualBits()                                 { return m_picActualBits; }
   int  getPicActualQP()                                   { return m_picQP; }
@@ -330,8 +333,9 @@ public:
             int picHeight, int LCUWidth, int LCUHeight, int bitDepth, int keepHierBits, bool useLCUSeparateModel,
             GOPEntry GOPList[MAX_GOP]);
   void destroy();
-  void initRCPic( int frameLevel );
+  void initRCPic( int frameLevel, double complexityWeight = 1.0 );
   void initRCGOP( int numberOfPictures );
+  void setLookaheadGOPWeight( double weight ) { m_lookaheadGOPWeight = weight; }
   void destroyRCGOP();
 
 public:
@@ -367,6 +371,7 @@ private:
   EncRCPic* m_encRCPic;
   std::list<EncRCPic *> m_listRCPictures;
   int        m_RCQP;
+  double     m_lookaheadGOPWeight;      // GOP bit allocation weight from the lookahead analysis
   bool       m_CpbSaturationEnabled;    // Enable target bits saturation to avoid CPB overflow and underflow
   int        m_cpbState;                // CPB State
   uint32_t       m_cpbSize;                 // CPB size
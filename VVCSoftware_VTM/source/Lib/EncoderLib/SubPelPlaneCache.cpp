@@ -0,0 +1,251 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2023, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     SubPelPlaneCache.cpp
+    \brief    cache of interpolated luma reference planes for fractional motion estimation
+*/
+
+#include "SubPelPlaneCache.h"
+
+#include "CommonLib/Picture.h"
+
+//! \ingroup EncoderLib
+//! \{
+
+SubPelPlaneCache::SubPelPlaneCache()
+  : m_maxBytes(0), m_usedBytes(0), m_maxCUSize(0), m_useCount(0), m_if(nullptr), m_tmpBuf(nullptr)
+{
+}
+
+void SubPelPlaneCache::init(size_t maxBytes, int maxCUSize, InterpolationFilter *filter)
+{
+  destroy();
+
+  m_maxBytes  = maxBytes;
+  m_maxCUSize = maxCUSize;
+  m_if        = filter;
+
+  if (m_maxBytes > 0)
+  {
+    m_tmpBuf = (Pel *) xMalloc(Pel, TILE_SIZE * (TILE_SIZE + NTAPS_LUMA) + MEMORY_ALIGN_DEF_SIZE);
+  }
+}
+
+void SubPelPlaneCache::destroy()
+{
+  for (Plane *plane: m_planes)
+  {
+    xFreePlane(plane);
+  }
+  m_planes.clear();
+  m_usedBytes = 0;
+  m_useCount  = 0;
+  m_maxBytes  = 0;
+
+  if (m_tmpBuf != nullptr)
+  {
+    xFree(m_tmpBuf);
+    m_tmpBuf = nullptr;
+  }
+}
+
+void SubPelPlaneCache::invalidate(const Picture *pic)
+{
+  for (size_t i = 0; i < m_planes.size();)
+  {
+    if (m_planes[i]->pic == pic)
+    {
+      xFreePlane(m_planes[i]);
+      m_planes[i] = m_planes.back();
+      m_planes.pop_back();
+    }
+    else
+    {
+      i++;
+    }
+  }
+}
+
+int SubPelPlaneCache::xGetPad(const Picture &refPic) const
+{
+  // keep the filter taps of the outermost tile inside the margin of the reconstruction buffer
+  return std::min<int>(m_maxCUSize + 16, int(refPic.margin) - NTAPS_LUMA);
+}
+
+bool SubPelPlaneCache::covers(const Picture &refPic, const Area &area) const
+{
+  if (m_maxBytes == 0)
+  {
+    return false;
+  }
+
+  const int pad = xGetPad(refPic);
+  if (pad <= 0)
+  {
+    return false;
+  }
+
+  const int picWidth  = refPic.getPicWidthInLumaSamples();
+  const int picHeight = refPic.getPicHeightInLumaSamples();
+
+  const size_t planeBytes = size_t((picWidth + 2 * pad + 7) & ~7) * (picHeight + 2 * pad) * sizeof(Pel);
+  if (planeBytes > m_maxBytes)
+  {
+    return false;
+  }
+
+  return area.x >= -pad && area.y >= -pad && area.x + int(area.width) <= picWidth + pad
+         && area.y + int(area.height) <= picHeight + pad;
+}
+
+const Pel *SubPelPlaneCache::getBlock(const Picture &refPic, int fracX, int fracY, bool useAltHpelIf,
+                                      const Area &area, const ClpRng &clpRng, ptrdiff_t &stride)
+{
+  CHECKD(!covers(refPic, area), "Area is not covered by the sub-pel plane cache");
+  CHECKD(fracX == 0 && fracY == 0, "Integer positions are not cached");
+
+  Plane *plane = xGetPlane(refPic, (fracY << 2) + fracX, useAltHpelIf);
+
+  const int pad = xGetPad(refPic);
+  const int x0  = area.x + pad;
+  const int y0  = area.y + pad;
+
+  for (int tileY = y0 >> TILE_SIZE_LOG2; tileY <= (y0 + int(area.height) - 1) >> TILE_SIZE_LOG2; tileY++)
+  {
+    for (int tileX = x0 >> TILE_SIZE_LOG2; tileX <= (x0 + int(area.width) - 1) >> TILE_SIZE_LOG2; tileX++)
+    {
+      uint8_t &done = plane->tileDone[tileY * plane->numTilesX + tileX];
+      if (!done)
+      {
+        xFillTile(*plane, refPic, tileX, tileY, clpRng);
+        done = 1;
+      }
+    }
+  }
+
+  stride = plane->stride;
+  return plane->buf + y0 * plane->stride + x0;
+}
+
+SubPelPlaneCache::Plane *SubPelPlaneCache::xGetPlane(const Picture &refPic, int phase, bool altHpel)
+{
+  const int poc = refPic.getPOC();
+
+  for (size_t i = 0; i < m_planes.size();)
+  {
+    Plane *plane = m_planes[i];
+    if (plane->pic == &refPic && plane->poc != poc)
+    {
+      // the picture buffer has been reused for another picture
+      xFreePlane(plane);
+      m_planes[i] = m_planes.back();
+      m_planes.pop_back();
+      continue;
+    }
+    if (plane->pic == &refPic && plane->phase == phase && plane->altHpel == altHpel)
+    {
+      plane->lastUse = ++m_useCount;
+      return plane;
+    }
+    i++;
+  }
+
+  const int pad = xGetPad(refPic);
+
+  Plane *plane   = new Plane;
+  plane->pic     = &refPic;
+  plane->poc     = poc;
+  plane->phase   = phase;
+  plane->altHpel = altHpel;
+  plane->width   = refPic.getPicWidthInLumaSamples() + 2 * pad;
+  plane->height  = refPic.getPicHeightInLumaSamples() + 2 * pad;
+  plane->stride  = (plane->width + 7) & ~7;
+  plane->numTilesX = (plane->width + TILE_SIZE - 1) >> TILE_SIZE_LOG2;
+  plane->tileDone.assign(plane->numTilesX * ((plane->height + TILE_SIZE - 1) >> TILE_SIZE_LOG2), 0);
+  plane->lastUse = ++m_useCount;
+
+  const size_t planeBytes = size_t(plane->stride) * plane->height * sizeof(Pel);
+  while (m_usedBytes + planeBytes > m_maxBytes && !m_planes.empty())
+  {
+    size_t lru = 0;
+    for (size_t i = 1; i < m_planes.size(); i++)
+    {
+      if (m_planes[i]->lastUse < m_planes[lru]->lastUse)
+      {
+        lru = i;
+      }
+    }
+    xFreePlane(m_planes[lru]);
+    m_planes[lru] = m_planes.back();
+    m_planes.pop_back();
+  }
+
+  plane->buf = (Pel *) xMalloc(Pel, plane->stride * plane->height);
+  m_usedBytes += planeBytes;
+  m_planes.push_back(plane);
+
+  return plane;
+}
+
+void SubPelPlaneCache::xFillTile(Plane &plane, const Picture &refPic, int tileX, int tileY, const ClpRng &clpRng)
+{
+  const int pad    = xGetPad(refPic);
+  const int posX   = tileX << TILE_SIZE_LOG2;
+  const int posY   = tileY << TILE_SIZE_LOG2;
+  const int width  = std::min(TILE_SIZE, plane.width - posX);
+  const int height = std::min(TILE_SIZE, plane.height - posY);
+  const int fracX  = plane.phase & 3;
+  const int fracY  = plane.phase >> 2;
+
+  const auto filterIdx =
+    plane.altHpel ? InterpolationFilter::Filter::HALFPEL_ALT : InterpolationFilter::Filter::DEFAULT;
+
+  const CPelBuf reco      = refPic.getRecoBuf(COMPONENT_Y);
+  const int     halfTaps  = NTAPS_LUMA >> 1;
+  const Pel    *src       = reco.buf + (posY - pad - (halfTaps - 1)) * reco.stride + (posX - pad);
+  Pel          *dst       = plane.buf + posY * plane.stride + posX;
+
+  m_if->filterHor(COMPONENT_Y, src, reco.stride, m_tmpBuf, TILE_SIZE, width, height + NTAPS_LUMA - 1,
+                  fracX << MV_FRACTIONAL_BITS_DIFF, false, clpRng, filterIdx);
+  m_if->filterVer(COMPONENT_Y, m_tmpBuf + (halfTaps - 1) * TILE_SIZE, TILE_SIZE, dst, plane.stride, width, height,
+                  fracY << MV_FRACTIONAL_BITS_DIFF, false, true, clpRng, filterIdx);
+}
+
+void SubPelPlaneCache::xFreePlane(Plane *plane)
+{
+  m_usedBytes -= size_t(plane->stride) * plane->height * sizeof(Pel);
+  xFree(plane->buf);
+  delete plane;
+}
+
+//! \}
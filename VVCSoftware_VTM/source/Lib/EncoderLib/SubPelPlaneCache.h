@@ -0,0 +1,115 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2023, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     SubPelPlaneCache.h
+    \brief    cache of interpolated luma reference planes for fractional motion estimation (header)
+*/
+
+#ifndef __SUBPELPLANECACHE__
+#define __SUBPELPLANECACHE__
+
+#include "CommonLib/CommonDef.h"
+#include "CommonLib/InterpolationFilter.h"
+
+#include <vector>
+
+//! \ingroup EncoderLib
+//! \{
+
+class Picture;
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// Holds sub-pel interpolated versions of the luma reference pictures, so that the half- and quarter-pel
+/// refinement of several blocks referring to the same area does not filter the same samples again.
+/// Each plane stores one fractional phase of one reference picture with a padding around the picture area.
+/// Planes are filled lazily in tiles and whole planes are evicted in LRU order when the memory cap is reached.
+class SubPelPlaneCache
+{
+public:
+  SubPelPlaneCache();
+  ~SubPelPlaneCache() { destroy(); }
+
+  void init(size_t maxBytes, int maxCUSize, InterpolationFilter *filter);
+  void destroy();
+
+  bool isEnabled() const { return m_maxBytes > 0; }
+
+  /// drops all planes created from the given picture, must be called when its reconstruction changes
+  void invalidate(const Picture *pic);
+
+  /// checks whether the luma area (in picture coordinates) of the reference picture can be served from the cache
+  bool covers(const Picture &refPic, const Area &area) const;
+
+  /// returns the interpolated samples of phase (fracX, fracY) in quarter-sample units at the top-left of the area
+  const Pel *getBlock(const Picture &refPic, int fracX, int fracY, bool useAltHpelIf, const Area &area,
+                      const ClpRng &clpRng, ptrdiff_t &stride);
+
+private:
+  static constexpr int TILE_SIZE_LOG2 = 6;
+  static constexpr int TILE_SIZE      = 1 << TILE_SIZE_LOG2;
+
+  struct Plane
+  {
+    const Picture       *pic;
+    int                  poc;
+    int                  phase;
+    bool                 altHpel;
+    Pel                 *buf;       // top-left sample of the padded plane
+    ptrdiff_t            stride;
+    int                  width;     // padded plane size
+    int                  height;
+    int                  numTilesX;
+    std::vector<uint8_t> tileDone;
+    uint64_t             lastUse;
+  };
+
+  int    xGetPad(const Picture &refPic) const;
+  Plane *xGetPlane(const Picture &refPic, int phase, bool altHpel);
+  void   xFillTile(Plane &plane, const Picture &refPic, int tileX, int tileY, const ClpRng &clpRng);
+  void   xFreePlane(Plane *plane);
+
+  size_t               m_maxBytes;
+  size_t               m_usedBytes;
+  int                  m_maxCUSize;
+  uint64_t             m_useCount;
+  InterpolationFilter *m_if;
+  std::vector<Plane *> m_planes;
+  Pel                 *m_tmpBuf;   // intermediate buffer of the separable filter for one tile
+};
+
+//! \}
+
+#endif // __SUBPELPLANECACHE__
@@ -49,6 +49,7 @@ TCPPPSNRMetric::TCPPPSNRMetric()
   m_pcReferenceGeomtry = nullptr;
   m_pcOutputCPPGeomtry = nullptr;
   m_pcRefCPPGeomtry    = nullptr;
+  memset(m_iCppInsideSize, 0, sizeof(m_iCppInsideSize));
 }
 
 TCPPPSNRMetric::~TCPPPSNRMetric()
@@ -78,6 +79,8 @@ TCPPPSNRMetric::~TCPPPSNRMetric()
   {
     delete m_pcRefCPPGeomtry; m_pcRefCPPGeomtry = nullptr;
   }
+  m_cppRefYuv.destroy();
+  m_cppOutYuv.destroy();
 }
 
 Void TCPPPSNRMetric::setOutputBitDepth(const BitDepths &outputBitDepths)
@@ -428,14 +431,57 @@ Void TCPPPSNRMetric::initCPPPSNR(InputGeoParam inputGeoParam, Int cppWidth, Int
 #endif
 }
 
+Void TCPPPSNRMetric::xInitCppInside()
+{
+  for(Int chan=0; chan<getNumberValidComponents(m_chromaFormatIDC); chan++)
+  {
+    const ComponentID ch=ComponentID(chan);
+    const Int   iWidth     = m_cppRefYuv.get(ch).width;
+    const Int   iHeight    = m_cppRefYuv.get(ch).height;
+
+    Int   iSize            = 0;
+    double fPhi, fLambda;
+    double fIdxX, fIdxY;
+    double fLamdaX, fLamdaY;
+
+    m_cppInside[chan].assign(iWidth*iHeight, 0);
+    UChar *pInside = m_cppInside[chan].data();
+    for(Int y=0;y<iHeight;y++)
+    {
+      for(Int x=0;x<iWidth;x++)
+      {
+        fLamdaX = ((double)x / (iWidth)) * (2 * S_PI) - S_PI;
+        fLamdaY = ((double)y / (iHeight)) * S_PI - (S_PI_2);
+
+        fPhi = 3 * sasin(fLamdaY / S_PI);
+        fLambda = fLamdaX / (2 * scos(2 * fPhi / 3) - 1);
+
+        fLamdaX = (fLambda + S_PI) / 2 / S_PI * (iWidth);
+        fLamdaY = (fPhi + (S_PI / 2)) / S_PI *  (iHeight);
+
+        fIdxX = (int)((fLamdaX < 0) ? fLamdaX - 0.5 : fLamdaX + 0.5);
+        fIdxY = (int)((fLamdaY < 0) ? fLamdaY - 0.5 : fLamdaY + 0.5);
+
+        if(fIdxY >= 0 && fIdxX >= 0 && fIdxX < iWidth && fIdxY < iHeight)
+        {
+          pInside[x] = 1;
+          iSize++;
+        }
+      }
+      pInside += iWidth;
+    }
+    m_iCppInsideSize[chan] = iSize;
+  }
+}
+
 Void TCPPPSNRMetric::xCalculateCPPPSNR( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcPicD)
 {
   Int iBitDepthForPSNRCalc[MAX_NUM_CHANNEL_TYPE];
   Int iReferenceBitShift[MAX_NUM_CHANNEL_TYPE];
   Int iOutputBitShift[MAX_NUM_CHANNEL_TYPE];
 
-  PelStorage *TPicYUVRefCPP;
-  PelStorage *TPicYUVOutCPP;
+  PelStorage *TPicYUVRefCPP = &m_cppRefYuv;
+  PelStorage *TPicYUVOutCPP = &m_cppOutYuv;
 
   iBitDepthForPSNRCalc[Int(ChannelType::LUMA)] = std::max(m_outputBitDepth[Int(ChannelType::LUMA)], m_referenceBitDepth[Int(ChannelType::LUMA)]);
   iBitDepthForPSNRCalc[Int(ChannelType::CHROMA)] = std::max(m_outputBitDepth[Int(ChannelType::CHROMA)], m_referenceBitDepth[Int(ChannelType::CHROMA)]);
@@ -448,11 +494,12 @@ Void TCPPPSNRMetric::xCalculateCPPPSNR( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcP
   Double SCPPDspsnr[3]={0, 0 ,0};
 
   // Convert Output and Ref to CPP_Projection
-  TPicYUVRefCPP = new PelStorage;
-  TPicYUVRefCPP->create(m_chromaFormatIDC, Area(Position(), Size(m_cppWidth, m_cppHeight)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
-
-  TPicYUVOutCPP = new PelStorage;
-  TPicYUVOutCPP->create(m_chromaFormatIDC, Area(Position(), Size(m_cppWidth, m_cppHeight)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+  if (TPicYUVRefCPP->bufs.empty())
+  {
+    TPicYUVRefCPP->create(m_chromaFormatIDC, Area(Position(), Size(m_cppWidth, m_cppHeight)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+    TPicYUVOutCPP->create(m_chromaFormatIDC, Area(Position(), Size(m_cppWidth, m_cppHeight)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+    xInitCppInside();
+  }
 
   // Converting Reference to CPP
   if ((m_pcReferenceGeomtry->getSVideoInfo()->geoType == SVIDEO_OCTAHEDRON || m_pcReferenceGeomtry->getSVideoInfo()->geoType == SVIDEO_ICOSAHEDRON) && m_pcReferenceGeomtry->getSVideoInfo()->iCompactFPStructure)
@@ -491,43 +538,29 @@ Void TCPPPSNRMetric::xCalculateCPPPSNR( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcP
     const Int   iRecStride = (Int)TPicYUVRefCPP->get(ch).stride;
     const Int   iWidth     = TPicYUVRefCPP->get(ch).width;
     const Int   iHeight    = TPicYUVRefCPP->get(ch).height;
-
-    Int   iSize            = 0;
-    double fPhi, fLambda;
-    double fIdxX, fIdxY;
-    double fLamdaX, fLamdaY;
+    const UChar *pInside   = m_cppInside[chan].data();
+#if SVIDEO_CPP_FIX
+    const Int   iOrgShift  = iOutputBitShift[Int(toChannelType(ch))];
+    const Int   iRecShift  = iReferenceBitShift[Int(toChannelType(ch))];
+#else
+    const Int   iOrgShift  = iReferenceBitShift[toChannelType(ch)];
+    const Int   iRecShift  = iOutputBitShift[toChannelType(ch)];
+#endif
+    // squares of integer differences, summed exactly; the samples outside the ellipse are masked out;
+    int64_t iSSD = 0;
 
     for(Int y=0;y<iHeight;y++)
     {
       for(Int x=0;x<iWidth;x++)
       {
-        fLamdaX = ((double)x / (iWidth)) * (2 * S_PI) - S_PI;
-        fLamdaY = ((double)y / (iHeight)) * S_PI - (S_PI_2);
-
-        fPhi = 3 * sasin(fLamdaY / S_PI);
-        fLambda = fLamdaX / (2 * scos(2 * fPhi / 3) - 1);
-
-        fLamdaX = (fLambda + S_PI) / 2 / S_PI * (iWidth);
-        fLamdaY = (fPhi + (S_PI / 2)) / S_PI *  (iHeight);
-
-        fIdxX = (int)((fLamdaX < 0) ? fLamdaX - 0.5 : fLamdaX + 0.5);
-        fIdxY = (int)((fLamdaY < 0) ? fLamdaY - 0.5 : fLamdaY + 0.5);
-
-        if(fIdxY >= 0 && fIdxX >= 0 && fIdxX < iWidth && fIdxY < iHeight)
-        {
-#if SVIDEO_CPP_FIX
-          Intermediate_Int iDifflp = (Intermediate_Int)((pOrg[x] << iOutputBitShift[Int(toChannelType(ch))]) - (pRec[x] << iReferenceBitShift[Int(toChannelType(ch))]));
-#else
-          Intermediate_Int iDifflp  = (Intermediate_Int)((pOrg[x]<<iReferenceBitShift[toChannelType(ch)]) - (pRec[x]<<iOutputBitShift[toChannelType(ch)]) );
-#endif
-          SCPPDspsnr[chan]         += iDifflp * iDifflp;
-          iSize++;
-        }
+        Intermediate_Int iDifflp = (Intermediate_Int)((pOrg[x] << iOrgShift) - (pRec[x] << iRecShift));
+        iSSD += pInside[x] ? iDifflp * iDifflp : 0;
       }
       pOrg += iOrgStride;
       pRec += iRecStride;
+      pInside += iWidth;
     }
-    SCPPDspsnr[chan] /= iSize;
+    SCPPDspsnr[chan] = (Double)iSSD / m_iCppInsideSize[chan];
   }
 
   for (Int ch_indx = 0; ch_indx < getNumberValidComponents(pcPicD->chromaFormat); ch_indx++)
@@ -538,19 +571,6 @@ Void TCPPPSNRMetric::xCalculateCPPPSNR( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcP
     Double fReflpsnr = maxval*maxval;
     m_dCPPPSNR[ch_indx] = ( SCPPDspsnr[ch_indx] ? 10.0 * log10( fReflpsnr / (Double)SCPPDspsnr[ch_indx] ) : 999.99 );
   }
-
-  if(TPicYUVRefCPP)
-  {
-    TPicYUVRefCPP->destroy();
-    delete TPicYUVRefCPP;
-    TPicYUVRefCPP = nullptr;
-  }
-  if(TPicYUVOutCPP)
-  {
-    TPicYUVOutCPP->destroy();
-    delete TPicYUVOutCPP;
-    TPicYUVOutCPP = nullptr;
-  }
 }
 
 #endif // SVIDEO_CPPPSNR
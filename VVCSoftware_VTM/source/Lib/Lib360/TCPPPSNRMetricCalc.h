@@ -38,6 +38,7 @@
 #ifndef __TCPPPSNRCALC__
 #define __TCPPPSNRCALC__
 #include "TGeometry.h"
+#include <vector>
 
 // ====================================================================================================================
 // Class definition
@@ -78,6 +79,13 @@ private:
   TGeometry     *m_pcOutputCPPGeomtry;
   TGeometry     *m_pcRefCPPGeomtry;
 
+  PelStorage    m_cppRefYuv;                              //reference and output converted to CPP, kept across pictures;
+  PelStorage    m_cppOutYuv;
+  std::vector<UChar> m_cppInside[MAX_NUM_COMPONENT];      //samples inside the CPP ellipse;
+  Int           m_iCppInsideSize[MAX_NUM_COMPONENT];
+
+  Void          xInitCppInside();
+
 public:
   TCPPPSNRMetric();
   virtual ~TCPPPSNRMetric();
@@ -308,29 +308,17 @@ TGeometry::~TGeometry()
   }
   for (Int i = 0; i < SV_MAX_NUM_FACES; i++)
   {
-    if (m_pPixelWeight[i])
+    for (Int j = 0; j < 2; j++)
     {
-      for (Int j = 0; j < 2; j++)
+      if (m_pPixelWeight[i][j])
       {
-        if (m_pPixelWeight[i][j])
-        {
-          delete[] m_pPixelWeight[i][j];
-          m_pPixelWeight[i][j] = nullptr;
-        }
+        delete[] m_pPixelWeight[i][j];
+        m_pPixelWeight[i][j] = nullptr;
       }
-    }
-    if (m_pPixelWeight4SherePadding[i])
-    {
-      for (Int j = 0; j < 2; j++)
+      if (m_pPixelWeight4SherePadding[i][j])
       {
-        if (m_pPixelWeight4SherePadding[i][j])
-        {
-          if (m_pPixelWeight4SherePadding[i][j])
-          {
-            delete[] m_pPixelWeight4SherePadding[i][j];
-            m_pPixelWeight4SherePadding[i][j] = nullptr;
-          }
-        }
+        delete[] m_pPixelWeight4SherePadding[i][j];
+        m_pPixelWeight4SherePadding[i][j] = nullptr;
       }
     }
   }
@@ -1064,32 +1052,70 @@ Void TGeometry::geometryMapping(TGeometry *pGeoSrc)
 }
 
 /***************************************************
-//convert source geometry to destination geometry;
+//weighted gathering of the samples listed in a conversion LUT;
+//the tap count is a template parameter for the common filters so that the inner products are unrolled and vectorized;
 ****************************************************/
-Void TGeometry::geoConvert(TGeometry *pGeoDst
-#if SVIDEO_ROT_FIX
-                           ,
-                           Bool bRec
-#endif
-)
+template<Int iTaps>
+static Void convertGather(const GeoConvertLut &lut, Int iStart, Int iEnd, Pel *const *pSrcFaces, Int iStrideSrc,
+                          Int *const *pWeightLut, Int iGenericTaps, Pel *pDst, Int iBitDepth)
 {
-  // padding;
-  spherePadding();
-
-  if (!pGeoDst->m_bGeometryMapping)
-#if SVIDEO_ROT_FIX
-    pGeoDst->geometryMapping(this, bRec);
+  const Int     iNumTaps     = iTaps ? iTaps : iGenericTaps;
+  const Int     iBDPrecision = S_INTERPOLATE_PrecisionBD;
+  const Int     iOffset      = 1 << (iBDPrecision - 1);
+  const Int    *pDstPos      = lut.dstPos.data();
+  const Int    *pSrcPos      = lut.srcPos.data();
+  const UChar  *pSrcFace     = lut.srcFace.data();
+  const UShort *pWeightIdx   = lut.weightIdx.data();
+
+  for (Int k = iStart; k < iEnd; k++)
+  {
+    const Pel *pPelLine = pSrcFaces[pSrcFace[k]] + pSrcPos[k];
+    const Int *pWLut    = pWeightLut[pWeightIdx[k]];
+    Int        sum      = 0;
+    for (Int m = 0; m < iNumTaps; m++)
+    {
+      for (Int n = 0; n < iNumTaps; n++)
+        sum += pPelLine[n] * pWLut[n];
+      pPelLine += iStrideSrc;
+      pWLut += iNumTaps;
+    }
+#if SVIDEO_GEOCONVERT_CLIP
+    pDst[pDstPos[k]] = ClipBD((sum + iOffset) >> iBDPrecision, iBitDepth);
 #else
-    pGeoDst->geometryMapping(this);
+    pDst[pDstPos[k]] = (sum + iOffset) >> iBDPrecision;
 #endif
+  }
+}
 
+Void TGeometry::setConvertThreads(Int iNumThreads)
+{
+  m_convertThreadPool.reset();
+  if (iNumThreads > 1)
+  {
+    m_convertThreadPool = std::make_unique<ThreadPool>(iNumThreads);
+  }
+}
+
+/***************************************************
+//collect the samples written by geoConvert from the weight map of the destination geometry;
+//the weight map is released afterwards, the conversion only reads the LUTs;
+****************************************************/
+Void TGeometry::initConvertLut(TGeometry *pGeoDst)
+{
   Int nFaces             = pGeoDst->m_sVideoInfo.iNumFaces;
-  Int iBDPrecision       = S_INTERPOLATE_PrecisionBD;
   Int iWeightMapFaceMask = (1 << m_WeightMap_NumOfBits4Faces) - 1;
-  Int iOffset            = 1 << (iBDPrecision - 1);
 
   for (Int fIdx = 0; fIdx < nFaces; fIdx++)
   {
+    for (Int ch = 0; ch < MAX_NUM_COMPONENT; ch++)
+    {
+      GeoConvertLut &lut = pGeoDst->m_convertLut[fIdx][ch];
+      lut.dstPos.clear();
+      lut.srcPos.clear();
+      lut.srcFace.clear();
+      lut.weightIdx.clear();
+      lut.fillPos.clear();
+    }
 #if SVIDEO_GENERALIZED_CUBEMAP
     if (pGeoDst->m_sVideoInfo.geoType == SVIDEO_GENERALIZEDCUBEMAP
         && (pGeoDst->m_sVideoInfo.iGCMPPackingType == 4 || pGeoDst->m_sVideoInfo.iGCMPPackingType == 5))
@@ -1103,9 +1129,10 @@ Void TGeometry::geoConvert(TGeometry *pGeoDst
 #endif
     for (Int ch = 0; ch < pGeoDst->getNumChannels(); ch++)
     {
-      ComponentID chId    = (ComponentID) ch;
-      Int         nWidth  = pGeoDst->m_sVideoInfo.iFaceWidth >> pGeoDst->getComponentScaleX(chId);
-      Int         nHeight = pGeoDst->m_sVideoInfo.iFaceHeight >> pGeoDst->getComponentScaleY(chId);
+      ComponentID    chId    = (ComponentID) ch;
+      GeoConvertLut &lut     = pGeoDst->m_convertLut[fIdx][ch];
+      Int            nWidth  = pGeoDst->m_sVideoInfo.iFaceWidth >> pGeoDst->getComponentScaleX(chId);
+      Int            nHeight = pGeoDst->m_sVideoInfo.iFaceHeight >> pGeoDst->getComponentScaleY(chId);
 
       Int nMarginX = pGeoDst->m_iMarginX >> pGeoDst->getComponentScaleX(chId);
       Int nMarginY = pGeoDst->m_iMarginY >> pGeoDst->getComponentScaleY(chId);
@@ -1115,7 +1142,9 @@ Void TGeometry::geoConvert(TGeometry *pGeoDst
          && pGeoDst->m_InterpolationType[Int(ChannelType::LUMA)] == pGeoDst->m_InterpolationType[Int(ChannelType::CHROMA)])
           ? 0
           : (ch > 0 ? 1 : 0);
-      ChannelType chType = toChannelType(chId);
+      ChannelType chType     = toChannelType(chId);
+      Int         iTapOffset = ((m_iInterpFilterTaps[Int(chType)][1] - 1) >> 1) * getStride(chId)
+                       + ((m_iInterpFilterTaps[Int(chType)][0] - 1) >> 1);
 
       for (Int j = -nMarginY; j < nHeight + nMarginY; j++)
         for (Int i = -nMarginX; i < nWidth + nMarginX; i++)
@@ -1125,58 +1154,128 @@ Void TGeometry::geoConvert(TGeometry *pGeoDst
                                       (j << pGeoDst->getComponentScaleY(chId)), COMPONENT_Y, chId))
             continue;
 
-          Int x   = i + nMarginX;
-          Int y   = j + nMarginY;
-          Int sum = 0;
-
+          Int iPos = j * pGeoDst->getStride(chId) + i;
 #if SVIDEO_FISHEYE
+          if (pGeoDst->m_sVideoInfo.geoType == SVIDEO_FISHEYE_CIRCULAR)
           {
             Int    xx    = i << pGeoDst->getComponentScaleX(chId);
             Int    yy    = j << pGeoDst->getComponentScaleY(chId);
             Double cnt_x = pGeoDst->m_sVideoInfo.sFisheyeInfo.fCircularRegionCentre_x;
             Double cnt_y = pGeoDst->m_sVideoInfo.sFisheyeInfo.fCircularRegionCentre_y;
             Double dist  = ssqrt((xx + 0.5 - cnt_x) * (xx + 0.5 - cnt_x) + (yy + 0.5 - cnt_y) * (yy + 0.5 - cnt_y));
-
-            if (pGeoDst->m_sVideoInfo.geoType != SVIDEO_FISHEYE_CIRCULAR
-                || (/*pGeoDst->m_sVideoInfo.geoType == SVIDEO_FISHEYE_CIRCULAR &&*/ dist
-                    < (Double)(pGeoDst->m_sVideoInfo.sFisheyeInfo.fCircularRegionRadius) - 0.5))
+            if (dist >= (Double)(pGeoDst->m_sVideoInfo.sFisheyeInfo.fCircularRegionRadius) - 0.5)
             {
+              lut.fillPos.push_back(iPos);
+              continue;
+            }
+          }
 #endif
+          PxlFltLut *pPelWeight = pGeoDst->m_pPixelWeight[fIdx][mapIdx] + (j + nMarginY) * iWidthPW + i + nMarginX;
+          lut.dstPos.push_back(iPos);
+          lut.srcPos.push_back(((pPelWeight->facePos) >> m_WeightMap_NumOfBits4Faces) - iTapOffset);
+          lut.srcFace.push_back((UChar)((pPelWeight->facePos) & iWeightMapFaceMask));
+          lut.weightIdx.push_back(pPelWeight->weightIdx);
+        }
+    }
+  }
 
-              PxlFltLut *pPelWeight = pGeoDst->m_pPixelWeight[fIdx][mapIdx] + y * iWidthPW + x;
-              Int        face       = (pPelWeight->facePos) & iWeightMapFaceMask;
-              Int        iTLPos     = (pPelWeight->facePos) >> m_WeightMap_NumOfBits4Faces;
-              Int        iWLutIdx =
-                (m_chromaFormatIDC == ChromaFormat::_400 || (m_InterpolationType[0] == m_InterpolationType[1])) ? 0 : Int(chType);
-              Int *pWLut    = m_pWeightLut[iWLutIdx][pPelWeight->weightIdx];
-              Pel *pPelLine = m_pFacesOrig[face][ch] + iTLPos
-                              - ((m_iInterpFilterTaps[Int(chType)][1] - 1) >> 1) * getStride(chId)
-                              - ((m_iInterpFilterTaps[Int(chType)][0] - 1) >> 1);
-              for (Int m = 0; m < m_iInterpFilterTaps[Int(chType)][1]; m++)
-              {
-                for (Int n = 0; n < m_iInterpFilterTaps[Int(chType)][0]; n++)
-                  sum += pPelLine[n] * pWLut[n];
-                pPelLine += getStride(chId);
-                pWLut += m_iInterpFilterTaps[Int(chType)][0];
-              }
+  for (Int fIdx = 0; fIdx < SV_MAX_NUM_FACES; fIdx++)
+  {
+    for (Int j = 0; j < 2; j++)
+    {
+      if (pGeoDst->m_pPixelWeight[fIdx][j])
+      {
+        delete[] pGeoDst->m_pPixelWeight[fIdx][j];
+        pGeoDst->m_pPixelWeight[fIdx][j] = nullptr;
+      }
+    }
+  }
+}
 
-              Int iPos = j * pGeoDst->getStride(chId) + i;
-#if SVIDEO_GEOCONVERT_CLIP
-              pGeoDst->m_pFacesOrig[fIdx][ch][iPos] = ClipBD((sum + iOffset) >> iBDPrecision, m_nBitDepth);
-#else
-          pGeoDst->m_pFacesOrig[fIdx][ch][iPos] = (sum + iOffset) >> iBDPrecision;
+/***************************************************
+//convert source geometry to destination geometry;
+//the samples of each face channel are split into chunks, which are converted in parallel if a thread pool is set;
+****************************************************/
+Void TGeometry::geoConvert(TGeometry *pGeoDst
+#if SVIDEO_ROT_FIX
+                           ,
+                           Bool bRec
 #endif
-#if SVIDEO_FISHEYE
-            }
-            else if (pGeoDst->m_sVideoInfo.geoType == SVIDEO_FISHEYE_CIRCULAR)
-            {
-              Int iPos                              = j * pGeoDst->getStride(chId) + i;
-              pGeoDst->m_pFacesOrig[fIdx][ch][iPos] = 1 << (m_nBitDepth - 1);
-            }
-          }
+)
+{
+  // padding;
+  spherePadding();
+
+  if (!pGeoDst->m_bGeometryMapping)
+  {
+#if SVIDEO_ROT_FIX
+    pGeoDst->geometryMapping(this, bRec);
+#else
+    pGeoDst->geometryMapping(this);
 #endif
-        }
+    initConvertLut(pGeoDst);
+  }
+
+  static const Int iChunkSize = 1 << 14;
+  struct ConvertChunk
+  {
+    Int fIdx;
+    Int ch;
+    Int iStart;
+    Int iEnd;
+  };
+  std::vector<ConvertChunk> chunks;
+  Pel                      *pSrcFaces[MAX_NUM_COMPONENT][SV_MAX_NUM_FACES];
+
+  for (Int ch = 0; ch < getNumChannels(); ch++)
+  {
+    for (Int face = 0; face < m_sVideoInfo.iNumFaces; face++)
+      pSrcFaces[ch][face] = m_pFacesOrig[face][ch];
+  }
+  for (Int fIdx = 0; fIdx < pGeoDst->m_sVideoInfo.iNumFaces; fIdx++)
+  {
+    for (Int ch = 0; ch < pGeoDst->getNumChannels(); ch++)
+    {
+      const GeoConvertLut &lut = pGeoDst->m_convertLut[fIdx][ch];
+      for (Int iPos : lut.fillPos)
+        pGeoDst->m_pFacesOrig[fIdx][ch][iPos] = 1 << (m_nBitDepth - 1);
+      for (Int iStart = 0; iStart < (Int) lut.dstPos.size(); iStart += iChunkSize)
+        chunks.push_back({ fIdx, ch, iStart, std::min(iStart + iChunkSize, (Int) lut.dstPos.size()) });
+    }
+  }
+
+  auto convertChunk = [&](int, int idx)
+  {
+    const ConvertChunk &chunk    = chunks[idx];
+    ComponentID         chId     = (ComponentID) chunk.ch;
+    ChannelType         chType   = toChannelType(chId);
+    Int                 iWLutIdx =
+      (m_chromaFormatIDC == ChromaFormat::_400 || (m_InterpolationType[0] == m_InterpolationType[1])) ? 0 : Int(chType);
+    Int                  iTaps   = m_iInterpFilterTaps[Int(chType)][0];
+    Int                  iStride = getStride(chId);
+    Int                **pWLut   = m_pWeightLut[iWLutIdx];
+    Pel                **pSrc    = pSrcFaces[chunk.ch];
+    Pel                 *pDst    = pGeoDst->m_pFacesOrig[chunk.fIdx][chunk.ch];
+    const GeoConvertLut &lut     = pGeoDst->m_convertLut[chunk.fIdx][chunk.ch];
+
+    switch (iTaps)
+    {
+    case 1: convertGather<1>(lut, chunk.iStart, chunk.iEnd, pSrc, iStride, pWLut, iTaps, pDst, m_nBitDepth); break;
+    case 2: convertGather<2>(lut, chunk.iStart, chunk.iEnd, pSrc, iStride, pWLut, iTaps, pDst, m_nBitDepth); break;
+    case 4: convertGather<4>(lut, chunk.iStart, chunk.iEnd, pSrc, iStride, pWLut, iTaps, pDst, m_nBitDepth); break;
+    case 6: convertGather<6>(lut, chunk.iStart, chunk.iEnd, pSrc, iStride, pWLut, iTaps, pDst, m_nBitDepth); break;
+    default: convertGather<0>(lut, chunk.iStart, chunk.iEnd, pSrc, iStride, pWLut, iTaps, pDst, m_nBitDepth); break;
     }
+  };
+
+  if (m_convertThreadPool)
+  {
+    m_convertThreadPool->parallelFor((Int) chunks.size(), convertChunk);
+  }
+  else
+  {
+    for (Int idx = 0; idx < (Int) chunks.size(); idx++)
+      convertChunk(0, idx);
   }
 
   pGeoDst->setPaddingFlag(pGeoDst->m_bConvOutputPaddingNeeded ? true : false);
@@ -2338,6 +2437,18 @@ Void TGeometry::initInterpolation(Int *pInterpolateType)
 
 #if SVIDEO_SPSNR_I
 Pel TGeometry::getPelValue(ComponentID chId, SPos inPos)
+{
+  PxlFltLut wList;
+  getPelWeight(chId, inPos, wList);
+  return getPelValueFromWeight(chId, wList);
+}
+
+Void TGeometry::getPelWeight(ComponentID chId, SPos inPos, PxlFltLut &wList)
+{
+  (this->*m_interpolateWeight[Int(toChannelType(chId))])(chId, &inPos, wList);
+}
+
+Pel TGeometry::getPelValueFromWeight(ComponentID chId, const PxlFltLut &wList)
 {
   Int         sum                = 0;
   ChannelType chType             = toChannelType(chId);
@@ -2346,10 +2457,6 @@ Pel TGeometry::getPelValue(ComponentID chId, SPos inPos)
   Pel         pVal;
   Int         iBDPrecision = S_INTERPOLATE_PrecisionBD;
   Int         iOffset      = 1 << (iBDPrecision - 1);
-  // Int x, y;
-  PxlFltLut wList;
-
-  (this->*m_interpolateWeight[Int(chType)])(chId, &inPos, wList);
 
   Int  face     = (wList.facePos) & iWeightMapFaceMask;
   Int  iTLPos   = (wList.facePos) >> m_WeightMap_NumOfBits4Faces;
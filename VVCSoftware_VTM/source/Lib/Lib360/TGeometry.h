@@ -38,7 +38,10 @@
 #ifndef __TGEOMETRY__
 #define __TGEOMETRY__
 #include <math.h>
+#include <memory>
+#include <vector>
 #include "../CommonLib/CommonDef.h"
+#include "../CommonLib/ThreadPool.h"
 #include "../Utilities/VideoIOYuv.h"
 
 
@@ -531,6 +534,15 @@ struct PxlFltLut
   Int facePos;          //MSBs for pos; LSBs for faceIdx;
   UShort weightIdx; 
 };
+//samples of one face channel written by geoConvert, stored as structure of arrays;
+struct GeoConvertLut
+{
+  std::vector<Int>    dstPos;      //position in the destination face;
+  std::vector<Int>    srcPos;      //position of the top-left filter tap in the source face;
+  std::vector<UChar>  srcFace;     //source face;
+  std::vector<UShort> weightIdx;   //row of the source filter weight table;
+  std::vector<Int>    fillPos;     //positions outside the fisheye circle, set to the mid level;
+};
 typedef Void (TGeometry::*interpolateWeightFP)(ComponentID chId, SPos *pSPosIn, PxlFltLut &wlist);
 
 
@@ -606,6 +618,8 @@ protected:
   Int m_iInterpFilterTaps[MAX_NUM_CHANNEL_TYPE][2];                                        //[channel][hor/ver];
   Int **m_pWeightLut[2];
   PxlFltLut *m_pPixelWeight[SV_MAX_NUM_FACES][2];                   //[SV_MAX_NUM_FACES][2][pxl_idx];
+  GeoConvertLut m_convertLut[SV_MAX_NUM_FACES][MAX_NUM_COMPONENT];  //built from m_pPixelWeight, which is released afterwards;
+  std::unique_ptr<ThreadPool> m_convertThreadPool;                  //converts the faces in chunks of samples;
 
   Int m_iChromaSampleLocType;
   Void setChromaResamplingFilter(Int iChromaSampleLocType);
@@ -615,6 +629,7 @@ protected:
   Bool m_bConvOutputPaddingNeeded;
 
   Void geometryMapping4SpherePadding();
+  Void initConvertLut(TGeometry *pGeoDst);
   Void getSPLutIdx(Int ch, Int x, Int y, Int& iIdx);
 
   Void initInterpolation(Int *pInterpolateType);
@@ -673,6 +688,7 @@ public:
   Pel *getAddr(Int fId, Int compId) { return m_pFacesOrig[fId][compId]; }
   Int getMarginSize(Int bY) { return (bY? m_iMarginY : m_iMarginX); }
   Void setPaddingFlag(Bool bFlag) { m_bPadded = bFlag; }
+  Void setConvertThreads(Int iNumThreads);
   TChar* getGeoName() 
   {
 #if SVIDEO_HEMI_PROJECTIONS
@@ -727,6 +743,8 @@ public:
   virtual Void geoToFramePack(IPos* posIn, IPos2D* posOut);
 #if SVIDEO_SPSNR_I
   virtual Pel  getPelValue(ComponentID chId, SPos in);
+  Void         getPelWeight(ComponentID chId, SPos in, PxlFltLut &wList);       //filter taps of getPelValue(), independent of the picture;
+  Pel          getPelValueFromWeight(ComponentID chId, const PxlFltLut &wList);
 #endif
   virtual Void spherePadding(Bool bEnforced=false);
   virtual Bool insideFace(Int fId, Int x, Int y, ComponentID chId, ComponentID origchId) { return ( x>=0 && x<(m_sVideoInfo.iFaceWidth>>getComponentScaleX(chId)) && y>=0 && y<(m_sVideoInfo.iFaceHeight>>getComponentScaleY(chId)) ); }
@@ -59,15 +59,12 @@ THybridEquiAngularCubeMap::~THybridEquiAngularCubeMap()
 #if SVIDEO_HEC_PADDING && SVIDEO_HEC_PADDING_TYPE == 1
   for(int i = 0; i < 2; i++)
   {
-    if(m_blendingMap[i])
+    for(int j = 0; j < 6; j++)
     {
-      for(int j = 0; j < 6; j++)
+      if(m_blendingMap[i][j])
       {
-        if(m_blendingMap[i][j])
-        {
-          delete[] m_blendingMap[i][j];
-          m_blendingMap[i][j] = nullptr;
-        }
+        delete[] m_blendingMap[i][j];
+        m_blendingMap[i][j] = nullptr;
       }
     }
   }
@@ -44,6 +44,8 @@ TSPSNRIMetric::TSPSNRIMetric()
 , m_pCart2D(nullptr)
 , m_fpDTable(nullptr)
 , m_fpTable(nullptr)
+, m_pcCodingGeometry(nullptr)
+, m_pcRefGeometry(nullptr)
 {
   m_dSPSNRI[0] = m_dSPSNRI[1] = m_dSPSNRI[2] = 0;
 }
@@ -62,6 +64,14 @@ TSPSNRIMetric::~TSPSNRIMetric()
   {
     free(m_fpTable); m_fpTable = nullptr;
   }
+  if(m_pcCodingGeometry)
+  {
+    delete m_pcCodingGeometry; m_pcCodingGeometry = nullptr;
+  }
+  if(m_pcRefGeometry)
+  {
+    delete m_pcRefGeometry; m_pcRefGeometry = nullptr;
+  }
 }
 
 Void TSPSNRIMetric::setVideoInfo(SVideoInfo sCodingVideoInfo, SVideoInfo sRefVideoInfo)
@@ -180,14 +190,70 @@ void TSPSNRIMetric::createTable(PelUnitBuf* pcPicD, TGeometry *pcCodingGeomtry)
   }
 }
 
+Void TSPSNRIMetric::xInitPelWeights(ChromaFormat chromaFormat)
+{
+  Int iNumPoints = m_iSphNumPoints;
+  SPos sCodingPos, sTempPos;
+  SPos sRefPos;
+  TGeometry  *pcCodingGeometry = m_pcCodingGeometry;
+  TGeometry  *pcRefGeometry    = m_pcRefGeometry;
+
+  for(Int chan=0; chan<getNumberValidComponents(chromaFormat); chan++)
+  {
+    const ComponentID ch=ComponentID(chan);
+
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+    Double chromaOffsetCoding[2] = { 0.0, 0.0 }; //[0: X; 1: Y];
+    Double chromaOffsetRef[2] = { 0.0, 0.0 }; //[0: X; 1: Y];
+#endif
+    m_codingPelWeight[chan].resize(iNumPoints);
+    m_refPelWeight[chan].resize(iNumPoints);
+
+    for (Int np = 0; np < iNumPoints; np++)
+    {
+#if SVIDEO_ROT_FIX
+      sTempPos = m_fpDTable[np];
+      pcCodingGeometry->invRotate3D(sTempPos, -pcCodingGeometry->getSVideoInfo()->sVideoRotation.degree[0], -pcCodingGeometry->getSVideoInfo()->sVideoRotation.degree[1], -pcCodingGeometry->getSVideoInfo()->sVideoRotation.degree[2]);
+      pcCodingGeometry->map3DTo2D(&sTempPos, &sCodingPos);
+#else
+      pcCodingGeometry->map3DTo2D(&m_fpDTable[np], &sCodingPos);
+#endif
+      pcRefGeometry->map3DTo2D(&m_fpDTable[np], &sRefPos);
+      if(chan != 0) 
+      {
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+        pcCodingGeometry->getFaceChromaOffset(chromaOffsetCoding, sCodingPos.faceIdx, ch);
+        sCodingPos.x = (sCodingPos.x - chromaOffsetCoding[0]) / (1 << pcCodingGeometry->getComponentScaleX(ch));
+        sCodingPos.y = (sCodingPos.y - chromaOffsetCoding[1]) / (1 << pcCodingGeometry->getComponentScaleY(ch));
+#else
+        sCodingPos.x = sCodingPos.x/2;
+        sCodingPos.y = sCodingPos.y/2;
+        sCodingPos.z = sCodingPos.z/2;
+#endif
+
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+        pcRefGeometry->getFaceChromaOffset(chromaOffsetRef, sRefPos.faceIdx, ch);
+        sRefPos.x = (sRefPos.x - chromaOffsetRef[0]) / (1 << pcRefGeometry->getComponentScaleX(ch));
+        sRefPos.y = (sRefPos.y - chromaOffsetRef[1]) / (1 << pcRefGeometry->getComponentScaleY(ch));
+#else
+        sRefPos.x = sRefPos.x/2;
+        sRefPos.y = sRefPos.y/2;
+        sRefPos.z = sRefPos.z/2;
+#endif
+      }
+
+      pcCodingGeometry->getPelWeight(ch, sCodingPos, m_codingPelWeight[chan][np]);
+      pcRefGeometry->getPelWeight(ch, sRefPos, m_refPelWeight[chan][np]);
+    }
+  }
+}
+
 Void TSPSNRIMetric::xCalculateSPSNRI( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcPicD )
 {
   Int iNumPoints = m_iSphNumPoints;
   Int iBitDepthForPSNRCalc[MAX_NUM_CHANNEL_TYPE];
   Int iReferenceBitShift[MAX_NUM_CHANNEL_TYPE];
   Int iOutputBitShift[MAX_NUM_CHANNEL_TYPE];
-  SPos sCodingPos, sTempPos;
-  SPos sRefPos;
   Pel   refPel, codingPel;
 
   TGeometry  *pcCodingGeometry;
@@ -203,8 +269,14 @@ Void TSPSNRIMetric::xCalculateSPSNRI( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcPic
 
   memset(m_dSPSNRI, 0, sizeof(Double)*3);
 
-  pcCodingGeometry    = TGeometry::create(m_OutputVideoInfo, &m_GeoParam);
-  pcRefGeometry       = TGeometry::create(m_RefVideoInfo, &m_GeoParam);
+  if(!m_pcCodingGeometry)
+  {
+    m_pcCodingGeometry = TGeometry::create(m_OutputVideoInfo, &m_GeoParam);
+    m_pcRefGeometry    = TGeometry::create(m_RefVideoInfo, &m_GeoParam);
+    xInitPelWeights(pcPicD->chromaFormat);
+  }
+  pcCodingGeometry    = m_pcCodingGeometry;
+  pcRefGeometry       = m_pcRefGeometry;
 
   if((pcCodingGeometry->getSVideoInfo()->geoType == SVIDEO_OCTAHEDRON || pcCodingGeometry->getSVideoInfo()->geoType == SVIDEO_ICOSAHEDRON) && pcCodingGeometry->getSVideoInfo()->iCompactFPStructure) 
   {
@@ -229,54 +301,20 @@ Void TSPSNRIMetric::xCalculateSPSNRI( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcPic
   for(Int chan=0; chan<getNumberValidComponents(pcPicD->chromaFormat); chan++)
   {
     const ComponentID ch=ComponentID(chan);
-    SSDspsnrI[chan] = 0;
-
-#if SVIDEO_CHROMA_TYPES_SUPPORT
-    Double chromaOffsetCoding[2] = { 0.0, 0.0 }; //[0: X; 1: Y];
-    Double chromaOffsetRef[2] = { 0.0, 0.0 }; //[0: X; 1: Y];
-#endif
+    const PxlFltLut* pCodingWeight = m_codingPelWeight[chan].data();
+    const PxlFltLut* pRefWeight    = m_refPelWeight[chan].data();
+    // squares of integer differences, summed exactly;
+    int64_t iSSD = 0;
 
     for (Int np = 0; np < iNumPoints; np++)
     {
-#if SVIDEO_ROT_FIX
-      sTempPos = m_fpDTable[np];
-      pcCodingGeometry->invRotate3D(sTempPos, -pcCodingGeometry->getSVideoInfo()->sVideoRotation.degree[0], -pcCodingGeometry->getSVideoInfo()->sVideoRotation.degree[1], -pcCodingGeometry->getSVideoInfo()->sVideoRotation.degree[2]);
-      pcCodingGeometry->map3DTo2D(&sTempPos, &sCodingPos);
-#else
-      pcCodingGeometry->map3DTo2D(&m_fpDTable[np], &sCodingPos);
-#endif
-      pcRefGeometry->map3DTo2D(&m_fpDTable[np], &sRefPos);
-      if(chan != 0) 
-      {
-#if SVIDEO_CHROMA_TYPES_SUPPORT
-        pcCodingGeometry->getFaceChromaOffset(chromaOffsetCoding, sCodingPos.faceIdx, ch);
-        sCodingPos.x = (sCodingPos.x - chromaOffsetCoding[0]) / (1 << pcCodingGeometry->getComponentScaleX(ch));
-        sCodingPos.y = (sCodingPos.y - chromaOffsetCoding[1]) / (1 << pcCodingGeometry->getComponentScaleY(ch));
-#else
-        sCodingPos.x = sCodingPos.x/2;
-        sCodingPos.y = sCodingPos.y/2;
-        sCodingPos.z = sCodingPos.z/2;
-#endif
+      codingPel = pcCodingGeometry->getPelValueFromWeight(ch, pCodingWeight[np]);
+      refPel    = pcRefGeometry->getPelValueFromWeight(ch, pRefWeight[np]);
 
-#if SVIDEO_CHROMA_TYPES_SUPPORT
-        pcRefGeometry->getFaceChromaOffset(chromaOffsetRef, sRefPos.faceIdx, ch);
-        sRefPos.x = (sRefPos.x - chromaOffsetRef[0]) / (1 << pcRefGeometry->getComponentScaleX(ch));
-        sRefPos.y = (sRefPos.y - chromaOffsetRef[1]) / (1 << pcRefGeometry->getComponentScaleY(ch));
-#else
-        sRefPos.x = sRefPos.x/2;
-        sRefPos.y = sRefPos.y/2;
-        sRefPos.z = sRefPos.z/2;
-#endif
-      }
-
-      codingPel = pcCodingGeometry->getPelValue(ch, sCodingPos);
-      refPel    = pcRefGeometry->getPelValue(ch, sRefPos);
-
-      //interpolate value TODO: implement interpolation (as option inherit all from SPSNR and make calc as )
       Intermediate_Int iDifflp=  (Intermediate_Int)((refPel<<iReferenceBitShift[Int(toChannelType(ch))]) - (codingPel<<iOutputBitShift[Int(toChannelType(ch))]) );
-      SSDspsnrI[chan]        += iDifflp*iDifflp;
+      iSSD                  += iDifflp*iDifflp;
     }
-    SSDspsnrI[chan] = SSDspsnrI[chan]/iNumPoints;
+    SSDspsnrI[chan] = (Double)iSSD/iNumPoints;
   }
 
   for (Int ch_indx = 0; ch_indx < getNumberValidComponents(pcPicD->chromaFormat); ch_indx++)
@@ -287,10 +325,5 @@ Void TSPSNRIMetric::xCalculateSPSNRI( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcPic
     Double fReflpsnr   = /*Double(iNumPoints)**/maxval*maxval;
     m_dSPSNRI[ch_indx] = ( SSDspsnrI[ch_indx] ? 10.0 * log10( fReflpsnr / (Double)SSDspsnrI[ch_indx] ) : 999.99 );
   }
-
-  if(pcCodingGeometry)
-    delete pcCodingGeometry;
-  if(pcRefGeometry)
-    delete pcRefGeometry;
 }
 #endif
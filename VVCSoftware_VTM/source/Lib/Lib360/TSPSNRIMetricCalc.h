@@ -38,6 +38,7 @@
 #ifndef __TSPSNRICALC__
 #define __TSPSNRICALC__
 #include "TGeometry.h"
+#include <vector>
 
 // ====================================================================================================================
 // Class definition
@@ -69,6 +70,13 @@ private:
   Int        m_iRefHeight;
   //ChromaFormat  m_chromaFormatIDC;
 
+  TGeometry  *m_pcCodingGeometry;                            //created at the first picture and kept for the following ones;
+  TGeometry  *m_pcRefGeometry;
+  std::vector<PxlFltLut> m_codingPelWeight[MAX_NUM_COMPONENT]; //interpolation taps of the sample points in each geometry;
+  std::vector<PxlFltLut> m_refPelWeight[MAX_NUM_COMPONENT];
+
+  Void    xInitPelWeights(ChromaFormat chromaFormat);
+
 
 public:
   TSPSNRIMetric();
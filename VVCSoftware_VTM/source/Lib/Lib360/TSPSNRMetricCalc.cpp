@@ -54,8 +54,16 @@ TSPSNRMetric::TSPSNRMetric()
 , m_pSamplePosCTable(nullptr)
 , m_pSamplePosCRecTable(nullptr)
 #endif
+#if SVIDEO_FISHEYE
+, m_iPointInsideWidth(0)
+, m_iPointInsideHeight(0)
+, m_pointInsideFormat(ChromaFormat::_400)
+#endif
 {
   m_dSPSNR[0] = m_dSPSNR[1] = m_dSPSNR[2] = 0;
+#if SVIDEO_FISHEYE
+  memset(m_iNumPointsInside, 0, sizeof(m_iNumPointsInside));
+#endif
 }
 
 TSPSNRMetric::~TSPSNRMetric()
@@ -222,6 +230,77 @@ void TSPSNRMetric::createTable(TGeometry *pcCodingGeomtry)
     }
 }
 
+#if SVIDEO_FISHEYE
+Void TSPSNRMetric::xInitPointInside(const PelUnitBuf& cPicD)
+{
+  m_iPointInsideWidth  = cPicD.get(COMPONENT_Y).width;
+  m_iPointInsideHeight = cPicD.get(COMPONENT_Y).height;
+  m_pointInsideFormat  = cPicD.chromaFormat;
+
+  // for fisheye center
+  Double  max_angle_rad = m_codingVideoInfo.sFisheyeInfo.fFOV /SVIDEO_ROT_PRECISION/ 2.0 * S_PI / 180.0;
+
+  Double  ctr_yaw = m_codingVideoInfo.sFisheyeInfo.fCentreAzimuth / SVIDEO_ROT_PRECISION * S_PI / 180;
+  Double  ctr_pitch = -m_codingVideoInfo.sFisheyeInfo.fCentreElevation / SVIDEO_ROT_PRECISION * S_PI / 180;
+
+  // ERP 2D to 3D mapping
+  Double  ctr_sphere_x = scos(ctr_pitch)*scos(ctr_yaw);
+  Double  ctr_sphere_y = ssin(ctr_pitch);
+  Double  ctr_sphere_z = -scos(ctr_pitch)*ssin(ctr_yaw);
+
+  Double  ctr_norm = ssqrt(ctr_sphere_x*ctr_sphere_x + ctr_sphere_y*ctr_sphere_y + ctr_sphere_z*ctr_sphere_z);
+
+  for (Int chan = 0; chan < MAX_NUM_COMPONENT; chan++)
+  {
+    m_pointInside[chan].clear();
+    m_iNumPointsInside[chan] = 0;
+  }
+  for (Int chan = 0; chan < getNumberValidComponents(cPicD.chromaFormat); chan++)
+  {
+    const ComponentID ch = ComponentID(chan);
+    Int iWidth = cPicD.get(ch).width << ::getComponentScaleX(ch, cPicD.chromaFormat);
+    Int iHeight = cPicD.get(ch).height << ::getComponentScaleY(ch, cPicD.chromaFormat);
+
+    m_pointInside[chan].assign(m_iSphNumPoints, 0);
+    for (Int np = 0; np < m_iSphNumPoints; np++)
+    {
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+      const IPos2D &pos = chan ? m_fpTableC[np] : m_fpTable[np];
+      Int x_loc = (Int)(pos.x);
+      Int y_loc = (Int)(pos.y);
+#else
+      Int x_loc = chan ? Int(m_fpTable[np].x >> ::getComponentScaleX(COMPONENT_Cb, cPicD.chromaFormat)) : (Int)(m_fpTable[np].x);
+      Int y_loc = chan ? Int(m_fpTable[np].y >> ::getComponentScaleY(COMPONENT_Cb, cPicD.chromaFormat)) : (Int)(m_fpTable[np].y);
+#endif
+
+      // for this position
+      Int    xx = x_loc << ::getComponentScaleX(ch, cPicD.chromaFormat);
+      Int    yy = y_loc << ::getComponentScaleY(ch, cPicD.chromaFormat);
+
+      Double  yaw = ((xx + 0.5) / iWidth - 0.5) * 2 * S_PI;
+      Double  pitch = ((yy + 0.5) / iHeight - 0.5) * -S_PI;
+
+      // ERP 2D to 3D mapping
+      Double  sphere_x = scos(pitch)*scos(yaw);
+      Double  sphere_y = ssin(pitch);
+      Double  sphere_z = -scos(pitch)*ssin(yaw);
+
+      Double  norm = ssqrt(sphere_x*sphere_x + sphere_y*sphere_y + sphere_z*sphere_z);
+
+      // theta 
+      Double  innerProduct = sphere_x*ctr_sphere_x + sphere_y*ctr_sphere_y + sphere_z*ctr_sphere_z;
+      Double  theta_rad = acos(innerProduct / (norm * ctr_norm));
+
+      if (theta_rad < max_angle_rad)
+      {
+        m_pointInside[chan][np] = 1;
+        m_iNumPointsInside[chan]++;
+      }
+    }
+  }
+}
+#endif
+
 Void TSPSNRMetric::xCalculateSPSNR(PelUnitBuf& cOrgPicYuv, PelUnitBuf& cPicD)
 {
   Int iNumPoints = m_iSphNumPoints;
@@ -236,10 +315,13 @@ Void TSPSNRMetric::xCalculateSPSNR(PelUnitBuf& cOrgPicYuv, PelUnitBuf& cPicD)
   iOutputBitShift[Int(ChannelType::CHROMA)] = iBitDepthForPSNRCalc[Int(ChannelType::CHROMA)] - m_outputBitDepth[Int(ChannelType::CHROMA)];
 
   memset(m_dSPSNR, 0, sizeof(Double) * 3);
-  //PelUnitBuf &picd=cPicD;
   Double SSDspsnr[3] = { 0, 0 ,0 };
-#if SVIDEO_FISHEYE  
-  Int num_subset[3] = { 0, 0, 0 };
+#if SVIDEO_FISHEYE
+  const Bool bFisheye = m_refVideoInfo.geoType == SVIDEO_EQUIRECT && m_codingVideoInfo.geoType == SVIDEO_FISHEYE_CIRCULAR;
+  if (bFisheye && (m_iPointInsideWidth != cPicD.get(COMPONENT_Y).width || m_iPointInsideHeight != cPicD.get(COMPONENT_Y).height || m_pointInsideFormat != cPicD.chromaFormat))
+  {
+    xInitPointInside(cPicD);
+  }
 #endif
   for (Int chan = 0; chan<getNumberValidComponents(cPicD.chromaFormat); chan++)
   {
@@ -248,124 +330,36 @@ Void TSPSNRMetric::xCalculateSPSNR(PelUnitBuf& cOrgPicYuv, PelUnitBuf& cPicD)
     const Int   iOrgStride = (Int)cOrgPicYuv.get(ch).stride;
     const Pel*  pRec = cPicD.get(ch).bufAt(0, 0);
     const Int   iRecStride = (Int)cPicD.get(ch).stride;
+    const Int   iOrgShift = iReferenceBitShift[Int(toChannelType(ch))];
+    const Int   iRecShift = iOutputBitShift[Int(toChannelType(ch))];
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+    const IPos2D* pTable = chan ? m_fpTableC : m_fpTable;
+    const Int   iScaleX = 0;
+    const Int   iScaleY = 0;
+#else
+    const IPos2D* pTable = m_fpTable;
+    const Int   iScaleX = chan ? ::getComponentScaleX(COMPONENT_Cb, cPicD.chromaFormat) : 0;
+    const Int   iScaleY = chan ? ::getComponentScaleY(COMPONENT_Cb, cPicD.chromaFormat) : 0;
+#endif
 #if SVIDEO_FISHEYE
-    num_subset[chan] = 0;
+    const UChar* pInside = bFisheye ? m_pointInside[chan].data() : nullptr;
 #endif
+    // squares of integer differences, summed exactly;
+    int64_t iSSD = 0;
     for (Int np = 0; np < iNumPoints; np++)
     {
-      if (!chan)
-      {
-        Int x_loc = (Int)(m_fpTable[np].x);
-        Int y_loc = (Int)(m_fpTable[np].y);
-        Intermediate_Int iDifflp = (pOrg[x_loc + (y_loc*iOrgStride)] << iReferenceBitShift[Int(toChannelType(ch))]) - (pRec[x_loc + (y_loc*iRecStride)] << iOutputBitShift[Int(toChannelType(ch))]);
 #if SVIDEO_FISHEYE
-        if (m_refVideoInfo.geoType == SVIDEO_EQUIRECT && m_codingVideoInfo.geoType == SVIDEO_FISHEYE_CIRCULAR)
-        {
-          Int iWidth = cPicD.get(ch).width << ::getComponentScaleX(ch, cPicD.chromaFormat);
-          Int iHeight = cPicD.get(ch).height << ::getComponentScaleY(ch, cPicD.chromaFormat);
-
-          // for fisheye center
-          Double  max_angle_rad = m_codingVideoInfo.sFisheyeInfo.fFOV /SVIDEO_ROT_PRECISION/ 2.0 * S_PI / 180.0;
-
-          Double  ctr_yaw = m_codingVideoInfo.sFisheyeInfo.fCentreAzimuth / SVIDEO_ROT_PRECISION * S_PI / 180;
-          Double  ctr_pitch = -m_codingVideoInfo.sFisheyeInfo.fCentreElevation / SVIDEO_ROT_PRECISION * S_PI / 180;
-
-          // ERP 2D to 3D mapping
-          Double  ctr_sphere_x = scos(ctr_pitch)*scos(ctr_yaw);
-          Double  ctr_sphere_y = ssin(ctr_pitch);
-          Double  ctr_sphere_z = -scos(ctr_pitch)*ssin(ctr_yaw);
-
-          Double  ctr_norm = ssqrt(ctr_sphere_x*ctr_sphere_x + ctr_sphere_y*ctr_sphere_y + ctr_sphere_z*ctr_sphere_z);
-
-
-          // for this position
-          Int    xx = x_loc << ::getComponentScaleX(ch, cPicD.chromaFormat);
-          Int    yy = y_loc << ::getComponentScaleY(ch, cPicD.chromaFormat);
-
-          Double  yaw = ((xx + 0.5) / iWidth - 0.5) * 2 * S_PI;
-          Double  pitch = ((yy + 0.5) / iHeight - 0.5) * -S_PI;
-
-          // ERP 2D to 3D mapping
-          Double  sphere_x = scos(pitch)*scos(yaw);
-          Double  sphere_y = ssin(pitch);
-          Double  sphere_z = -scos(pitch)*ssin(yaw);
-
-          Double  norm = ssqrt(sphere_x*sphere_x + sphere_y*sphere_y + sphere_z*sphere_z);
-
-          // theta 
-          Double  innerProduct = sphere_x*ctr_sphere_x + sphere_y*ctr_sphere_y + sphere_z*ctr_sphere_z;
-          Double  theta_rad = acos(innerProduct / (norm * ctr_norm));
-
-          if (theta_rad < max_angle_rad)
-          {
-            SSDspsnr[chan] += iDifflp*iDifflp;
-            num_subset[chan]++;
-          }
-        }
-        else
-#endif
-          SSDspsnr[chan] += iDifflp*iDifflp;
-      }
-      else
+      if (pInside && !pInside[np])
       {
-#if SVIDEO_CHROMA_TYPES_SUPPORT
-        Int x_loc = Int(m_fpTableC[np].x);
-        Int y_loc = Int(m_fpTableC[np].y);
-#else
-        Int x_loc = Int(m_fpTable[np].x >> ::getComponentScaleX(COMPONENT_Cb, cPicD.chromaFormat));
-        Int y_loc = Int(m_fpTable[np].y >> ::getComponentScaleY(COMPONENT_Cb, cPicD.chromaFormat));
-#endif
-        Intermediate_Int iDifflp = (pOrg[x_loc + (y_loc*iOrgStride)] << iReferenceBitShift[Int(toChannelType(ch))]) - (pRec[x_loc + (y_loc*iRecStride)] << iOutputBitShift[Int(toChannelType(ch))]);
-
-#if SVIDEO_FISHEYE
-        if (m_refVideoInfo.geoType == SVIDEO_EQUIRECT && m_codingVideoInfo.geoType == SVIDEO_FISHEYE_CIRCULAR)
-        {
-          Int iWidth = cPicD.get(ch).width << ::getComponentScaleX(ch, cPicD.chromaFormat);
-          Int iHeight = cPicD.get(ch).height << ::getComponentScaleY(ch, cPicD.chromaFormat);
-
-          // for fisheye center
-          Double  max_angle_rad = m_codingVideoInfo.sFisheyeInfo.fFOV / SVIDEO_ROT_PRECISION / 2.0 * S_PI / 180.0;
-
-          Double  ctr_yaw = m_codingVideoInfo.sFisheyeInfo.fCentreAzimuth / SVIDEO_ROT_PRECISION * S_PI / 180 ;
-          Double  ctr_pitch = -m_codingVideoInfo.sFisheyeInfo.fCentreElevation / SVIDEO_ROT_PRECISION * S_PI / 180;
-
-          // ERP 2D to 3D mapping
-          Double  ctr_sphere_x = scos(ctr_pitch)*scos(ctr_yaw);
-          Double  ctr_sphere_y = ssin(ctr_pitch);
-          Double  ctr_sphere_z = -scos(ctr_pitch)*ssin(ctr_yaw);
-
-          Double  ctr_norm = ssqrt(ctr_sphere_x*ctr_sphere_x + ctr_sphere_y*ctr_sphere_y + ctr_sphere_z*ctr_sphere_z);
-
-
-          // for this position
-          Int    xx = x_loc << ::getComponentScaleX(ch, cPicD.chromaFormat);
-          Int    yy = y_loc << ::getComponentScaleY(ch, cPicD.chromaFormat);
-
-          Double  yaw = ((xx + 0.5) / iWidth - 0.5) * 2 * S_PI;
-          Double  pitch = ((yy + 0.5) / iHeight - 0.5) * -S_PI;
-
-          // ERP 2D to 3D mapping
-          Double  sphere_x = scos(pitch)*scos(yaw);
-          Double  sphere_y = ssin(pitch);
-          Double  sphere_z = -scos(pitch)*ssin(yaw);
-
-          Double  norm = ssqrt(sphere_x*sphere_x + sphere_y*sphere_y + sphere_z*sphere_z);
-
-          // theta 
-          Double  innerProduct = sphere_x*ctr_sphere_x + sphere_y*ctr_sphere_y + sphere_z*ctr_sphere_z;
-          Double  theta_rad = acos(innerProduct / (norm * ctr_norm));
-
-          if (theta_rad < max_angle_rad)
-          {
-            SSDspsnr[chan] += iDifflp*iDifflp;
-            num_subset[chan]++;
-          }
-        }
-        else
-#endif
-          SSDspsnr[chan] += iDifflp*iDifflp;
+        continue;
       }
+#endif
+      Int x_loc = Int(pTable[np].x >> iScaleX);
+      Int y_loc = Int(pTable[np].y >> iScaleY);
+      Intermediate_Int iDifflp = (pOrg[x_loc + (y_loc*iOrgStride)] << iOrgShift) - (pRec[x_loc + (y_loc*iRecStride)] << iRecShift);
+      iSSD += iDifflp*iDifflp;
     }
+    SSDspsnr[chan] = (Double)iSSD;
   }
 
   for (Int ch_indx = 0; ch_indx < getNumberValidComponents(cPicD.chromaFormat); ch_indx++)
@@ -375,8 +369,8 @@ Void TSPSNRMetric::xCalculateSPSNR(PelUnitBuf& cOrgPicYuv, PelUnitBuf& cPicD)
 
     Double fReflpsnr = Double(iNumPoints)*maxval*maxval;
 #if SVIDEO_FISHEYE
-    if (m_refVideoInfo.geoType == SVIDEO_EQUIRECT && m_codingVideoInfo.geoType == SVIDEO_FISHEYE_CIRCULAR)
-      fReflpsnr = Double(num_subset[ch_indx])*maxval*maxval;
+    if (bFisheye)
+      fReflpsnr = Double(m_iNumPointsInside[ch_indx])*maxval*maxval;
 #endif
     m_dSPSNR[ch_indx] = (SSDspsnr[ch_indx] ? 10.0 * log10(fReflpsnr / (Double)SSDspsnr[ch_indx]) : 999.99);
   }
@@ -609,45 +603,64 @@ Void TSPSNRMetric::xCalculateCFSPSNR( PelUnitBuf *pcOrigPicYuv, PelUnitBuf* pcRe
   }
   pcRefGeometry->spherePadding(true);
   
-  for(Int chan=0; chan<getNumberValidComponents(pcRecPicYuv->chromaFormat); chan++)
+  if (m_refPelWeight[COMPONENT_Y].empty())
   {
-    const ComponentID ch=ComponentID(chan);
+    for(Int chan=0; chan<getNumberValidComponents(pcRecPicYuv->chromaFormat); chan++)
+    {
+      const ComponentID ch=ComponentID(chan);
 #if SVIDEO_CF_SPSNR_NN_ENH
-    SPos2D* pSamplePosRef = chan==0? m_pSamplePosTable : m_pSamplePosCTable;
-    SPos2D* pSamplePosRec = chan==0? m_pSamplePosRecTable : m_pSamplePosCRecTable;
+      SPos2D* pSamplePosRef = chan==0? m_pSamplePosTable : m_pSamplePosCTable;
+      SPos2D* pSamplePosRec = chan==0? m_pSamplePosRecTable : m_pSamplePosCRecTable;
 #else
-    IPos* pSamplePosRef = chan==0? m_pSamplePosTable : m_pSamplePosCTable;
-    IPos* pSamplePosRec = chan==0? m_pSamplePosRecTable : m_pSamplePosCRecTable;
-#endif    
-    for (Int np = 0; np < iNumPoints; np++)
-    {
-      SPos sCodingPos, sRefPos;
+      IPos* pSamplePosRef = chan==0? m_pSamplePosTable : m_pSamplePosCTable;
+      IPos* pSamplePosRec = chan==0? m_pSamplePosRecTable : m_pSamplePosCRecTable;
+#endif
+      m_refPelWeight[chan].resize(iNumPoints);
+      m_recPelWeight[chan].resize(iNumPoints);
+      for (Int np = 0; np < iNumPoints; np++)
+      {
+        SPos sCodingPos, sRefPos;
 
-      sRefPos.faceIdx = pSamplePosRef[np].faceIdx;
+        sRefPos.faceIdx = pSamplePosRef[np].faceIdx;
 #if SVIDEO_CF_SPSNR_NN_ENH
-      sRefPos.x = pSamplePosRef[np].x;
-      sRefPos.y = pSamplePosRef[np].y;
+        sRefPos.x = pSamplePosRef[np].x;
+        sRefPos.y = pSamplePosRef[np].y;
 #else
-      sRefPos.x = pSamplePosRef[np].u;
-      sRefPos.y = pSamplePosRef[np].v;
+        sRefPos.x = pSamplePosRef[np].u;
+        sRefPos.y = pSamplePosRef[np].v;
 #endif
-      sRefPos.z = 0;
-      Pel refPel    = pcRefGeometry->getPelValue(ch, sRefPos);
+        sRefPos.z = 0;
+        pcRefGeometry->getPelWeight(ch, sRefPos, m_refPelWeight[chan][np]);
 
-      sCodingPos.faceIdx = pSamplePosRec[np].faceIdx;
+        sCodingPos.faceIdx = pSamplePosRec[np].faceIdx;
 #if SVIDEO_CF_SPSNR_NN_ENH
-      sCodingPos.x = pSamplePosRec[np].x;
-      sCodingPos.y = pSamplePosRec[np].y;
+        sCodingPos.x = pSamplePosRec[np].x;
+        sCodingPos.y = pSamplePosRec[np].y;
 #else
-      sCodingPos.x = pSamplePosRec[np].u;
-      sCodingPos.y = pSamplePosRec[np].v;
+        sCodingPos.x = pSamplePosRec[np].u;
+        sCodingPos.y = pSamplePosRec[np].v;
 #endif
-      sCodingPos.z = 0;
-      Pel codingPel = pcCodingGeometry->getPelValue(ch, sCodingPos);      
+        sCodingPos.z = 0;
+        pcCodingGeometry->getPelWeight(ch, sCodingPos, m_recPelWeight[chan][np]);
+      }
+    }
+  }
+
+  for(Int chan=0; chan<getNumberValidComponents(pcRecPicYuv->chromaFormat); chan++)
+  {
+    const ComponentID ch=ComponentID(chan);
+    const PxlFltLut* pRefWeight = m_refPelWeight[chan].data();
+    const PxlFltLut* pRecWeight = m_recPelWeight[chan].data();
+    int64_t iSSD = 0;
+    for (Int np = 0; np < iNumPoints; np++)
+    {
+      Pel refPel    = pcRefGeometry->getPelValueFromWeight(ch, pRefWeight[np]);
+      Pel codingPel = pcCodingGeometry->getPelValueFromWeight(ch, pRecWeight[np]);
 
       Intermediate_Int iDifflp =  (Intermediate_Int)((refPel<<iReferenceBitShift[Int(toChannelType(ch))]) - (codingPel<<iOutputBitShift[Int(toChannelType(ch))]) );
-      SSDSPSNR[chan] += iDifflp*iDifflp;
+      iSSD += iDifflp*iDifflp;
     }
+    SSDSPSNR[chan] = (Double)iSSD;
   }
 
   for (Int ch_indx = 0; ch_indx < getNumberValidComponents(pcRecPicYuv->chromaFormat); ch_indx++)
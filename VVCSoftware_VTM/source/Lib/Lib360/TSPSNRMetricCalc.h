@@ -38,6 +38,7 @@
 #ifndef __TSPSNRCALC__
 #define __TSPSNRCALC__
 #include "TGeometry.h"
+#include <vector>
 
 // ====================================================================================================================
 // Class definition
@@ -78,6 +79,17 @@ private:
   IPos*       m_pSamplePosCTable;  
   IPos*       m_pSamplePosCRecTable;
 #endif
+  std::vector<PxlFltLut> m_refPelWeight[MAX_NUM_COMPONENT];  //interpolation taps of the sample positions, built at the first picture;
+  std::vector<PxlFltLut> m_recPelWeight[MAX_NUM_COMPONENT];
+#endif
+#if SVIDEO_FISHEYE
+  std::vector<UChar> m_pointInside[MAX_NUM_COMPONENT];       //sample points inside the fisheye field of view;
+  Int           m_iNumPointsInside[MAX_NUM_COMPONENT];
+  Int           m_iPointInsideWidth;                         //luma size the points were tested for, 0 if not tested yet;
+  Int           m_iPointInsideHeight;
+  ChromaFormat  m_pointInsideFormat;
+
+  Void    xInitPointInside(const PelUnitBuf& cPicD);
 #endif
 public:
   TSPSNRMetric();
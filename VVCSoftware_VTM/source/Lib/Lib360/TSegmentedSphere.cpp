@@ -62,15 +62,12 @@ TSegmentedSphere::~TSegmentedSphere()
 #if SVIDEO_EAP_SSP_PADDING
   for(Int i = 0; i < 2; i++)
   {
-    if(pixelWeight4PolePadding[i])
+    for(Int j = 0; j < 2; j++)
     {
-      for(Int j = 0; j < 2; j++)
+      if(pixelWeight4PolePadding[i][j])
       {
-        if(pixelWeight4PolePadding[i][j])
-        {
-          delete[] pixelWeight4PolePadding[i][j];
-          pixelWeight4PolePadding[i][j] = nullptr;
-        }
+        delete[] pixelWeight4PolePadding[i][j];
+        pixelWeight4PolePadding[i][j] = nullptr;
       }
     }
   }
@@ -88,8 +88,12 @@ TWSPSNRMetric::TWSPSNRMetric()
 , m_temporalSubsampleRatio(1)
 #endif
 #endif
+, m_sampleWeightWidth(0)
+, m_sampleWeightHeight(0)
+, m_sampleWeightFormat(ChromaFormat::_400)
 {
   m_dWSPSNR[0] = m_dWSPSNR[1] = m_dWSPSNR[2] = 0;
+  memset(m_sampleWeightSum, 0, sizeof(m_sampleWeightSum));
 }
 
 TWSPSNRMetric::~TWSPSNRMetric()
@@ -302,6 +306,7 @@ void TWSPSNRMetric::createTable(PelUnitBuf* pcPicD, TGeometry *pcCodingGeomtry)
   {
     return;
   }
+  m_sampleWeightWidth = 0;
 
   SVideoInfo *pCodingSVideoInfo = pcCodingGeomtry->getSVideoInfo();
   Int iFaceWidth = pCodingSVideoInfo->iFaceWidth;
@@ -2885,314 +2890,285 @@ void TWSPSNRMetric::createTable(PelUnitBuf* pcPicD, TGeometry *pcCodingGeomtry)
   }
 }
 
-Void TWSPSNRMetric::xCalculateWSPSNR( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcPicD )
+//weighted SSE of one row, with 4 partial sums so that the loop is vectorized;
+static Double xWeightedSSE(const Pel* pOrg, Int iOrgShift, const Pel* pRec, Int iRecShift, const Double* pWeight, Int iWidth)
 {
-  Int iBitDepthForPSNRCalc[MAX_NUM_CHANNEL_TYPE];
-  Int iReferenceBitShift[MAX_NUM_CHANNEL_TYPE];
-  Int iOutputBitShift[MAX_NUM_CHANNEL_TYPE];
-  iBitDepthForPSNRCalc[Int(ChannelType::LUMA)] = std::max(m_outputBitDepth[Int(ChannelType::LUMA)], m_referenceBitDepth[Int(ChannelType::LUMA)]);
-  iBitDepthForPSNRCalc[Int(ChannelType::CHROMA)] = std::max(m_outputBitDepth[Int(ChannelType::CHROMA)], m_referenceBitDepth[Int(ChannelType::CHROMA)]);
-  iReferenceBitShift[Int(ChannelType::LUMA)] = iBitDepthForPSNRCalc[Int(ChannelType::LUMA)] - m_referenceBitDepth[Int(ChannelType::LUMA)];
-  iReferenceBitShift[Int(ChannelType::CHROMA)] = iBitDepthForPSNRCalc[Int(ChannelType::CHROMA)] - m_referenceBitDepth[Int(ChannelType::CHROMA)];
-  iOutputBitShift[Int(ChannelType::LUMA)] = iBitDepthForPSNRCalc[Int(ChannelType::LUMA)] - m_outputBitDepth[Int(ChannelType::LUMA)];
-  iOutputBitShift[Int(ChannelType::CHROMA)] = iBitDepthForPSNRCalc[Int(ChannelType::CHROMA)] - m_outputBitDepth[Int(ChannelType::CHROMA)];
-
-  memset(m_dWSPSNR, 0, sizeof(Double)*3);
-  PelUnitBuf &picd=*pcPicD;
-  //Double SSDspsnr[3]={0, 0 ,0};
-  //ChromaFormat chromaFormat = pcPicD->chromaFormat;
-
-  for(Int chan=0; chan< getNumberValidComponents(pcPicD->chromaFormat); chan++)
+  Double dSum[4] = { 0, 0, 0, 0 };
+  Int x = 0;
+  for (; x + 4 <= iWidth; x += 4)
   {
-    const ComponentID ch=ComponentID(chan);
-    const Pel*  pOrg       = pcOrgPicYuv->get(ch).bufAt(0, 0);
-    const Int   iOrgStride = (Int)pcOrgPicYuv->get(ch).stride;
-    const Pel*  pRec       = picd.get(ch).bufAt(0, 0);
-    const Int   iRecStride = (Int)picd.get(ch).stride;
-#if SVIDEO_HEMI_PROJECTIONS || SVIDEO_FISHEYE
-    Int Width_from = 0;
-    Int Width_to = 0;
-    Int iWidth = pcPicD->get(ch).width;
-    Int iHeight = pcPicD->get(ch).height;
-  
-    if (m_recGeoType == SVIDEO_HCMP || m_recGeoType == SVIDEO_HEAC)
+    for (Int k = 0; k < 4; k++)
     {
-      Width_from = iWidth / 4;
-      Width_to = iWidth - iWidth / 4;
-    }
-    else
-    {
-      Width_to = iWidth;
+      Intermediate_Int iDiff = (Intermediate_Int)((pOrg[x + k] << iOrgShift) - (pRec[x + k] << iRecShift));
+      dSum[k] += iDiff * iDiff * pWeight[x + k];
     }
+  }
+  for (; x < iWidth; x++)
+  {
+    Intermediate_Int iDiff = (Intermediate_Int)((pOrg[x] << iOrgShift) - (pRec[x] << iRecShift));
+    dSum[0] += iDiff * iDiff * pWeight[x];
+  }
+  return (dSum[0] + dSum[1]) + (dSum[2] + dSum[3]);
+}
 
-#else
-    const Int   iWidth  = pcPicD->get(ch).width ;
-    const Int   iHeight = pcPicD->get(ch).height ;
-#endif
-    Double fWeight =1;
-    Double fWeightSum=0;
-    //Int   iSize   = iWidth*iHeight;
+//unweighted SSE of one row segment, the caller applies the weight shared by its samples;
+static int64_t xSSE(const Pel* pOrg, Int iOrgShift, const Pel* pRec, Int iRecShift, Int iWidth)
+{
+  int64_t iSum = 0;
+  for (Int x = 0; x < iWidth; x++)
+  {
+    const int64_t iDiff = (int64_t)(pOrg[x] << iOrgShift) - (int64_t)(pRec[x] << iRecShift);
+    iSum += iDiff * iDiff;
+  }
+  return iSum;
+}
 
-    Double SSDwpsnr=0;
-      
-      
-    //WS-PSNR
-    for(Int y = 0; y < iHeight; y++ )
-    {
-        
-      if (m_codingGeoType==SVIDEO_EQUIRECT)
-      {      
-        if(!chan)
-        {
-          fWeight=m_fErpWeight_Y[y];
-        }
-        else
-        {
-          fWeight=m_fErpWeight_C[y];
-        }
-      }
-#if SVIDEO_HEMI_PROJECTIONS 
-      for (Int x = Width_from; x < Width_to; x++)
+Void TWSPSNRMetric::xInitSampleWeights(const PelUnitBuf* pcPicD)
+{
+  m_sampleWeightWidth  = pcPicD->get(COMPONENT_Y).width;
+  m_sampleWeightHeight = pcPicD->get(COMPONENT_Y).height;
+  m_sampleWeightFormat = pcPicD->chromaFormat;
+
+  for(Int chan=0; chan< MAX_NUM_COMPONENT; chan++)
+  {
+    m_weightSpan[chan].clear();
+    m_weightSpanRow[chan].clear();
+    m_sampleWeightSum[chan] = 0;
+  }
+  for(Int chan=0; chan< getNumberValidComponents(pcPicD->chromaFormat); chan++)
+  {
+    const ComponentID  ch      = ComponentID(chan);
+    const ChromaFormat fmt     = pcPicD->chromaFormat;
+    const Int          iWidth  = pcPicD->get(ch).width;
+    const Int          iHeight = pcPicD->get(ch).height;
+#if SVIDEO_HEMI_PROJECTIONS
+    const Bool bHemi      = m_recGeoType == SVIDEO_HCMP || m_recGeoType == SVIDEO_HEAC;
+    const Int  Width_from = bHemi ? iWidth / 4 : 0;
+    const Int  Width_to   = bHemi ? iWidth - iWidth / 4 : iWidth;
 #else
-      for(Int x = 0; x < iWidth; x++ )
+    const Int  Width_from = 0;
+    const Int  Width_to   = iWidth;
 #endif
-      {
-        Intermediate_Int iDiff = (Intermediate_Int)( (pOrg[x]<<iReferenceBitShift[Int(toChannelType(ch))]) - (pRec[x]<<iOutputBitShift[Int(toChannelType(ch))]) );
-        if(  (m_codingGeoType == SVIDEO_CUBEMAP) 
+
+    //the weight of a sample comes from the face table, from the plane table, or is the same for the whole row;
+    const Bool bCube = (m_codingGeoType == SVIDEO_CUBEMAP)
 #if SVIDEO_ADJUSTED_CUBEMAP
-          || (m_codingGeoType == SVIDEO_ADJUSTEDCUBEMAP)
+      || (m_codingGeoType == SVIDEO_ADJUSTEDCUBEMAP)
 #endif
 #if SVIDEO_EQUATORIAL_CYLINDRICAL && !SVIDEO_ECP_WSPSNR_FIX_TICKET56
-          || (m_codingGeoType == SVIDEO_EQUATORIALCYLINDRICAL)
+      || (m_codingGeoType == SVIDEO_EQUATORIALCYLINDRICAL)
 #endif
 #if SVIDEO_EQUIANGULAR_CUBEMAP
-          || (m_codingGeoType == SVIDEO_EQUIANGULARCUBEMAP)
+      || (m_codingGeoType == SVIDEO_EQUIANGULARCUBEMAP)
 #endif
 #if SVIDEO_HEMI_PROJECTIONS
-          || (m_codingGeoType == SVIDEO_HCMP)
-          || (m_codingGeoType == SVIDEO_HEAC)
+      || (m_codingGeoType == SVIDEO_HCMP)
+      || (m_codingGeoType == SVIDEO_HEAC)
 #endif
-          )
-        {
-          if(!chan)
-          {
-            if(iWidth/4 == iHeight/3 && x >= iWidth/4 && (y< iHeight/3 || y>= 2*iHeight/3))
-            {
-              fWeight=0;
-            }
-            else 
-            {
-              fWeight=m_fCubeWeight_Y[(m_iCodingFaceWidth)*(y%(m_iCodingFaceHeight)) +(x%(m_iCodingFaceWidth))];
-            }
+      ;
+    const Int     iFaceWidth  = m_iCodingFaceWidth >> (chan ? ::getComponentScaleX(COMPONENT_Cb, fmt) : 0);
+    const Int     iFaceHeight = m_iCodingFaceHeight >> (chan ? ::getComponentScaleY(COMPONENT_Cb, fmt) : 0);
+    const Double *pFaceWeight = bCube ? (chan ? m_fCubeWeight_C : m_fCubeWeight_Y) : nullptr;
 
-          }
-          else
-          {
-            if(iWidth/4 == iHeight/3 && x >= iWidth/4 && (y< iHeight/3 || y>= 2*iHeight/3))
-            {
-              fWeight=0;
-            }
-            else
-            {
-              fWeight=m_fCubeWeight_C[(m_iCodingFaceWidth>>(::getComponentScaleX(COMPONENT_Cb, pcPicD->chromaFormat)))*(y%(m_iCodingFaceHeight>>(::getComponentScaleY(COMPONENT_Cb, pcPicD->chromaFormat)))) +(x%(m_iCodingFaceWidth>>(::getComponentScaleX(COMPONENT_Cb,pcPicD->chromaFormat))))];
-            }  
-          }
-        }
+    const Double *pPlaneWeight = nullptr;
 #if SVIDEO_ADJUSTED_EQUALAREA
-        else if (m_codingGeoType==SVIDEO_ADJUSTEDEQUALAREA)
+    if (m_codingGeoType==SVIDEO_ADJUSTEDEQUALAREA)
 #else
-        else if (m_codingGeoType==SVIDEO_EQUALAREA)
+    if (m_codingGeoType==SVIDEO_EQUALAREA)
 #endif
-        {
-          if(!chan)
-          {
-            fWeight=m_fEapWeight_Y[y*iWidth+x];
-          }
-          else
-          {
-            fWeight=m_fEapWeight_C[y*iWidth+x];
-          }
-        }
-        else if (m_codingGeoType==SVIDEO_OCTAHEDRON )
-        {
-          if(!chan)
-          {
-            fWeight=m_fOctaWeight_Y[iWidth*y +x];
-          }
-          else
-          {
-            fWeight=m_fOctaWeight_C[y*iWidth+x];
-          }
-        }
-        else if ( m_codingGeoType==SVIDEO_ICOSAHEDRON)
-        {
-          if(!chan)
-          {
-            fWeight=m_fIcoWeight_Y[iWidth*y +x];
-          }
-          else
-          {
-            fWeight=m_fIcoWeight_C[y*iWidth+x];
-          }
-        }
+    {
+      pPlaneWeight = chan ? m_fEapWeight_C : m_fEapWeight_Y;
+    }
+    else if (m_codingGeoType==SVIDEO_OCTAHEDRON)
+    {
+      pPlaneWeight = chan ? m_fOctaWeight_C : m_fOctaWeight_Y;
+    }
+    else if (m_codingGeoType==SVIDEO_ICOSAHEDRON)
+    {
+      pPlaneWeight = chan ? m_fIcoWeight_C : m_fIcoWeight_Y;
+    }
 #if SVIDEO_WSPSNR_SSP
-        else if (m_codingGeoType == SVIDEO_SEGMENTEDSPHERE)
-        {
-            if (!chan)
-            {
-                fWeight = m_fSspWeight_Y[iWidth*y + x];
-            }
-            else
-            {
-                fWeight = m_fSspWeight_C[y*iWidth + x];
-            }
-        }
+    else if (m_codingGeoType == SVIDEO_SEGMENTEDSPHERE)
+    {
+      pPlaneWeight = chan ? m_fSspWeight_C : m_fSspWeight_Y;
+    }
 #endif
 #if SVIDEO_ROTATED_SPHERE
-        else if (m_codingGeoType==SVIDEO_ROTATEDSPHERE)
-        {
-            if(!chan)
-            {
-                fWeight = m_fRspWeight_Y[iWidth*y + x];
-            }
-            else
-            {
-                fWeight = m_fRspWeight_C[y*iWidth + x];
-            }
-        }
+    else if (m_codingGeoType==SVIDEO_ROTATEDSPHERE)
+    {
+      pPlaneWeight = chan ? m_fRspWeight_C : m_fRspWeight_Y;
+    }
 #endif
 #if SVIDEO_ECP_WSPSNR_FIX_TICKET56
-        else if (m_codingGeoType==SVIDEO_EQUATORIALCYLINDRICAL)
-        {
-            if(!chan)
-            {
-                fWeight = m_fEcpWeight_Y[iWidth*y + x];
-            }
-            else
-            {
-                fWeight = m_fEcpWeight_C[y*iWidth + x];
-            }
-        }
-#endif
-#if SVIDEO_ERP_PADDING
-        else if (m_codingGeoType == SVIDEO_EQUIRECT && m_bPERP )
-        {
-#if 1
-            ChromaFormat fmt = pcPicD->chromaFormat;                
-            if ((x < (SVIDEO_ERP_PAD_L >> getComponentScaleX(ch, fmt))) || (x >= (iWidth - (SVIDEO_ERP_PAD_R >> getComponentScaleX(ch, fmt)))))
-                fWeight = 0;
-            else
-                fWeight = (!chan)? m_fErpWeight_Y[y] : m_fErpWeight_C[y];
-#else
-            if (!chan)
-            {
-                if( (x < SVIDEO_ERP_PAD_L) || (x >= (iWidth - SVIDEO_ERP_PAD_R)))
-                    fWeight = 0;
-                else
-                    fWeight = m_fErpWeight_Y[y];
-            }
-            else
-            {
-                ComponentID chId = ComponentID(chan);
-                ChromaFormat fmt = pcPicD->chromaFormat;
-                
-                if ((x < (SVIDEO_ERP_PAD_L >> getComponentScaleX(chId, fmt))) || (x >= (iWidth - (SVIDEO_ERP_PAD_R >> getComponentScaleX(chId, fmt)))))
-                    fWeight = 0;
-                else
-                    fWeight = m_fErpWeight_C[y];
-            }
-#endif
-        }
+    else if (m_codingGeoType==SVIDEO_EQUATORIALCYLINDRICAL)
+    {
+      pPlaneWeight = chan ? m_fEcpWeight_C : m_fEcpWeight_Y;
+    }
 #endif
 #if SVIDEO_HYBRID_EQUIANGULAR_CUBEMAP
-        else if (m_codingGeoType == SVIDEO_HYBRIDEQUIANGULARCUBEMAP)
-        {
-          if(!chan)
-          {
-            fWeight=m_fHecWeight_Y[y*iWidth+x];
-          }
-          else
-          {
-            fWeight=m_fHecWeight_C[y*iWidth+x];
-          }
-        }
+    else if (m_codingGeoType == SVIDEO_HYBRIDEQUIANGULARCUBEMAP)
+    {
+      pPlaneWeight = chan ? m_fHecWeight_C : m_fHecWeight_Y;
+    }
 #endif
 #if SVIDEO_GENERALIZED_CUBEMAP
-        else if (m_codingGeoType == SVIDEO_GENERALIZEDCUBEMAP)
-        {
-          if(!chan)
-          {
-            fWeight=m_fGcmpWeight_Y[y*iWidth+x];
-          }
-          else
-          {
-            fWeight=m_fGcmpWeight_C[y*iWidth+x];
-          }
-        }
+    else if (m_codingGeoType == SVIDEO_GENERALIZEDCUBEMAP)
+    {
+      pPlaneWeight = chan ? m_fGcmpWeight_C : m_fGcmpWeight_Y;
+    }
 #endif
 
-
+#if SVIDEO_ERP_PADDING
+    const Bool bPERP = m_codingGeoType == SVIDEO_EQUIRECT && m_bPERP;
+    const Int  iPadL = SVIDEO_ERP_PAD_L >> getComponentScaleX(ch, fmt);
+    const Int  iPadR = SVIDEO_ERP_PAD_R >> getComponentScaleX(ch, fmt);
+#endif
 #if SVIDEO_FISHEYE
-    if (m_codingGeoType == SVIDEO_EQUIRECT && m_recGeoType == SVIDEO_FISHEYE_CIRCULAR)
-    {
-      Double  max_angle_rad = m_fisheyeInfo.fFOV / SVIDEO_ROT_PRECISION / 2 * S_PI / 180.0;
+    const Bool bFisheye = m_codingGeoType == SVIDEO_EQUIRECT && m_recGeoType == SVIDEO_FISHEYE_CIRCULAR;
 
-      Double  ctr_yaw = m_fisheyeInfo.fCentreAzimuth/SVIDEO_ROT_PRECISION * S_PI / 180;
-      Double  ctr_pitch = -m_fisheyeInfo.fCentreElevation/SVIDEO_ROT_PRECISION  * S_PI / 180;
+    Double  max_angle_rad = m_fisheyeInfo.fFOV / SVIDEO_ROT_PRECISION / 2 * S_PI / 180.0;
 
-      Double  ctr_sphere_x = scos(ctr_pitch)*scos(ctr_yaw);
-      Double  ctr_sphere_y = ssin(ctr_pitch);
-      Double  ctr_sphere_z = -scos(ctr_pitch)*ssin(ctr_yaw);
+    Double  ctr_yaw = m_fisheyeInfo.fCentreAzimuth/SVIDEO_ROT_PRECISION * S_PI / 180;
+    Double  ctr_pitch = -m_fisheyeInfo.fCentreElevation/SVIDEO_ROT_PRECISION  * S_PI / 180;
 
-      Double  ctr_norm = ssqrt(ctr_sphere_x*ctr_sphere_x + ctr_sphere_y*ctr_sphere_y + ctr_sphere_z*ctr_sphere_z);
+    Double  ctr_sphere_x = scos(ctr_pitch)*scos(ctr_yaw);
+    Double  ctr_sphere_y = ssin(ctr_pitch);
+    Double  ctr_sphere_z = -scos(ctr_pitch)*ssin(ctr_yaw);
+
+    Double  ctr_norm = ssqrt(ctr_sphere_x*ctr_sphere_x + ctr_sphere_y*ctr_sphere_y + ctr_sphere_z*ctr_sphere_z);
+
+    Int    sWidth = iWidth << getComponentScaleX(ch, fmt);
+    Int    sHeight = iHeight << getComponentScaleY(ch, fmt);
+#endif
 
+    Double fWeightSum=0;
+    std::vector<WeightSpan> &spans = m_weightSpan[chan];
+    m_weightSpanRow[chan].resize(iHeight + 1);
 
-      Int    xx = x << getComponentScaleX(ch, pcPicD->chromaFormat);
-      Int    yy = y << getComponentScaleY(ch, pcPicD->chromaFormat);
+    for(Int y = 0; y < iHeight; y++ )
+    {
+      const Int     iRowStart   = (Int)spans.size();
+      const Double  fRowWeight  = m_codingGeoType == SVIDEO_EQUIRECT ? (chan ? m_fErpWeight_C[y] : m_fErpWeight_Y[y]) : 1;
+      const Double *pRowWeight  = pFaceWeight ? pFaceWeight + iFaceWidth * (y % iFaceHeight)
+                                              : (pPlaneWeight ? pPlaneWeight + iWidth * y : nullptr);
+      const Bool    bEmptyFaces = bCube && iWidth/4 == iHeight/3 && (y< iHeight/3 || y>= 2*iHeight/3);
+      m_weightSpanRow[chan][y] = iRowStart;
 
-      Int    sWidth = pcPicD->get(ch).width << getComponentScaleX(ch, pcPicD->chromaFormat);
-      Int    sHeight = pcPicD->get(ch).height << getComponentScaleY(ch, pcPicD->chromaFormat);
+      for (Int x = Width_from; x < Width_to; x++)
+      {
+        if (bEmptyFaces && x >= iWidth/4)
+        {
+          break;
+        }
+#if SVIDEO_ERP_PADDING
+        if (bPERP && (x < iPadL || x >= iWidth - iPadR))
+        {
+          continue;
+        }
+#endif
+#if SVIDEO_FISHEYE
+        if (bFisheye)
+        {
+          Int    xx = x << getComponentScaleX(ch, fmt);
+          Int    yy = y << getComponentScaleY(ch, fmt);
 
-      Double  yaw = ((xx + 0.5) / sWidth - 0.5) * 2 * S_PI;
-      Double  pitch = ((yy + 0.5) / sHeight - 0.5) * -S_PI;
+          Double  yaw = ((xx + 0.5) / sWidth - 0.5) * 2 * S_PI;
+          Double  pitch = ((yy + 0.5) / sHeight - 0.5) * -S_PI;
 
-      Double  sphere_x = scos(pitch)*scos(yaw);
-      Double  sphere_y = ssin(pitch);
-      Double  sphere_z = -scos(pitch)*ssin(yaw);
+          Double  sphere_x = scos(pitch)*scos(yaw);
+          Double  sphere_y = ssin(pitch);
+          Double  sphere_z = -scos(pitch)*ssin(yaw);
 
-      Double  norm = ssqrt(sphere_x*sphere_x + sphere_y*sphere_y + sphere_z*sphere_z);
+          Double  norm = ssqrt(sphere_x*sphere_x + sphere_y*sphere_y + sphere_z*sphere_z);
 
+          Double  innerProduct = sphere_x*ctr_sphere_x + sphere_y*ctr_sphere_y + sphere_z*ctr_sphere_z;
+          Double  theta_rad = acos(innerProduct / (norm * ctr_norm));
 
-      Double  innerProduct = sphere_x*ctr_sphere_x + sphere_y*ctr_sphere_y + sphere_z*ctr_sphere_z;
-      Double  theta_rad = acos(innerProduct / (norm * ctr_norm));
-      
-      if (theta_rad < max_angle_rad)
-      {
+          if (theta_rad >= max_angle_rad)
+          {
+            continue;
+          }
+        }
+#endif  // SVIDEO_FISHEYE
+        const Double *pWeight = pRowWeight ? pRowWeight + (pFaceWeight ? x % iFaceWidth : x) : nullptr;
+        const Double  fWeight = pWeight ? *pWeight : fRowWeight;
         if (fWeight > 0)
+        {
           fWeightSum += fWeight;
-        SSDwpsnr += iDiff * iDiff*fWeight;
+        }
+
+        //a span of table weights must not cross a face boundary, where the table restarts;
+        if ((Int)spans.size() > iRowStart && spans.back().x1 == x && !(pFaceWeight && x % iFaceWidth == 0))
+        {
+          spans.back().x1++;
+        }
+        else
+        {
+          spans.push_back({ x, x + 1, pWeight, fRowWeight });
+        }
       }
     }
-    else
+    m_weightSpanRow[chan][iHeight] = (Int)spans.size();
+    m_sampleWeightSum[chan] = fWeightSum;
+  }
+}
+
+Void TWSPSNRMetric::xCalculateWSPSNR( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcPicD )
+{
+  Int iBitDepthForPSNRCalc[MAX_NUM_CHANNEL_TYPE];
+  Int iReferenceBitShift[MAX_NUM_CHANNEL_TYPE];
+  Int iOutputBitShift[MAX_NUM_CHANNEL_TYPE];
+  iBitDepthForPSNRCalc[Int(ChannelType::LUMA)] = std::max(m_outputBitDepth[Int(ChannelType::LUMA)], m_referenceBitDepth[Int(ChannelType::LUMA)]);
+  iBitDepthForPSNRCalc[Int(ChannelType::CHROMA)] = std::max(m_outputBitDepth[Int(ChannelType::CHROMA)], m_referenceBitDepth[Int(ChannelType::CHROMA)]);
+  iReferenceBitShift[Int(ChannelType::LUMA)] = iBitDepthForPSNRCalc[Int(ChannelType::LUMA)] - m_referenceBitDepth[Int(ChannelType::LUMA)];
+  iReferenceBitShift[Int(ChannelType::CHROMA)] = iBitDepthForPSNRCalc[Int(ChannelType::CHROMA)] - m_referenceBitDepth[Int(ChannelType::CHROMA)];
+  iOutputBitShift[Int(ChannelType::LUMA)] = iBitDepthForPSNRCalc[Int(ChannelType::LUMA)] - m_outputBitDepth[Int(ChannelType::LUMA)];
+  iOutputBitShift[Int(ChannelType::CHROMA)] = iBitDepthForPSNRCalc[Int(ChannelType::CHROMA)] - m_outputBitDepth[Int(ChannelType::CHROMA)];
+
+  memset(m_dWSPSNR, 0, sizeof(Double)*3);
+  PelUnitBuf &picd=*pcPicD;
+
+  if (m_sampleWeightWidth != pcPicD->get(COMPONENT_Y).width || m_sampleWeightHeight != pcPicD->get(COMPONENT_Y).height || m_sampleWeightFormat != pcPicD->chromaFormat)
+  {
+    xInitSampleWeights(pcPicD);
+  }
+
+  for(Int chan=0; chan< getNumberValidComponents(pcPicD->chromaFormat); chan++)
+  {
+    const ComponentID ch=ComponentID(chan);
+    const Pel*  pOrg       = pcOrgPicYuv->get(ch).bufAt(0, 0);
+    const Int   iOrgStride = (Int)pcOrgPicYuv->get(ch).stride;
+    const Pel*  pRec       = picd.get(ch).bufAt(0, 0);
+    const Int   iRecStride = (Int)picd.get(ch).stride;
+    const Int   iHeight    = pcPicD->get(ch).height;
+    const Int   iOrgShift  = iReferenceBitShift[Int(toChannelType(ch))];
+    const Int   iRecShift  = iOutputBitShift[Int(toChannelType(ch))];
+    const WeightSpan *pSpan   = m_weightSpan[chan].data();
+    const Int        *pRowEnd = m_weightSpanRow[chan].data() + 1;
+
+    Double SSDwpsnr=0;
+    for(Int y = 0; y < iHeight; y++ )
     {
-#endif  // SVIDEO_FISHEYE
-      if (fWeight > 0)
-        fWeightSum += fWeight;
-      SSDwpsnr += iDiff * iDiff*fWeight;
-#if SVIDEO_FISHEYE
-    }
-#endif  // SVIDEO_FISHEYE
+      for (const WeightSpan *pRowSpanEnd = m_weightSpan[chan].data() + pRowEnd[y]; pSpan < pRowSpanEnd; pSpan++)
+      {
+        const Int x0 = pSpan->x0;
+        if (pSpan->weight)
+        {
+          SSDwpsnr += xWeightedSSE(pOrg + x0, iOrgShift, pRec + x0, iRecShift, pSpan->weight, pSpan->x1 - x0);
+        }
+        else
+        {
+          SSDwpsnr += pSpan->rowWeight * (Double)xSSE(pOrg + x0, iOrgShift, pRec + x0, iRecShift, pSpan->x1 - x0);
+        }
       }
-    
-      pOrg += iOrgStride;
-      pRec += iRecStride;
-    }      
+      pOrg    += iOrgStride;
+      pRec    += iRecStride;
+    }
 
     const Int maxval = 255<<(iBitDepthForPSNRCalc[Int(toChannelType(ch))]-8) ;
-    //const Double fRefValue = (Double) maxval * maxval * iSize;
 
-    m_dWSPSNR[ch]         = ( SSDwpsnr ? 10.0 * log10( (maxval * maxval*fWeightSum) / (Double)SSDwpsnr ) : 999.99 );
-}
+    m_dWSPSNR[ch]         = ( SSDwpsnr ? 10.0 * log10( (maxval * maxval*m_sampleWeightSum[chan]) / (Double)SSDwpsnr ) : 999.99 );
+  }
 }
 
 #if SVIDEO_WSPSNR_E2E
@@ -3235,6 +3211,7 @@ Void TWSPSNRMetric::setCodingGeoInfo2(SVideoInfo& sRefVideoInfo, SVideoInfo& sRe
   m_recGeoType = sRecVideoInfo.geoType;  
   m_fisheyeInfo = sRecVideoInfo.sFisheyeInfo;
 #endif
+  m_sampleWeightWidth = 0;
 }
 #if SVIDEO_E2E_METRICS
 Void TWSPSNRMetric::xCalculateE2EWSPSNR( PelUnitBuf *pcPicYuv, PelUnitBuf *pcOrigPicYuv)
@@ -39,6 +39,7 @@
 #define __TWSPSNRCALC__
 #include "TGeometry.h"
 #include "../Utilities/VideoIOYuv.h"
+#include <vector>
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -117,6 +118,20 @@ private:
 #if SVIDEO_FISHEYE
   FisheyeInfo m_fisheyeInfo;
 #endif
+  struct WeightSpan
+  {
+    Int           x0, x1;                                   //samples [x0, x1) of a row;
+    const Double* weight;                                   //weight of the sample at x0 and the following ones in the geometry table, nullptr if they all have rowWeight;
+    Double        rowWeight;
+  };
+  std::vector<WeightSpan> m_weightSpan[MAX_NUM_COMPONENT];  //runs of measured samples row by row, the weights stay in the geometry tables;
+  std::vector<Int>        m_weightSpanRow[MAX_NUM_COMPONENT];  //index of the first span of each row, followed by the span count;
+  Double       m_sampleWeightSum[MAX_NUM_COMPONENT];       //sum of the positive weights;
+  Int          m_sampleWeightWidth;                        //luma size the weights were built for, 0 if they must be rebuilt;
+  Int          m_sampleWeightHeight;
+  ChromaFormat m_sampleWeightFormat;
+
+  Void    xInitSampleWeights(const PelUnitBuf* pcPicD);
 public:
   TWSPSNRMetric();
   virtual ~TWSPSNRMetric();
@@ -139,9 +154,10 @@ public:
 #if SVIDEO_FISHEYE
   m_fisheyeInfo = sVidInfo.sFisheyeInfo;
 #endif
+    m_sampleWeightWidth = 0;
   }
 #if SVIDEO_ERP_PADDING
-  Void    setPERPFlag(Bool bPERP) { m_bPERP = bPERP; }
+  Void    setPERPFlag(Bool bPERP) { m_bPERP = bPERP; m_sampleWeightWidth = 0; }
 #endif
 
 #if SVIDEO_WSPSNR_E2E